@@ -21,7 +21,7 @@ set WX_LIBS=-L%WXWIN%\lib\gcc_dll -lwxmsw32u_core_gcc_custom -lwxbase32u_gcc_cus
 
 
 :: Windows system libraries required for wxWidgets
-set SYS_LIBS=-lkernel32 -luser32 -lgdi32 -lwinspool -lcomdlg32 -ladvapi32 -lshell32 -lole32 -loleaut32 -luuid -lcomctl32 -lwsock32 -lodbc32
+set SYS_LIBS=-lkernel32 -luser32 -lgdi32 -lwinspool -lcomdlg32 -ladvapi32 -lshell32 -lole32 -loleaut32 -luuid -lcomctl32 -lwsock32 -lodbc32 -lws2_32
 
 echo ========================================
 echo Building GUI Version with wxWidgets
@@ -80,6 +80,9 @@ if %ERRORLEVEL% neq 0 goto :error
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\models\Booking.cpp -o %OBJ_DIR%\Booking.o
 if %ERRORLEVEL% neq 0 goto :error
 
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\models\BookingSeries.cpp -o %OBJ_DIR%\BookingSeries.o
+if %ERRORLEVEL% neq 0 goto :error
+
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\models\Statistics.cpp -o %OBJ_DIR%\Statistics.o
 if %ERRORLEVEL% neq 0 goto :error
 
@@ -97,6 +100,12 @@ if %ERRORLEVEL% neq 0 goto :error
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\controllers\StatisticsController.cpp -o %OBJ_DIR%\StatisticsController.o
 if %ERRORLEVEL% neq 0 goto :error
 
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\controllers\BookingClient.cpp -o %OBJ_DIR%\BookingClient.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\controllers\BookingReplica.cpp -o %OBJ_DIR%\BookingReplica.o
+if %ERRORLEVEL% neq 0 goto :error
+
 :: Compile patterns
 echo Compiling design patterns...
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\patterns\BookingManager.cpp -o %OBJ_DIR%\BookingManager.o
@@ -105,6 +114,24 @@ if %ERRORLEVEL% neq 0 goto :error
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\patterns\NotificationObserver.cpp -o %OBJ_DIR%\NotificationObserver.o
 if %ERRORLEVEL% neq 0 goto :error
 
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\patterns\NotificationDispatcher.cpp -o %OBJ_DIR%\NotificationDispatcher.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\patterns\ReminderScheduler.cpp -o %OBJ_DIR%\ReminderScheduler.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\patterns\NotificationOutbox.cpp -o %OBJ_DIR%\NotificationOutbox.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\patterns\PricingEngine.cpp -o %OBJ_DIR%\PricingEngine.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\patterns\BookingServer.cpp -o %OBJ_DIR%\BookingServer.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\patterns\ChangeFeed.cpp -o %OBJ_DIR%\ChangeFeed.o
+if %ERRORLEVEL% neq 0 goto :error
+
 :: Compile utilities
 echo Compiling utilities...
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\Database.cpp -o %OBJ_DIR%\Database.o
@@ -113,6 +140,39 @@ if %ERRORLEVEL% neq 0 goto :error
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\DateTimeUtils.cpp -o %OBJ_DIR%\DateTimeUtils.o
 if %ERRORLEVEL% neq 0 goto :error
 
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\BookingIndex.cpp -o %OBJ_DIR%\BookingIndex.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\SearchIndex.cpp -o %OBJ_DIR%\SearchIndex.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\OccupancyMap.cpp -o %OBJ_DIR%\OccupancyMap.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\IntervalSet.cpp -o %OBJ_DIR%\IntervalSet.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\Waitlist.cpp -o %OBJ_DIR%\Waitlist.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\TimerWheel.cpp -o %OBJ_DIR%\TimerWheel.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\SmtpClient.cpp -o %OBJ_DIR%\SmtpClient.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\NotificationTemplate.cpp -o %OBJ_DIR%\NotificationTemplate.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\NumberFormat.cpp -o %OBJ_DIR%\NumberFormat.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\SocketUtils.cpp -o %OBJ_DIR%\SocketUtils.o
+if %ERRORLEVEL% neq 0 goto :error
+
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\utils\BookingProtocol.cpp -o %OBJ_DIR%\BookingProtocol.o
+if %ERRORLEVEL% neq 0 goto :error
+
 :: Compile GUI views (create stubs first if needed)
 echo Compiling GUI views...
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\views\LoginFrame.cpp -o %OBJ_DIR%\LoginFrame.o
@@ -129,6 +189,8 @@ g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\views\StatisticsPanel
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\views\RegisterDialog.cpp -o %OBJ_DIR%\RegisterDialog.o
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\views\UserManagementPanel.cpp -o %OBJ_DIR%\UserManagementPanel.o
 g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\views\AdminPanel.cpp -o %OBJ_DIR%\AdminPanel.o
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\views\ScheduleGridPanel.cpp -o %OBJ_DIR%\ScheduleGridPanel.o
+g++ %CXX_FLAGS% %INCLUDE_FLAGS% %WX_CXXFLAGS% -c %SRC_DIR%\views\CourtTimeline.cpp -o %OBJ_DIR%\CourtTimeline.o
 
 :: Compile main (GUI version)
 echo Compiling main GUI application...
@@ -145,15 +207,35 @@ g++ %CXX_FLAGS% ^
     %OBJ_DIR%\User.o ^
     %OBJ_DIR%\Court.o ^
     %OBJ_DIR%\Booking.o ^
+    %OBJ_DIR%\BookingSeries.o ^
     %OBJ_DIR%\Statistics.o ^
     %OBJ_DIR%\AuthController.o ^
     %OBJ_DIR%\CourtController.o ^
     %OBJ_DIR%\BookingController.o ^
     %OBJ_DIR%\StatisticsController.o ^
+    %OBJ_DIR%\BookingClient.o ^
+    %OBJ_DIR%\BookingReplica.o ^
     %OBJ_DIR%\BookingManager.o ^
     %OBJ_DIR%\NotificationObserver.o ^
+    %OBJ_DIR%\NotificationDispatcher.o ^
+    %OBJ_DIR%\ReminderScheduler.o ^
+    %OBJ_DIR%\NotificationOutbox.o ^
+    %OBJ_DIR%\PricingEngine.o ^
+    %OBJ_DIR%\BookingServer.o ^
+    %OBJ_DIR%\ChangeFeed.o ^
     %OBJ_DIR%\Database.o ^
     %OBJ_DIR%\DateTimeUtils.o ^
+    %OBJ_DIR%\BookingIndex.o ^
+    %OBJ_DIR%\SearchIndex.o ^
+    %OBJ_DIR%\OccupancyMap.o ^
+    %OBJ_DIR%\IntervalSet.o ^
+    %OBJ_DIR%\Waitlist.o ^
+    %OBJ_DIR%\TimerWheel.o ^
+    %OBJ_DIR%\SmtpClient.o ^
+    %OBJ_DIR%\NotificationTemplate.o ^
+    %OBJ_DIR%\NumberFormat.o ^
+    %OBJ_DIR%\SocketUtils.o ^
+    %OBJ_DIR%\BookingProtocol.o ^
     %OBJ_DIR%\LoginFrame.o ^
     %OBJ_DIR%\MainFrame.o ^
     %OBJ_DIR%\CourtManagementPanel.o ^
@@ -162,6 +244,8 @@ g++ %CXX_FLAGS% ^
     %OBJ_DIR%\RegisterDialog.o ^
     %OBJ_DIR%\UserManagementPanel.o ^
     %OBJ_DIR%\AdminPanel.o ^
+    %OBJ_DIR%\ScheduleGridPanel.o ^
+    %OBJ_DIR%\CourtTimeline.o ^
     %OBJ_DIR%\main.o ^
     %WX_LIBS% ^
     %SYS_LIBS% ^
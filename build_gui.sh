@@ -57,6 +57,7 @@ compile() {
 compile "$SRC_DIR/models/User.cpp" "$OBJ_DIR/User.o"
 compile "$SRC_DIR/models/Court.cpp" "$OBJ_DIR/Court.o"
 compile "$SRC_DIR/models/Booking.cpp" "$OBJ_DIR/Booking.o"
+compile "$SRC_DIR/models/BookingSeries.cpp" "$OBJ_DIR/BookingSeries.o"
 compile "$SRC_DIR/models/Statistics.cpp" "$OBJ_DIR/Statistics.o"
 
 # Compile controllers
@@ -64,14 +65,33 @@ compile "$SRC_DIR/controllers/AuthController.cpp" "$OBJ_DIR/AuthController.o"
 compile "$SRC_DIR/controllers/CourtController.cpp" "$OBJ_DIR/CourtController.o"
 compile "$SRC_DIR/controllers/BookingController.cpp" "$OBJ_DIR/BookingController.o"
 compile "$SRC_DIR/controllers/StatisticsController.cpp" "$OBJ_DIR/StatisticsController.o"
+compile "$SRC_DIR/controllers/BookingClient.cpp" "$OBJ_DIR/BookingClient.o"
+compile "$SRC_DIR/controllers/BookingReplica.cpp" "$OBJ_DIR/BookingReplica.o"
 
 # Compile patterns
 compile "$SRC_DIR/patterns/BookingManager.cpp" "$OBJ_DIR/BookingManager.o"
 compile "$SRC_DIR/patterns/NotificationObserver.cpp" "$OBJ_DIR/NotificationObserver.o"
+compile "$SRC_DIR/patterns/NotificationDispatcher.cpp" "$OBJ_DIR/NotificationDispatcher.o"
+compile "$SRC_DIR/patterns/ReminderScheduler.cpp" "$OBJ_DIR/ReminderScheduler.o"
+compile "$SRC_DIR/patterns/NotificationOutbox.cpp" "$OBJ_DIR/NotificationOutbox.o"
+compile "$SRC_DIR/patterns/PricingEngine.cpp" "$OBJ_DIR/PricingEngine.o"
+compile "$SRC_DIR/patterns/BookingServer.cpp" "$OBJ_DIR/BookingServer.o"
+compile "$SRC_DIR/patterns/ChangeFeed.cpp" "$OBJ_DIR/ChangeFeed.o"
 
 # Compile utils
 compile "$SRC_DIR/utils/Database.cpp" "$OBJ_DIR/Database.o"
 compile "$SRC_DIR/utils/DateTimeUtils.cpp" "$OBJ_DIR/DateTimeUtils.o"
+compile "$SRC_DIR/utils/BookingIndex.cpp" "$OBJ_DIR/BookingIndex.o"
+compile "$SRC_DIR/utils/SearchIndex.cpp" "$OBJ_DIR/SearchIndex.o"
+compile "$SRC_DIR/utils/OccupancyMap.cpp" "$OBJ_DIR/OccupancyMap.o"
+compile "$SRC_DIR/utils/IntervalSet.cpp" "$OBJ_DIR/IntervalSet.o"
+compile "$SRC_DIR/utils/Waitlist.cpp" "$OBJ_DIR/Waitlist.o"
+compile "$SRC_DIR/utils/TimerWheel.cpp" "$OBJ_DIR/TimerWheel.o"
+compile "$SRC_DIR/utils/SmtpClient.cpp" "$OBJ_DIR/SmtpClient.o"
+compile "$SRC_DIR/utils/NotificationTemplate.cpp" "$OBJ_DIR/NotificationTemplate.o"
+compile "$SRC_DIR/utils/NumberFormat.cpp" "$OBJ_DIR/NumberFormat.o"
+compile "$SRC_DIR/utils/SocketUtils.cpp" "$OBJ_DIR/SocketUtils.o"
+compile "$SRC_DIR/utils/BookingProtocol.cpp" "$OBJ_DIR/BookingProtocol.o"
 
 # Compile views
 compile "$SRC_DIR/views/LoginFrame.cpp" "$OBJ_DIR/LoginFrame.o"
@@ -82,6 +102,8 @@ compile "$SRC_DIR/views/StatisticsPanel.cpp" "$OBJ_DIR/StatisticsPanel.o"
 compile "$SRC_DIR/views/RegisterDialog.cpp" "$OBJ_DIR/RegisterDialog.o"
 compile "$SRC_DIR/views/UserManagementPanel.cpp" "$OBJ_DIR/UserManagementPanel.o"
 compile "$SRC_DIR/views/AdminPanel.cpp" "$OBJ_DIR/AdminPanel.o"
+compile "$SRC_DIR/views/ScheduleGridPanel.cpp" "$OBJ_DIR/ScheduleGridPanel.o"
+compile "$SRC_DIR/views/CourtTimeline.cpp" "$OBJ_DIR/CourtTimeline.o"
 
 # Compile main
 compile "$SRC_DIR/main.cpp" "$OBJ_DIR/main.o"
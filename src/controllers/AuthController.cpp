@@ -1,13 +1,14 @@
 #include "AuthController.h"
+#include "ChangeFeed.h"
 #include <algorithm>
 #include <fstream>
 #include <sstream>
-#include <regex>
 #include <filesystem>
 
-AuthController::AuthController() : m_currentUser(nullptr)
+AuthController::AuthController() : m_currentUser(nullptr), m_nextUserId(1), m_userSearch({3, 2, 2})
 {
     loadUsers();
+    loadUserSequence();
 
     // Clean up any duplicate admin@badminton.com entries first
     std::vector<User *> adminDuplicates;
@@ -53,6 +54,8 @@ AuthController::AuthController() : m_currentUser(nullptr)
         m_users.push_back(adminDuplicates[0]); // Keep only the first one
         saveUsers();
     }
+
+    rebuildIndexes();
 }
 
 AuthController::~AuthController()
@@ -108,7 +111,11 @@ bool AuthController::registerUser(const std::string &email, const std::string &p
     newUser->setId(generateUserId());
 
     m_users.push_back(newUser);
+    m_usersById[newUser->getId()] = newUser;
+    m_usersByEmail[foldEmail(newUser->getEmail())] = newUser;
+    indexUser(newUser);
     saveUsers(); // Save changes immediately
+    publishUser(newUser);
     return true;
 }
 
@@ -119,24 +126,47 @@ std::vector<User *> AuthController::getAllUsers() const
 
 User *AuthController::getUserById(int userId) const
 {
-    auto it = std::find_if(m_users.begin(), m_users.end(),
-                           [userId](const User *user)
-                           {
-                               return user->getId() == userId;
-                           });
-
-    return (it != m_users.end()) ? *it : nullptr;
+    auto it = m_usersById.find(userId);
+    return (it != m_usersById.end()) ? it->second : nullptr;
 }
 
 User *AuthController::getUserByEmail(const std::string &email) const
 {
-    auto it = std::find_if(m_users.begin(), m_users.end(),
-                           [&email](const User *user)
-                           {
-                               return user->getEmail() == email;
-                           });
+    // Emails are matched case-insensitively
+    auto it = m_usersByEmail.find(foldEmail(email));
+    return (it != m_usersByEmail.end()) ? it->second : nullptr;
+}
+
+std::vector<User *> AuthController::searchUsers(const std::string &text, size_t limit) const
+{
+    std::vector<User *> result;
+    for (const auto &match : m_userSearch.search(text, limit))
+    {
+        if (User *user = getUserById(match.docId))
+        {
+            result.push_back(user);
+        }
+    }
+    return result;
+}
 
-    return (it != m_users.end()) ? *it : nullptr;
+std::vector<int> AuthController::searchUserIds(const std::string &text) const
+{
+    return m_userSearch.searchIds(text);
+}
+
+bool AuthController::getUserContact(int userId, std::string &fullName, std::string &email,
+                                    std::string &phoneNumber) const
+{
+    std::lock_guard<std::mutex> lock(m_contactsMutex);
+    auto it = m_contacts.find(userId);
+    if (it == m_contacts.end())
+        return false;
+
+    fullName = it->second.fullName;
+    email = it->second.email;
+    phoneNumber = it->second.phoneNumber;
+    return true;
 }
 
 bool AuthController::updateUser(int userId, const User &updatedUser)
@@ -146,19 +176,24 @@ bool AuthController::updateUser(int userId, const User &updatedUser)
         return false;
 
     // Check if email is changing and if new email is available
-    if (user->getEmail() != updatedUser.getEmail() && isEmailTaken(updatedUser.getEmail()))
+    User *owner = getUserByEmail(updatedUser.getEmail());
+    if (owner && owner != user)
     {
         return false;
     }
 
     // Update user data
+    m_usersByEmail.erase(foldEmail(user->getEmail()));
     user->setEmail(updatedUser.getEmail());
+    m_usersByEmail[foldEmail(user->getEmail())] = user;
     user->setFullName(updatedUser.getFullName());
     user->setPhoneNumber(updatedUser.getPhoneNumber());
     user->setRole(updatedUser.getRole());
     user->setActive(updatedUser.isActive());
+    indexUser(user);
 
     saveUsers(); // Save changes immediately
+    publishUser(user);
     return true;
 }
 
@@ -173,10 +208,19 @@ bool AuthController::deleteUser(int userId)
     if (it != m_users.end())
     {
         // Clean up memory before removing
+        m_userSearch.removeDocument(userId);
+        m_usersById.erase(userId);
+        m_usersByEmail.erase(foldEmail((*it)->getEmail()));
+        {
+            std::lock_guard<std::mutex> lock(m_contactsMutex);
+            m_contacts.erase(userId);
+        }
         delete *it;
         // Actually remove the user from the list
         m_users.erase(it);
         saveUsers(); // Save changes immediately
+        if (m_changeFeed)
+            m_changeFeed->publishUserRemoved(userId);
         return true;
     }
 
@@ -191,6 +235,7 @@ bool AuthController::changeUserRole(int userId, UserRole newRole)
 
     user->setRole(newRole);
     saveUsers(); // Save changes immediately
+    publishUser(user);
     return true;
 }
 
@@ -202,6 +247,7 @@ bool AuthController::toggleUserStatus(int userId)
 
     user->setActive(!user->isActive());
     saveUsers(); // Save changes immediately
+    publishUser(user);
     return true;
 }
 
@@ -223,11 +269,63 @@ bool AuthController::changePassword(int userId, const std::string &oldPassword,
     return true;
 }
 
+void AuthController::setChangeFeed(ChangeFeed *feed)
+{
+    m_changeFeed = feed;
+    for (const User *user : m_users)
+    {
+        publishUser(user);
+    }
+}
+
 bool AuthController::validateEmail(const std::string &email) const
 {
-    // Simple email validation using regex
-    std::regex emailRegex(R"([a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,})");
-    return std::regex_match(email, emailRegex);
+    // Single pass equivalent of [a-zA-Z0-9._%+-]+@[a-zA-Z0-9.-]+\.[a-zA-Z]{2,}
+    auto isAlpha = [](char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    };
+    auto isAlnum = [&isAlpha](char c)
+    {
+        return isAlpha(c) || (c >= '0' && c <= '9');
+    };
+
+    size_t at = std::string::npos;
+    size_t lastDot = std::string::npos;
+    for (size_t i = 0; i < email.size(); ++i)
+    {
+        char c = email[i];
+        if (c == '@')
+        {
+            if (at != std::string::npos)
+                return false; // Only one '@'
+            at = i;
+        }
+        else if (at == std::string::npos)
+        {
+            if (!isAlnum(c) && c != '.' && c != '_' && c != '%' && c != '+' && c != '-')
+                return false;
+        }
+        else
+        {
+            if (!isAlnum(c) && c != '.' && c != '-')
+                return false;
+            if (c == '.')
+                lastDot = i;
+        }
+    }
+
+    // Non-empty local part and domain label, then a top-level domain of two or more letters
+    if (at == std::string::npos || at == 0 || lastDot == std::string::npos || lastDot <= at + 1)
+        return false;
+    if (email.size() - lastDot - 1 < 2)
+        return false;
+    for (size_t i = lastDot + 1; i < email.size(); ++i)
+    {
+        if (!isAlpha(email[i]))
+            return false;
+    }
+    return true;
 }
 
 bool AuthController::validatePassword(const std::string &password) const
@@ -343,13 +441,99 @@ void AuthController::saveUsers()
 
 int AuthController::generateUserId()
 {
+    // Ids come from a persisted sequence so deleted ids are never reused
+    int userId = m_nextUserId++;
+    saveUserSequence();
+    return userId;
+}
+
+void AuthController::loadUserSequence()
+{
+    std::ifstream file("data/users.seq");
+    int storedNext = 0;
+    if (file.is_open())
+    {
+        file >> storedNext;
+    }
+
+    // Never hand out an id that is already in users.txt, even if the sequence file is stale
     int maxId = 0;
     for (const auto &user : m_users)
     {
-        if (user->getId() > maxId)
+        if (user && user->getId() > maxId)
         {
             maxId = user->getId();
         }
     }
-    return maxId + 1;
+    m_nextUserId = std::max(storedNext, maxId + 1);
+}
+
+void AuthController::saveUserSequence() const
+{
+    std::filesystem::create_directories("data");
+    std::ofstream file("data/users.seq");
+    if (file.is_open())
+    {
+        file << m_nextUserId << std::endl;
+    }
+}
+
+void AuthController::indexUser(const User *user)
+{
+    // Phone numbers are indexed as digits only
+    std::string phoneDigits;
+    for (char c : user->getPhoneNumber())
+    {
+        if (c >= '0' && c <= '9')
+        {
+            phoneDigits.push_back(c);
+        }
+    }
+    m_userSearch.addDocument(user->getId(), {user->getFullName(), user->getEmail(), phoneDigits});
+
+    std::lock_guard<std::mutex> lock(m_contactsMutex);
+    m_contacts[user->getId()] = Contact{user->getFullName(), user->getEmail(), user->getPhoneNumber()};
+}
+
+void AuthController::publishUser(const User *user)
+{
+    if (m_changeFeed)
+    {
+        m_changeFeed->publishUser(*user);
+    }
+}
+
+void AuthController::rebuildIndexes()
+{
+    m_usersById.clear();
+    m_usersByEmail.clear();
+    m_userSearch.clear();
+    {
+        std::lock_guard<std::mutex> lock(m_contactsMutex);
+        m_contacts.clear();
+    }
+    m_usersById.reserve(m_users.size());
+    m_usersByEmail.reserve(m_users.size());
+    for (const auto &user : m_users)
+    {
+        if (user)
+        {
+            m_usersById[user->getId()] = user;
+            m_usersByEmail[foldEmail(user->getEmail())] = user;
+            indexUser(user);
+        }
+    }
+}
+
+std::string AuthController::foldEmail(const std::string &email)
+{
+    std::string folded = email;
+    for (char &c : folded)
+    {
+        if (c >= 'A' && c <= 'Z')
+        {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+    }
+    return folded;
 }
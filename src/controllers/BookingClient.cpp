@@ -0,0 +1,584 @@
+#include "BookingClient.h"
+#include "SocketUtils.h"
+#include <algorithm>
+
+namespace
+{
+    // u8 op | u32 requestId | u8 status
+    const size_t RESPONSE_HEADER_SIZE = 6;
+
+    MessageWriter beginRequest(ProtocolOp op, uint32_t requestId)
+    {
+        MessageWriter request;
+        request.writeU8(static_cast<uint8_t>(op));
+        request.writeU32(requestId);
+        return request;
+    }
+
+    void writeCreate(MessageWriter &request, int userId, int courtId, std::time_t bookingDate,
+                     std::time_t startTime, std::time_t endTime, const std::string &notes)
+    {
+        request.writeI32(userId);
+        request.writeI32(courtId);
+        request.writeI64(bookingDate);
+        request.writeI64(startTime);
+        request.writeI64(endTime);
+        request.writeString(notes);
+    }
+
+    void writeModify(MessageWriter &request, int bookingId, std::time_t newStartTime,
+                     std::time_t newEndTime, const std::string &notes)
+    {
+        request.writeI32(bookingId);
+        request.writeI64(newStartTime);
+        request.writeI64(newEndTime);
+        request.writeString(notes);
+    }
+
+    void writeCourtDay(MessageWriter &request, int courtId, std::time_t date)
+    {
+        request.writeI32(courtId);
+        request.writeI64(date);
+    }
+
+    void writeInterval(MessageWriter &request, int courtId, std::time_t startTime, std::time_t endTime)
+    {
+        request.writeI32(courtId);
+        request.writeI64(startTime);
+        request.writeI64(endTime);
+    }
+
+    bool readBookings(MessageReader &reader, std::vector<Booking> &bookings)
+    {
+        uint32_t count = reader.readU32();
+        bookings.clear();
+        for (uint32_t i = 0; i < count && reader.ok(); ++i)
+        {
+            Booking booking;
+            if (reader.readBooking(booking))
+            {
+                bookings.push_back(booking);
+            }
+        }
+        return reader.ok();
+    }
+
+    // u8 more, then the page of bookings
+    bool readBookingPage(MessageReader &reader, std::vector<Booking> &bookings, bool &more)
+    {
+        more = reader.readU8() != 0;
+        return readBookings(reader, bookings);
+    }
+
+    void writeFindPage(MessageWriter &request, const BookingQuery &query, std::time_t afterStart, int afterId)
+    {
+        request.writeQuery(query);
+        request.writeI64(afterStart);
+        request.writeI32(afterId);
+    }
+
+    bool readSlots(MessageReader &reader, std::vector<std::pair<std::time_t, std::time_t>> &slots)
+    {
+        uint32_t count = reader.readU32();
+        slots.clear();
+        for (uint32_t i = 0; i < count && reader.ok(); ++i)
+        {
+            std::time_t start = static_cast<std::time_t>(reader.readI64());
+            std::time_t end = static_cast<std::time_t>(reader.readI64());
+            slots.push_back(std::make_pair(start, end));
+        }
+        return reader.ok();
+    }
+
+    bool readCourts(MessageReader &reader, std::vector<Court> &courts)
+    {
+        uint32_t count = reader.readU32();
+        courts.clear();
+        for (uint32_t i = 0; i < count && reader.ok(); ++i)
+        {
+            Court court;
+            if (reader.readCourt(court))
+            {
+                courts.push_back(court);
+            }
+        }
+        return reader.ok();
+    }
+
+    // Responses echo the op and request id of the request they answer
+    bool matchesRequest(const std::string &payload, const std::string &requestFrame)
+    {
+        return payload.size() >= RESPONSE_HEADER_SIZE &&
+               payload.compare(0, 5, requestFrame, BookingProtocol::HEADER_SIZE, 5) == 0;
+    }
+
+    ProtocolStatus statusOf(const std::string &payload)
+    {
+        return static_cast<ProtocolStatus>(static_cast<unsigned char>(payload[5]));
+    }
+}
+
+// BookingRequestBatch implementation
+size_t BookingRequestBatch::addPing()
+{
+    add(ProtocolOp::PING);
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addGetBooking(int bookingId)
+{
+    add(ProtocolOp::GET_BOOKING).writeI32(bookingId);
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addFindBookings(const BookingQuery &query, std::time_t afterStart, int afterId)
+{
+    writeFindPage(add(ProtocolOp::FIND_BOOKINGS), query, afterStart, afterId);
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addCourtOccupancy(int courtId, std::time_t date)
+{
+    writeCourtDay(add(ProtocolOp::GET_COURT_OCCUPANCY), courtId, date);
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addAvailableSlots(int courtId, std::time_t date, int slotDurationMinutes)
+{
+    MessageWriter &request = add(ProtocolOp::GET_AVAILABLE_SLOTS);
+    writeCourtDay(request, courtId, date);
+    request.writeU32(static_cast<uint32_t>(slotDurationMinutes));
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addGetCourts()
+{
+    add(ProtocolOp::GET_COURTS);
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addEstimateCost(int courtId, std::time_t startTime, std::time_t endTime)
+{
+    writeInterval(add(ProtocolOp::ESTIMATE_COST), courtId, startTime, endTime);
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addCreateBooking(int userId, int courtId, std::time_t bookingDate,
+                                             std::time_t startTime, std::time_t endTime,
+                                             const std::string &notes)
+{
+    writeCreate(add(ProtocolOp::CREATE_BOOKING), userId, courtId, bookingDate, startTime, endTime, notes);
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addCancelBooking(int bookingId)
+{
+    add(ProtocolOp::CANCEL_BOOKING).writeI32(bookingId);
+    return m_requests.size() - 1;
+}
+
+size_t BookingRequestBatch::addModifyBooking(int bookingId, std::time_t newStartTime,
+                                             std::time_t newEndTime, const std::string &notes)
+{
+    writeModify(add(ProtocolOp::MODIFY_BOOKING), bookingId, newStartTime, newEndTime, notes);
+    return m_requests.size() - 1;
+}
+
+void BookingRequestBatch::clear()
+{
+    m_requests.clear();
+    m_responses.clear();
+    m_version = 0;
+}
+
+ProtocolStatus BookingRequestBatch::getStatus(size_t index) const
+{
+    if (index >= m_responses.size() || m_responses[index].size() < RESPONSE_HEADER_SIZE)
+        return ProtocolStatus::SERVER_ERROR; // Not run, or the exchange failed
+    return statusOf(m_responses[index]);
+}
+
+bool BookingRequestBatch::getBooking(size_t index, Booking &booking) const
+{
+    MessageReader reader(nullptr, 0);
+    return openResult(index, reader) && reader.readBooking(booking);
+}
+
+bool BookingRequestBatch::getBookings(size_t index, std::vector<Booking> &bookings) const
+{
+    MessageReader reader(nullptr, 0);
+    bool more;
+    return openResult(index, reader) && readBookingPage(reader, bookings, more);
+}
+
+bool BookingRequestBatch::hasMoreBookings(size_t index) const
+{
+    MessageReader reader(nullptr, 0);
+    return openResult(index, reader) && reader.readU8() != 0 && reader.ok();
+}
+
+bool BookingRequestBatch::getCourtOccupancy(size_t index, OccupancyMap::DayBits &bits) const
+{
+    MessageReader reader(nullptr, 0);
+    return openResult(index, reader) && reader.readDayBits(bits);
+}
+
+bool BookingRequestBatch::getAvailableSlots(size_t index, std::vector<std::pair<std::time_t, std::time_t>> &slots) const
+{
+    MessageReader reader(nullptr, 0);
+    return openResult(index, reader) && readSlots(reader, slots);
+}
+
+bool BookingRequestBatch::getCourts(size_t index, std::vector<Court> &courts) const
+{
+    MessageReader reader(nullptr, 0);
+    return openResult(index, reader) && readCourts(reader, courts);
+}
+
+bool BookingRequestBatch::getCost(size_t index, double &cost) const
+{
+    MessageReader reader(nullptr, 0);
+    if (!openResult(index, reader))
+        return false;
+    cost = reader.readDouble();
+    return reader.ok();
+}
+
+MessageWriter &BookingRequestBatch::add(ProtocolOp op)
+{
+    m_requests.push_back(beginRequest(op, static_cast<uint32_t>(m_requests.size())));
+    return m_requests.back();
+}
+
+bool BookingRequestBatch::openResult(size_t index, MessageReader &reader) const
+{
+    if (getStatus(index) != ProtocolStatus::OK)
+        return false;
+
+    const std::string &payload = m_responses[index];
+    reader = MessageReader(payload.data() + RESPONSE_HEADER_SIZE, payload.size() - RESPONSE_HEADER_SIZE);
+    return true;
+}
+
+// BookingClient implementation
+BookingClient::BookingClient()
+    : m_socket(SocketUtils::INVALID_HANDLE), m_nextRequestId(1), m_lastStatus(ProtocolStatus::OK)
+{
+}
+
+BookingClient::~BookingClient()
+{
+    close();
+}
+
+bool BookingClient::connect(const std::string &address, int timeoutSeconds)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SocketUtils::close(m_socket);
+    m_socket = SocketUtils::connectTo(address, timeoutSeconds, m_lastError);
+    return m_socket != SocketUtils::INVALID_HANDLE;
+}
+
+void BookingClient::close()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    SocketUtils::close(m_socket);
+    m_socket = SocketUtils::INVALID_HANDLE;
+}
+
+bool BookingClient::isConnected() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_socket != SocketUtils::INVALID_HANDLE;
+}
+
+std::string BookingClient::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastError;
+}
+
+ProtocolStatus BookingClient::getLastStatus() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastStatus;
+}
+
+bool BookingClient::ping()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::PING, m_nextRequestId++);
+    MessageReader body(nullptr, 0);
+    return call(request, body);
+}
+
+bool BookingClient::createBooking(int userId, int courtId, std::time_t bookingDate,
+                                  std::time_t startTime, std::time_t endTime,
+                                  const std::string &notes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::CREATE_BOOKING, m_nextRequestId++);
+    writeCreate(request, userId, courtId, bookingDate, startTime, endTime, notes);
+    MessageReader body(nullptr, 0);
+    return call(request, body);
+}
+
+bool BookingClient::cancelBooking(int bookingId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::CANCEL_BOOKING, m_nextRequestId++);
+    request.writeI32(bookingId);
+    MessageReader body(nullptr, 0);
+    return call(request, body);
+}
+
+bool BookingClient::modifyBooking(int bookingId, std::time_t newStartTime,
+                                  std::time_t newEndTime, const std::string &notes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::MODIFY_BOOKING, m_nextRequestId++);
+    writeModify(request, bookingId, newStartTime, newEndTime, notes);
+    MessageReader body(nullptr, 0);
+    return call(request, body);
+}
+
+bool BookingClient::getBooking(int bookingId, Booking &booking)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::GET_BOOKING, m_nextRequestId++);
+    request.writeI32(bookingId);
+    MessageReader body(nullptr, 0);
+    return call(request, body) && body.readBooking(booking);
+}
+
+bool BookingClient::findBookings(const BookingQuery &query, std::vector<Booking> &bookings)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bookings.clear();
+    std::time_t afterStart = 0;
+    int afterId = 0;
+    for (;;)
+    {
+        MessageWriter request = beginRequest(ProtocolOp::FIND_BOOKINGS, m_nextRequestId++);
+        writeFindPage(request, query, afterStart, afterId);
+        MessageReader body(nullptr, 0);
+        std::vector<Booking> page;
+        bool more;
+        if (!call(request, body) || !readBookingPage(body, page, more))
+            return false;
+
+        bookings.insert(bookings.end(), page.begin(), page.end());
+        if (!more || page.empty())
+            return true;
+        afterStart = page.back().getStartTime();
+        afterId = page.back().getId();
+    }
+}
+
+bool BookingClient::getCourtOccupancy(int courtId, std::time_t date, OccupancyMap::DayBits &bits)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::GET_COURT_OCCUPANCY, m_nextRequestId++);
+    writeCourtDay(request, courtId, date);
+    MessageReader body(nullptr, 0);
+    return call(request, body) && body.readDayBits(bits);
+}
+
+bool BookingClient::getAvailableSlots(int courtId, std::time_t date, int slotDurationMinutes,
+                                      std::vector<std::pair<std::time_t, std::time_t>> &slots)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::GET_AVAILABLE_SLOTS, m_nextRequestId++);
+    writeCourtDay(request, courtId, date);
+    request.writeU32(static_cast<uint32_t>(slotDurationMinutes));
+    MessageReader body(nullptr, 0);
+    return call(request, body) && readSlots(body, slots);
+}
+
+bool BookingClient::getCourts(std::vector<Court> &courts)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::GET_COURTS, m_nextRequestId++);
+    MessageReader body(nullptr, 0);
+    return call(request, body) && readCourts(body, courts);
+}
+
+bool BookingClient::calculateBookingCost(int courtId, std::time_t startTime, std::time_t endTime, double &cost)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    MessageWriter request = beginRequest(ProtocolOp::ESTIMATE_COST, m_nextRequestId++);
+    writeInterval(request, courtId, startTime, endTime);
+    MessageReader body(nullptr, 0);
+    if (!call(request, body))
+        return false;
+
+    cost = body.readDouble();
+    return body.ok();
+}
+
+bool BookingClient::execute(BookingRequestBatch &batch)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    batch.m_responses.clear();
+    batch.m_version = 0;
+
+    MessageWriter request = beginRequest(ProtocolOp::BATCH, m_nextRequestId++);
+    request.writeU32(static_cast<uint32_t>(batch.m_requests.size()));
+    for (MessageWriter &item : batch.m_requests)
+    {
+        const std::string &frame = item.finish();
+        request.writeBytes(frame.data(), frame.size());
+    }
+
+    MessageReader body(nullptr, 0);
+    if (!call(request, body))
+        return false;
+
+    batch.m_version = static_cast<uint64_t>(body.readI64());
+    uint32_t count = body.readU32();
+    if (count != batch.m_requests.size())
+    {
+        fail("Batch response does not match the request");
+        return false;
+    }
+
+    batch.m_responses.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t length = body.readU32();
+        const char *payload = body.readBytes(length);
+        if (!payload)
+        {
+            fail("Malformed batch response from the booking server");
+            batch.m_responses.clear();
+            return false;
+        }
+
+        batch.m_responses[i].assign(payload, length);
+        if (!matchesRequest(batch.m_responses[i], batch.m_requests[i].finish()))
+        {
+            fail("Batch response does not match the request");
+            batch.m_responses.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool BookingClient::pipeline(BookingRequestBatch &batch)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    batch.m_responses.clear();
+    batch.m_version = 0;
+    if (m_socket == SocketUtils::INVALID_HANDLE)
+    {
+        m_lastError = "Not connected to the booking server";
+        m_lastStatus = ProtocolStatus::SERVER_ERROR;
+        return false;
+    }
+
+    // Send a window of frames in one write, then collect their responses;
+    // bounded so neither side stalls on a full socket buffer
+    batch.m_responses.resize(batch.m_requests.size());
+    for (size_t first = 0; first < batch.m_requests.size(); first += PIPELINE_DEPTH)
+    {
+        size_t last = std::min(first + PIPELINE_DEPTH, batch.m_requests.size());
+        std::string frames;
+        for (size_t i = first; i < last; ++i)
+        {
+            frames += batch.m_requests[i].finish();
+        }
+        if (!sendFrame(frames))
+        {
+            batch.m_responses.clear();
+            return false;
+        }
+
+        for (size_t i = first; i < last; ++i)
+        {
+            if (!receiveResponse(batch.m_requests[i].finish(), batch.m_responses[i]))
+            {
+                batch.m_responses.clear();
+                return false;
+            }
+        }
+    }
+
+    m_lastStatus = ProtocolStatus::OK;
+    return true;
+}
+
+bool BookingClient::call(MessageWriter &request, MessageReader &body)
+{
+    if (m_socket == SocketUtils::INVALID_HANDLE)
+    {
+        m_lastError = "Not connected to the booking server";
+        m_lastStatus = ProtocolStatus::SERVER_ERROR;
+        return false;
+    }
+
+    const std::string &frame = request.finish();
+    if (!sendFrame(frame) || !receiveResponse(frame, m_response))
+        return false;
+
+    m_lastStatus = statusOf(m_response);
+    if (m_lastStatus != ProtocolStatus::OK)
+    {
+        m_lastError = BookingProtocol::getStatusString(m_lastStatus);
+        return false;
+    }
+
+    body = MessageReader(m_response.data() + RESPONSE_HEADER_SIZE, m_response.size() - RESPONSE_HEADER_SIZE);
+    return true;
+}
+
+bool BookingClient::sendFrame(const std::string &frame)
+{
+    if (!SocketUtils::sendAll(m_socket, frame.data(), frame.size()))
+    {
+        fail("Cannot send the request to the booking server");
+        return false;
+    }
+    return true;
+}
+
+bool BookingClient::receiveResponse(const std::string &requestFrame, std::string &payload)
+{
+    char header[BookingProtocol::HEADER_SIZE];
+    if (!SocketUtils::receiveAll(m_socket, header, sizeof(header)))
+    {
+        fail("No response from the booking server");
+        return false;
+    }
+
+    uint32_t length = BookingProtocol::readLength(header);
+    if (length < RESPONSE_HEADER_SIZE || length > BookingProtocol::MAX_PAYLOAD_SIZE)
+    {
+        fail("Malformed response from the booking server");
+        return false;
+    }
+
+    payload.resize(length);
+    if (!SocketUtils::receiveAll(m_socket, &payload[0], length))
+    {
+        fail("Connection to the booking server was lost");
+        return false;
+    }
+
+    // Responses come back in request order, so the echoed op and id must match
+    if (!matchesRequest(payload, requestFrame))
+    {
+        fail("Response does not match the request");
+        return false;
+    }
+    return true;
+}
+
+void BookingClient::fail(const std::string &error)
+{
+    // The stream position is unknown after a transport error, so the connection is dropped
+    m_lastError = error;
+    m_lastStatus = ProtocolStatus::SERVER_ERROR;
+    SocketUtils::close(m_socket);
+    m_socket = SocketUtils::INVALID_HANDLE;
+}
@@ -1,4 +1,9 @@
 #include "BookingController.h"
+#include "BookingClient.h"
+#include "BookingReplica.h"
+#include "DateTimeUtils.h"
+#include "PricingEngine.h"
+#include "SearchIndex.h"
 #include <algorithm>
 #include <iterator>
 #include <ctime>
@@ -7,10 +12,23 @@ BookingController::BookingController() : m_bookingManager(BookingManager::getIns
 
 BookingController::~BookingController() {}
 
+void BookingController::setRemote(BookingClient *client, const BookingReplica *replica)
+{
+    m_client = client;
+    m_replica = replica;
+}
+
+uint64_t BookingController::getRemoteSequence() const
+{
+    return m_replica ? m_replica->getSequence() : 0;
+}
+
 bool BookingController::createBooking(int userId, int courtId, std::time_t bookingDate,
                                       std::time_t startTime, std::time_t endTime,
                                       const std::string &notes)
 {
+    if (m_client)
+        return m_client->createBooking(userId, courtId, bookingDate, startTime, endTime, notes);
 
     double cost = calculateBookingCost(courtId, startTime, endTime);
     if (cost < 0)
@@ -23,14 +41,134 @@ bool BookingController::createBooking(int userId, int courtId, std::time_t booki
     return m_bookingManager.createBooking(booking);
 }
 
+std::vector<BatchResult> BookingController::createBookings(const std::vector<Booking> &bookings, bool allOrNothing)
+{
+    if (m_client)
+        return std::vector<BatchResult>(bookings.size()); // All NOT_COMMITTED; the protocol has no batch create
+
+    std::vector<Booking> priced(bookings);
+    for (Booking &booking : priced)
+    {
+        // An unknown court costs -1, which the manager rejects as INVALID for that entry
+        booking.setTotalAmount(calculateBookingCost(booking.getCourtId(), booking.getStartTime(), booking.getEndTime()));
+        booking.setStatus(BookingStatus::CONFIRMED);
+    }
+    return m_bookingManager.createBookings(priced, allOrNothing);
+}
+
+int BookingController::createRecurringBookings(const RecurringSeries &series, std::vector<BatchResult> &results,
+                                               bool allOrNothing)
+{
+    results.clear();
+    if (m_client)
+        return 0;
+
+    RecurringSeries priced(series);
+    priced.price = [this, &series](std::time_t startTime, std::time_t endTime)
+    { return calculateBookingCost(series.courtId, startTime, endTime); };
+    return m_bookingManager.createSeries(priced, results, allOrNothing);
+}
+
+bool BookingController::skipRecurringOccurrence(int seriesId, std::time_t date)
+{
+    return m_bookingManager.skipSeriesOccurrence(seriesId, date);
+}
+
+bool BookingController::endRecurringBookings(int seriesId)
+{
+    return m_bookingManager.endSeries(seriesId, std::time(nullptr));
+}
+
+int BookingController::holdSlot(int userId, int courtId, std::time_t startTime, std::time_t endTime)
+{
+    if (m_client)
+        return 0;
+
+    return m_bookingManager.placeHold(userId, courtId, startTime, endTime);
+}
+
+bool BookingController::releaseHold(int holdId)
+{
+    return m_bookingManager.releaseHold(holdId);
+}
+
+bool BookingController::bookHeldSlot(int holdId, int userId, int courtId, std::time_t bookingDate,
+                                     std::time_t startTime, std::time_t endTime, const std::string &notes)
+{
+    double cost = calculateBookingCost(courtId, startTime, endTime);
+    if (cost < 0)
+        return false;
+
+    Booking booking(userId, courtId, bookingDate, startTime, endTime, cost);
+    booking.setNotes(notes);
+    booking.setStatus(BookingStatus::CONFIRMED);
+
+    return m_bookingManager.bookHold(holdId, booking);
+}
+
+int BookingController::findUserHold(int userId, int courtId, std::time_t startTime, std::time_t endTime) const
+{
+    if (m_client)
+        return 0;
+
+    for (const SlotHold &hold : m_bookingManager.getUserHolds(userId))
+    {
+        if (hold.courtId == courtId && hold.startTime == startTime && hold.endTime == endTime)
+        {
+            return hold.id;
+        }
+    }
+    return 0;
+}
+
+int BookingController::joinWaitlist(int userId, int courtId, std::time_t startTime, std::time_t endTime,
+                                    const std::string &notes, bool autoBook)
+{
+    if (m_client)
+        return 0;
+
+    double cost = calculateBookingCost(courtId, startTime, endTime);
+    if (cost < 0)
+        return 0;
+
+    WaitlistEntry entry;
+    entry.userId = userId;
+    entry.courtId = courtId;
+    entry.startTime = startTime;
+    entry.endTime = endTime;
+    entry.amount = cost;
+    entry.notes = notes;
+    entry.autoBook = autoBook;
+    return m_bookingManager.joinWaitlist(entry);
+}
+
+bool BookingController::leaveWaitlist(int entryId)
+{
+    return m_bookingManager.leaveWaitlist(entryId);
+}
+
+std::vector<WaitlistEntry> BookingController::getUserWaitlist(int userId) const
+{
+    if (m_client)
+        return std::vector<WaitlistEntry>();
+
+    return m_bookingManager.getWaitlist(userId);
+}
+
 bool BookingController::cancelBooking(int bookingId)
 {
+    if (m_client)
+        return m_client->cancelBooking(bookingId);
+
     return m_bookingManager.cancelBooking(bookingId);
 }
 
 bool BookingController::modifyBooking(int bookingId, std::time_t newStartTime,
                                       std::time_t newEndTime, const std::string &notes)
 {
+    if (m_client)
+        return m_client->modifyBooking(bookingId, newStartTime, newEndTime, notes);
+
     auto booking = m_bookingManager.getBooking(bookingId);
     if (!booking)
         return false;
@@ -54,47 +192,120 @@ bool BookingController::modifyBooking(int bookingId, std::time_t newStartTime,
     return m_bookingManager.modifyBooking(bookingId, modifiedBooking);
 }
 
-Booking* BookingController::getBooking(int bookingId) const
+BookingPtr BookingController::getBooking(int bookingId) const
 {
+    if (m_replica)
+        return m_replica->getBooking(bookingId);
+
     return m_bookingManager.getBooking(bookingId);
 }
 
-std::vector<Booking*> BookingController::getAllBookings() const
+std::vector<BookingPtr> BookingController::getAllBookings() const
 {
+    if (m_replica)
+        return m_replica->getBookings();
+
     return m_bookingManager.getAllBookings();
 }
 
-std::vector<Booking*> BookingController::getUserBookings(int userId) const
+std::vector<BookingPtr> BookingController::getUserBookings(int userId) const
 {
+    if (m_replica)
+        return m_replica->getUserBookings(userId);
+
     return m_bookingManager.getBookingsByUser(userId);
 }
 
-std::vector<Booking*> BookingController::getCourtBookings(int courtId) const
+std::vector<BookingPtr> BookingController::getCourtBookings(int courtId) const
 {
+    if (m_replica)
+        return m_replica->getCourtBookings(courtId);
+
     return m_bookingManager.getBookingsByCourt(courtId);
 }
 
-std::vector<Booking*> BookingController::getBookingsByDate(std::time_t date) const
+std::vector<BookingPtr> BookingController::getBookingsByDate(std::time_t date) const
 {
     return m_bookingManager.getBookingsByDate(date);
 }
 
-std::vector<Booking*> BookingController::getUpcomingBookings(int userId) const
+std::vector<int> BookingController::findBookings(const BookingQuery &query) const
+{
+    if (m_client)
+    {
+        std::vector<Booking> bookings;
+        std::vector<int> ids;
+        if (m_client->findBookings(query, bookings))
+        {
+            for (const Booking &booking : bookings)
+            {
+                ids.push_back(booking.getId());
+            }
+        }
+        return ids;
+    }
+
+    return m_bookingManager.findBookingIds(query);
+}
+
+BookingManager::ReadView BookingController::openReadView() const
+{
+    return m_bookingManager.openReadView();
+}
+
+std::vector<int> BookingController::searchBookings(const std::string &text, const std::vector<int> &userIds) const
+{
+    if (m_replica)
+    {
+        // The replica keeps no note index; build one from its copy, same matching rules
+        std::vector<BookingPtr> bookings = m_replica->getBookings();
+        SearchIndex noteSearch;
+        for (const BookingPtr &booking : bookings)
+        {
+            noteSearch.addDocument(booking->getId(), {booking->getNotes()});
+        }
+
+        std::vector<int> users(userIds);
+        std::sort(users.begin(), users.end());
+        std::vector<int> result = noteSearch.searchIds(text);
+        for (const BookingPtr &booking : bookings)
+        {
+            if (std::binary_search(users.begin(), users.end(), booking->getUserId()))
+            {
+                result.push_back(booking->getId());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    std::vector<int> byNotes = m_bookingManager.searchBookingNotes(text);
+    std::vector<int> byUsers = m_bookingManager.getBookingIdsForUsers(userIds);
+
+    std::vector<int> result;
+    result.reserve(byNotes.size() + byUsers.size());
+    std::set_union(byNotes.begin(), byNotes.end(), byUsers.begin(), byUsers.end(),
+                   std::back_inserter(result));
+    return result;
+}
+
+std::vector<BookingPtr> BookingController::getUpcomingBookings(int userId) const
 {
     auto userBookings = getUserBookings(userId);
-    std::vector<Booking*> upcomingBookings;
+    std::vector<BookingPtr> upcomingBookings;
 
     std::time_t now = std::time(nullptr);
 
     std::copy_if(userBookings.begin(), userBookings.end(), std::back_inserter(upcomingBookings),
-                 [now](const Booking* booking)
+                 [now](const BookingPtr &booking)
                  {
                      return booking->getStartTime() > now && booking->isActive();
                  });
 
     // Sort by start time
     std::sort(upcomingBookings.begin(), upcomingBookings.end(),
-              [](const Booking* a, const Booking* b)
+              [](const BookingPtr &a, const BookingPtr &b)
               {
                   return a->getStartTime() < b->getStartTime();
               });
@@ -104,9 +315,39 @@ std::vector<Booking*> BookingController::getUpcomingBookings(int userId) const
 
 bool BookingController::isSlotAvailable(int courtId, std::time_t startTime, std::time_t endTime) const
 {
+    if (m_replica)
+    {
+        for (const BookingPtr &booking : m_replica->getCourtBookings(courtId))
+        {
+            if (booking->isActive() && booking->getStartTime() < endTime && startTime < booking->getEndTime())
+                return false;
+        }
+        return true;
+    }
+
     return m_bookingManager.isCourtAvailable(courtId, startTime, endTime);
 }
 
+OccupancyMap::DayBits BookingController::getCourtOccupancy(int courtId, std::time_t date) const
+{
+    if (m_client)
+    {
+        OccupancyMap::DayBits bits;
+        m_client->getCourtOccupancy(courtId, date, bits);
+        return bits;
+    }
+
+    return m_bookingManager.getCourtOccupancy(courtId, date);
+}
+
+std::vector<SlotOption> BookingController::findEarliestSlots(const SlotSearch &search) const
+{
+    if (m_client)
+        return std::vector<SlotOption>();
+
+    return m_bookingManager.findEarliestSlots(search);
+}
+
 bool BookingController::validateBookingTime(std::time_t startTime, std::time_t endTime) const
 {
     if (startTime >= endTime)
@@ -133,32 +374,27 @@ bool BookingController::validateBookingDate(std::time_t bookingDate) const
 
 double BookingController::calculateBookingCost(int courtId, std::time_t startTime, std::time_t endTime) const
 {
-    // This would typically get the court's hourly rate from CourtController
-    // For now, using a fixed rate in VND
-    double hourlyRate = 50000.0; // Default rate in VND
-
-    double hours = static_cast<double>(endTime - startTime) / 3600.0;
-    return hours * hourlyRate;
+    // Court rate with the peak/off-peak and weekend rules applied
+    double cost;
+    if (m_client && m_client->calculateBookingCost(courtId, startTime, endTime, cost))
+        return cost;
+
+    // The engine would price any id from its default table, so check the court first
+    PricingEngine &pricing = PricingEngine::getInstance();
+    if (!pricing.hasCourt(courtId))
+        return -1.0;
+    return pricing.getCost(courtId, startTime, endTime);
 }
 
 bool BookingController::confirmBooking(int bookingId)
 {
-    auto booking = getBooking(bookingId);
-    if (booking && booking->getStatus() == BookingStatus::PENDING)
-    {
-        booking->setStatus(BookingStatus::CONFIRMED);
-        return true;
-    }
-    return false;
+    return m_bookingManager.confirmBooking(bookingId);
 }
 
 bool BookingController::isWithinBusinessHours(std::time_t time) const
 {
-    struct tm *timeInfo = std::localtime(&time);
-    int hour = timeInfo->tm_hour;
-
     // Business hours: 6 AM to 11 PM
-    return hour >= 6 && hour < 23;
+    return DateTimeUtils::isWithinBusinessHours(time, 6, 23);
 }
 
 bool BookingController::isValidBookingDuration(std::time_t startTime, std::time_t endTime) const
@@ -171,20 +407,10 @@ bool BookingController::isValidBookingDuration(std::time_t startTime, std::time_
 
 std::time_t BookingController::getBusinessHoursStart() const
 {
-    std::time_t now = std::time(nullptr);
-    struct tm *timeInfo = std::localtime(&now);
-    timeInfo->tm_hour = 6;
-    timeInfo->tm_min = 0;
-    timeInfo->tm_sec = 0;
-    return std::mktime(timeInfo);
+    return DateTimeUtils::getTimeOnDay(std::time(nullptr), 6);
 }
 
 std::time_t BookingController::getBusinessHoursEnd() const
 {
-    std::time_t now = std::time(nullptr);
-    struct tm *timeInfo = std::localtime(&now);
-    timeInfo->tm_hour = 23;
-    timeInfo->tm_min = 0;
-    timeInfo->tm_sec = 0;
-    return std::mktime(timeInfo);
+    return DateTimeUtils::getTimeOnDay(std::time(nullptr), 23);
 }
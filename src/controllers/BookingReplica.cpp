@@ -0,0 +1,412 @@
+#include "BookingReplica.h"
+#include "SocketUtils.h"
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+    // Short receive timeout so the thread notices stop() while the feed is idle
+    const int RECEIVE_TIMEOUT_SECONDS = 1;
+    const size_t READ_CHUNK_SIZE = 16 * 1024;
+
+    bool byStartTime(const BookingPtr &a, const BookingPtr &b)
+    {
+        return a->getStartTime() < b->getStartTime();
+    }
+}
+
+BookingReplica::BookingReplica()
+    : m_stopping(false), m_synced(false), m_epoch(0), m_sequence(0)
+{
+}
+
+BookingReplica::~BookingReplica()
+{
+    stop();
+}
+
+void BookingReplica::start(const std::string &address)
+{
+    stop();
+    m_address = address;
+    m_stopping = false;
+    m_thread = std::thread(&BookingReplica::run, this);
+}
+
+void BookingReplica::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_stateMutex);
+        m_stopping = true;
+    }
+    m_stateChanged.notify_all();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+    m_synced = false;
+}
+
+bool BookingReplica::waitUntilSynced(int timeoutMs) const
+{
+    std::unique_lock<std::mutex> lock(m_stateMutex);
+    return m_stateChanged.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this]
+                                   { return m_synced.load(); });
+}
+
+uint64_t BookingReplica::getSequence() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    return m_sequence;
+}
+
+std::string BookingReplica::getLastError() const
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    return m_lastError;
+}
+
+void BookingReplica::setChangeListener(std::function<void(uint64_t)> listener)
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_listener = std::move(listener);
+}
+
+BookingPtr BookingReplica::getBooking(int bookingId) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    auto it = m_bookings.find(bookingId);
+    return it != m_bookings.end() ? it->second : BookingPtr();
+}
+
+std::vector<BookingPtr> BookingReplica::getBookings() const
+{
+    std::vector<BookingPtr> bookings;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_dataLock);
+        bookings.reserve(m_bookings.size());
+        for (const auto &entry : m_bookings)
+        {
+            bookings.push_back(entry.second);
+        }
+    }
+    std::sort(bookings.begin(), bookings.end(), byStartTime);
+    return bookings;
+}
+
+std::vector<BookingPtr> BookingReplica::getCourtBookings(int courtId) const
+{
+    std::vector<BookingPtr> bookings;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_dataLock);
+        for (const auto &entry : m_bookings)
+        {
+            if (entry.second->getCourtId() == courtId)
+            {
+                bookings.push_back(entry.second);
+            }
+        }
+    }
+    std::sort(bookings.begin(), bookings.end(), byStartTime);
+    return bookings;
+}
+
+std::vector<BookingPtr> BookingReplica::getUserBookings(int userId) const
+{
+    std::vector<BookingPtr> bookings;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_dataLock);
+        for (const auto &entry : m_bookings)
+        {
+            if (entry.second->getUserId() == userId)
+            {
+                bookings.push_back(entry.second);
+            }
+        }
+    }
+    std::sort(bookings.begin(), bookings.end(), byStartTime);
+    return bookings;
+}
+
+std::vector<Court> BookingReplica::getCourts() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    std::vector<Court> courts;
+    for (const auto &entry : m_courts)
+    {
+        courts.push_back(entry.second);
+    }
+    return courts;
+}
+
+bool BookingReplica::getUser(int userId, User &user) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    auto it = m_users.find(userId);
+    if (it == m_users.end())
+        return false;
+
+    user = it->second;
+    return true;
+}
+
+std::vector<User> BookingReplica::getUsers() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    std::vector<User> users;
+    for (const auto &entry : m_users)
+    {
+        users.push_back(entry.second);
+    }
+    return users;
+}
+
+void BookingReplica::run()
+{
+    while (!m_stopping.load())
+    {
+        std::string error;
+        intptr_t socket = SocketUtils::connectTo(m_address, RECEIVE_TIMEOUT_SECONDS, error);
+        if (socket != SocketUtils::INVALID_HANDLE)
+        {
+            follow(socket);
+            SocketUtils::close(socket);
+        }
+        else
+        {
+            setError(error);
+        }
+        m_synced = false;
+
+        // The local copy stays readable while disconnected, just not current
+        // (+ passes RECONNECT_DELAY_MS by value, so it needs no definition)
+        std::unique_lock<std::mutex> lock(m_stateMutex);
+        m_stateChanged.wait_for(lock, std::chrono::milliseconds(+RECONNECT_DELAY_MS), [this]
+                                { return m_stopping.load(); });
+    }
+}
+
+bool BookingReplica::follow(intptr_t socket)
+{
+    MessageWriter request;
+    request.writeU8(static_cast<uint8_t>(ProtocolOp::SUBSCRIBE));
+    request.writeU32(1);
+    {
+        std::shared_lock<std::shared_mutex> lock(m_dataLock);
+        request.writeI64(static_cast<int64_t>(m_epoch));
+        request.writeI64(static_cast<int64_t>(m_sequence));
+    }
+    const std::string &frame = request.finish();
+    if (!SocketUtils::sendAll(socket, frame.data(), frame.size()))
+    {
+        setError("Cannot subscribe to the booking server");
+        return false;
+    }
+
+    std::string buffer;
+    char chunk[READ_CHUNK_SIZE];
+    bool subscribed = false;
+    bool receivingSnapshot = false;
+    PendingSnapshot snapshot;
+    while (!m_stopping.load())
+    {
+        bool applied = false;
+        size_t offset = 0;
+        while (buffer.size() - offset >= BookingProtocol::HEADER_SIZE)
+        {
+            uint32_t length = BookingProtocol::readLength(buffer.data() + offset);
+            if (length > BookingProtocol::MAX_PAYLOAD_SIZE)
+            {
+                setError("Malformed frame from the booking server");
+                return false;
+            }
+            if (buffer.size() - offset - BookingProtocol::HEADER_SIZE < length)
+                break;
+
+            MessageReader reader(buffer.data() + offset + BookingProtocol::HEADER_SIZE, length);
+            offset += BookingProtocol::HEADER_SIZE + length;
+            ProtocolOp op = static_cast<ProtocolOp>(reader.readU8());
+            reader.readU32(); // Request id
+            ProtocolStatus status = static_cast<ProtocolStatus>(reader.readU8());
+
+            if (!subscribed)
+            {
+                if (op != ProtocolOp::SUBSCRIBE || status != ProtocolStatus::OK)
+                {
+                    setError("Booking server refused the subscription");
+                    return false;
+                }
+
+                snapshot.epoch = static_cast<uint64_t>(reader.readI64());
+                snapshot.sequence = static_cast<uint64_t>(reader.readI64());
+                receivingSnapshot = reader.readU8() != 0;
+                if (receivingSnapshot)
+                {
+                    snapshot.courtsLeft = reader.readU32();
+                    snapshot.usersLeft = reader.readU32();
+                    snapshot.bookingsLeft = reader.readU32();
+                }
+                if (!reader.ok())
+                {
+                    setError("Malformed subscription from the booking server");
+                    return false;
+                }
+                subscribed = true;
+            }
+            else if (receivingSnapshot)
+            {
+                if (op != ProtocolOp::SNAPSHOT_CHUNK || status != ProtocolStatus::OK ||
+                    !readSnapshotChunk(reader, snapshot))
+                {
+                    setError("Malformed snapshot from the booking server");
+                    return false;
+                }
+            }
+            else if (op == ProtocolOp::CHANGE_EVENT)
+            {
+                ChangeRecord change;
+                if (!reader.readChange(change))
+                {
+                    setError("Malformed change from the booking server");
+                    return false;
+                }
+
+                // Changes arrive in order; a gap means resubscribing is the safe way back
+                uint64_t expected = getSequence() + 1;
+                if (change.sequence > expected)
+                {
+                    setError("Change feed skipped a sequence");
+                    return false;
+                }
+                if (change.sequence == expected)
+                {
+                    applyChange(change);
+                    applied = true;
+                }
+            }
+
+            // Synced once resumed, or once the whole snapshot has arrived
+            if (subscribed && !m_synced.load() && (!receivingSnapshot || snapshot.complete()))
+            {
+                if (receivingSnapshot)
+                {
+                    applySnapshot(snapshot);
+                    receivingSnapshot = false;
+                }
+                applied = true;
+                {
+                    std::lock_guard<std::mutex> lock(m_stateMutex);
+                    m_synced = true;
+                }
+                m_stateChanged.notify_all();
+            }
+        }
+        buffer.erase(0, offset);
+
+        if (applied)
+        {
+            std::function<void(uint64_t)> listener;
+            {
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                listener = m_listener;
+            }
+            if (listener)
+            {
+                listener(getSequence());
+            }
+        }
+
+        long received = SocketUtils::receiveSome(socket, chunk, sizeof(chunk));
+        if (received < 0)
+        {
+            setError("Connection to the booking server was lost");
+            return false;
+        }
+        buffer.append(chunk, static_cast<size_t>(received));
+    }
+    return true;
+}
+
+bool BookingReplica::readSnapshotChunk(MessageReader &reader, PendingSnapshot &snapshot)
+{
+    // A chunk may not carry more than the totals announced
+    uint32_t count = reader.readU32();
+    if (count > snapshot.courtsLeft)
+        return false;
+    snapshot.courtsLeft -= count;
+    for (uint32_t i = 0; i < count && reader.ok(); ++i)
+    {
+        Court court;
+        if (reader.readCourt(court))
+        {
+            snapshot.courts[court.getId()] = court;
+        }
+    }
+
+    count = reader.readU32();
+    if (!reader.ok() || count > snapshot.usersLeft)
+        return false;
+    snapshot.usersLeft -= count;
+    for (uint32_t i = 0; i < count && reader.ok(); ++i)
+    {
+        User user;
+        if (reader.readUser(user))
+        {
+            snapshot.users[user.getId()] = user;
+        }
+    }
+
+    count = reader.readU32();
+    if (!reader.ok() || count > snapshot.bookingsLeft)
+        return false;
+    snapshot.bookingsLeft -= count;
+    for (uint32_t i = 0; i < count && reader.ok(); ++i)
+    {
+        auto booking = std::make_shared<Booking>();
+        if (reader.readBooking(*booking))
+        {
+            snapshot.bookings[booking->getId()] = booking;
+        }
+    }
+    return reader.ok() && reader.atEnd();
+}
+
+void BookingReplica::applySnapshot(PendingSnapshot &snapshot)
+{
+    std::unique_lock<std::shared_mutex> lock(m_dataLock);
+    m_courts.swap(snapshot.courts);
+    m_users.swap(snapshot.users);
+    m_bookings.swap(snapshot.bookings);
+    m_epoch = snapshot.epoch;
+    m_sequence = snapshot.sequence;
+}
+
+void BookingReplica::applyChange(const ChangeRecord &change)
+{
+    std::unique_lock<std::shared_mutex> lock(m_dataLock);
+    switch (change.type)
+    {
+    case ChangeType::COURT_CHANGED:
+        m_courts[change.court->getId()] = *change.court;
+        break;
+    case ChangeType::COURT_REMOVED:
+        m_courts.erase(change.removedId);
+        break;
+    case ChangeType::USER_CHANGED:
+        m_users[change.user->getId()] = *change.user;
+        break;
+    case ChangeType::USER_REMOVED:
+        m_users.erase(change.removedId);
+        break;
+    default:
+        m_bookings[change.booking->getId()] = change.booking;
+        break;
+    }
+    m_sequence = change.sequence;
+}
+
+void BookingReplica::setError(const std::string &error)
+{
+    std::lock_guard<std::mutex> lock(m_stateMutex);
+    m_lastError = error;
+}
@@ -1,4 +1,6 @@
 #include "CourtController.h"
+#include "ChangeFeed.h"
+#include "PricingEngine.h"
 #include <algorithm>
 #include <fstream>
 #include <sstream>
@@ -38,7 +40,10 @@ bool CourtController::addCourt(const std::string &name, const std::string &descr
     newCourt->setId(generateCourtId());
 
     m_courts.push_back(newCourt);
+    PricingEngine::getInstance().setCourtRate(newCourt->getId(), hourlyRate);
     saveCourts(); // Save changes immediately
+    if (m_changeFeed)
+        m_changeFeed->publishCourt(*newCourt);
     return true;
 }
 
@@ -63,8 +68,11 @@ bool CourtController::updateCourt(int courtId, const Court &updatedCourt)
     court->setDescription(updatedCourt.getDescription());
     court->setHourlyRate(updatedCourt.getHourlyRate());
     court->setStatus(updatedCourt.getStatus());
+    PricingEngine::getInstance().setCourtRate(courtId, court->getHourlyRate());
 
     saveCourts(); // Save changes immediately
+    if (m_changeFeed)
+        m_changeFeed->publishCourt(*court);
     return true;
 }
 
@@ -78,9 +86,12 @@ bool CourtController::deleteCourt(int courtId)
 
     if (it != m_courts.end())
     {
+        PricingEngine::getInstance().removeCourt(courtId);
         delete *it; // Clean up memory
         m_courts.erase(it);
         saveCourts(); // Save changes immediately
+        if (m_changeFeed)
+            m_changeFeed->publishCourtRemoved(courtId);
         return true;
     }
 
@@ -123,11 +134,42 @@ bool CourtController::setCourtStatus(int courtId, CourtStatus status)
     {
         court->setStatus(status);
         saveCourts(); // Save changes immediately
+        if (m_changeFeed)
+            m_changeFeed->publishCourt(*court);
         return true;
     }
     return false;
 }
 
+void CourtController::setChangeFeed(ChangeFeed *feed)
+{
+    m_changeFeed = feed;
+    if (m_changeFeed)
+    {
+        for (const Court *court : m_courts)
+        {
+            m_changeFeed->publishCourt(*court);
+        }
+    }
+}
+
+void CourtController::mirrorCourts(const std::vector<Court> &courts)
+{
+    for (auto court : m_courts)
+    {
+        PricingEngine::getInstance().removeCourt(court->getId());
+        delete court;
+    }
+    m_courts.clear();
+
+    for (const Court &court : courts)
+    {
+        m_courts.push_back(new Court(court));
+        PricingEngine::getInstance().setCourtRate(court.getId(), court.getHourlyRate());
+    }
+    m_mirrored = true;
+}
+
 int CourtController::getAvailableCourtCount() const
 {
     return static_cast<int>(getAvailableCourts().size());
@@ -191,6 +233,7 @@ void CourtController::loadCourts()
                     court->setStatus(status);
 
                     m_courts.push_back(court);
+                    PricingEngine::getInstance().setCourtRate(court->getId(), court->getHourlyRate());
                 }
                 catch (const std::exception &e)
                 {
@@ -205,6 +248,9 @@ void CourtController::loadCourts()
 
 void CourtController::saveCourts()
 {
+    if (m_mirrored)
+        return;
+
     // Create data directory if it doesn't exist
     std::filesystem::create_directories("data");
 
@@ -1,6 +1,7 @@
 #include "StatisticsController.h"
 #include "BookingManager.h"
 #include "Booking.h"
+#include "DateTimeUtils.h"
 #include <iostream>
 #include <map>
 #include <ctime>
@@ -66,16 +67,16 @@ void StatisticsController::collectDataFromBookingManager()
 {
     // Get all bookings from BookingManager
     BookingManager &bookingManager = BookingManager::getInstance();
-    auto allBookings = bookingManager.getAllBookings();
+    auto snapshot = bookingManager.getSnapshot(); // One consistent version, read without blocking bookings
 
     // Clear existing statistics
     delete m_statistics;
     m_statistics = new Statistics();
 
     // Group bookings by date and court for statistics
-    std::map<std::time_t, std::map<int, std::vector<Booking*>>> dailyCourtBookings;
+    std::map<std::time_t, std::map<int, std::vector<const Booking*>>> dailyCourtBookings;
 
-    for (const auto &booking : allBookings)
+    for (const auto &booking : snapshot->getBookings())
     {
         if (!booking)
             continue;
@@ -87,14 +88,24 @@ void StatisticsController::collectDataFromBookingManager()
         }
 
         // Get date (midnight of booking date)
-        std::time_t bookingDate = booking->getBookingDate();
-        std::tm *tm = std::localtime(&bookingDate);
-        tm->tm_hour = 0;
-        tm->tm_min = 0;
-        tm->tm_sec = 0;
-        std::time_t dateKey = std::mktime(tm);
-
-        dailyCourtBookings[dateKey][booking->getCourtId()].push_back(booking);
+        std::time_t dateKey = DateTimeUtils::getStartOfDay(booking->getBookingDate());
+
+        dailyCourtBookings[dateKey][booking->getCourtId()].push_back(booking.get());
+    }
+
+    // Standing series count once per occurrence; the expansions live only for this pass
+    std::vector<Booking> occurrences;
+    for (const SeriesPtr &series : snapshot->getSeries())
+    {
+        for (const auto &occurrence : series->getAllOccurrences())
+        {
+            occurrences.push_back(series->toBooking(occurrence.first, occurrence.second));
+        }
+    }
+    for (const Booking &occurrence : occurrences)
+    {
+        std::time_t dateKey = DateTimeUtils::getStartOfDay(occurrence.getBookingDate());
+        dailyCourtBookings[dateKey][occurrence.getCourtId()].push_back(&occurrence);
     }
 
     // Calculate daily statistics
@@ -4,11 +4,40 @@
 #include <wx/datectrl.h>
 #include <wx/dateevt.h>
 #include <wx/choice.h>
+#include <wx/timer.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 // Forward declarations
 class BookingController;
 class CourtController;
 class AuthController;
 class Booking;
+class AdminPanel;
+
+// Virtual list that renders only the visible rows from a list of booking ids
+class BookingHistoryList : public wxListCtrl
+{
+public:
+    BookingHistoryList(AdminPanel *owner, wxWindowID id, const wxSize &size);
+
+    void SetRows(std::vector<int> bookingIds);
+    const std::vector<int> &GetRows() const { return m_rowIds; }
+    int GetBookingIdAt(long row) const;
+
+protected:
+    wxString OnGetItemText(long item, long column) const override;
+    wxItemAttr *OnGetItemAttr(long item) const override;
+
+private:
+    AdminPanel *m_owner;
+    std::vector<int> m_rowIds;
+
+    // Row colours by booking status
+    mutable wxItemAttr m_cancelledAttr;
+    mutable wxItemAttr m_confirmedAttr;
+    mutable wxItemAttr m_pendingAttr;
+};
 
 class AdminPanel : public wxPanel
 {
@@ -21,6 +50,10 @@ public:
 
     void RefreshData();
 
+    // Cell text for the booking history list and CSV export
+    wxString GetBookingCellText(int bookingId, long column) const;
+    std::shared_ptr<const Booking> GetBookingById(int bookingId) const;
+
 private:
     // UI Creation
     void CreateUI();
@@ -36,13 +69,18 @@ private:
     void OnExportData(wxCommandEvent &event);
     void OnBookingSelected(wxListEvent &event);
     void OnCancelBooking(wxCommandEvent &event);
+    void OnFilterTimer(wxTimerEvent &event);
+    void OnSearchText(wxCommandEvent &event);
 
     // Data methods
     void RefreshBookingHistory();
     void RefreshStatistics();
     void ApplyFilters();
-    wxString GetUserNameById(int userId);
-    wxString FormatCurrency(double amount);
+    void ScheduleFilterUpdate();
+    void RebuildNameCaches();
+    int GetSelectedFilterId(wxChoice *choice) const;
+    void SelectFilterId(wxChoice *choice, int id);
+    wxString GetUserNameById(int userId) const;
 
     // Member variables
     BookingController* m_bookingController;
@@ -51,12 +89,13 @@ private:
 
     // UI Controls
     wxBoxSizer *m_mainSizer;
-    wxListCtrl *m_bookingHistoryList;
+    BookingHistoryList *m_bookingHistoryList;
     wxDatePickerCtrl *m_startDatePicker;
     wxDatePickerCtrl *m_endDatePicker;
     wxChoice *m_courtFilter;
     wxChoice *m_userFilter;
     wxChoice *m_statusFilter;
+    wxTextCtrl *m_searchCtrl;
 
     // Buttons
     wxButton *m_refreshBtn;
@@ -70,6 +109,11 @@ private:
 
     int m_selectedBookingId;
 
+    // Filter state: keystrokes and picker changes restart the debounce timer
+    wxTimer m_filterTimer;
+    std::unordered_map<int, wxString> m_courtNames;
+    std::unordered_map<int, wxString> m_userNames;
+
     // Event IDs
     enum
     {
@@ -84,7 +128,9 @@ private:
         ID_END_DATE_PICKER,
         ID_COURT_FILTER,
         ID_USER_FILTER,
-        ID_STATUS_FILTER
+        ID_STATUS_FILTER,
+        ID_FILTER_TIMER,
+        ID_SEARCH_TEXT
     };
 
     wxDECLARE_EVENT_TABLE();
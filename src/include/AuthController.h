@@ -1,13 +1,33 @@
 #pragma once
 #include "User.h"
+#include "SearchIndex.h"
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+class ChangeFeed;
+
 class AuthController
 {
 private:
     User* m_currentUser;
     std::vector<User*> m_users;
+    std::unordered_map<int, User*> m_usersById;
+    std::unordered_map<std::string, User*> m_usersByEmail; // Keyed by lower-cased email
+    int m_nextUserId;                                       // Persisted in data/users.seq
+    SearchIndex m_userSearch; // Full name, email, phone
+    ChangeFeed *m_changeFeed = nullptr;
+
+    // Copy of each user's contact details for notification worker threads
+    struct Contact
+    {
+        std::string fullName;
+        std::string email;
+        std::string phoneNumber;
+    };
+    mutable std::mutex m_contactsMutex;
+    std::unordered_map<int, Contact> m_contacts;
 
 public:
     AuthController();
@@ -29,6 +49,10 @@ public:
     std::vector<User*> getAllUsers() const;
     User* getUserById(int userId) const;
     User* getUserByEmail(const std::string &email) const;
+    std::vector<User*> searchUsers(const std::string &text, size_t limit = 0) const; // Best match first
+    std::vector<int> searchUserIds(const std::string &text) const;                   // Sorted ids
+    bool getUserContact(int userId, std::string &fullName, std::string &email,
+                        std::string &phoneNumber) const; // Safe from any thread
     bool updateUser(int userId, const User &updatedUser);
     bool deleteUser(int userId);
     bool changeUserRole(int userId, UserRole newRole);
@@ -36,6 +60,9 @@ public:
     bool changePassword(int userId, const std::string &oldPassword,
                         const std::string &newPassword);
 
+    // Publishes every user profile now and each change from then on
+    void setChangeFeed(ChangeFeed *feed);
+
     // Validation
     bool validateEmail(const std::string &email) const;
     bool validatePassword(const std::string &password) const;
@@ -48,4 +75,10 @@ public:
 private:
     // Helper methods
     int generateUserId();
+    void loadUserSequence();
+    void saveUserSequence() const;
+    void indexUser(const User *user);
+    void publishUser(const User *user);
+    void rebuildIndexes();
+    static std::string foldEmail(const std::string &email);
 };
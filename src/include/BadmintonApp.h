@@ -1,11 +1,15 @@
 #pragma once
 #include <wx/wx.h>
+#include <string>
 
 class AuthController;
 class CourtController;
 class BookingController;
 class EmailNotificationObserver;
 class InAppNotificationObserver;
+class NotificationOutbox;
+class BookingClient;
+class BookingReplica;
 
 class BadmintonApp : public wxApp
 {
@@ -15,6 +19,9 @@ private:
     BookingController *m_bookingController;
     EmailNotificationObserver *m_emailObserver;
     InAppNotificationObserver *m_inAppObserver;
+    NotificationOutbox *m_outbox;
+    BookingClient *m_bookingClient = nullptr;   // Set when running as a thin client (--connect)
+    BookingReplica *m_bookingReplica = nullptr;
 
 public:
     virtual bool OnInit();
@@ -28,6 +35,7 @@ public:
     AuthController *GetAuthController() { return m_authController; }
     CourtController *GetCourtController() { return m_courtController; }
     BookingController *GetBookingController() { return m_bookingController; }
+    InAppNotificationObserver *GetInAppObserver() { return m_inAppObserver; }
 
     // Application flow control
     void ShowLoginFrame();
@@ -38,4 +46,5 @@ private:
     void InitializeControllers();
     void SetupNotifications();
     void LoadInitialData();
+    bool ConnectToServer(const std::string &address);
 };
@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <ctime>
+#include <memory>
 
 enum class BookingStatus
 {
@@ -61,3 +62,7 @@ public:
     bool conflictsWith(const Booking &other) const;
     void updateTimestamp();
 };
+
+// Bookings published by BookingManager are never edited in place; a change
+// replaces the object, so holders of a BookingPtr keep a consistent copy
+typedef std::shared_ptr<const Booking> BookingPtr;
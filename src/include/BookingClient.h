@@ -0,0 +1,130 @@
+#pragma once
+#include "Booking.h"
+#include "BookingIndex.h"
+#include "BookingProtocol.h"
+#include "Court.h"
+#include "OccupancyMap.h"
+#include <cstdint>
+#include <ctime>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Requests gathered for one round-trip. Each add call returns the index to
+// read that request's result with once BookingClient has run the batch.
+// execute() sends them in one BATCH envelope that the server answers from a
+// single consistent version, so only queries are allowed there; pipeline()
+// sends them as separate frames back to back and also accepts updates.
+class BookingRequestBatch
+{
+public:
+    // Queries
+    size_t addPing();
+    size_t addGetBooking(int bookingId);
+    // One page of matches after the cursor; see hasMoreBookings
+    size_t addFindBookings(const BookingQuery &query, std::time_t afterStart = 0, int afterId = 0);
+    size_t addCourtOccupancy(int courtId, std::time_t date);
+    size_t addAvailableSlots(int courtId, std::time_t date, int slotDurationMinutes = 60);
+    size_t addGetCourts();
+    size_t addEstimateCost(int courtId, std::time_t startTime, std::time_t endTime);
+
+    // Updates (pipeline() only)
+    size_t addCreateBooking(int userId, int courtId, std::time_t bookingDate,
+                            std::time_t startTime, std::time_t endTime,
+                            const std::string &notes = "");
+    size_t addCancelBooking(int bookingId);
+    size_t addModifyBooking(int bookingId, std::time_t newStartTime,
+                            std::time_t newEndTime, const std::string &notes = "");
+
+    size_t size() const { return m_requests.size(); }
+    void clear();
+
+    // Results; false if the request failed (see getStatus) or was not run
+    uint64_t getVersion() const { return m_version; } // Bookings version an executed batch saw
+    ProtocolStatus getStatus(size_t index) const;
+    bool succeeded(size_t index) const { return getStatus(index) == ProtocolStatus::OK; }
+    bool getBooking(size_t index, Booking &booking) const;
+    bool getBookings(size_t index, std::vector<Booking> &bookings) const;
+    // True when a find page was cut short; ask again after its last booking
+    bool hasMoreBookings(size_t index) const;
+    bool getCourtOccupancy(size_t index, OccupancyMap::DayBits &bits) const;
+    bool getAvailableSlots(size_t index, std::vector<std::pair<std::time_t, std::time_t>> &slots) const;
+    bool getCourts(size_t index, std::vector<Court> &courts) const;
+    bool getCost(size_t index, double &cost) const;
+
+private:
+    friend class BookingClient;
+
+    MessageWriter &add(ProtocolOp op); // Request id is the index
+    bool openResult(size_t index, MessageReader &reader) const;
+
+    std::vector<MessageWriter> m_requests;
+    std::vector<std::string> m_responses; // Response payloads, filled when the batch runs
+    uint64_t m_version = 0;
+};
+
+// Blocking connection from a front desk to a BookingServer. Mirrors the
+// BookingController calls the panels make; every call is one round-trip
+// and returns false when the server refused it or the connection failed
+// (see getLastStatus() and getLastError()). Safe to share between threads;
+// calls are serialized on the connection.
+class BookingClient
+{
+public:
+    static const int DEFAULT_TIMEOUT_SECONDS = 10;
+    // Requests in flight at once when pipelining; stays below the server's per-connection limit
+    static const size_t PIPELINE_DEPTH = 64;
+
+    BookingClient();
+    ~BookingClient();
+
+    BookingClient(const BookingClient &) = delete;
+    BookingClient &operator=(const BookingClient &) = delete;
+
+    bool connect(const std::string &address, int timeoutSeconds = DEFAULT_TIMEOUT_SECONDS);
+    void close();
+    bool isConnected() const;
+
+    std::string getLastError() const;
+    ProtocolStatus getLastStatus() const;
+
+    bool ping();
+
+    // Booking operations
+    bool createBooking(int userId, int courtId, std::time_t bookingDate,
+                       std::time_t startTime, std::time_t endTime,
+                       const std::string &notes = "");
+    bool cancelBooking(int bookingId);
+    bool modifyBooking(int bookingId, std::time_t newStartTime,
+                       std::time_t newEndTime, const std::string &notes = "");
+
+    // Queries
+    bool getBooking(int bookingId, Booking &booking);
+    // Every match, fetched a page per round-trip; pages may see different versions
+    bool findBookings(const BookingQuery &query, std::vector<Booking> &bookings);
+    bool getCourtOccupancy(int courtId, std::time_t date, OccupancyMap::DayBits &bits);
+    bool getAvailableSlots(int courtId, std::time_t date, int slotDurationMinutes,
+                           std::vector<std::pair<std::time_t, std::time_t>> &slots);
+    bool getCourts(std::vector<Court> &courts);
+    bool calculateBookingCost(int courtId, std::time_t startTime, std::time_t endTime, double &cost);
+
+    // Several requests per round-trip. Both return false only when the
+    // exchange itself failed; individual results carry their own status.
+    bool execute(BookingRequestBatch &batch);  // One envelope, one consistent version
+    bool pipeline(BookingRequestBatch &batch); // Back-to-back frames, updates allowed
+
+private:
+    // Callers hold m_mutex
+    bool call(MessageWriter &request, MessageReader &body);
+    bool sendFrame(const std::string &frame);
+    bool receiveResponse(const std::string &requestFrame, std::string &payload);
+    void fail(const std::string &error);
+
+    mutable std::mutex m_mutex;
+    intptr_t m_socket;
+    uint32_t m_nextRequestId;
+    std::string m_response; // Payload of the last single-call response
+    std::string m_lastError;
+    ProtocolStatus m_lastStatus;
+};
@@ -3,15 +3,29 @@
 #include "BookingManager.h"
 #include <vector>
 
+class BookingClient;
+class BookingReplica;
+
 class BookingController
 {
 private:
     BookingManager &m_bookingManager;
+    BookingClient *m_client = nullptr;           // Set in thin-client mode
+    const BookingReplica *m_replica = nullptr;
 
 public:
     BookingController();
     ~BookingController();
 
+    // Thin-client mode: bookings live on a BookingServer. Booking, cancelling,
+    // modifying, pricing and occupancy go through the client; lists, lookups
+    // and searches read the replica. Holds, waitlists, batches, series and
+    // the earliest-slot search are not in the protocol: they fail here (0,
+    // empty or NOT_COMMITTED) and the panels check isRemote() to not offer them.
+    void setRemote(BookingClient *client, const BookingReplica *replica);
+    bool isRemote() const { return m_client != nullptr; }
+    uint64_t getRemoteSequence() const; // Last change the replica applied; 0 when local
+
     // Booking operations
     bool createBooking(int userId, int courtId, std::time_t bookingDate,
                        std::time_t startTime, std::time_t endTime,
@@ -19,41 +33,71 @@ public:
     bool cancelBooking(int bookingId);
     bool modifyBooking(int bookingId, std::time_t newStartTime,
                        std::time_t newEndTime, const std::string &notes = "");
+    // Priced and confirmed like createBooking, committed together; one result
+    // per booking, see BookingManager::createBookings
+    std::vector<BatchResult> createBookings(const std::vector<Booking> &bookings, bool allOrNothing = true);
+    // Stored as one series rule priced from its first occurrence; returns its id, or 0
+    int createRecurringBookings(const RecurringSeries &series, std::vector<BatchResult> &results,
+                                bool allOrNothing = true);
+    bool skipRecurringOccurrence(int seriesId, std::time_t date);
+    bool endRecurringBookings(int seriesId); // Keeps occurrences that already started
+
+    // Slot holds while a customer checks out; see BookingManager::placeHold
+    int holdSlot(int userId, int courtId, std::time_t startTime, std::time_t endTime);
+    bool releaseHold(int holdId);
+    // Books a held slot, priced and confirmed like createBooking
+    bool bookHeldSlot(int holdId, int userId, int courtId, std::time_t bookingDate,
+                      std::time_t startTime, std::time_t endTime, const std::string &notes = "");
+    // Held slot of the user's matching the times exactly (e.g. a waitlist offer), or 0
+    int findUserHold(int userId, int courtId, std::time_t startTime, std::time_t endTime) const;
+
+    // Waiting for a taken slot, priced now; see BookingManager::joinWaitlist. Returns the entry id, or 0
+    int joinWaitlist(int userId, int courtId, std::time_t startTime, std::time_t endTime,
+                     const std::string &notes = "", bool autoBook = true);
+    bool leaveWaitlist(int entryId);
+    std::vector<WaitlistEntry> getUserWaitlist(int userId) const;
 
     // Booking retrieval
-    Booking *getBooking(int bookingId) const;
-    std::vector<Booking *> getAllBookings() const;
-    std::vector<Booking *> getUserBookings(int userId) const;
-    std::vector<Booking *> getCourtBookings(int courtId) const;
-    std::vector<Booking *> getBookingsByDate(std::time_t date) const;
-    std::vector<Booking *> getBookingsInRange(std::time_t startDate, std::time_t endDate) const;
-    std::vector<Booking *> getUpcomingBookings(int userId) const;
-    std::vector<Booking *> getBookingHistory(int userId) const;
+    BookingPtr getBooking(int bookingId) const;
+    std::vector<BookingPtr> getAllBookings() const;
+    std::vector<BookingPtr> getUserBookings(int userId) const;
+    std::vector<BookingPtr> getCourtBookings(int courtId) const;
+    std::vector<BookingPtr> getBookingsByDate(std::time_t date) const;
+    std::vector<BookingPtr> getBookingsInRange(std::time_t startDate, std::time_t endDate) const;
+    std::vector<BookingPtr> getUpcomingBookings(int userId) const;
+    std::vector<BookingPtr> getBookingHistory(int userId) const;
+    std::vector<int> findBookings(const BookingQuery &query) const;
+    // Several queries against one consistent version; see BookingManager::ReadView
+    BookingManager::ReadView openReadView() const;
+    // Sorted ids of bookings whose notes match the text or that belong to one of the users
+    std::vector<int> searchBookings(const std::string &text, const std::vector<int> &userIds) const;
 
     // Availability checking
     bool isSlotAvailable(int courtId, std::time_t startTime, std::time_t endTime) const;
     std::vector<std::pair<std::time_t, std::time_t>> getAvailableSlots(
         int courtId, std::time_t date, int slotDurationMinutes = 60) const;
+    OccupancyMap::DayBits getCourtOccupancy(int courtId, std::time_t date) const;
+    std::vector<SlotOption> findEarliestSlots(const SlotSearch &search) const;
 
     // Booking validation
     bool validateBookingTime(std::time_t startTime, std::time_t endTime) const;
     bool validateBookingDate(std::time_t bookingDate) const;
-    double calculateBookingCost(int courtId, std::time_t startTime, std::time_t endTime) const;
+    double calculateBookingCost(int courtId, std::time_t startTime, std::time_t endTime) const; // -1 for an unknown court
 
     // Status management
     bool confirmBooking(int bookingId);
     bool completeBooking(int bookingId);
-    std::vector<Booking *> getPendingBookings() const;
-    std::vector<Booking *> getConfirmedBookings() const;
+    std::vector<BookingPtr> getPendingBookings() const;
+    std::vector<BookingPtr> getConfirmedBookings() const;
 
     // Reminder and notification support
-    std::vector<Booking *> getBookingsForReminder(int hoursAhead = 24) const;
+    std::vector<BookingPtr> getBookingsForReminder(int hoursAhead = 24) const;
     void sendBookingReminders();
 
     // Statistics support
     int getTotalBookingCount() const;
     double getTotalRevenue() const;
-    std::vector<Booking *> getMostRecentBookings(int limit = 10) const;
+    std::vector<BookingPtr> getMostRecentBookings(int limit = 10) const;
 
 private:
     // Helper methods
@@ -0,0 +1,21 @@
+#pragma once
+#include "Booking.h"
+#include <cstdint>
+
+enum class BookingEventType
+{
+    CREATED,
+    CANCELLED,
+    MODIFIED,
+    REMINDER,
+    WAITLIST_OFFER // A freed slot held for a waiting customer; the booking has no id yet
+};
+
+// Snapshot of a booking change, copied so observers never touch live bookings
+struct BookingEvent
+{
+    BookingEventType type = BookingEventType::CREATED;
+    Booking booking;         // State after the change
+    Booking previousBooking; // State before the change (MODIFIED only)
+    uint64_t sequence = 0;   // Assigned by the dispatcher, increasing per publish
+};
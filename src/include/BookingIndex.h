@@ -0,0 +1,61 @@
+#pragma once
+#include "Booking.h"
+#include <ctime>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Filter criteria for indexed booking lookups (0 means "any")
+struct BookingQuery
+{
+    int courtId = 0;
+    int userId = 0;
+    std::time_t fromTime = 0; // Inclusive lower bound on start time
+    std::time_t toTime = 0;   // Inclusive upper bound on start time
+    bool filterStatus = false;
+    BookingStatus status = BookingStatus::PENDING;
+    bool restrictToIds = false;
+    std::vector<int> bookingIds; // Sorted; only used when restrictToIds is set
+};
+
+// Secondary indexes over the bookings owned by BookingManager.
+// Court and user posting lists hold booking ids in ascending order so they
+// can be intersected directly; the time index is ordered by start time.
+class BookingIndex
+{
+private:
+    std::unordered_map<int, BookingPtr> m_byId;
+    std::unordered_map<int, std::vector<int>> m_byCourt;
+    std::unordered_map<int, std::vector<int>> m_byUser;
+    std::vector<std::pair<std::time_t, int>> m_byStartTime;
+
+public:
+    // Index maintenance
+    void clear();
+    void rebuild(const std::vector<BookingPtr> &bookings);
+    void add(const BookingPtr &booking);
+    void remove(const Booking &booking);
+    void replace(const BookingPtr &booking); // New version of an indexed booking, same court and user
+    void updateStartTime(int bookingId, std::time_t oldStart, std::time_t newStart);
+
+    // Lookups
+    const Booking *find(int bookingId) const;
+    BookingPtr findPtr(int bookingId) const; // Shares ownership, for callers outside the manager's lock
+    size_t size() const { return m_byId.size(); }
+    const std::vector<int> &getCourtPostings(int courtId) const;
+    const std::vector<int> &getUserPostings(int userId) const;
+    const std::vector<std::pair<std::time_t, int>> &getTimeIndex() const { return m_byStartTime; }
+
+    // Returns matching booking ids ordered by start time
+    std::vector<int> query(const BookingQuery &query) const;
+
+    // Sorted-list intersection, galloping through the longer list
+    static std::vector<int> intersect(const std::vector<int> &a, const std::vector<int> &b);
+
+private:
+    std::vector<std::pair<std::time_t, int>>::const_iterator timeLowerBound(std::time_t time) const;
+    std::vector<std::pair<std::time_t, int>>::const_iterator timeUpperBound(std::time_t time) const;
+    bool matches(const Booking &booking, const BookingQuery &query) const;
+    static void insertSorted(std::vector<int> &postings, int bookingId);
+    static void eraseSorted(std::vector<int> &postings, int bookingId);
+};
@@ -3,22 +3,192 @@
 #include "Court.h"
 #include "User.h"
 #include "NotificationObserver.h"
+#include "NotificationDispatcher.h"
+#include "ReminderScheduler.h"
+#include "BookingIndex.h"
+#include "SearchIndex.h"
+#include "OccupancyMap.h"
+#include "BookingSeries.h"
+#include "BookingSnapshot.h"
+#include "IntervalSet.h"
+#include "TimerWheel.h"
+#include "ChangeFeed.h"
+#include "Waitlist.h"
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
+#include <thread>
 
 // Forward declarations
 class Booking;
 class NotificationObserver;
 
-// Singleton pattern for managing all booking operations
+// Request for BookingManager::findEarliestSlots
+struct SlotSearch
+{
+    std::vector<int> courtIds;     // Courts to consider; earlier ones win ties
+    std::time_t earliestStart = 0; // No slot starts before this
+    int durationMinutes = 60;
+    int days = 7;        // Local days searched, starting with earliestStart's
+    int firstHour = 6;   // Daily window the whole slot must fit in
+    int lastHour = 23;
+    int stepMinutes = 15; // Slots start on multiples of this from midnight
+    int maxResults = 5;
+};
+
+struct SlotOption
+{
+    int courtId;
+    std::time_t startTime;
+    std::time_t endTime;
+};
+
+// A standing booking: same court and local time of day, every intervalDays days
+struct RecurringSeries
+{
+    int userId = 0;
+    int courtId = 0;
+    std::time_t firstStart = 0; // First occurrence; later ones keep its wall-clock time
+    std::time_t firstEnd = 0;
+    int occurrences = 1;
+    int intervalDays = 7;
+    double amount = 0.0; // Per occurrence, when price is unset
+    std::string notes;
+    // Prices each occurrence, since weekday rates and DST days can differ
+    std::function<double(std::time_t, std::time_t)> price;
+};
+
+enum class BatchStatus
+{
+    CREATED,
+    INVALID,      // Failed validation
+    CONFLICT,     // Overlaps an existing booking or an earlier entry of the batch
+    NOT_COMMITTED // Valid, but an all-or-nothing batch had a failing entry
+};
+
+// Outcome of one entry of BookingManager::createBookings
+struct BatchResult
+{
+    BatchStatus status = BatchStatus::NOT_COMMITTED;
+    int bookingId = 0;            // CREATED
+    int conflictingBookingId = 0; // CONFLICT with an existing booking
+    int conflictingSeriesId = 0;  // CONFLICT with an occurrence of a standing series
+    int conflictingHoldId = 0;    // CONFLICT with a slot hold
+    int conflictingIndex = -1;    // CONFLICT with another entry of the batch
+};
+
+// A short lease that keeps an interval free while a customer checks out
+struct SlotHold
+{
+    int id = 0;
+    int userId = 0;
+    int courtId = 0;
+    std::time_t startTime = 0;
+    std::time_t endTime = 0;
+    std::time_t expiresAt = 0;
+};
+
+// Singleton pattern for managing all booking operations.
+// Readers share m_dataLock and writers take it exclusively. Bookings are
+// immutable once added: a change swaps in a new object, so the BookingPtr
+// and snapshot results stay valid and unchanged after the lock is released.
+// Each write bumps the version; getSnapshot() copies the list at most once
+// per version. Saving and notifying happen after the writer lock is dropped.
+//
+// Conflicts only arise within a court, so a write first locks its court's
+// stripe, checks and updates that court's active intervals and standing
+// series there, and only then takes m_dataLock briefly to publish. Writes to courts on different
+// stripes overlap everywhere but the publish. Lock order: stripe, then
+// m_dataLock.
+//
+// Slot holds sit in their court's interval set under the negated hold id, so
+// every conflict and availability check already sees them. A timer wheel
+// ticked once a second by a background thread expires them. m_holdLock comes
+// after the stripe and m_dataLock is never taken while holding it.
+//
+// The waitlist has its own lock, taken on its own. Whatever frees time on a
+// court serves the waitlist after its locks are released, booking or holding
+// through the same paths as any other caller.
+//
+// A background sweeper moves bookings through their lifecycle by walking the
+// time index forward from two watermarks, so each sweep only reads rows that
+// became eligible since the last one. Writes behind a watermark pull it back.
 class BookingManager
 {
 private:
     static BookingManager *m_instance;
     static std::mutex m_mutex;
+    static bool m_remoteStore;
+
+    static const int COURT_STRIPES = 16;
+
+    struct CourtStripe
+    {
+        std::mutex lock;
+        std::unordered_map<int, IntervalSet> activeByCourt;             // PENDING and CONFIRMED bookings, holds
+        std::unordered_map<int, std::vector<SeriesPtr>> seriesByCourt; // Series with occurrences left
+    };
+
+    mutable CourtStripe m_stripes[COURT_STRIPES];
+    std::atomic<int> m_nextBookingId{1};
+    std::atomic<int> m_nextSeriesId{1};
+
+    mutable std::shared_mutex m_dataLock; // Guards the bookings, indexes and observer list
+    std::vector<BookingPtr> m_bookings;   // Ordered by start time
+    std::map<int, SeriesPtr> m_series;    // Standing bookings by id, ended ones included
+    uint64_t m_version = 0;
+    mutable std::mutex m_snapshotLock; // Readers building the cached snapshot
+    mutable std::shared_ptr<const BookingSnapshot> m_snapshot;
+
+    // Group commit: one writer saves the newest snapshot, the others wait for it
+    std::mutex m_saveLock;
+    std::condition_variable m_saveDone;
+    bool m_saving = false;
+    uint64_t m_savedVersion = 0;
+    // Sweep batches append their status changes here instead of saving a
+    // snapshot; the first snapshot that covers m_loggedVersion empties it
+    std::ofstream m_statusLog;
+    uint64_t m_loggedVersion = 0;
+
+    mutable std::mutex m_holdLock;
+    std::unordered_map<int, SlotHold> m_holds;
+    TimerWheel m_holdExpiry{std::time(nullptr)}; // One tick per second
+    int m_nextHoldId = 1;
+    std::thread m_holdThread; // Started by the first hold
+    std::atomic<bool> m_holdsRunning{false};
+    std::mutex m_holdWakeMutex;
+    std::condition_variable m_holdWake;
+
+    mutable std::mutex m_waitlistLock; // Never held together with another lock
+    Waitlist m_waitlist;
+    std::ofstream m_waitlistLog; // Append-only; compacted when loaded
+
+    // No CONFIRMED booking starting before m_completeMark still needs
+    // completing, and no PENDING one before m_expireMark expiring. Lowered
+    // under the exclusive m_dataLock; a sweep with nothing due advances them
+    // under the shared one, hence atomic.
+    std::atomic<std::time_t> m_completeMark{std::numeric_limits<std::time_t>::max()};
+    std::atomic<std::time_t> m_expireMark{std::numeric_limits<std::time_t>::max()};
+    std::thread m_sweepThread;
+    std::atomic<bool> m_sweepRunning{false};
+    std::mutex m_sweepWakeMutex;
+    std::condition_variable m_sweepWake;
 
-    std::vector<Booking *> m_bookings;
     std::vector<NotificationObserver *> m_observers;
+    ChangeFeed *m_changeFeed = nullptr; // Appended to under m_dataLock, so in version order
+    BookingIndex m_index;
+    SearchIndex m_noteSearch;
+    OccupancyMap m_occupancy;
+    NotificationDispatcher m_dispatcher;
+    ReminderScheduler m_reminders; // Publishes through m_dispatcher, so declared after it
 
     // Private constructor for Singleton
     BookingManager() = default;
@@ -30,6 +200,10 @@ public:
     // Singleton access
     static BookingManager &getInstance();
     static void cleanup(); // Method to clean up singleton instance
+    // For a thin client whose bookings live on a server; call before the
+    // first getInstance() so it neither loads the local files nor starts the
+    // sweeper and reminder threads
+    static void useRemoteStore();
 
     // Delete copy constructor and assignment operator
     BookingManager(const BookingManager &) = delete;
@@ -39,36 +213,185 @@ public:
     bool createBooking(const Booking &booking);
     bool cancelBooking(int bookingId);
     bool modifyBooking(int bookingId, const Booking &newBooking);
-    Booking *getBooking(int bookingId) const;
-    std::vector<Booking *> getBookingsByUser(int userId) const;
-    std::vector<Booking *> getBookingsByCourt(int courtId) const;
-    std::vector<Booking *> getBookingsByDate(std::time_t date) const;
-    std::vector<Booking *> getAllBookings() const;
+    bool confirmBooking(int bookingId); // PENDING -> CONFIRMED
+    // Checks every entry first, then commits the accepted ones as one version
+    // with a single save. With allOrNothing, one failing entry rejects all.
+    std::vector<BatchResult> createBookings(const std::vector<Booking> &bookings, bool allOrNothing = true);
+
+    // Slot holds. placeHold returns the hold id, or 0 if the interval is taken.
+    // bookHold turns a live hold into the given booking, which must be for
+    // the holder's user id and the held court and times, without another
+    // conflict check. Only the customer who holds a slot can book it.
+    static const int DEFAULT_HOLD_SECONDS = 120;
+    int placeHold(int userId, int courtId, std::time_t startTime, std::time_t endTime,
+                  int ttlSeconds = DEFAULT_HOLD_SECONDS);
+    bool extendHold(int holdId, int ttlSeconds = DEFAULT_HOLD_SECONDS);
+    bool releaseHold(int holdId);
+    bool bookHold(int holdId, const Booking &booking);
+    bool getHold(int holdId, SlotHold &hold) const;
+    size_t getHoldCount() const;
+    void expireHolds(std::time_t now); // The hold thread calls this every second
+    std::vector<SlotHold> getUserHolds(int userId) const;
+
+    // Waitlist. When a cancellation, a moved booking, a lapsed hold or a
+    // skipped occurrence frees time on a court, the earliest-joined request
+    // overlapping it that is now entirely free is booked, or held for
+    // WAITLIST_OFFER_SECONDS and offered without autoBook; then the next.
+    static const int WAITLIST_OFFER_SECONDS = 15 * 60; // The offer texts say 15 minutes
+    int joinWaitlist(const WaitlistEntry &entry);     // Returns its id, or 0; served at once if already free
+    bool leaveWaitlist(int entryId);
+    std::vector<WaitlistEntry> getWaitlist(int userId) const;
+    size_t getWaitlistSize() const;
+
+    // Lifecycle sweep. CONFIRMED bookings that have ended become COMPLETED;
+    // PENDING ones still unconfirmed PENDING_EXPIRY_LEAD_SECONDS before they
+    // start are cancelled, freeing the slot for the waitlist. Commits once
+    // per batch of up to SWEEP_BATCH_SIZE rows and appends the batch to the
+    // status log in one write; returns the rows changed. The sweeper thread calls this every SWEEP_INTERVAL_SECONDS.
+    static const int SWEEP_BATCH_SIZE = 256;
+    static const int SWEEP_INTERVAL_SECONDS = 60;
+    static const int PENDING_EXPIRY_LEAD_SECONDS = 60 * 60;
+    int sweepLifecycle(std::time_t now);
+
+    // Standing bookings, stored as one rule each. Every occurrence is checked
+    // on creation; results has one entry per occurrence. Without allOrNothing,
+    // conflicting occurrences are skipped. Returns the series id, or 0.
+    int createSeries(const RecurringSeries &series, std::vector<BatchResult> &results, bool allOrNothing = true);
+    bool skipSeriesOccurrence(int seriesId, std::time_t date); // Frees that day's occurrence
+    bool endSeries(int seriesId, std::time_t from);            // Drops occurrences starting at or after 'from'
+    SeriesPtr getSeries(int seriesId) const;
+    std::vector<SeriesPtr> getAllSeries() const;
+    // Occurrences starting in [from, to) as bookings, by start time
+    std::vector<Booking> getSeriesOccurrences(std::time_t from, std::time_t to) const;
+    // Also resolves occurrence ids; cancelling an occurrence skips its day,
+    // and occurrences cannot be modified one by one
+    BookingPtr getBooking(int bookingId) const;
+    // Per-user and per-court lists, and queries without a time range, include
+    // series occurrences that start within SERIES_LIST_DAYS of today, either way
+    static const int SERIES_LIST_DAYS = 90;
+    std::vector<BookingPtr> getBookingsByUser(int userId) const;
+    std::vector<BookingPtr> getBookingsByCourt(int courtId) const;
+    std::vector<BookingPtr> getBookingsByDate(std::time_t date) const;
+    std::vector<BookingPtr> getAllBookings() const;
+    std::vector<int> findBookingIds(const BookingQuery &query) const;
+
+    // Consistent view for reports and exports; never blocks writers once taken
+    std::shared_ptr<const BookingSnapshot> getSnapshot() const;
+    uint64_t getVersion() const;
+
+    // Indexed queries that all see one committed version. The view holds the
+    // reader lock until it is destroyed, so keep it short-lived and do not
+    // call other BookingManager methods while it is open.
+    class ReadView
+    {
+    public:
+        uint64_t getVersion() const { return m_manager.m_version; }
+        const std::vector<BookingPtr> &getBookings() const { return m_manager.m_bookings; } // By start time
+        BookingPtr getBooking(int bookingId) const;
+        std::vector<int> findBookingIds(const BookingQuery &query) const;
+        std::vector<BookingPtr> getSeriesBookings() const; // Every occurrence of every series
+        OccupancyMap::DayBits getCourtOccupancy(int courtId, std::time_t date) const;
+        std::vector<std::pair<std::time_t, std::time_t>> getAvailableSlots(
+            int courtId, std::time_t date, int slotDurationMinutes = 60) const;
+
+    private:
+        friend class BookingManager;
+        explicit ReadView(const BookingManager &manager);
+
+        const BookingManager &m_manager;
+        std::shared_lock<std::shared_mutex> m_lock;
+    };
+    ReadView openReadView() const;
+
+    // Text search (ids are returned sorted)
+    std::vector<int> searchBookingNotes(const std::string &text) const;
+    std::vector<int> getBookingIdsForUsers(const std::vector<int> &userIds) const;
 
     // Availability checking
     bool isCourtAvailable(int courtId, std::time_t startTime, std::time_t endTime) const;
     std::vector<std::pair<std::time_t, std::time_t>> getAvailableSlots(
         int courtId, std::time_t date, int slotDurationMinutes = 60) const;
     bool hasConflict(const Booking &booking) const;
+    OccupancyMap::DayBits getCourtOccupancy(int courtId, std::time_t date) const;
+    // Soonest free intervals across courts, at most one overlapping result per court
+    std::vector<SlotOption> findEarliestSlots(const SlotSearch &search) const;
+
+    // Records every committed booking change for the server's subscribers
+    void setChangeFeed(ChangeFeed *feed);
 
     // Observer pattern for notifications
     void addObserver(NotificationObserver *observer);
     void removeObserver(NotificationObserver *observer);
-    void notifyObservers(const std::string &message, const Booking &booking);
+    void notifyObservers(const BookingEvent &event); // Queued; observers run on their own threads
+    void shutdownNotifications();                   // Flushes queued events, call before deleting observers
+    uint64_t getDroppedNotificationCount() const;
+    size_t getPendingReminderCount() const;
 
     // Statistics support
-    std::vector<Booking *> getBookingsInDateRange(std::time_t startDate, std::time_t endDate) const;
+    std::vector<BookingPtr> getBookingsInDateRange(std::time_t startDate, std::time_t endDate) const;
     double getTotalRevenue(std::time_t startDate, std::time_t endDate) const;
     int getBookingCount(std::time_t startDate, std::time_t endDate) const;
 
     // Data management
     void loadBookings();
-    void saveBookings();
+    void saveBookings(); // Writes the latest snapshot unless a newer one is already saved
     void clearAllBookings();
 
 private:
     // Helper methods
     bool validateBooking(const Booking &booking) const;
+    CourtStripe &stripeFor(int courtId) const;
+    // Callers hold the court's stripe; id of an overlapping series, or 0
+    int findSeriesConflict(const CourtStripe &stripe, int courtId, std::time_t startTime, std::time_t endTime) const;
+    // Callers hold the series' stripe; swaps in the new rule in place of
+    // 'previous' (null for a new series), records the occurrences it adds or
+    // drops in the change feed, and returns the version to persist
+    uint64_t publishSeries(CourtStripe &stripe, const SeriesPtr &series, const SeriesPtr &previous);
+    // Appends occurrences of the matching series within SERIES_LIST_DAYS; 0 matches any user or court
+    static void appendSeriesBookings(const BookingSnapshot &snapshot, int userId, int courtId,
+                                     std::vector<BookingPtr> &bookings);
+    bool removeHold(int holdId, bool onlyIfExpired, std::time_t now);
+    void runHoldExpiry();
+    void serveWaitlist(int courtId, std::time_t startTime, std::time_t endTime); // Call without locks
+    // Callers hold m_waitlistLock. Loading replays and compacts the log,
+    // dropping requests that have started; each change then appends a line.
+    void loadWaitlist();
+    void logWaitlistEntry(const WaitlistEntry &entry);
+    void logWaitlistRemoval(int entryId);
+    static std::string encodeWaitlistEntry(const WaitlistEntry &entry);
+    // Caller holds m_dataLock, shared or exclusive. Finds up to SWEEP_BATCH_SIZE
+    // rows due for completing or expiring and the marks to advance to after them.
+    void planSweep(std::time_t now, std::vector<int> &toComplete, std::vector<int> &toExpire,
+                   std::time_t &completeMark, std::time_t &expireMark) const;
+    int sweepBatch(std::time_t now);
+    void runSweeper();
+    std::vector<SeriesPtr> readSeriesFile() const;
+    void writeSeriesFile(const BookingSnapshot &snapshot);
+    void persist(uint64_t version); // Returns once that version is on disk
+    // One line per row, "id|status", flushed once; loading replays the log
+    void logStatusChanges(uint64_t version, const std::vector<BookingPtr> &bookings);
+    void writeSnapshot(const BookingSnapshot &snapshot);
     void generateBookingId(Booking &booking);
+
+    // Callers hold m_dataLock exclusively
+    void insertBooking(const BookingPtr &booking);
+    void insertBookings(const std::vector<BookingPtr> &bookings); // Ordered by start time
+    void addToIndexes(const BookingPtr &booking);
+    void lowerSweepMarks(const Booking &booking);
+    void replaceBooking(const BookingPtr &booking);
+    uint64_t commit(); // Publishes a write: new version, cached snapshot dropped
+    void recordChange(ChangeType type, const BookingPtr &booking);
     void sortBookingsByDate();
+    void indexNotes(const Booking &booking);
+    void refreshOccupancy(int courtId, std::time_t startTime, std::time_t endTime);
+    // Callers hold m_dataLock. Occurrences are resolved from their series, and
+    // queries merge in the matching occurrences by start time.
+    BookingPtr findBooking(int bookingId) const;
+    std::vector<int> queryBookingIds(const BookingQuery &query) const;
+    // Callers hold m_dataLock. A series has one reminder at a time, for its
+    // next occurrence; each one fired schedules the one after it.
+    void scheduleSeriesReminder(const BookingSeries &series, std::time_t after);
+    void rebuildReminders();
+    void startReminders();
+    void startSweeper();
 };
@@ -5,11 +5,14 @@
 #include <wx/dateevt.h>
 #include <wx/timectrl.h>
 #include <wx/grid.h>
+#include <wx/timer.h>
+#include <cstdint>
 #include <ctime>
 
 class BookingController;
 class CourtController;
 class AuthController;
+class CourtTimeline;
 
 class BookingPanel : public wxPanel
 {
@@ -27,8 +30,10 @@ private:
     wxStaticText *m_costLabel;
     wxButton *m_bookBtn;
     wxButton *m_checkAvailabilityBtn;
+    wxButton *m_findEarliestBtn;
 
     // Available slots display
+    CourtTimeline *m_timeline;
     wxListCtrl *m_availableSlotsList;
 
     // User bookings
@@ -45,6 +50,9 @@ private:
 
     // State
     int m_selectedBookingId;
+    int m_heldSlotId; // Hold on the slot picked from the list, 0 if none
+    wxTimer m_remoteTimer; // Thin-client mode: picks up changes pushed to the replica
+    uint64_t m_remoteSequence;
 
 public:
     BookingPanel(wxWindow *parent,
@@ -56,6 +64,7 @@ public:
     // Event handlers
     void OnBookCourt(wxCommandEvent &event);
     void OnCheckAvailability(wxCommandEvent &event);
+    void OnFindEarliestSlot(wxCommandEvent &event);
     void OnCancelBooking(wxCommandEvent &event);
     void OnModifyBooking(wxCommandEvent &event);
     void OnRefreshBookings(wxCommandEvent &event);
@@ -64,6 +73,8 @@ public:
     void OnDateChanged(wxDateEvent &event);
     void OnBookingSelected(wxListEvent &event);
     void OnAvailableSlotSelected(wxListEvent &event);
+    void OnTimelineSelection(wxCommandEvent &event);
+    void OnRemoteTimer(wxTimerEvent &event);
 
     // Public methods
     void RefreshBookings();
@@ -85,6 +96,7 @@ private:
     void BindEvents();
 
     void UpdateAvailableSlots();
+    void UpdateTimelineSelection();
     void UpdateBookingCost();
     void UpdateEstimatedCost();
     void SavePendingChanges();
@@ -95,10 +107,10 @@ private:
     void ClearBookingForm();
     void UpdateButtonStates();
     bool IsCourtFullyBooked();
+    void ReleaseHeldSlot();
 
     // Helper methods
     wxString FormatTimeSlot(std::time_t startTime, std::time_t endTime);
-    wxString FormatCurrency(double amount);
     wxString FormatDateTime(std::time_t time);
     std::time_t CombineDateTime(const wxDateTime &date, const wxDateTime &time);
 
@@ -118,5 +130,8 @@ enum
     ID_START_TIME,
     ID_END_TIME,
     ID_BOOKING_LIST,
-    ID_AVAILABLE_SLOTS_LIST
+    ID_AVAILABLE_SLOTS_LIST,
+    ID_AVAILABILITY_TIMELINE,
+    ID_FIND_EARLIEST_SLOT,
+    ID_REMOTE_TIMER
 };
@@ -0,0 +1,171 @@
+#pragma once
+#include "Booking.h"
+#include "BookingIndex.h"
+#include "ChangeFeed.h"
+#include "Court.h"
+#include "OccupancyMap.h"
+#include "User.h"
+#include <cstdint>
+#include <string>
+
+// Binary protocol between BookingServer and BookingClient.
+//
+// Every message is a frame: a 4-byte little-endian payload length, then the
+// payload. Requests start with the op and a client-chosen request id;
+// responses echo both and add a status byte. All integers are little-endian,
+// doubles travel as their IEEE-754 bits and strings as a u32 length and bytes.
+//
+//   request:  u8 op | u32 requestId | body
+//   response: u8 op | u32 requestId | u8 status | body (when status is OK)
+//
+// Bodies (request -> response):
+//   PING                 -                                      -> -
+//   CREATE_BOOKING       userId courtId date start end notes    -> -
+//   CANCEL_BOOKING       bookingId                              -> -
+//   MODIFY_BOOKING       bookingId start end notes              -> -
+//   GET_BOOKING          bookingId                              -> booking
+//   FIND_BOOKINGS        query, i64 afterStart, i32 afterId     -> u8 more, u32 count, bookings
+//   GET_COURT_OCCUPANCY  courtId date                           -> day bits
+//   GET_COURTS           -                                      -> u32 count, courts
+//   ESTIMATE_COST        courtId start end                      -> f64 cost
+//   GET_AVAILABLE_SLOTS  courtId date u32 slotMinutes           -> u32 count, (start end) pairs
+//   BATCH                u32 count, request frames              -> u64 version, u32 count, response frames
+//   SUBSCRIBE            u64 epoch, u64 afterSequence           -> u64 epoch, u64 sequence, u8 snapshot,
+//                                                                  [u32 courts, u32 users, u32 bookings]
+//   SNAPSHOT_CHUNK       (server to client only)                -> u32 count, courts, u32 count, users,
+//                                                                  u32 count, bookings
+//   CHANGE_EVENT         (server to client only, request id 0)  -> change
+//
+// FIND_BOOKINGS answers one page of matches in (start time, id) order,
+// beginning after the given position (0, 0 for the first page) and cut at
+// about PAGE_BYTES. When more is set the client asks again from the last
+// booking it received; each page reads the version current when it runs.
+//
+// A BATCH carries read-only requests (no create, cancel, modify or nested
+// batch) and runs them all against one committed version of the bookings,
+// so a panel refresh costs one round-trip and sees a consistent picture.
+// Each inner request gets its own response and status; a rejected item
+// does not fail the batch. Pages inside a batch are cut smaller so the
+// whole envelope fits in one frame; an item whose response still would
+// not fit is answered TOO_LARGE. Without a batch, a client may still pipeline:
+// send several frames before reading, and responses come back in order.
+//
+// SUBSCRIBE turns the connection into a change feed. When the epoch and
+// sequence name a position the server still retains, only the changes
+// after it follow; otherwise a full snapshot as of the returned sequence
+// follows. The response then gives the snapshot's totals, and
+// SNAPSHOT_CHUNK frames of about PAGE_BYTES each (same request id) carry
+// the courts, users and bookings in that order until the totals are met;
+// the client applies the snapshot only once all of it has arrived, so a
+// connection lost midway resubscribes from its old position. Either way
+// CHANGE_EVENT frames are then pushed as changes commit. A change is u64 sequence, u8 ChangeType and the new
+// booking, court or user, or the removed id. The server drops a subscriber
+// that falls too far behind; it reconnects and resumes the same way.
+enum class ProtocolOp : uint8_t
+{
+    PING = 0,
+    CREATE_BOOKING = 1,
+    CANCEL_BOOKING = 2,
+    MODIFY_BOOKING = 3,
+    GET_BOOKING = 4,
+    FIND_BOOKINGS = 5,
+    GET_COURT_OCCUPANCY = 6,
+    GET_COURTS = 7,
+    ESTIMATE_COST = 8,
+    GET_AVAILABLE_SLOTS = 9,
+    BATCH = 10,
+    SUBSCRIBE = 11,
+    CHANGE_EVENT = 12,
+    SNAPSHOT_CHUNK = 13
+};
+
+enum class ProtocolStatus : uint8_t
+{
+    OK = 0,
+    REJECTED = 1,    // Valid request the controller refused (conflict, validation)
+    NOT_FOUND = 2,
+    BAD_REQUEST = 3, // Unknown op or malformed body
+    SERVER_ERROR = 4,
+    TOO_LARGE = 5    // Response would not fit in a frame; ask for less
+};
+
+// Builds one frame; the length prefix is filled in by finish()
+class MessageWriter
+{
+private:
+    std::string m_data;
+
+public:
+    MessageWriter();
+
+    void writeU8(uint8_t value);
+    void writeU32(uint32_t value);
+    void writeI32(int32_t value) { writeU32(static_cast<uint32_t>(value)); }
+    void writeI64(int64_t value);
+    void writeDouble(double value);
+    void writeString(const std::string &value);
+    void writeBytes(const void *data, size_t size);
+
+    void writeBooking(const Booking &booking);
+    void writeQuery(const BookingQuery &query);
+    void writeCourt(const Court &court);
+    void writeUser(const User &user); // Profile only, never the password
+    void writeChange(const ChangeRecord &change);
+    void writeDayBits(const OccupancyMap::DayBits &bits);
+
+    size_t size() const { return m_data.size(); } // Frame bytes so far, header included
+    void setU32(size_t offset, uint32_t value);   // Overwrites a value written at that frame offset, e.g. a count
+    const std::string &finish(); // Complete frame, ready to send
+
+    static size_t bookingSize(const Booking &booking); // Bytes writeBooking adds
+};
+
+// Reads a payload; any overrun marks the reader failed instead of throwing
+class MessageReader
+{
+private:
+    const unsigned char *m_position;
+    const unsigned char *m_end;
+    bool m_ok;
+
+public:
+    MessageReader(const char *data, size_t size);
+
+    bool ok() const { return m_ok; }
+    bool atEnd() const { return m_position == m_end; }
+
+    uint8_t readU8();
+    uint32_t readU32();
+    int32_t readI32() { return static_cast<int32_t>(readU32()); }
+    int64_t readI64();
+    double readDouble();
+    std::string readString();
+    const char *readBytes(size_t size); // Points into the payload; nullptr on overrun
+
+    bool readBooking(Booking &booking);
+    bool readQuery(BookingQuery &query);
+    bool readCourt(Court &court);
+    bool readUser(User &user);
+    bool readChange(ChangeRecord &change);
+    bool readDayBits(OccupancyMap::DayBits &bits);
+
+private:
+    bool take(size_t size);
+};
+
+class BookingProtocol
+{
+public:
+    static const size_t HEADER_SIZE = 4;
+    static const uint32_t MAX_PAYLOAD_SIZE = 16 * 1024 * 1024;
+    static const uint32_t MAX_BATCH_REQUESTS = 1024;
+    static const uint32_t PAGE_BYTES = 1024 * 1024; // Size of a FIND_BOOKINGS page or SNAPSHOT_CHUNK
+
+    // Payload length of a frame whose header starts at data (HEADER_SIZE bytes)
+    static uint32_t readLength(const char *data);
+
+    static const char *getStatusString(ProtocolStatus status);
+
+private:
+    BookingProtocol() = default; // Utility class, no instances
+};
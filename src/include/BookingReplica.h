@@ -0,0 +1,96 @@
+#pragma once
+#include "Booking.h"
+#include "BookingProtocol.h"
+#include "ChangeFeed.h"
+#include "Court.h"
+#include "User.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Local copy of a BookingServer's courts, users and bookings, kept current
+// by its change feed so panels can read without a round-trip. A background
+// thread holds its own subscribed connection, applies pushed changes and,
+// after a disconnect, resubscribes from the last sequence it applied; the
+// server answers with only the missed changes, or a fresh snapshot when it
+// no longer has them.
+class BookingReplica
+{
+public:
+    static const int RECONNECT_DELAY_MS = 1000;
+
+    BookingReplica();
+    ~BookingReplica();
+
+    BookingReplica(const BookingReplica &) = delete;
+    BookingReplica &operator=(const BookingReplica &) = delete;
+
+    void start(const std::string &address);
+    void stop();
+
+    // True once a snapshot or resume has been applied on the current connection
+    bool isSynced() const { return m_synced.load(); }
+    bool waitUntilSynced(int timeoutMs) const;
+    uint64_t getSequence() const;
+    std::string getLastError() const;
+
+    // Called on the replica thread after each batch of applied changes, with
+    // the sequence reached; GUI code should post an event rather than redraw here
+    void setChangeListener(std::function<void(uint64_t)> listener);
+
+    // Reads, from the local copy
+    BookingPtr getBooking(int bookingId) const;
+    std::vector<BookingPtr> getBookings() const; // Ordered by start time
+    std::vector<BookingPtr> getCourtBookings(int courtId) const;
+    std::vector<BookingPtr> getUserBookings(int userId) const;
+    std::vector<Court> getCourts() const;
+    bool getUser(int userId, User &user) const;
+    std::vector<User> getUsers() const;
+
+private:
+    // A snapshot arriving in chunks; swapped in once the totals are met
+    struct PendingSnapshot
+    {
+        uint64_t epoch = 0;
+        uint64_t sequence = 0;
+        uint32_t courtsLeft = 0;
+        uint32_t usersLeft = 0;
+        uint32_t bookingsLeft = 0;
+        std::map<int, Court> courts;
+        std::map<int, User> users;
+        std::unordered_map<int, BookingPtr> bookings;
+
+        bool complete() const { return courtsLeft == 0 && usersLeft == 0 && bookingsLeft == 0; }
+    };
+
+    void run();
+    bool follow(intptr_t socket); // Subscribes and applies changes until the connection ends
+    static bool readSnapshotChunk(MessageReader &reader, PendingSnapshot &snapshot);
+    void applySnapshot(PendingSnapshot &snapshot);
+    void applyChange(const ChangeRecord &change);
+    void setError(const std::string &error);
+
+    std::string m_address;
+    std::thread m_thread;
+    std::atomic<bool> m_stopping;
+    std::atomic<bool> m_synced;
+    mutable std::mutex m_stateMutex; // Guards m_lastError and m_listener; wakes stop() and waitUntilSynced()
+    mutable std::condition_variable m_stateChanged;
+
+    mutable std::shared_mutex m_dataLock;
+    std::unordered_map<int, BookingPtr> m_bookings;
+    std::map<int, Court> m_courts;
+    std::map<int, User> m_users;
+    uint64_t m_epoch;
+    uint64_t m_sequence;
+    std::string m_lastError;
+    std::function<void(uint64_t)> m_listener;
+};
@@ -0,0 +1,93 @@
+#pragma once
+#include "Booking.h"
+#include <ctime>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A standing booking kept as a rule instead of one row per occurrence: the
+// same court and local time of day every intervalDays days between two
+// local days, minus the skipped days. Occurrences are worked out for
+// whatever window a query asks about, so storage stays one row per series.
+// Every occurrence counts as a confirmed booking.
+class BookingSeries
+{
+public:
+    // Occurrences have ids of their own, above any booking id: the series id
+    // and the occurrence's place in the rhythm. Skipping or ending keeps the
+    // first day, so an occurrence keeps its id for as long as it exists.
+    static const int FIRST_OCCURRENCE_ID = 1 << 30;
+    static const int MAX_OCCURRENCES = 1 << 12;     // Per series
+    static const int MAX_SERIES_ID = (1 << 18) - 1; // So every occurrence id fits in an int
+
+    static bool isOccurrenceId(int bookingId) { return bookingId >= FIRST_OCCURRENCE_ID; }
+    static int getSeriesIdOf(int occurrenceId) { return (occurrenceId - FIRST_OCCURRENCE_ID) / MAX_OCCURRENCES; }
+
+private:
+    int m_id;
+    int m_userId;
+    int m_courtId;
+    int m_firstDay; // Local day keys of the first and last possible occurrence
+    int m_lastDay;
+    int m_intervalDays;
+    int m_startSecond; // Local time of day, seconds after midnight
+    int m_durationSeconds;
+    double m_amount;                  // Per occurrence, unless priced differently below
+    std::map<int, double> m_dayAmounts; // Day key -> amount, e.g. another weekday's rate or a DST day
+    std::string m_notes;
+    std::vector<int> m_skippedDays; // Sorted day keys without an occurrence
+
+public:
+    BookingSeries();
+
+    // Getters
+    int getId() const { return m_id; }
+    int getUserId() const { return m_userId; }
+    int getCourtId() const { return m_courtId; }
+    int getFirstDay() const { return m_firstDay; }
+    int getLastDay() const { return m_lastDay; }
+    int getIntervalDays() const { return m_intervalDays; }
+    int getStartSecond() const { return m_startSecond; }
+    int getDurationSeconds() const { return m_durationSeconds; }
+    double getAmount() const { return m_amount; }
+    const std::map<int, double> &getDayAmounts() const { return m_dayAmounts; }
+    double getAmountOn(int dayKey) const;
+    const std::string &getNotes() const { return m_notes; }
+    const std::vector<int> &getSkippedDays() const { return m_skippedDays; }
+
+    // Setters
+    void setId(int id) { m_id = id; }
+    void setUserId(int userId) { m_userId = userId; }
+    void setCourtId(int courtId) { m_courtId = courtId; }
+    void setDays(int firstDay, int lastDay, int intervalDays);
+    void setTimeBand(int startSecond, int durationSeconds);
+    void setAmount(double amount) { m_amount = amount; }
+    void setDayAmount(int dayKey, double amount); // Kept only where it differs from the series amount
+    void setNotes(const std::string &notes) { m_notes = notes; }
+    void skipDay(int dayKey);
+
+    bool isActive() const { return m_lastDay >= m_firstDay; } // Ending a series moves its last day back
+    bool occursOn(int dayKey) const;
+
+    // Occurrence starting on the local day that begins at dayStart
+    bool getOccurrence(std::time_t dayStart, std::time_t &start, std::time_t &end) const;
+    // Occurrences starting in [from, to), in order
+    std::vector<std::pair<std::time_t, std::time_t>> getOccurrences(std::time_t from, std::time_t to) const;
+    std::vector<std::pair<std::time_t, std::time_t>> getAllOccurrences() const;
+    // True if an occurrence overlaps [start, end)
+    bool overlaps(std::time_t start, std::time_t end) const;
+    int getOccurrenceCount() const;
+    // First occurrence starting after 'after'
+    bool getNextOccurrence(std::time_t after, std::time_t &start, std::time_t &end) const;
+
+    int getOccurrenceId(int dayKey) const;
+    int getOccurrenceDay(int occurrenceId) const; // Day key the id stands for, occurring or not
+
+    // One occurrence as a confirmed booking with its occurrence id
+    Booking toBooking(std::time_t start, std::time_t end) const;
+};
+
+// Like bookings, a published series is replaced rather than edited
+typedef std::shared_ptr<const BookingSeries> SeriesPtr;
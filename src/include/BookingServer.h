@@ -0,0 +1,135 @@
+#pragma once
+#include "BookingManager.h"
+#include "BookingProtocol.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class BookingController;
+class CourtController;
+
+// Hosts the controllers for many front desks over the binary protocol in
+// BookingProtocol.h. One event-loop thread owns every socket (epoll on Linux,
+// poll/WSAPoll elsewhere) and only moves bytes; complete frames are handed
+// to a worker pool that runs them through the controllers. Requests from one
+// connection are executed in the order they arrived, so a client may send
+// several before reading any response. A BATCH request runs all of its
+// queries under one BookingManager::ReadView. Connections that SUBSCRIBE
+// are pushed every ChangeFeed record from the loop thread as it commits.
+class BookingServer
+{
+public:
+    static const size_t MAX_PENDING_REQUESTS = 256;       // Per connection; reading pauses beyond it
+    static const size_t MAX_OUTPUT_BYTES = 4 * 1024 * 1024; // Per connection; reading pauses beyond it
+
+    BookingServer(BookingController &bookingController, CourtController &courtController);
+    ~BookingServer();
+
+    BookingServer(const BookingServer &) = delete;
+    BookingServer &operator=(const BookingServer &) = delete;
+
+    // Enables SUBSCRIBE; call before start()
+    void setChangeFeed(ChangeFeed *feed) { m_changeFeed = feed; }
+
+    // Address is "host:port" or "unix:/path"; workerCount 0 picks one per core
+    bool start(const std::string &address, int workerCount = 0);
+    void stop(); // Closes every connection and waits for in-flight requests
+
+    bool isRunning() const { return m_running.load(); }
+    const std::string &getLastError() const { return m_lastError; }
+    uint64_t getRequestCount() const { return m_requestCount.load(); }
+    size_t getConnectionCount() const { return m_connectionCount.load(); }
+
+private:
+    struct Connection
+    {
+        intptr_t socket = -1;
+        std::string input;  // Bytes received but not yet framed
+        std::string output; // Response frames not yet sent
+        size_t outputOffset = 0;
+        std::deque<std::string> pending; // Framed requests waiting for the one in flight
+        bool inFlight = false;
+        bool wantRead = false;
+        bool wantWrite = false;
+        bool subscribed = false; // Receives change events after feedCursor
+        uint64_t feedEpoch = 0;
+        uint64_t feedCursor = 0;
+    };
+
+    struct Job
+    {
+        uint64_t connectionId;
+        std::string payload;
+    };
+
+    struct Completion
+    {
+        uint64_t connectionId = 0;
+        std::string frame;
+        bool subscribed = false; // Set by SUBSCRIBE: events start after feedCursor
+        uint64_t feedEpoch = 0;
+        uint64_t feedCursor = 0;
+    };
+
+    // Event loop thread
+    void eventLoop();
+    void acceptConnections();
+    bool readFrom(uint64_t connectionId, Connection &connection);
+    bool writeTo(Connection &connection);
+    bool serviceConnection(uint64_t connectionId, Connection &connection, bool readable, bool writable);
+    void collectCompletions();
+    void pushChangesToSubscribers();
+    bool pushChanges(Connection &connection);
+    void dispatchNext(uint64_t connectionId, Connection &connection);
+    void updateInterest(uint64_t connectionId, Connection &connection);
+    void closeConnection(uint64_t connectionId);
+    void closeAllConnections();
+
+    // Request execution, on worker threads
+    void handleRequest(const std::string &payload, Completion &completion);
+    std::string executeUpdate(ProtocolOp op, uint32_t requestId, MessageReader &reader);
+    std::string executeQuery(ProtocolOp op, uint32_t requestId, MessageReader &reader,
+                             const BookingManager::ReadView &view, size_t pageBytes);
+    std::string executeBatch(uint32_t requestId, MessageReader &reader);
+    std::string executeSubscribe(uint32_t requestId, MessageReader &reader, Completion &completion);
+
+    // Worker threads
+    void workerLoop();
+    void wakeEventLoop();
+
+    BookingController &m_bookingController;
+    CourtController &m_courtController;
+    ChangeFeed *m_changeFeed;
+
+    std::string m_address;
+    std::string m_lastError;
+    intptr_t m_listener;
+    intptr_t m_wakeRead;
+    intptr_t m_wakeWrite;
+    intptr_t m_poller; // epoll descriptor on Linux, unused elsewhere
+
+    std::unordered_map<uint64_t, Connection> m_connections; // Loop thread only
+    uint64_t m_nextConnectionId;
+    size_t m_subscriberCount;
+
+    std::mutex m_jobsMutex;
+    std::condition_variable m_jobsReady;
+    std::deque<Job> m_jobs;
+    bool m_stopWorkers;
+
+    std::mutex m_completionsMutex;
+    std::vector<Completion> m_completions;
+    std::atomic<bool> m_wakePending;
+
+    std::thread m_loopThread;
+    std::vector<std::thread> m_workers;
+    std::atomic<bool> m_running;
+    std::atomic<uint64_t> m_requestCount;
+    std::atomic<size_t> m_connectionCount;
+};
@@ -0,0 +1,24 @@
+#pragma once
+#include "Booking.h"
+#include "BookingSeries.h"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Every booking as of one committed version of BookingManager. It is never
+// modified, so any thread may read it for as long as it holds it.
+class BookingSnapshot
+{
+private:
+    uint64_t m_version;
+    std::vector<BookingPtr> m_bookings;
+    std::vector<SeriesPtr> m_series;
+
+public:
+    BookingSnapshot(uint64_t version, std::vector<BookingPtr> bookings, std::vector<SeriesPtr> series = {})
+        : m_version(version), m_bookings(std::move(bookings)), m_series(std::move(series)) {}
+
+    uint64_t getVersion() const { return m_version; }                        // Increases with every commit
+    const std::vector<BookingPtr> &getBookings() const { return m_bookings; } // Ordered by start time
+    const std::vector<SeriesPtr> &getSeries() const { return m_series; }     // By id, ended ones included
+};
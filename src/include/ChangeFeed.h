@@ -0,0 +1,88 @@
+#pragma once
+#include "Booking.h"
+#include "Court.h"
+#include "User.h"
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+enum class ChangeType : uint8_t
+{
+    BOOKING_CREATED = 0,
+    BOOKING_MODIFIED = 1,
+    BOOKING_CANCELLED = 2,
+    BOOKING_UPDATED = 3, // Any other change, e.g. a status transition
+    COURT_CHANGED = 4,
+    COURT_REMOVED = 5,
+    USER_CHANGED = 6,
+    USER_REMOVED = 7
+};
+
+// One change with the full new state, so applying a record twice is harmless
+struct ChangeRecord
+{
+    uint64_t sequence = 0;
+    ChangeType type = ChangeType::BOOKING_CREATED;
+    BookingPtr booking;                 // BOOKING_* records
+    std::shared_ptr<const Court> court; // COURT_CHANGED
+    std::shared_ptr<const User> user;   // USER_CHANGED, without the password
+    int removedId = 0;                  // COURT_REMOVED, USER_REMOVED
+};
+
+// Ordered log of booking, court and user changes for the server's
+// subscribers. Every record gets the next sequence number; the most recent
+// ones are retained so a client that reconnects can resume after the last
+// sequence it applied. The epoch changes whenever the sequence restarts
+// (a new process or a reload), so a stale cursor is never mistaken for a
+// current one. Courts and users are also kept as current state for the
+// snapshots new subscribers start from; bookings come from BookingManager.
+class ChangeFeed
+{
+public:
+    static const size_t DEFAULT_CAPACITY = 65536;
+
+    explicit ChangeFeed(size_t capacity = DEFAULT_CAPACITY);
+
+    ChangeFeed(const ChangeFeed &) = delete;
+    ChangeFeed &operator=(const ChangeFeed &) = delete;
+
+    uint64_t publishBooking(ChangeType type, const BookingPtr &booking);
+    uint64_t publishCourt(const Court &court);
+    uint64_t publishCourtRemoved(int courtId);
+    uint64_t publishUser(const User &user);
+    uint64_t publishUserRemoved(int userId);
+
+    // New epoch and an empty log, e.g. after the bookings were reloaded
+    void restart();
+
+    uint64_t getEpoch() const;
+    uint64_t getLastSequence() const;
+
+    // Up to maxCount records after 'after', oldest first. False when the
+    // cursor cannot be resumed: another epoch, or records already dropped.
+    bool readSince(uint64_t epoch, uint64_t after, size_t maxCount, std::vector<ChangeRecord> &records) const;
+
+    // Current courts and users with the sequence they reflect
+    void getDirectory(uint64_t &epoch, uint64_t &sequence, std::vector<Court> &courts,
+                      std::vector<User> &users) const;
+
+    // Called after each publish, with the feed locked; must not block
+    void setListener(std::function<void()> listener);
+
+private:
+    uint64_t append(ChangeRecord record);
+    static uint64_t newEpoch();
+
+    mutable std::mutex m_mutex;
+    size_t m_capacity;
+    uint64_t m_epoch;
+    uint64_t m_lastSequence;
+    std::deque<ChangeRecord> m_records;
+    std::map<int, std::shared_ptr<const Court>> m_courts;
+    std::map<int, std::shared_ptr<const User>> m_users;
+    std::function<void()> m_listener;
+};
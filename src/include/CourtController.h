@@ -2,10 +2,14 @@
 #include "Court.h"
 #include <vector>
 
+class ChangeFeed;
+
 class CourtController
 {
 private:
     std::vector<Court*> m_courts;
+    ChangeFeed *m_changeFeed = nullptr;
+    bool m_mirrored = false; // Courts copied from a server are never saved here
 
 public:
     CourtController();
@@ -35,6 +39,13 @@ public:
     bool isCourtNameTaken(const std::string &name, int excludeId = -1) const;
     bool validateCourtData(const std::string &name, double hourlyRate) const;
 
+    // Publishes every court now and each change from then on
+    void setChangeFeed(ChangeFeed *feed);
+
+    // Replaces the courts with a server's, e.g. for a thin client; the
+    // local file is left alone from then on
+    void mirrorCourts(const std::vector<Court> &courts);
+
     // Data persistence
     void loadCourts();
     void saveCourts();
@@ -76,7 +76,6 @@ private:
 
     // Helper methods
     void PopulateCourtList();
-    wxString FormatCurrency(double amount);
 
     DECLARE_EVENT_TABLE()
 };
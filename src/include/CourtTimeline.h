@@ -0,0 +1,86 @@
+#pragma once
+#include <wx/wx.h>
+#include <wx/bitmap.h>
+#include "OccupancyMap.h"
+#include <ctime>
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+
+// Sent when the user finishes selecting a free span; use GetSelectionStart/End
+wxDECLARE_EVENT(wxEVT_TIMELINE_SELECTION, wxCommandEvent);
+
+// Owner-drawn business-hours timeline for one court-day.
+// The static part (free/booked spans, hour ticks) is rendered once into a
+// bitmap cached per court-day; painting blits only the invalidated region
+// and draws the past shading and the drag selection on top.
+class CourtTimeline : public wxWindow
+{
+public:
+    static const int FIRST_HOUR = 6; // Business hours
+    static const int LAST_HOUR = 23;
+    static const int SNAP_SLOTS = 3; // Selections snap to 15 minutes
+
+    CourtTimeline(wxWindow *parent, wxWindowID id);
+
+    // Shows a court-day; re-renders only if the bookings changed since it was cached
+    void SetDay(int courtId, const wxDateTime &day, const OccupancyMap::DayBits &occupancy);
+    void SetSelection(std::time_t startTime, std::time_t endTime);
+    void ClearSelection();
+
+    bool HasSelection() const { return m_selStart >= 0 && m_selEnd > m_selStart; }
+    std::time_t GetSelectionStart() const { return SlotToTime(m_selStart); }
+    std::time_t GetSelectionEnd() const { return SlotToTime(m_selEnd); }
+
+protected:
+    wxSize DoGetBestSize() const override { return wxSize(480, 56); }
+
+private:
+    struct CachedDay
+    {
+        OccupancyMap::DayBits occupancy;
+        wxBitmap bitmap;
+    };
+
+    // Painting
+    void OnPaint(wxPaintEvent &event);
+    void OnSize(wxSizeEvent &event);
+    const wxBitmap &GetDayBitmap();
+    wxBitmap RenderDay(const OccupancyMap::DayBits &occupancy, const wxSize &size) const;
+
+    // Mouse selection
+    void OnLeftDown(wxMouseEvent &event);
+    void OnMotion(wxMouseEvent &event);
+    void OnLeftUp(wxMouseEvent &event);
+    void OnCaptureLost(wxMouseCaptureLostEvent &event);
+    void UpdateDragSelection(int slot);
+    void FinishDrag();
+    void SetSelectionSlots(int start, int end);
+
+    // Geometry (slots are counted from midnight, as in OccupancyMap)
+    int FirstSlot() const { return FIRST_HOUR * OccupancyMap::SLOTS_PER_HOUR; }
+    int LastSlot() const { return LAST_HOUR * OccupancyMap::SLOTS_PER_HOUR; }
+    int SlotToX(int slot) const;
+    int XToSlot(int x) const;
+    wxRect SlotRangeRect(int start, int end) const;
+    std::time_t SlotToTime(int slot) const;
+    int TimeToSlot(std::time_t time) const;
+    bool IsSlotFree(int slot) const;
+
+    int m_courtId;
+    wxDateTime m_day;
+    std::time_t m_dayStart;
+    OccupancyMap::DayBits m_occupancy;
+
+    // Rendered days, most recently used at the front
+    std::unordered_map<uint64_t, CachedDay> m_cache;
+    std::list<uint64_t> m_cacheOrder;
+
+    // Selection in slots, end exclusive (-1 when empty)
+    int m_selStart;
+    int m_selEnd;
+    int m_dragAnchor;
+    bool m_dragMoved;
+
+    wxDECLARE_EVENT_TABLE();
+};
@@ -1,19 +1,62 @@
 #pragma once
 #include <string>
+#include <cstddef>
 #include <ctime>
 
 class DateTimeUtils
 {
 public:
+    // Local calendar fields of one instant in the venue's time zone
+    struct LocalTime
+    {
+        std::time_t dayStart; // First instant of the local day
+        std::time_t dayEnd;   // Start of the next day (exclusive)
+        int dayKey;           // Days since 1970-01-01, local calendar
+        int year;
+        int month;   // 1-12
+        int day;     // 1-31
+        int weekday; // 0 = Sunday
+        int hour;
+        int minute;
+        int second;
+    };
+
+    // Local time conversion. Backed by a per-year table of DST-aware day
+    // boundaries built on first use, so lookups are O(1) and safe to call
+    // from worker threads. Falls back to the C library outside 2000-2099.
+    static LocalTime toLocal(std::time_t time);
+    static int getDayKey(std::time_t time);
+    static std::time_t getDayStart(int dayKey); // Local midnight of a day key
+    static int getHour(std::time_t time);
+    static std::time_t getTimeOnDay(std::time_t day, int hour, int minute = 0); // Same local day
+
     // String formatting
     static std::string formatDateTime(std::time_t time, const std::string &format = "%Y-%m-%d %H:%M:%S");
     static std::string formatDate(std::time_t time, const std::string &format = "%Y-%m-%d");
     static std::string formatTime(std::time_t time, const std::string &format = "%H:%M:%S");
 
-    // Parsing
+    // Buffer formatting, local time. Handles %Y %y %m %d %e %j %H %I %M %S
+    // %p %a %A %b %B %F %T %R %% itself (English names) and hands any other
+    // format to strftime. Like strftime, returns the length written or 0
+    // if the result does not fit.
+    static size_t formatTo(char *buffer, size_t size, std::time_t time, const char *format);
+    // Fixed-width writers from precomputed tables; return the end, no terminator
+    static char *writeDate(char *out, std::time_t time);  // YYYY-MM-DD
+    static char *writeClock(char *out, std::time_t time); // HH:MM
+
+    // Parsing. Formats use the subset above (except %j) plus %z ("Z", "+07:00");
+    // a space matches any run of whitespace. Without %z the text is local
+    // time, and a format with no date fields means today.
+    // The string versions return -1 when the text does not match.
     static std::time_t parseDateTime(const std::string &dateTimeStr, const std::string &format = "%Y-%m-%d %H:%M:%S");
     static std::time_t parseDate(const std::string &dateStr, const std::string &format = "%Y-%m-%d");
     static std::time_t parseTime(const std::string &timeStr, const std::string &format = "%H:%M:%S");
+    static bool tryParse(const char *text, size_t length, const char *format, std::time_t &result);
+    // YYYY-MM-DD with optional [T| ]HH:MM[:SS[.fff]] and Z/+HH:MM offset
+    static bool parseIso(const char *text, size_t length, std::time_t &result);
+
+    // Local date and time of day to epoch; fields must be in range
+    static std::time_t makeTime(int year, int month, int day, int hour = 0, int minute = 0, int second = 0);
 
     // Utility functions
     static std::time_t getCurrentTime();
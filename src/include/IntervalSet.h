@@ -0,0 +1,30 @@
+#pragma once
+#include <ctime>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Half-open [start, end) intervals keyed by booking id, ordered by start.
+// Overlap checks look back only as far as the longest interval stored,
+// so they cost O(log n) plus the few neighbours for short bookings.
+class IntervalSet
+{
+private:
+    std::map<std::pair<std::time_t, int>, std::time_t> m_intervals; // (start, id) -> end
+    std::time_t m_maxLength = 0;                                     // Never shrinks; only widens the look-back
+
+public:
+    void clear();
+    void insert(int id, std::time_t start, std::time_t end);
+    void erase(int id, std::time_t start);
+
+    // True if any interval other than ignoreId overlaps [start, end)
+    bool overlaps(std::time_t start, std::time_t end, int ignoreId = 0) const;
+    // Id of the earliest such interval, or 0 if there is none
+    int findOverlap(std::time_t start, std::time_t end, int ignoreId = 0) const;
+    // Appends the ids of all intervals overlapping [start, end), by start
+    void findOverlaps(std::time_t start, std::time_t end, std::vector<int> &ids) const;
+
+    size_t size() const { return m_intervals.size(); }
+    bool empty() const { return m_intervals.empty(); }
+};
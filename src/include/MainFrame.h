@@ -1,6 +1,7 @@
 #pragma once
 #include <wx/wx.h>
 #include <wx/notebook.h>
+#include <cstdint>
 
 class AuthController;
 class CourtController;
@@ -10,6 +11,7 @@ class BookingPanel;
 class StatisticsPanel;
 class UserManagementPanel;
 class AdminPanel;
+class ScheduleGridPanel;
 class LoginFrame;
 
 class MainFrame : public wxFrame
@@ -30,10 +32,16 @@ private:
     StatisticsPanel *m_statisticsPanel;
     UserManagementPanel *m_userPanel;
     AdminPanel *m_adminPanel;
+    ScheduleGridPanel *m_schedulePanel;
 
     // Current user info
     wxStaticText *m_userLabel;
 
+    // Unread notification badge, polled from the in-app inboxes
+    wxTimer m_notificationTimer;
+    size_t m_lastUnreadCount;
+    uint64_t m_remoteSequence; // Thin-client mode: last replica change the panels show
+
     // State variables
     int m_selectedCourtId;
     int m_selectedBookingId;
@@ -50,6 +58,8 @@ public:
     void OnLogout(wxCommandEvent &event);
     void OnRefresh(wxCommandEvent &event);
     void OnClose(wxCloseEvent &event);
+    void OnShowNotifications(wxCommandEvent &event);
+    void OnNotificationTimer(wxTimerEvent &event);
 
     // Panel management
     void OnPageChanged(wxBookCtrlEvent &event);
@@ -64,6 +74,7 @@ private:
     void SetupPanels();
     void BindEvents();
     void UpdateStatusBar();
+    void UpdateNotificationBadge();
     void ShowUserInfo();
 
     DECLARE_EVENT_TABLE()
@@ -75,5 +86,7 @@ enum
     ID_LOGOUT = 2000,
     ID_REFRESH,
     ID_ABOUT,
-    ID_NOTEBOOK
+    ID_NOTEBOOK,
+    ID_NOTIFICATIONS,
+    ID_NOTIFICATION_TIMER
 };
@@ -0,0 +1,82 @@
+#pragma once
+#include "BookingEvent.h"
+#include "MpscRingBuffer.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class NotificationObserver;
+
+// Delivers booking events to observers off the booking path.
+// publish() only copies the event into a lock-free ring; a dispatcher thread
+// fans it out to one bounded queue per observer, and each observer runs on
+// its own worker thread. Events are never dropped while the dispatcher runs:
+// a full ring makes publish() wait, and a full observer queue makes the
+// dispatcher wait, so bursts (batches, series, sweeps) slow down instead of
+// losing confirmations. publish() is only called after the booking locks are
+// released, so waiting there never holds up other bookings.
+class NotificationDispatcher
+{
+public:
+    static const size_t EVENT_QUEUE_CAPACITY = 1024;
+    static const size_t OBSERVER_QUEUE_CAPACITY = 256;
+
+    NotificationDispatcher();
+    ~NotificationDispatcher();
+
+    NotificationDispatcher(const NotificationDispatcher &) = delete;
+    NotificationDispatcher &operator=(const NotificationDispatcher &) = delete;
+
+    void addObserver(NotificationObserver *observer);
+    void removeObserver(NotificationObserver *observer); // Waits for its in-flight callback
+
+    // Waits while the ring is full; returns false only if no dispatcher
+    // is running to deliver it (before the first observer or after shutdown)
+    bool publish(BookingEvent event);
+
+    // Delivers everything already published, then stops all threads.
+    // Observers may be destroyed once this returns.
+    void shutdown();
+
+    // Events published with no dispatcher running
+    uint64_t getDroppedEvents() const { return m_droppedEvents.load(); }
+
+private:
+    struct ObserverQueue
+    {
+        NotificationObserver *observer = nullptr;
+        std::deque<BookingEvent> pending;
+        std::mutex mutex;
+        std::condition_variable ready;
+        std::condition_variable space; // Signalled as the worker takes events
+        bool stopping = false;
+        std::thread worker;
+    };
+
+    void startThread();
+    void dispatchLoop();
+    void fanOut(const BookingEvent &event);
+    static void observerLoop(ObserverQueue *queue);
+    static void deliver(NotificationObserver *observer, const BookingEvent &event);
+    static void stopQueue(ObserverQueue *queue);
+
+    MpscRingBuffer<BookingEvent> m_events;
+    std::atomic<uint64_t> m_nextSequence;
+    std::atomic<uint64_t> m_droppedEvents;
+
+    mutable std::mutex m_queuesMutex;
+    std::vector<std::unique_ptr<ObserverQueue>> m_queues;
+
+    // Dispatcher thread
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+    std::mutex m_spaceMutex; // Publishers waiting for room in the ring
+    std::condition_variable m_space;
+};
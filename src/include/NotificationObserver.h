@@ -1,8 +1,26 @@
 #pragma once
 #include "Booking.h"
+#include "NotificationTemplate.h"
+#include <ctime>
+#include <functional>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+class NotificationOutbox;
+
+// Contact details of the customer a booking belongs to
+struct NotificationRecipient
+{
+    std::string fullName;
+    std::string email;
+    std::string phoneNumber;
+};
+
+// Looks up a user's contact details; called from notification worker threads
+using RecipientResolver = std::function<bool(int userId, NotificationRecipient &recipient)>;
+
 // Observer pattern for notifications
 class NotificationObserver
 {
@@ -12,6 +30,7 @@ public:
     virtual void onBookingCancelled(const Booking &booking) = 0;
     virtual void onBookingModified(const Booking &oldBooking, const Booking &newBooking) = 0;
     virtual void onBookingReminder(const Booking &booking) = 0;
+    virtual void onWaitlistOffer(const Booking &offer) = 0;
 };
 
 // Email notification observer
@@ -23,6 +42,18 @@ private:
     std::string m_username;
     std::string m_password;
     bool m_isEnabled;
+    NotificationOutbox *m_outbox; // Not owned; nullptr prints to stdout instead
+    RecipientResolver m_resolveRecipient;
+
+    // Bodies are parsed once; callbacks arrive on one worker thread, so the
+    // date cache and render buffer need no locking
+    NotificationTemplate m_createdBody;
+    NotificationTemplate m_cancelledBody;
+    NotificationTemplate m_modifiedBody;
+    NotificationTemplate m_reminderBody;
+    NotificationTemplate m_offerBody;
+    DateFragmentCache m_dates;
+    std::string m_buffer;
 
 public:
     EmailNotificationObserver(const std::string &smtpServer, int smtpPort,
@@ -32,17 +63,20 @@ public:
     void onBookingCancelled(const Booking &booking) override;
     void onBookingModified(const Booking &oldBooking, const Booking &newBooking) override;
     void onBookingReminder(const Booking &booking) override;
+    void onWaitlistOffer(const Booking &offer) override;
 
     // Configuration
     void setEnabled(bool enabled) { m_isEnabled = enabled; }
     bool isEnabled() const { return m_isEnabled; }
     void configure(const std::string &smtpServer, int smtpPort,
                    const std::string &username, const std::string &password);
+    void setOutbox(NotificationOutbox *outbox); // Also hands it the SMTP settings
+    void setRecipientResolver(RecipientResolver resolver) { m_resolveRecipient = std::move(resolver); }
 
 private:
+    void send(const Booking &booking, const std::string &subject, const NotificationTemplate &body);
     bool sendEmail(const std::string &to, const std::string &subject,
                    const std::string &body) const;
-    std::string formatBookingDetails(const Booking &booking) const;
 };
 
 // SMS notification observer (future extension)
@@ -52,6 +86,16 @@ private:
     std::string m_apiKey;
     std::string m_apiUrl;
     bool m_isEnabled;
+    NotificationOutbox *m_outbox; // Not owned; nullptr prints to stdout instead
+    RecipientResolver m_resolveRecipient;
+
+    NotificationTemplate m_createdText;
+    NotificationTemplate m_cancelledText;
+    NotificationTemplate m_modifiedText;
+    NotificationTemplate m_reminderText;
+    NotificationTemplate m_offerText;
+    DateFragmentCache m_dates;
+    std::string m_buffer;
 
 public:
     SMSNotificationObserver(const std::string &apiKey, const std::string &apiUrl);
@@ -60,34 +104,111 @@ public:
     void onBookingCancelled(const Booking &booking) override;
     void onBookingModified(const Booking &oldBooking, const Booking &newBooking) override;
     void onBookingReminder(const Booking &booking) override;
+    void onWaitlistOffer(const Booking &offer) override;
 
     void setEnabled(bool enabled) { m_isEnabled = enabled; }
     bool isEnabled() const { return m_isEnabled; }
+    void setOutbox(NotificationOutbox *outbox) { m_outbox = outbox; }
+    void setRecipientResolver(RecipientResolver resolver) { m_resolveRecipient = std::move(resolver); }
 
 private:
+    void send(const Booking &booking, const NotificationTemplate &text);
     bool sendSMS(const std::string &phoneNumber, const std::string &message) const;
 };
 
-// In-app notification observer
-class InAppNotificationObserver : public NotificationObserver
+// One in-app notification; the timestamp is only formatted when displayed
+struct InAppNotification
 {
-private:
-    std::vector<std::string> m_notifications;
-    size_t m_maxNotifications;
+    std::time_t timestamp = 0;
+    int bookingId = 0;
+    std::string message;
+
+    std::string formatTimestamp() const; // "YYYY-MM-DD HH:MM:SS", local time
+};
 
+// In-app notification observer with a fixed-capacity inbox per user
+class InAppNotificationObserver : public NotificationObserver
+{
 public:
-    InAppNotificationObserver(size_t maxNotifications = 100);
+    // Ring buffer of one user's notifications; the newest overwrites the oldest
+    class Inbox
+    {
+    public:
+        explicit Inbox(size_t capacity);
+
+        void push(InAppNotification notification);
+        void markAllRead() { m_unread = 0; }
+        void clear();
+
+        size_t size() const { return m_count; }
+        size_t capacity() const { return m_capacity; }
+        size_t getUnreadCount() const { return m_unread; }
+        const InAppNotification &at(size_t index) const; // 0 = newest
+
+    private:
+        std::vector<InAppNotification> m_items;
+        size_t m_capacity;
+        size_t m_next; // Slot the next push writes
+        size_t m_count;
+        size_t m_unread;
+    };
+
+    // Newest-first view over one inbox without copying it. The view holds the
+    // observer's lock while it is alive, so keep it short-lived.
+    class InboxView
+    {
+    public:
+        class const_iterator
+        {
+        public:
+            const_iterator(const Inbox *inbox, size_t index) : m_inbox(inbox), m_index(index) {}
+            const InAppNotification &operator*() const { return m_inbox->at(m_index); }
+            const InAppNotification *operator->() const { return &m_inbox->at(m_index); }
+            const_iterator &operator++()
+            {
+                ++m_index;
+                return *this;
+            }
+            bool operator==(const const_iterator &other) const { return m_index == other.m_index; }
+            bool operator!=(const const_iterator &other) const { return m_index != other.m_index; }
+
+        private:
+            const Inbox *m_inbox;
+            size_t m_index;
+        };
+
+        InboxView(std::unique_lock<std::mutex> lock, const Inbox *inbox)
+            : m_lock(std::move(lock)), m_inbox(inbox) {}
+
+        const_iterator begin() const { return const_iterator(m_inbox, 0); }
+        const_iterator end() const { return const_iterator(m_inbox, size()); }
+        size_t size() const { return m_inbox ? m_inbox->size() : 0; }
+        bool empty() const { return size() == 0; }
+        size_t getUnreadCount() const { return m_inbox ? m_inbox->getUnreadCount() : 0; }
+
+    private:
+        std::unique_lock<std::mutex> m_lock;
+        const Inbox *m_inbox; // nullptr when the user has no inbox yet
+    };
+
+    InAppNotificationObserver(size_t capacityPerUser = 100);
 
     void onBookingCreated(const Booking &booking) override;
     void onBookingCancelled(const Booking &booking) override;
     void onBookingModified(const Booking &oldBooking, const Booking &newBooking) override;
     void onBookingReminder(const Booking &booking) override;
+    void onWaitlistOffer(const Booking &offer) override;
 
-    // Notification management
-    std::vector<std::string> getNotifications() const { return m_notifications; }
-    void clearNotifications() { m_notifications.clear(); }
-    size_t getNotificationCount() const { return m_notifications.size(); }
+    // Inbox access (safe from any thread)
+    InboxView getInbox(int userId) const;
+    size_t getUnreadCount(int userId) const; // O(1), for badges
+    void markAllRead(int userId);
+    void clearInbox(int userId);
 
 private:
-    void addNotification(const std::string &message);
+    void addNotification(const Booking &booking, std::string message);
+
+    size_t m_capacityPerUser;
+    mutable std::mutex m_mutex; // Callbacks arrive on the dispatcher's worker thread
+    std::unordered_map<int, Inbox> m_inboxes;
 };
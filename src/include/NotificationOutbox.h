@@ -0,0 +1,129 @@
+#pragma once
+#include "SmtpClient.h"
+#include <condition_variable>
+#include <cstddef>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+enum class OutboxChannel
+{
+    EMAIL,
+    SMS
+};
+
+enum class OutboxState
+{
+    PENDING,
+    DELIVERED,
+    FAILED
+};
+
+struct OutboxMessage
+{
+    int id = 0;
+    OutboxChannel channel = OutboxChannel::EMAIL;
+    OutboxState state = OutboxState::PENDING;
+    int attempts = 0;
+    std::time_t createdAt = 0;
+    std::time_t nextAttemptAt = 0;
+    std::string recipient; // Email address or phone number
+    std::string subject;
+    std::string body;
+    std::string lastError;
+};
+
+struct SmtpSettings
+{
+    std::string host = "localhost";
+    int port = 1025;
+    std::string username; // Empty to skip AUTH
+    std::string password;
+    std::string sender = "noreply@badminton.local";
+    std::string smsGatewayDomain; // SMS goes to <digits>@domain; empty disables SMS
+};
+
+// Durable queue of outgoing email and SMS.
+// enqueue() appends the message to an append-only log and returns at once;
+// a delivery worker sends due messages in batches over one reused SMTP
+// connection, retries transient failures with exponential backoff and
+// appends each batch's state changes to the log in a single write. The log
+// is replayed and compacted on startup, so undelivered messages survive
+// a restart. Failed messages are kept for FAILED_RETENTION_SECONDS after
+// their last attempt so they can be counted and retried.
+class NotificationOutbox
+{
+public:
+    static const size_t BATCH_SIZE = 100;
+    static const int MAX_ATTEMPTS = 8;
+    static const std::time_t BASE_RETRY_SECONDS = 30;
+    static const std::time_t MAX_RETRY_SECONDS = 60 * 60;
+    static const std::time_t FAILED_RETENTION_SECONDS = 7 * 24 * 60 * 60;
+
+    explicit NotificationOutbox(const std::string &logPath = "data/outbox.log");
+    ~NotificationOutbox();
+
+    NotificationOutbox(const NotificationOutbox &) = delete;
+    NotificationOutbox &operator=(const NotificationOutbox &) = delete;
+
+    void configure(const SmtpSettings &settings);
+    SmtpSettings getSettings() const;
+
+    void start();
+    void stop(); // Pending messages stay in the log for the next start
+
+    // Safe from any thread; returns the message id
+    int enqueue(OutboxChannel channel, const std::string &recipient,
+                const std::string &subject, const std::string &body);
+
+    // Status
+    size_t getPendingCount() const;
+    size_t getDeliveredCount() const;
+    size_t getFailedCount() const; // Failed messages still retained
+    bool getMessage(int messageId, OutboxMessage &message) const; // Pending or failed messages
+
+    // Queues every retained failed message again with a fresh attempt count,
+    // e.g. once the SMTP settings are fixed; returns how many
+    size_t retryFailed();
+
+private:
+    // Log
+    void load();
+    void appendRecord(const std::string &record);
+    static std::string encodeMessage(const OutboxMessage &message);
+    static std::string encodeState(const OutboxMessage &message);
+    static std::string escape(const std::string &text);
+    static std::string unescape(const std::string &text);
+
+    // Delivery
+    void run();
+    std::vector<OutboxMessage> takeDueBatch(std::time_t now);
+    void deliverBatch(std::vector<OutboxMessage> &batch, const SmtpSettings &settings);
+    bool ensureConnected(const SmtpSettings &settings);
+    void recordAttempt(OutboxMessage &message, bool delivered, bool permanent,
+                       const std::string &error, std::time_t now) const;
+    void applyResults(const std::vector<OutboxMessage> &batch);
+
+    std::string m_logPath;
+    std::ofstream m_log;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::map<int, OutboxMessage> m_pending;
+    std::set<std::pair<std::time_t, int>> m_due; // Next attempt, id; in-flight messages are absent
+    std::map<int, OutboxMessage> m_failed;       // Until retried or past retention
+    size_t m_deliveredCount;
+    int m_nextId;
+    SmtpSettings m_settings;
+    bool m_settingsChanged;
+
+    SmtpClient m_client; // Worker thread only
+    std::thread m_thread;
+    bool m_running;
+};
@@ -0,0 +1,71 @@
+#pragma once
+#include "Booking.h"
+#include <ctime>
+#include <string>
+#include <vector>
+
+// Caches the formatted local date of the most recent day seen, so rendering
+// many notifications for the same day skips the day-table lookup and
+// formatting. Not thread-safe: each rendering thread keeps its own cache.
+class DateFragmentCache
+{
+public:
+    DateFragmentCache();
+
+    void appendDate(std::string &out, std::time_t time); // YYYY-MM-DD
+    void appendTime(std::string &out, std::time_t time); // HH:MM
+
+private:
+    void load(std::time_t time);
+
+    std::time_t m_dayStart;
+    std::time_t m_dayEnd; // Exclusive
+    bool m_regularDay;    // 24 hours long, so HH:MM is plain arithmetic
+    char m_date[16];
+};
+
+// A notification text parsed once into literal and field segments.
+// Placeholders look like {startTime}; unknown names are kept as literal
+// text. render() appends to a caller-owned buffer, so a reused buffer
+// renders without allocating once it has grown.
+//
+// Fields: bookingId, userId, courtId, date, startTime, endTime, amount,
+// status, notes, notesLine ("\nNotes: ..." or nothing), customerName.
+class NotificationTemplate
+{
+public:
+    explicit NotificationTemplate(const std::string &text);
+
+    void render(const Booking &booking, const std::string &customerName,
+                DateFragmentCache &dates, std::string &out) const;
+
+private:
+    enum class Field
+    {
+        LITERAL,
+        BOOKING_ID,
+        USER_ID,
+        COURT_ID,
+        DATE,
+        START_TIME,
+        END_TIME,
+        AMOUNT,
+        STATUS,
+        NOTES,
+        NOTES_LINE,
+        CUSTOMER_NAME
+    };
+
+    struct Segment
+    {
+        Field field;
+        size_t offset; // Literal text range in m_text
+        size_t length;
+    };
+
+    static Field lookupField(const std::string &name);
+    static void appendInt(std::string &out, long long value);
+
+    std::string m_text;
+    std::vector<Segment> m_segments;
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+
+// Formatted number held on the caller's stack
+class NumberText
+{
+public:
+    static const size_t CAPACITY = 40;
+
+    const char *c_str() const { return m_text; }
+    size_t size() const { return m_length; }
+
+private:
+    friend class NumberFormat;
+
+    char m_text[CAPACITY];
+    size_t m_length;
+};
+
+// Integers and VND amounts with thousands separators, rendered with
+// to_chars straight into caller buffers. Whole-thousand amounts up to
+// 2,000,000 VND (court rates, booking totals) are copied from a table
+// built on first use.
+class NumberFormat
+{
+public:
+    static const size_t MAX_LENGTH = 32; // Longest output of the writers
+
+    // Return the end of the text; no terminator is written
+    static char *writeInteger(char *out, long long value); // -1,234,567
+    static char *writeVnd(char *out, double amount);       // 1,234,567 VND, rounded to whole dong
+
+    static NumberText integer(long long value);
+    static NumberText vnd(double amount);
+
+private:
+    NumberFormat() = default; // Utility class, no instances
+};
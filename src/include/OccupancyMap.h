@@ -0,0 +1,56 @@
+#pragma once
+#include "BookingSeries.h"
+#include <bitset>
+#include <ctime>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Per court-day occupancy bitmaps at 5-minute resolution.
+// A bit is set when any active booking covers part of that slot, so
+// schedule views can draw a whole day without walking the bookings.
+// Standing series and slot holds are not stamped into the days; each court
+// keeps its series rules and held intervals, overlaid when a day is read.
+class OccupancyMap
+{
+public:
+    static const int SLOT_MINUTES = 5;
+    static const int SLOTS_PER_HOUR = 60 / SLOT_MINUTES;
+    static const int SLOTS_PER_DAY = 24 * SLOTS_PER_HOUR;
+    using DayBits = std::bitset<SLOTS_PER_DAY>;
+
+private:
+    // Key packs the court id with the local day number
+    std::unordered_map<uint64_t, DayBits> m_days;
+    std::unordered_map<int, std::vector<SeriesPtr>> m_series; // By court
+    std::unordered_map<int, std::unordered_map<int, std::pair<std::time_t, std::time_t>>> m_holds; // By court, then hold id
+
+public:
+    void clear();
+
+    void addSeries(const SeriesPtr &series);
+    void removeSeries(int courtId, int seriesId);
+    void addHold(int holdId, int courtId, std::time_t startTime, std::time_t endTime);
+    void removeHold(int holdId, int courtId);
+
+    // Marks [startTime, endTime), splitting at midnight when needed
+    void mark(int courtId, std::time_t startTime, std::time_t endTime);
+    void clearDay(int courtId, std::time_t dayStart);
+
+    // Bits for the local day containing 'date' (all clear if nothing is booked)
+    DayBits getDay(int courtId, std::time_t date) const;
+    bool isFree(int courtId, std::time_t startTime, std::time_t endTime) const;
+
+    // First start slot >= fromSlot, a multiple of step, with 'length' free slots
+    // ending by endSlot on the day starting at dayStart; -1 if there is none
+    int findFreeRun(int courtId, std::time_t dayStart, int fromSlot, int endSlot, int length, int step) const;
+
+    // Slot covering a time, counted from the given local midnight
+    static int slotOf(std::time_t dayStart, std::time_t time);
+
+private:
+    DayBits combinedDay(int courtId, std::time_t dayStart) const;
+    static uint64_t makeKey(int courtId, std::time_t dayStart);
+    static std::time_t nextDayStart(std::time_t dayStart);
+};
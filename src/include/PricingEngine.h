@@ -0,0 +1,83 @@
+#pragma once
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// Minutes [startMinute, endMinute) of the selected weekdays cost percent%
+// of the court's base hourly rate. Later rules override earlier ones.
+struct PriceRule
+{
+    int courtId;      // 0 = every court
+    unsigned dayMask; // Bit 0 = Sunday ... bit 6 = Saturday
+    int startMinute;  // From local midnight
+    int endMinute;    // Exclusive, at most 24:00
+    int percent;
+};
+
+// Singleton holding compiled court prices. For every court and weekday the
+// rules are folded into a prefix array of per-minute hourly rates, so the
+// cost of any span of a day is one subtraction.
+//
+// Rules live in data/pricing.txt, one per line (# starts a comment):
+//   courtId|days|start|end|percent      e.g.  0|Mon-Fri|17:00|22:00|130
+// where courtId 0 means every court and days is *, a list or a range.
+class PricingEngine
+{
+public:
+    static const int DEFAULT_HOURLY_RATE = 50000; // For courts not registered with setCourtRate
+    static const int MINUTES_PER_DAY = 24 * 60;
+
+    // Prices of one court-day; keeps its table alive while rates change
+    class DayPrices
+    {
+    public:
+        double getCost(int startMinute, int endMinute) const; // Minutes from local midnight
+
+    private:
+        friend class PricingEngine;
+
+        std::shared_ptr<const std::vector<double>> m_table;
+        const double *m_prefix = nullptr;
+    };
+
+    static PricingEngine &getInstance();
+
+    // Court base rates, kept in step by CourtController
+    void setCourtRate(int courtId, double hourlyRate);
+    void removeCourt(int courtId);
+    bool hasCourt(int courtId) const; // Other ids are priced from the default table
+
+    // setRules recompiles every court and saves the file
+    std::vector<PriceRule> getRules() const;
+    void setRules(const std::vector<PriceRule> &rules);
+    void loadRules();
+    void saveRules() const;
+
+    // Cost of a booking; spans local days and DST changes
+    double getCost(int courtId, std::time_t startTime, std::time_t endTime) const;
+    DayPrices getDayPrices(int courtId, std::time_t date) const;
+
+    PricingEngine(const PricingEngine &) = delete;
+    PricingEngine &operator=(const PricingEngine &) = delete;
+
+private:
+    // 7 weekdays x (MINUTES_PER_DAY + 1) running sums, in rate-minutes
+    typedef std::vector<double> PriceTable;
+
+    PricingEngine() = default;
+
+    std::shared_ptr<const PriceTable> compile(int courtId, double hourlyRate) const; // Caller holds m_lock
+    void recompileAll();                                                             // Caller holds m_lock
+    std::shared_ptr<const PriceTable> findTable(int courtId) const;
+
+    static PricingEngine *m_instance;
+    static std::mutex m_instanceMutex;
+
+    mutable std::mutex m_lock;
+    std::vector<PriceRule> m_rules;
+    std::map<int, double> m_courtRates;
+    std::map<int, std::shared_ptr<const PriceTable>> m_tables;
+    std::shared_ptr<const PriceTable> m_defaultTable;
+};
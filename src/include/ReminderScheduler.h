@@ -0,0 +1,58 @@
+#pragma once
+#include "Booking.h"
+#include "TimerWheel.h"
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Keeps one reminder per active upcoming booking on a timer wheel and
+// hands each due booking to a callback from a background thread that
+// ticks once per second. The wheel stores booking snapshots, so the
+// thread never reads the live bookings.
+class ReminderScheduler
+{
+public:
+    static const std::time_t REMINDER_LEAD_SECONDS = 60 * 60; // One hour before start
+
+    using ReminderCallback = std::function<void(const Booking &)>;
+
+    ReminderScheduler();
+    ~ReminderScheduler();
+
+    ReminderScheduler(const ReminderScheduler &) = delete;
+    ReminderScheduler &operator=(const ReminderScheduler &) = delete;
+
+    void start(ReminderCallback callback);
+    void stop();
+
+    // Schedules, moves or drops the reminder to match the booking's current state
+    void update(const Booking &booking);
+    void cancel(int bookingId);
+
+    // Replaces every reminder; bookings should be ordered by start time
+    void rebuild(const std::vector<const Booking *> &bookings);
+
+    size_t getPendingCount() const;
+
+    // Fires what is due at 'now'; the thread calls this every second
+    void tick(std::time_t now);
+
+private:
+    void run();
+    bool shouldRemind(const Booking &booking, std::time_t now) const;
+
+    mutable std::mutex m_mutex;
+    TimerWheel m_wheel;
+    std::unordered_map<int, Booking> m_bookings; // Snapshot per pending reminder
+    ReminderCallback m_callback;
+
+    std::thread m_thread;
+    std::atomic<bool> m_running;
+    std::mutex m_wakeMutex;
+    std::condition_variable m_wake;
+};
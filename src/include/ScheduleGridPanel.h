@@ -0,0 +1,118 @@
+#pragma once
+#include <wx/wx.h>
+#include <wx/grid.h>
+#include <wx/datectrl.h>
+#include <wx/dateevt.h>
+#include "OccupancyMap.h"
+#include <ctime>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Forward declarations
+class BookingController;
+class CourtController;
+
+// Courts x hours table for one week. Cells carry no text; the renderer asks
+// for the 5-minute occupancy of the hour, and day bitmaps are fetched only
+// when a visible cell first needs them.
+class ScheduleGridTable : public wxGridTableBase
+{
+public:
+    static const int FIRST_HOUR = 6;  // Business hours shown per day
+    static const int LAST_HOUR = 23;
+    static const int HOURS_PER_DAY = LAST_HOUR - FIRST_HOUR;
+    static const int DAYS_PER_WEEK = 7;
+
+    explicit ScheduleGridTable(BookingController *bookingController);
+
+    void SetCourts(const std::vector<std::pair<int, wxString>> &courts);
+    void SetWeekStart(const wxDateTime &weekStart);
+    void InvalidateCache() { m_dayCache.clear(); }
+
+    // Occupied 5-minute slots within the cell's hour, bit 0 = first slot
+    uint16_t GetHourMask(int row, int col) const;
+    bool IsFirstHourOfDay(int col) const { return col % HOURS_PER_DAY == 0; }
+    int GetDayOfColumn(int col) const { return col / HOURS_PER_DAY; }
+    std::time_t GetHourEnd(int col) const;
+
+    // wxGridTableBase
+    int GetNumberRows() override { return static_cast<int>(m_courts.size()); }
+    int GetNumberCols() override { return DAYS_PER_WEEK * HOURS_PER_DAY; }
+    bool IsEmptyCell(int row, int col) override { return false; }
+    wxString GetValue(int row, int col) override { return wxEmptyString; }
+    void SetValue(int row, int col, const wxString &value) override {}
+    wxString GetRowLabelValue(int row) override;
+    wxString GetColLabelValue(int col) override;
+
+private:
+    BookingController *m_bookingController;
+    std::vector<std::pair<int, wxString>> m_courts; // Court id, label
+    wxDateTime m_days[DAYS_PER_WEEK];
+    // Local hour boundaries per day, as times and as slots from midnight
+    std::time_t m_hourStarts[DAYS_PER_WEEK][HOURS_PER_DAY + 1];
+    int m_hourSlots[DAYS_PER_WEEK][HOURS_PER_DAY + 1];
+    mutable std::unordered_map<uint64_t, OccupancyMap::DayBits> m_dayCache; // Key: row, day
+};
+
+// Paints the booked spans of one hour cell at 5-minute resolution
+class ScheduleSpanRenderer : public wxGridCellRenderer
+{
+public:
+    void Draw(wxGrid &grid, wxGridCellAttr &attr, wxDC &dc, const wxRect &rect,
+              int row, int col, bool isSelected) override;
+    wxSize GetBestSize(wxGrid &grid, wxGridCellAttr &attr, wxDC &dc, int row, int col) override;
+    wxGridCellRenderer *Clone() const override { return new ScheduleSpanRenderer; }
+};
+
+class ScheduleGridPanel : public wxPanel
+{
+public:
+    ScheduleGridPanel(wxWindow *parent,
+                      BookingController *bookingController,
+                      CourtController *courtController);
+    ~ScheduleGridPanel();
+
+    void RefreshData();
+
+private:
+    // UI Creation
+    void CreateUI();
+    void CreateControls();
+    void CreateGrid();
+
+    // Event handlers
+    void OnWeekChanged(wxDateEvent &event);
+    void OnPreviousWeek(wxCommandEvent &event);
+    void OnNextWeek(wxCommandEvent &event);
+    void OnThisWeek(wxCommandEvent &event);
+    void OnRefresh(wxCommandEvent &event);
+
+    // Helper methods
+    void ShowWeek(const wxDateTime &date);
+    void UpdateRowCount(int oldRows);
+
+    // Member variables
+    BookingController *m_bookingController;
+    CourtController *m_courtController;
+
+    // UI Controls
+    wxBoxSizer *m_mainSizer;
+    wxDatePickerCtrl *m_weekPicker;
+    wxStaticText *m_weekLabel;
+    wxGrid *m_grid;
+    ScheduleGridTable *m_table; // Owned by m_grid
+
+    // Event IDs
+    enum
+    {
+        ID_WEEK_PICKER = 8000,
+        ID_PREV_WEEK,
+        ID_NEXT_WEEK,
+        ID_THIS_WEEK,
+        ID_REFRESH_SCHEDULE
+    };
+
+    wxDECLARE_EVENT_TABLE();
+};
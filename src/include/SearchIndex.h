@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// In-memory trigram index for partial-text lookups over short fields
+// (names, emails, phone numbers, booking notes).
+// Terms of three or more characters match anywhere inside a field; shorter
+// terms match the start of a word. Every query term must match (AND).
+class SearchIndex
+{
+public:
+    struct Result
+    {
+        int docId;
+        int score;
+    };
+
+private:
+    struct Document
+    {
+        int docId = 0;
+        bool live = false;
+        std::vector<std::string> fields; // Normalized field text
+        std::vector<uint32_t> grams;     // Sorted, unique
+    };
+
+    // Documents live in dense slots so verification walks contiguous memory;
+    // posting lists hold slot numbers in ascending order
+    std::vector<int> m_fieldWeights;
+    std::vector<Document> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    std::unordered_map<int, uint32_t> m_slotById;
+    std::unordered_map<uint32_t, std::vector<uint32_t>> m_postings;
+
+public:
+    // Field weights are given in the order fields are passed to addDocument
+    explicit SearchIndex(std::vector<int> fieldWeights = {1});
+
+    // Index maintenance (adding an existing id replaces it)
+    void clear();
+    void addDocument(int docId, const std::vector<std::string> &fields);
+    void removeDocument(int docId);
+    size_t size() const { return m_slotById.size(); }
+
+    // Ranked search, best match first; limit 0 returns every match
+    std::vector<Result> search(const std::string &query, size_t limit = 0) const;
+
+    // Sorted ids of all matching documents, for combining with other filters
+    std::vector<int> searchIds(const std::string &query) const;
+
+    // Lower-case ASCII and collapse whitespace; other bytes pass through
+    static std::string normalize(const std::string &text);
+
+private:
+    std::vector<uint32_t> matchCandidates(const std::vector<std::string> &terms) const;
+    int scoreDocument(const Document &document, const std::vector<std::string> &terms) const;
+    static void collectGrams(const std::string &field, std::vector<uint32_t> &grams);
+    static std::vector<uint32_t> queryGrams(const std::string &term);
+    static std::vector<std::string> splitTerms(const std::string &query);
+};
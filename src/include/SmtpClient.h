@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+#include <string>
+
+// Minimal blocking SMTP client for the notification outbox.
+// One connection is kept open across messages; there is no TLS, so it is
+// meant for a local relay or test sink rather than a public mail server.
+class SmtpClient
+{
+public:
+    SmtpClient();
+    ~SmtpClient();
+
+    SmtpClient(const SmtpClient &) = delete;
+    SmtpClient &operator=(const SmtpClient &) = delete;
+
+    bool connect(const std::string &host, int port, int timeoutSeconds = 10);
+    bool hello(const std::string &clientName);
+    bool login(const std::string &username, const std::string &password); // AUTH PLAIN
+    bool sendMail(const std::string &from, const std::string &to,
+                  const std::string &subject, const std::string &body);
+    bool reset(); // RSET after a rejected message
+    void quit();
+    void close();
+
+    bool isConnected() const { return m_socket != INVALID_HANDLE; }
+    int getLastReplyCode() const { return m_lastReplyCode; }
+    const std::string &getLastError() const { return m_lastError; }
+
+    // 5xx replies mean the message will never be accepted as it is
+    bool isPermanentFailure() const { return m_lastReplyCode >= 500 && m_lastReplyCode < 600; }
+
+private:
+    static const intptr_t INVALID_HANDLE = -1;
+
+    bool command(const std::string &line, int expectedCode, int alternateCode = 0);
+    bool readReply();
+    bool sendAll(const std::string &data);
+    bool fail(const std::string &message);
+    static std::string encodeBase64(const std::string &data);
+
+    intptr_t m_socket;
+    std::string m_buffer; // Received bytes not yet consumed
+    int m_lastReplyCode;
+    std::string m_lastReply;
+    std::string m_lastError;
+};
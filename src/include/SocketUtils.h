@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Thin portable wrappers over BSD sockets and Winsock for the booking
+// server and client. Handles are intptr_t so Winsock SOCKETs fit.
+//
+// Addresses are "host:port" for TCP or "unix:/path/to/socket" for a Unix
+// domain socket (not on Windows).
+class SocketUtils
+{
+public:
+    static const intptr_t INVALID_HANDLE = -1;
+
+    static void initialize(); // Once per process; needed on Windows only
+    static void close(intptr_t socket);
+    static bool setNonBlocking(intptr_t socket);
+    static void setNoDelay(intptr_t socket); // TCP only; harmless elsewhere
+
+    static intptr_t listenOn(const std::string &address, std::string &error);
+    static intptr_t connectTo(const std::string &address, int timeoutSeconds, std::string &error);
+    static intptr_t acceptClient(intptr_t listener);
+
+    // Bytes moved, 0 if the call would block, -1 on error or (receive) peer close
+    static long sendSome(intptr_t socket, const char *data, size_t size);
+    static long receiveSome(intptr_t socket, char *buffer, size_t size);
+
+    // Blocking helpers for client sockets
+    static bool sendAll(intptr_t socket, const char *data, size_t size);
+    static bool receiveAll(intptr_t socket, char *buffer, size_t size);
+
+    // Connected pair used to wake a thread blocked in poll/epoll
+    static bool createWakeupPair(intptr_t &readEnd, intptr_t &writeEnd);
+
+private:
+    SocketUtils() = default; // Utility class, no instances
+};
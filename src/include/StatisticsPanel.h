@@ -62,7 +62,6 @@ private:
     void CalculateSummary();
 
     // Helper methods
-    wxString FormatCurrency(double amount);
     wxString FormatDuration(int hours);
 
     DECLARE_EVENT_TABLE()
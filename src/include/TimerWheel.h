@@ -0,0 +1,53 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Hierarchical timer wheel keyed by integer ids.
+// Level 0 has one slot per tick; each higher level covers 64 times the span
+// of the one below and is cascaded down as time reaches it. Timers live in
+// intrusive lists inside a node pool, so schedule and cancel are O(1) and an
+// advance of one tick touches only the slots that are due.
+class TimerWheel
+{
+public:
+    static const int SLOT_BITS = 6;
+    static const int SLOTS_PER_LEVEL = 1 << SLOT_BITS;
+    static const int LEVELS = 5; // 64^5 ticks, about 34 years at one tick per second
+
+    explicit TimerWheel(int64_t currentTick = 0);
+
+    // Replaces any timer already scheduled for the id; past ticks fire on the next advance
+    void schedule(int id, int64_t expiryTick);
+    bool cancel(int id);
+    void clear(int64_t currentTick);
+
+    // Moves time forward and appends the ids that expired, in expiry order
+    void advance(int64_t nowTick, std::vector<int> &expired);
+
+    bool contains(int id) const { return m_nodeById.count(id) != 0; }
+    size_t size() const { return m_nodeById.size(); }
+    int64_t getCurrentTick() const { return m_currentTick; }
+
+private:
+    struct Node
+    {
+        int id;
+        int64_t expiry;
+        int prev;
+        int next;
+        int slot; // Index into m_heads, -1 while free
+    };
+
+    void link(int nodeIndex);
+    void unlink(int nodeIndex);
+    int allocateNode();
+    void cascade(int level);
+
+    int64_t m_currentTick;
+    std::vector<Node> m_nodes;
+    std::vector<int> m_freeNodes;
+    std::unordered_map<int, int> m_nodeById;
+    int m_heads[LEVELS * SLOTS_PER_LEVEL]; // List head per slot, -1 when empty
+};
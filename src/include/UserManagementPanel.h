@@ -7,6 +7,7 @@
 #include <wx/sizer.h>
 #include <wx/statbox.h>
 #include <wx/choice.h>
+#include <wx/timer.h>
 
 class AuthController;
 
@@ -17,7 +18,9 @@ enum
     ID_DELETE_USER,
     ID_CHANGE_ROLE,
     ID_TOGGLE_STATUS,
-    ID_ROLE_CHOICE
+    ID_ROLE_CHOICE,
+    ID_USER_SEARCH,
+    ID_USER_SEARCH_TIMER
 };
 
 class UserManagementPanel : public wxPanel
@@ -38,6 +41,8 @@ private:
     void OnChangeRole(wxCommandEvent &event);
     void OnToggleStatus(wxCommandEvent &event);
     void OnUserSelected(wxListEvent &event);
+    void OnSearchText(wxCommandEvent &event);
+    void OnSearchTimer(wxTimerEvent &event);
 
     // Helper methods
     void RefreshUserList();
@@ -50,6 +55,7 @@ private:
     wxStaticBoxSizer *m_actionsSizer;
 
     wxListCtrl *m_userList;
+    wxTextCtrl *m_searchCtrl;
     wxButton *m_refreshBtn;
     wxButton *m_deleteBtn;
     wxButton *m_changeRoleBtn;
@@ -61,6 +67,7 @@ private:
 
     // State
     int m_selectedUserId;
+    wxTimer m_searchTimer; // Debounces typing in the search box
 
     wxDECLARE_EVENT_TABLE();
 };
@@ -0,0 +1,49 @@
+#pragma once
+#include "IntervalSet.h"
+#include <ctime>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+// A customer waiting for an interval that was taken when they asked for it
+struct WaitlistEntry
+{
+    int id = 0; // Lower ids joined earlier
+    int userId = 0;
+    int courtId = 0;
+    std::time_t startTime = 0;
+    std::time_t endTime = 0;
+    double amount = 0.0; // Priced when joining
+    std::string notes;
+    bool autoBook = true; // Book it when it frees up; otherwise hold it and offer it
+};
+
+// Waiting requests indexed by requested interval within each court and local
+// day, so a freed interval finds the requests it touches in O(log n) plus the
+// matches, however many customers wait on other courts and days.
+class Waitlist
+{
+private:
+    std::map<int, WaitlistEntry> m_entries;                  // By id
+    std::map<std::pair<int, int>, IntervalSet> m_byCourtDay; // (courtId, day key of start) -> requests
+    int m_nextId = 1;
+
+public:
+    void clear();
+
+    int add(WaitlistEntry entry); // Assigns and returns the id
+    void restore(const WaitlistEntry &entry); // Keeps the entry's id, e.g. when loading
+    bool remove(int entryId);
+    bool get(int entryId, WaitlistEntry &entry) const;
+    size_t removeStarted(std::time_t now); // Requests nobody can play any more
+
+    // Requests on the court overlapping [startTime, endTime), earliest joined first
+    std::vector<WaitlistEntry> findOverlapping(int courtId, std::time_t startTime, std::time_t endTime) const;
+    std::vector<WaitlistEntry> getUserEntries(int userId) const;
+    const std::map<int, WaitlistEntry> &getEntries() const { return m_entries; }
+    size_t size() const { return m_entries.size(); }
+
+private:
+    static std::pair<int, int> keyOf(const WaitlistEntry &entry);
+};
@@ -10,11 +10,116 @@
 #include "BookingController.h"
 #include "BookingManager.h"
 #include "NotificationObserver.h"
+#include "NotificationOutbox.h"
+#include "BookingServer.h"
+#include "BookingClient.h"
+#include "BookingReplica.h"
+#include "ChangeFeed.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstring>
+#include <iostream>
 #include <memory>
 #include <fstream>
+#include <thread>
 #include <vector>
 
-wxIMPLEMENT_APP(BadmintonApp);
+wxIMPLEMENT_APP_NO_MAIN(BadmintonApp);
+
+namespace
+{
+    const char DEFAULT_SERVER_ADDRESS[] = "127.0.0.1:7878";
+    const int CONNECT_TIMEOUT_MS = 10000;
+
+    std::string g_connectAddress; // Set by --connect; empty runs on local data
+
+    std::atomic<bool> g_stopServer(false);
+
+    void RequestServerStop(int)
+    {
+        g_stopServer = true;
+    }
+
+    // Headless mode: hosts the controllers for front desks that connect with
+    // BookingClient, without creating any window
+    int RunServer(const std::string &address)
+    {
+        // Declared first so it outlives everything that publishes to it
+        ChangeFeed changeFeed;
+
+        AuthController authController;
+        CourtController courtController;
+        BookingController bookingController;
+
+        BookingManager &bookingManager = BookingManager::getInstance();
+        bookingManager.loadBookings();
+
+        NotificationOutbox outbox("data/outbox.log");
+        outbox.start();
+
+        EmailNotificationObserver emailObserver("localhost", 1025, "", "");
+        emailObserver.setRecipientResolver([&authController](int userId, NotificationRecipient &recipient)
+                                           {
+                                               return authController.getUserContact(userId, recipient.fullName, recipient.email,
+                                                                                    recipient.phoneNumber);
+                                           });
+        emailObserver.setOutbox(&outbox);
+        bookingManager.addObserver(&emailObserver);
+
+        bookingManager.setChangeFeed(&changeFeed);
+        courtController.setChangeFeed(&changeFeed);
+        authController.setChangeFeed(&changeFeed);
+
+        BookingServer server(bookingController, courtController);
+        server.setChangeFeed(&changeFeed);
+        if (!server.start(address))
+        {
+            std::cerr << "Cannot start booking server: " << server.getLastError() << std::endl;
+            bookingManager.setChangeFeed(nullptr);
+            bookingManager.shutdownNotifications();
+            outbox.stop();
+            return 1;
+        }
+        std::cout << "Booking server listening on " << address << std::endl;
+
+        std::signal(SIGINT, RequestServerStop);
+        std::signal(SIGTERM, RequestServerStop);
+        while (!g_stopServer)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        }
+
+        std::cout << "Stopping booking server after " << server.getRequestCount() << " requests" << std::endl;
+        server.stop();
+        bookingManager.setChangeFeed(nullptr);
+        bookingManager.saveBookings();
+        bookingManager.shutdownNotifications();
+        outbox.stop();
+        return 0;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    // --server [address] runs without a GUI, e.g. --server unix:/tmp/badminton.sock;
+    // --connect [address] runs the GUI as a thin client of such a server
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasAddress = i + 1 < argc && argv[i + 1][0] != '-';
+        if (std::strcmp(argv[i], "--server") == 0)
+        {
+            return RunServer(hasAddress ? argv[i + 1] : DEFAULT_SERVER_ADDRESS);
+        }
+        if (std::strcmp(argv[i], "--connect") == 0)
+        {
+            g_connectAddress = hasAddress ? argv[i + 1] : DEFAULT_SERVER_ADDRESS;
+            BookingManager::useRemoteStore();
+        }
+    }
+
+    return wxEntry(argc, argv);
+}
 
 bool BadmintonApp::OnInit()
 {
@@ -29,6 +134,11 @@ bool BadmintonApp::OnInit()
     // Setup notification system
     SetupNotifications();
 
+    if (!g_connectAddress.empty() && !ConnectToServer(g_connectAddress))
+    {
+        return false;
+    }
+
     // Load initial data
     LoadInitialData();
 
@@ -51,8 +161,20 @@ int BadmintonApp::OnExit()
         m_courtController->saveCourts();
     }
 
-    // Save bookings through BookingManager
-    BookingManager::getInstance().saveBookings();
+    // Save bookings through BookingManager; a thin client has none of its own
+    if (!m_bookingClient)
+    {
+        BookingManager::getInstance().saveBookings();
+    }
+
+    // Deliver queued notifications before the observers are deleted
+    BookingManager::getInstance().shutdownNotifications();
+
+    // Undelivered messages stay in the outbox log for the next start
+    if (m_outbox)
+    {
+        m_outbox->stop();
+    }
 
     return wxApp::OnExit();
 }
@@ -66,9 +188,22 @@ void BadmintonApp::InitializeControllers()
 
 void BadmintonApp::SetupNotifications()
 {
-    // Create notification observers
-    m_emailObserver = new EmailNotificationObserver(
-        "smtp.gmail.com", 587, "your-email@gmail.com", "your-password");
+    // Outgoing email/SMS are queued in a durable outbox and delivered in the background
+    m_outbox = new NotificationOutbox("data/outbox.log");
+    m_outbox->start();
+
+    // Observers run on worker threads, so they resolve contacts through the thread-safe lookup
+    AuthController *authController = m_authController;
+    RecipientResolver resolveRecipient = [authController](int userId, NotificationRecipient &recipient)
+    {
+        return authController->getUserContact(userId, recipient.fullName, recipient.email,
+                                              recipient.phoneNumber);
+    };
+
+    // Create notification observers (plain SMTP, e.g. a local relay or test sink)
+    m_emailObserver = new EmailNotificationObserver("localhost", 1025, "", "");
+    m_emailObserver->setRecipientResolver(resolveRecipient);
+    m_emailObserver->setOutbox(m_outbox);
 
     m_inAppObserver = new InAppNotificationObserver(100);
 
@@ -78,8 +213,33 @@ void BadmintonApp::SetupNotifications()
     bookingManager.addObserver(m_inAppObserver);
 }
 
+bool BadmintonApp::ConnectToServer(const std::string &address)
+{
+    // Bookings and courts come from the server; the replica keeps the panels' copy current
+    m_bookingClient = new BookingClient();
+    m_bookingReplica = new BookingReplica();
+    m_bookingReplica->start(address);
+    if (!m_bookingClient->connect(address) || !m_bookingReplica->waitUntilSynced(CONNECT_TIMEOUT_MS))
+    {
+        std::string error = m_bookingClient->isConnected() ? m_bookingReplica->getLastError()
+                                                           : m_bookingClient->getLastError();
+        wxMessageBox(wxString::Format("Cannot connect to booking server %s: %s", address, error),
+                     "Error", wxOK | wxICON_ERROR);
+        return false;
+    }
+
+    m_courtController->mirrorCourts(m_bookingReplica->getCourts());
+    m_bookingController->setRemote(m_bookingClient, m_bookingReplica);
+    return true;
+}
+
 void BadmintonApp::LoadInitialData()
 {
+    if (m_bookingClient)
+    {
+        return; // Everything but sign-in is on the server
+    }
+
     // Load data from files/database (courts are already loaded in CourtController constructor)
     BookingManager::getInstance().loadBookings();
 
@@ -156,6 +316,25 @@ BadmintonApp::~BadmintonApp()
         m_inAppObserver = nullptr;
     }
 
+    if (m_outbox)
+    {
+        delete m_outbox;
+        m_outbox = nullptr;
+    }
+
+    // Stop following the server before the controllers that read the replica go
+    if (m_bookingReplica)
+    {
+        delete m_bookingReplica;
+        m_bookingReplica = nullptr;
+    }
+
+    if (m_bookingClient)
+    {
+        delete m_bookingClient;
+        m_bookingClient = nullptr;
+    }
+
     // Clean up controllers
     if (m_authController)
     {
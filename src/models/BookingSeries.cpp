@@ -0,0 +1,150 @@
+#include "BookingSeries.h"
+#include "DateTimeUtils.h"
+#include <algorithm>
+
+BookingSeries::BookingSeries()
+    : m_id(0), m_userId(0), m_courtId(0), m_firstDay(0), m_lastDay(-1), m_intervalDays(7),
+      m_startSecond(0), m_durationSeconds(0), m_amount(0.0) {}
+
+void BookingSeries::setDays(int firstDay, int lastDay, int intervalDays)
+{
+    m_firstDay = firstDay;
+    m_lastDay = lastDay;
+    m_intervalDays = std::max(1, intervalDays);
+}
+
+void BookingSeries::setTimeBand(int startSecond, int durationSeconds)
+{
+    m_startSecond = startSecond;
+    m_durationSeconds = durationSeconds;
+}
+
+void BookingSeries::setDayAmount(int dayKey, double amount)
+{
+    if (amount == m_amount)
+    {
+        m_dayAmounts.erase(dayKey);
+    }
+    else
+    {
+        m_dayAmounts[dayKey] = amount;
+    }
+}
+
+double BookingSeries::getAmountOn(int dayKey) const
+{
+    auto it = m_dayAmounts.find(dayKey);
+    return it == m_dayAmounts.end() ? m_amount : it->second;
+}
+
+void BookingSeries::skipDay(int dayKey)
+{
+    auto it = std::lower_bound(m_skippedDays.begin(), m_skippedDays.end(), dayKey);
+    if (it == m_skippedDays.end() || *it != dayKey)
+    {
+        m_skippedDays.insert(it, dayKey);
+    }
+}
+
+bool BookingSeries::occursOn(int dayKey) const
+{
+    return dayKey >= m_firstDay && dayKey <= m_lastDay && (dayKey - m_firstDay) % m_intervalDays == 0 &&
+           !std::binary_search(m_skippedDays.begin(), m_skippedDays.end(), dayKey);
+}
+
+bool BookingSeries::getOccurrence(std::time_t dayStart, std::time_t &start, std::time_t &end) const
+{
+    if (!occursOn(DateTimeUtils::getDayKey(dayStart)))
+        return false;
+
+    start = DateTimeUtils::getTimeOnDay(dayStart, m_startSecond / 3600, m_startSecond / 60 % 60) + m_startSecond % 60;
+    end = start + m_durationSeconds;
+    return true;
+}
+
+std::vector<std::pair<std::time_t, std::time_t>> BookingSeries::getOccurrences(std::time_t from, std::time_t to) const
+{
+    std::vector<std::pair<std::time_t, std::time_t>> occurrences;
+    if (from >= to || m_durationSeconds <= 0)
+        return occurrences;
+
+    int lastKey = std::min(m_lastDay, DateTimeUtils::getDayKey(to - 1));
+
+    // Jump straight to the first day of the rhythm inside the window
+    int dayKey = std::max(m_firstDay, DateTimeUtils::getDayKey(from));
+    dayKey += (m_intervalDays - (dayKey - m_firstDay) % m_intervalDays) % m_intervalDays;
+    for (; dayKey <= lastKey; dayKey += m_intervalDays)
+    {
+        std::time_t start, end;
+        if (getOccurrence(DateTimeUtils::getDayStart(dayKey), start, end) && start >= from && start < to)
+        {
+            occurrences.push_back(std::make_pair(start, end));
+        }
+    }
+    return occurrences;
+}
+
+bool BookingSeries::overlaps(std::time_t start, std::time_t end) const
+{
+    // Only occurrences starting less than one duration before 'start' can reach it
+    for (const auto &occurrence : getOccurrences(start - m_durationSeconds + 1, end))
+    {
+        if (occurrence.second > start)
+            return true;
+    }
+    return false;
+}
+
+std::vector<std::pair<std::time_t, std::time_t>> BookingSeries::getAllOccurrences() const
+{
+    if (m_lastDay < m_firstDay)
+        return std::vector<std::pair<std::time_t, std::time_t>>();
+
+    return getOccurrences(DateTimeUtils::getDayStart(m_firstDay), DateTimeUtils::getDayStart(m_lastDay + 1));
+}
+
+int BookingSeries::getOccurrenceCount() const
+{
+    if (m_lastDay < m_firstDay)
+        return 0;
+
+    int count = (m_lastDay - m_firstDay) / m_intervalDays + 1;
+    for (int dayKey : m_skippedDays)
+    {
+        if (dayKey >= m_firstDay && dayKey <= m_lastDay && (dayKey - m_firstDay) % m_intervalDays == 0)
+            --count;
+    }
+    return count;
+}
+
+bool BookingSeries::getNextOccurrence(std::time_t after, std::time_t &start, std::time_t &end) const
+{
+    int dayKey = std::max(m_firstDay, DateTimeUtils::getDayKey(after));
+    dayKey += (m_intervalDays - (dayKey - m_firstDay) % m_intervalDays) % m_intervalDays;
+    for (; dayKey <= m_lastDay; dayKey += m_intervalDays)
+    {
+        if (getOccurrence(DateTimeUtils::getDayStart(dayKey), start, end) && start > after)
+            return true;
+    }
+    return false;
+}
+
+int BookingSeries::getOccurrenceId(int dayKey) const
+{
+    return FIRST_OCCURRENCE_ID + m_id * MAX_OCCURRENCES + (dayKey - m_firstDay) / m_intervalDays;
+}
+
+int BookingSeries::getOccurrenceDay(int occurrenceId) const
+{
+    return m_firstDay + (occurrenceId - FIRST_OCCURRENCE_ID) % MAX_OCCURRENCES * m_intervalDays;
+}
+
+Booking BookingSeries::toBooking(std::time_t start, std::time_t end) const
+{
+    int dayKey = DateTimeUtils::getDayKey(start);
+    Booking booking(m_userId, m_courtId, DateTimeUtils::getStartOfDay(start), start, end, getAmountOn(dayKey));
+    booking.setId(getOccurrenceId(dayKey));
+    booking.setStatus(BookingStatus::CONFIRMED);
+    booking.setNotes(m_notes);
+    return booking;
+}
@@ -1,4 +1,5 @@
 #include "Statistics.h"
+#include "DateTimeUtils.h"
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
@@ -144,7 +145,7 @@ std::string Statistics::exportToCSV(std::time_t startDate, std::time_t endDate)
     auto dailyStats = getDailyStats(startDate, endDate);
     for (const auto &stats : dailyStats)
     {
-        csv << std::put_time(std::localtime(&stats.date), "%Y-%m-%d") << ","
+        csv << DateTimeUtils::formatDate(stats.date) << ","
             << stats.bookingCount << ","
             << std::fixed << std::setprecision(2) << stats.revenue << "\n";
     }
@@ -159,8 +160,8 @@ std::string Statistics::generateReport(std::time_t startDate, std::time_t endDat
     auto bookingStats = calculateBookingStats(startDate, endDate);
 
     report << "=== Badminton Court Statistics Report ===\n\n";
-    report << "Period: " << std::put_time(std::localtime(&startDate), "%Y-%m-%d")
-           << " to " << std::put_time(std::localtime(&endDate), "%Y-%m-%d") << "\n\n";
+    report << "Period: " << DateTimeUtils::formatDate(startDate)
+           << " to " << DateTimeUtils::formatDate(endDate) << "\n\n";
 
     report << "Total Bookings: " << bookingStats.totalBookings << "\n";
     report << "Total Revenue: $" << std::fixed << std::setprecision(2)
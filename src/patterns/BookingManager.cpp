@@ -1,21 +1,37 @@
 #include "BookingManager.h"
+#include "DateTimeUtils.h"
 #include <algorithm>
+#include <chrono>
+#include <climits>
 #include <filesystem>
 #include <fstream>
+#include <iterator>
+#include <queue>
 #include <sstream>
 
 BookingManager* BookingManager::m_instance = nullptr;
 std::mutex BookingManager::m_mutex;
+bool BookingManager::m_remoteStore = false;
 
 BookingManager::~BookingManager()
 {
-    // Clean up all bookings
-    for (Booking* booking : m_bookings)
+    // The sweeper can place waitlist holds, so it stops before the hold thread
+    if (m_sweepRunning.exchange(false))
     {
-        delete booking;
+        m_sweepWake.notify_one();
+        m_sweepThread.join();
+    }
+    if (m_holdsRunning.exchange(false))
+    {
+        m_holdWake.notify_one();
+        m_holdThread.join();
     }
     m_bookings.clear();
-    
+
+    // Stop delivery before the observers go away
+    m_reminders.stop();
+    m_dispatcher.shutdown();
+
     // Clean up all observers
     for (NotificationObserver* observer : m_observers)
     {
@@ -30,11 +46,22 @@ BookingManager &BookingManager::getInstance()
     if (m_instance == nullptr)
     {
         m_instance = new BookingManager();
-        m_instance->loadBookings(); // Load data on first instantiation
+        if (!m_remoteStore)
+        {
+            m_instance->loadBookings(); // Load data on first instantiation
+            m_instance->startReminders();
+            m_instance->startSweeper();
+        }
     }
     return *m_instance;
 }
 
+void BookingManager::useRemoteStore()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_remoteStore = true;
+}
+
 void BookingManager::cleanup()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -52,378 +79,1682 @@ bool BookingManager::createBooking(const Booking &booking)
         return false;
     }
 
-    if (hasConflict(booking))
+    BookingEvent event;
+    event.type = BookingEventType::CREATED;
+    uint64_t version;
     {
-        return false;
-    }
-
-    // Create a copy and assign ID, preserve status
-    Booking* newBooking = new Booking(booking);
-    generateBookingId(*newBooking);
-    // Ensure the status from the original booking is preserved
-    newBooking->setStatus(booking.getStatus());
-
-    // Add to bookings
-    m_bookings.push_back(newBooking);
+        CourtStripe &stripe = stripeFor(booking.getCourtId());
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        IntervalSet &active = stripe.activeByCourt[booking.getCourtId()];
+        if (active.overlaps(booking.getStartTime(), booking.getEndTime()) ||
+            findSeriesConflict(stripe, booking.getCourtId(), booking.getStartTime(), booking.getEndTime()) != 0)
+        {
+            return false;
+        }
 
-    // Sort by date
-    sortBookingsByDate();
+        // Create a copy and assign ID, preserve status
+        auto newBooking = std::make_shared<Booking>(booking);
+        generateBookingId(*newBooking);
+        // Ensure the status from the original booking is preserved
+        newBooking->setStatus(booking.getStatus());
+        if (newBooking->isActive())
+        {
+            active.insert(newBooking->getId(), newBooking->getStartTime(), newBooking->getEndTime());
+        }
 
-    // Save changes immediately
-    saveBookings();
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        insertBooking(newBooking);
+        version = commit();
+        recordChange(ChangeType::BOOKING_CREATED, newBooking);
+        event.booking = *newBooking;
+    }
 
-    // Notify observers
-    notifyObservers("Booking created", *newBooking);
+    // Save changes immediately, then notify observers
+    persist(version);
+    notifyObservers(event);
 
     return true;
 }
 
 bool BookingManager::cancelBooking(int bookingId)
 {
-    auto it = std::find_if(m_bookings.begin(), m_bookings.end(),
-                           [bookingId](const Booking* booking)
-                           {
-                               return booking->getId() == bookingId;
-                           });
+    BookingPtr current = getBooking(bookingId);
+    if (!current)
+    {
+        return false;
+    }
+    if (BookingSeries::isOccurrenceId(bookingId))
+    {
+        return skipSeriesOccurrence(BookingSeries::getSeriesIdOf(bookingId), current->getStartTime());
+    }
 
-    if (it != m_bookings.end())
+    BookingEvent event;
+    event.type = BookingEventType::CANCELLED;
+    uint64_t version;
     {
-        (*it)->setStatus(BookingStatus::CANCELLED);
-        saveBookings(); // Save changes immediately
-        notifyObservers("Booking cancelled", **it);
-        return true;
+        // Writes to a booking hold its court's stripe, so 'current' cannot go stale below
+        CourtStripe &stripe = stripeFor(current->getCourtId());
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        current = getBooking(bookingId);
+        if (!current)
+        {
+            return false;
+        }
+        stripe.activeByCourt[current->getCourtId()].erase(bookingId, current->getStartTime());
+
+        auto booking = std::make_shared<Booking>(*current);
+        booking->setStatus(BookingStatus::CANCELLED);
+
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        replaceBooking(booking);
+        refreshOccupancy(booking->getCourtId(), booking->getStartTime(), booking->getEndTime());
+        m_reminders.cancel(bookingId);
+        version = commit();
+        recordChange(ChangeType::BOOKING_CANCELLED, booking);
+        event.booking = *booking;
     }
 
-    return false;
+    persist(version); // Save changes immediately
+    notifyObservers(event);
+    serveWaitlist(event.booking.getCourtId(), event.booking.getStartTime(), event.booking.getEndTime());
+    return true;
 }
 
 bool BookingManager::modifyBooking(int bookingId, const Booking &newBooking)
 {
-    auto it = std::find_if(m_bookings.begin(), m_bookings.end(),
-                           [bookingId](const Booking* booking)
-                           {
-                               return booking->getId() == bookingId;
-                           });
+    BookingPtr current = getBooking(bookingId);
+    if (!current || BookingSeries::isOccurrenceId(bookingId))
+    {
+        return false;
+    }
 
-    if (it != m_bookings.end())
+    BookingEvent event;
+    event.type = BookingEventType::MODIFIED;
+    uint64_t version;
     {
-        Booking oldBooking = **it;
+        CourtStripe &stripe = stripeFor(current->getCourtId());
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        current = getBooking(bookingId);
+        if (!current)
+        {
+            return false;
+        }
 
-        // Update booking details
-        (*it)->setStartTime(newBooking.getStartTime());
-        (*it)->setEndTime(newBooking.getEndTime());
-        (*it)->setTotalAmount(newBooking.getTotalAmount());
-        (*it)->setNotes(newBooking.getNotes());
+        // Update booking details on a copy; the original stays untouched on conflict
+        auto booking = std::make_shared<Booking>(*current);
+        booking->setStartTime(newBooking.getStartTime());
+        booking->setEndTime(newBooking.getEndTime());
+        booking->setTotalAmount(newBooking.getTotalAmount());
+        booking->setNotes(newBooking.getNotes());
 
         // Check for conflicts with new time
-        if (hasConflict(**it))
+        IntervalSet &active = stripe.activeByCourt[current->getCourtId()];
+        if (active.overlaps(booking->getStartTime(), booking->getEndTime(), bookingId) ||
+            findSeriesConflict(stripe, booking->getCourtId(), booking->getStartTime(), booking->getEndTime()) != 0)
         {
-            // Revert changes
-            (*it)->setStartTime(oldBooking.getStartTime());
-            (*it)->setEndTime(oldBooking.getEndTime());
-            (*it)->setTotalAmount(oldBooking.getTotalAmount());
-            (*it)->setNotes(oldBooking.getNotes());
             return false;
         }
+        if (current->isActive())
+        {
+            active.erase(bookingId, current->getStartTime());
+            active.insert(bookingId, booking->getStartTime(), booking->getEndTime());
+        }
 
-        saveBookings(); // Save changes immediately
-        notifyObservers("Booking modified", **it);
-        return true;
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        replaceBooking(booking);
+        indexNotes(*booking);
+        refreshOccupancy(booking->getCourtId(), current->getStartTime(), current->getEndTime());
+        refreshOccupancy(booking->getCourtId(), booking->getStartTime(), booking->getEndTime());
+        m_reminders.update(*booking);
+        version = commit();
+        recordChange(ChangeType::BOOKING_MODIFIED, booking);
+        event.booking = *booking;
+        event.previousBooking = *current;
     }
 
-    return false;
+    persist(version); // Save changes immediately
+    notifyObservers(event);
+    serveWaitlist(event.previousBooking.getCourtId(), event.previousBooking.getStartTime(),
+                  event.previousBooking.getEndTime());
+    return true;
 }
 
-Booking* BookingManager::getBooking(int bookingId) const
+bool BookingManager::confirmBooking(int bookingId)
 {
-    auto it = std::find_if(m_bookings.begin(), m_bookings.end(),
-                           [bookingId](const Booking* booking)
-                           {
-                               return booking->getId() == bookingId;
-                           });
+    BookingPtr current = getBooking(bookingId);
+    if (!current)
+    {
+        return false;
+    }
 
-    return (it != m_bookings.end()) ? *it : nullptr;
-}
+    uint64_t version;
+    {
+        CourtStripe &stripe = stripeFor(current->getCourtId());
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        current = getBooking(bookingId);
+        if (!current || current->getStatus() != BookingStatus::PENDING)
+        {
+            return false;
+        }
 
-std::vector<Booking*> BookingManager::getBookingsByUser(int userId) const
-{
-    std::vector<Booking*> userBookings;
+        auto booking = std::make_shared<Booking>(*current);
+        booking->setStatus(BookingStatus::CONFIRMED);
 
-    std::copy_if(m_bookings.begin(), m_bookings.end(), std::back_inserter(userBookings),
-                 [userId](const Booking* booking)
-                 {
-                     return booking->getUserId() == userId;
-                 });
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        replaceBooking(booking);
+        m_reminders.update(*booking);
+        version = commit();
+        recordChange(ChangeType::BOOKING_UPDATED, booking);
+    }
 
-    return userBookings;
+    persist(version);
+    return true;
 }
 
-std::vector<Booking*> BookingManager::getBookingsByCourt(int courtId) const
+std::vector<BatchResult> BookingManager::createBookings(const std::vector<Booking> &bookings, bool allOrNothing)
 {
-    std::vector<Booking*> courtBookings;
+    std::vector<BatchResult> results(bookings.size());
+    std::vector<size_t> stripes;
+    bool failed = false;
+    for (size_t i = 0; i < bookings.size(); ++i)
+    {
+        if (!validateBooking(bookings[i]))
+        {
+            results[i].status = BatchStatus::INVALID;
+            failed = true;
+        }
+        else
+        {
+            stripes.push_back(static_cast<unsigned>(bookings[i].getCourtId()) % COURT_STRIPES);
+        }
+    }
+    if (failed && allOrNothing)
+    {
+        return results;
+    }
 
-    std::copy_if(m_bookings.begin(), m_bookings.end(), std::back_inserter(courtBookings),
-                 [courtId](const Booking* booking)
-                 {
-                     return booking->getCourtId() == courtId;
-                 });
+    // Every stripe the batch touches, in index order so batches cannot deadlock
+    std::sort(stripes.begin(), stripes.end());
+    stripes.erase(std::unique(stripes.begin(), stripes.end()), stripes.end());
+    std::vector<std::unique_lock<std::mutex>> courtLocks;
+    for (size_t stripe : stripes)
+    {
+        courtLocks.emplace_back(m_stripes[stripe].lock);
+    }
 
-    return courtBookings;
-}
+    // One pass over the batch: each entry against the court's bookings and
+    // the entries accepted before it (keyed by index + 1, as ids start at 1)
+    std::unordered_map<int, IntervalSet> accepted;
+    for (size_t i = 0; i < bookings.size(); ++i)
+    {
+        const Booking &booking = bookings[i];
+        if (results[i].status == BatchStatus::INVALID)
+        {
+            continue;
+        }
 
-std::vector<Booking*> BookingManager::getBookingsByDate(std::time_t date) const
-{
-    std::vector<Booking*> dateBookings;
+        CourtStripe &stripe = stripeFor(booking.getCourtId());
+        IntervalSet &batch = accepted[booking.getCourtId()];
+        int existing = stripe.activeByCourt[booking.getCourtId()].findOverlap(booking.getStartTime(), booking.getEndTime());
+        int series = findSeriesConflict(stripe, booking.getCourtId(), booking.getStartTime(), booking.getEndTime());
+        int earlier = batch.findOverlap(booking.getStartTime(), booking.getEndTime());
+        if (existing != 0 || series != 0 || earlier != 0)
+        {
+            results[i].status = BatchStatus::CONFLICT;
+            results[i].conflictingBookingId = std::max(existing, 0);
+            results[i].conflictingHoldId = std::max(-existing, 0); // Holds are stored negated
+            results[i].conflictingSeriesId = series;
+            results[i].conflictingIndex = earlier - 1;
+            failed = true;
+        }
+        else if (booking.isActive())
+        {
+            batch.insert(static_cast<int>(i) + 1, booking.getStartTime(), booking.getEndTime());
+        }
+    }
+    if (failed && allOrNothing)
+    {
+        return results;
+    }
 
-    std::copy_if(m_bookings.begin(), m_bookings.end(), std::back_inserter(dateBookings),
-                 [date](const Booking* booking)
-                 {
-                     // Compare dates (ignoring time)
-                     std::time_t bookingDate = booking->getBookingDate();
-                     struct tm *bookingTm = std::localtime(&bookingDate);
-                     struct tm *searchTm = std::localtime(&date);
+    std::vector<BookingPtr> created;
+    for (size_t i = 0; i < bookings.size(); ++i)
+    {
+        if (results[i].status != BatchStatus::NOT_COMMITTED)
+        {
+            continue;
+        }
 
-                     return (bookingTm->tm_year == searchTm->tm_year &&
-                             bookingTm->tm_mon == searchTm->tm_mon &&
-                             bookingTm->tm_mday == searchTm->tm_mday);
-                 });
+        auto newBooking = std::make_shared<Booking>(bookings[i]);
+        generateBookingId(*newBooking);
+        newBooking->setStatus(bookings[i].getStatus());
+        if (newBooking->isActive())
+        {
+            stripeFor(newBooking->getCourtId()).activeByCourt[newBooking->getCourtId()].insert(
+                newBooking->getId(), newBooking->getStartTime(), newBooking->getEndTime());
+        }
+        results[i].status = BatchStatus::CREATED;
+        results[i].bookingId = newBooking->getId();
+        created.push_back(newBooking);
+    }
+    if (created.empty())
+    {
+        return results;
+    }
 
-    return dateBookings;
+    std::vector<BookingPtr> ordered(created);
+    std::stable_sort(ordered.begin(), ordered.end(),
+                     [](const BookingPtr &a, const BookingPtr &b)
+                     {
+                         return a->getStartTime() < b->getStartTime();
+                     });
+    uint64_t version;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        insertBookings(ordered);
+        version = commit();
+        for (const BookingPtr &booking : created)
+        {
+            recordChange(ChangeType::BOOKING_CREATED, booking);
+        }
+    }
+    courtLocks.clear();
+
+    // One save for the whole batch, then the usual per-booking notifications
+    persist(version);
+    for (const BookingPtr &booking : created)
+    {
+        BookingEvent event;
+        event.type = BookingEventType::CREATED;
+        event.booking = *booking;
+        notifyObservers(event);
+    }
+    return results;
 }
 
-bool BookingManager::isCourtAvailable(int courtId, std::time_t startTime, std::time_t endTime) const
+int BookingManager::placeHold(int userId, int courtId, std::time_t startTime, std::time_t endTime, int ttlSeconds)
 {
-    return std::none_of(m_bookings.begin(), m_bookings.end(),
-                        [courtId, startTime, endTime](const Booking* booking)
-                        {
-                            if (booking->getCourtId() != courtId || !booking->isActive())
-                            {
-                                return false;
-                            }
+    if (userId <= 0 || courtId <= 0 || startTime >= endTime || ttlSeconds <= 0)
+    {
+        return 0;
+    }
+
+    SlotHold hold;
+    hold.userId = userId;
+    hold.courtId = courtId;
+    hold.startTime = startTime;
+    hold.endTime = endTime;
+    {
+        CourtStripe &stripe = stripeFor(courtId);
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        IntervalSet &active = stripe.activeByCourt[courtId];
+        if (active.overlaps(startTime, endTime) || findSeriesConflict(stripe, courtId, startTime, endTime) != 0)
+        {
+            return 0;
+        }
+
+        {
+            std::lock_guard<std::mutex> holdLock(m_holdLock);
+            std::time_t now = std::time(nullptr);
+            if (m_holds.empty())
+            {
+                m_holdExpiry.clear(now); // Idle wheels would otherwise replay every missed tick
+            }
+            hold.id = m_nextHoldId++;
+            hold.expiresAt = now + ttlSeconds;
+            m_holds[hold.id] = hold;
+            m_holdExpiry.schedule(hold.id, hold.expiresAt);
+        }
+        active.insert(-hold.id, startTime, endTime);
+
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        m_occupancy.addHold(hold.id, courtId, startTime, endTime);
+    }
 
-                            // Check for time overlap
-                            return !(endTime <= booking->getStartTime() || startTime >= booking->getEndTime());
-                        });
+    // Expiry runs on its own thread, started once holds are first used
+    if (!m_holdsRunning.exchange(true))
+    {
+        m_holdThread = std::thread(&BookingManager::runHoldExpiry, this);
+    }
+    return hold.id;
 }
 
-std::vector<std::pair<std::time_t, std::time_t>> BookingManager::getAvailableSlots(
-    int courtId, std::time_t date, int slotDurationMinutes) const
+bool BookingManager::extendHold(int holdId, int ttlSeconds)
 {
+    std::lock_guard<std::mutex> holdLock(m_holdLock);
+    auto it = m_holds.find(holdId);
+    std::time_t now = std::time(nullptr);
+    if (it == m_holds.end() || it->second.expiresAt <= now || ttlSeconds <= 0)
+    {
+        return false;
+    }
 
-    std::vector<std::pair<std::time_t, std::time_t>> availableSlots;
-
-    // Business hours: 6 AM to 11 PM
-    struct tm *dateTm = std::localtime(&date);
-    dateTm->tm_hour = 6;
-    dateTm->tm_min = 0;
-    dateTm->tm_sec = 0;
-    std::time_t startOfDay = std::mktime(dateTm);
+    it->second.expiresAt = now + ttlSeconds;
+    m_holdExpiry.schedule(holdId, it->second.expiresAt);
+    return true;
+}
 
-    dateTm->tm_hour = 23;
-    std::time_t endOfDay = std::mktime(dateTm);
+bool BookingManager::releaseHold(int holdId)
+{
+    return removeHold(holdId, false, 0);
+}
 
-    // Generate time slots
-    std::time_t currentSlot = startOfDay;
-    int slotDurationSeconds = slotDurationMinutes * 60;
+bool BookingManager::bookHold(int holdId, const Booking &booking)
+{
+    SlotHold hold;
+    if (!validateBooking(booking) || !getHold(holdId, hold) || booking.getUserId() != hold.userId ||
+        booking.getCourtId() != hold.courtId || booking.getStartTime() != hold.startTime ||
+        booking.getEndTime() != hold.endTime)
+    {
+        return false;
+    }
 
-    while (currentSlot + slotDurationSeconds <= endOfDay)
+    BookingEvent event;
+    event.type = BookingEventType::CREATED;
+    uint64_t version;
     {
-        std::time_t slotEnd = currentSlot + slotDurationSeconds;
+        CourtStripe &stripe = stripeFor(hold.courtId);
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        {
+            std::lock_guard<std::mutex> holdLock(m_holdLock);
+            auto it = m_holds.find(holdId);
+            if (it == m_holds.end() || it->second.expiresAt <= std::time(nullptr))
+            {
+                return false;
+            }
+            m_holds.erase(it);
+            m_holdExpiry.cancel(holdId);
+        }
 
-        if (isCourtAvailable(courtId, currentSlot, slotEnd))
+        // The hold kept the interval free, so the booking takes its place unchecked
+        auto newBooking = std::make_shared<Booking>(booking);
+        generateBookingId(*newBooking);
+        newBooking->setStatus(booking.getStatus());
+        IntervalSet &active = stripe.activeByCourt[hold.courtId];
+        active.erase(-holdId, hold.startTime);
+        if (newBooking->isActive())
         {
-            availableSlots.push_back(std::make_pair(currentSlot, slotEnd));
+            active.insert(newBooking->getId(), newBooking->getStartTime(), newBooking->getEndTime());
         }
 
-        currentSlot += slotDurationSeconds;
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        m_occupancy.removeHold(holdId, hold.courtId);
+        insertBooking(newBooking);
+        version = commit();
+        recordChange(ChangeType::BOOKING_CREATED, newBooking);
+        event.booking = *newBooking;
     }
 
-    return availableSlots;
+    persist(version);
+    notifyObservers(event);
+    return true;
 }
 
-bool BookingManager::hasConflict(const Booking &booking) const
+bool BookingManager::getHold(int holdId, SlotHold &hold) const
 {
-    return std::any_of(m_bookings.begin(), m_bookings.end(),
-                       [&booking](const Booking* existingBooking)
-                       {
-                           return existingBooking->getId() != booking.getId() &&
-                                  existingBooking->isActive() &&
-                                  existingBooking->conflictsWith(booking);
-                       });
+    std::lock_guard<std::mutex> holdLock(m_holdLock);
+    auto it = m_holds.find(holdId);
+    if (it == m_holds.end())
+        return false;
+
+    hold = it->second;
+    return true;
 }
 
-void BookingManager::addObserver(NotificationObserver* observer)
+size_t BookingManager::getHoldCount() const
 {
-    m_observers.push_back(observer);
+    std::lock_guard<std::mutex> holdLock(m_holdLock);
+    return m_holds.size();
 }
 
-void BookingManager::removeObserver(NotificationObserver* observer)
+void BookingManager::expireHolds(std::time_t now)
 {
-    m_observers.erase(
-        std::remove(m_observers.begin(), m_observers.end(), observer),
-        m_observers.end());
+    std::vector<int> expired;
+    {
+        std::lock_guard<std::mutex> holdLock(m_holdLock);
+        m_holdExpiry.advance(now, expired);
+    }
+    for (int holdId : expired)
+    {
+        removeHold(holdId, true, now);
+    }
 }
 
-void BookingManager::notifyObservers(const std::string &message, const Booking &booking)
+std::vector<SlotHold> BookingManager::getUserHolds(int userId) const
 {
-    for (auto &observer : m_observers)
+    std::vector<SlotHold> holds;
+    std::lock_guard<std::mutex> holdLock(m_holdLock);
+    for (const auto &entry : m_holds)
     {
-        if (message == "Booking created")
+        if (entry.second.userId == userId)
         {
-            observer->onBookingCreated(booking);
-        }
-        else if (message == "Booking cancelled")
-        {
-            observer->onBookingCancelled(booking);
-        }
-        else if (message == "Booking modified")
-        {
-            // For simplicity, using the same booking for old and new
-            observer->onBookingModified(booking, booking);
+            holds.push_back(entry.second);
         }
     }
+    return holds;
 }
 
-std::vector<Booking*> BookingManager::getAllBookings() const
+int BookingManager::joinWaitlist(const WaitlistEntry &entry)
 {
-    return m_bookings;
-}
-
-std::vector<Booking*> BookingManager::getBookingsInDateRange(std::time_t startDate, std::time_t endDate) const
-{
-    std::vector<Booking*> rangeBookings;
+    if (entry.userId <= 0 || entry.courtId <= 0 || entry.startTime >= entry.endTime ||
+        entry.startTime <= std::time(nullptr))
+    {
+        return 0;
+    }
 
-    std::copy_if(m_bookings.begin(), m_bookings.end(), std::back_inserter(rangeBookings),
-                 [startDate, endDate](const Booking* booking)
-                 {
-                     std::time_t bookingDate = booking->getBookingDate();
-                     return bookingDate >= startDate && bookingDate <= endDate;
-                 });
+    int entryId;
+    {
+        std::lock_guard<std::mutex> waitLock(m_waitlistLock);
+        entryId = m_waitlist.add(entry);
+        WaitlistEntry added(entry);
+        added.id = entryId;
+        logWaitlistEntry(added);
+    }
 
-    return rangeBookings;
+    // The interval may have been freed while the customer decided to wait
+    serveWaitlist(entry.courtId, entry.startTime, entry.endTime);
+    return entryId;
 }
 
-double BookingManager::getTotalRevenue(std::time_t startDate, std::time_t endDate) const
+bool BookingManager::leaveWaitlist(int entryId)
 {
-    auto bookings = getBookingsInDateRange(startDate, endDate);
-    double totalRevenue = 0.0;
-
-    for (const auto &booking : bookings)
+    std::lock_guard<std::mutex> waitLock(m_waitlistLock);
+    if (!m_waitlist.remove(entryId))
     {
-        if (booking->getStatus() == BookingStatus::CONFIRMED ||
-            booking->getStatus() == BookingStatus::COMPLETED)
-        {
-            totalRevenue += booking->getTotalAmount();
-        }
+        return false;
     }
+    logWaitlistRemoval(entryId);
+    return true;
+}
 
-    return totalRevenue;
+std::vector<WaitlistEntry> BookingManager::getWaitlist(int userId) const
+{
+    std::lock_guard<std::mutex> waitLock(m_waitlistLock);
+    return m_waitlist.getUserEntries(userId);
 }
 
-int BookingManager::getBookingCount(std::time_t startDate, std::time_t endDate) const
+size_t BookingManager::getWaitlistSize() const
 {
-    auto bookings = getBookingsInDateRange(startDate, endDate);
-    return static_cast<int>(bookings.size());
+    std::lock_guard<std::mutex> waitLock(m_waitlistLock);
+    return m_waitlist.size();
 }
 
-void BookingManager::loadBookings()
+int BookingManager::sweepLifecycle(std::time_t now)
 {
-    const std::string filename = "data/bookings.txt";
-    std::ifstream file(filename);
+    int changed = 0;
+    int batch;
+    do
+    {
+        batch = sweepBatch(now);
+        changed += batch;
+    } while (batch == SWEEP_BATCH_SIZE);
+    return changed;
+}
 
-    if (!file.is_open())
+int BookingManager::createSeries(const RecurringSeries &series, std::vector<BatchResult> &results, bool allOrNothing)
+{
+    results.clear();
+    std::time_t duration = series.firstEnd - series.firstStart;
+    if (series.userId <= 0 || series.courtId <= 0 || series.occurrences <= 0 ||
+        series.occurrences > BookingSeries::MAX_OCCURRENCES || series.intervalDays <= 0 ||
+        duration <= 0 || duration > static_cast<std::time_t>(series.intervalDays) * 24 * 3600 || series.amount < 0)
     {
-        return;
+        return 0;
     }
 
-    m_bookings.clear();
-    std::string line;
-
-    while (std::getline(file, line))
+    DateTimeUtils::LocalTime first = DateTimeUtils::toLocal(series.firstStart);
+    auto rule = std::make_shared<BookingSeries>();
+    rule->setUserId(series.userId);
+    rule->setCourtId(series.courtId);
+    rule->setDays(first.dayKey, first.dayKey + (series.occurrences - 1) * series.intervalDays, series.intervalDays);
+    rule->setTimeBand(first.hour * 3600 + first.minute * 60 + first.second, static_cast<int>(duration));
+    rule->setNotes(series.notes);
+
+    // The only full expansion a series gets: each occurrence priced and checked once
+    auto occurrences = rule->getAllOccurrences();
+    if (series.price)
     {
-        if (line.empty())
-            continue;
+        rule->setAmount(occurrences.empty() ? 0.0 : series.price(occurrences[0].first, occurrences[0].second));
+        for (const auto &occurrence : occurrences)
+        {
+            double amount = series.price(occurrence.first, occurrence.second);
+            if (amount < 0)
+            {
+                return 0;
+            }
+            rule->setDayAmount(DateTimeUtils::getDayKey(occurrence.first), amount);
+        }
+    }
+    else
+    {
+        rule->setAmount(series.amount);
+    }
 
-        std::istringstream iss(line);
-        std::string token;
-        std::vector<std::string> tokens;
+    BookingEvent event;
+    event.type = BookingEventType::CREATED;
+    uint64_t version;
+    {
+        CourtStripe &stripe = stripeFor(series.courtId);
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        const IntervalSet &active = stripe.activeByCourt[series.courtId];
 
-        while (std::getline(iss, token, '|'))
+        results.resize(occurrences.size());
+        bool failed = false;
+        for (size_t i = 0; i < occurrences.size(); ++i)
         {
-            tokens.push_back(token);
+            int existing = active.findOverlap(occurrences[i].first, occurrences[i].second);
+            int other = findSeriesConflict(stripe, series.courtId, occurrences[i].first, occurrences[i].second);
+            if (existing != 0 || other != 0)
+            {
+                results[i].status = BatchStatus::CONFLICT;
+                results[i].conflictingBookingId = std::max(existing, 0);
+                results[i].conflictingHoldId = std::max(-existing, 0);
+                results[i].conflictingSeriesId = other;
+                rule->skipDay(DateTimeUtils::getDayKey(occurrences[i].first));
+                failed = true;
+            }
+        }
+        if ((failed && allOrNothing) || rule->getOccurrenceCount() == 0)
+        {
+            return 0;
         }
 
-        if (tokens.size() >= 8)
+        rule->setId(m_nextSeriesId.fetch_add(1));
+        if (rule->getId() > BookingSeries::MAX_SERIES_ID)
         {
-            try
+            return 0;
+        }
+        for (size_t i = 0; i < occurrences.size(); ++i)
+        {
+            if (results[i].status == BatchStatus::NOT_COMMITTED)
             {
-                auto booking = new Booking();
-                booking->setId(std::stoi(tokens[0]));
-                booking->setUserId(std::stoi(tokens[1]));
-                booking->setCourtId(std::stoi(tokens[2]));
-                booking->setBookingDate(std::stoll(tokens[3]));
-                booking->setStartTime(std::stoll(tokens[4]));
-                booking->setEndTime(std::stoll(tokens[5]));
-                booking->setTotalAmount(std::stod(tokens[6]));
-
-                // Handle both old format (8 tokens) and new format (9 tokens)
-                if (tokens.size() >= 9)
-                {
-                    // New format with status
-                    int statusInt = std::stoi(tokens[7]);
-                    booking->setStatus(static_cast<BookingStatus>(statusInt));
-                    booking->setNotes(tokens[8]);
-                }
-                else
-                {
-                    // Old format without status, set default to PENDING
-                    booking->setStatus(BookingStatus::PENDING);
-                    booking->setNotes(tokens[7]);
-                }
-
-                m_bookings.push_back(booking);
+                results[i].status = BatchStatus::CREATED;
             }
-            catch (const std::exception &e)
+        }
+        version = publishSeries(stripe, rule, SeriesPtr());
+
+        // Observers hear about the series once, through its first occurrence
+        for (size_t i = 0; i < occurrences.size(); ++i)
+        {
+            if (results[i].status == BatchStatus::CREATED)
             {
-                // Skip invalid lines
-                continue;
+                event.booking = rule->toBooking(occurrences[i].first, occurrences[i].second);
+                break;
+            }
+        }
+    }
+
+    persist(version);
+    notifyObservers(event);
+    return rule->getId();
+}
+
+bool BookingManager::skipSeriesOccurrence(int seriesId, std::time_t date)
+{
+    SeriesPtr current = getSeries(seriesId);
+    if (!current)
+    {
+        return false;
+    }
+
+    BookingEvent event;
+    event.type = BookingEventType::CANCELLED;
+    uint64_t version;
+    std::time_t start, end;
+    {
+        CourtStripe &stripe = stripeFor(current->getCourtId());
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        current = getSeries(seriesId);
+        int dayKey = DateTimeUtils::getDayKey(date);
+        if (!current || !current->getOccurrence(DateTimeUtils::getDayStart(dayKey), start, end))
+        {
+            return false;
+        }
+
+        auto series = std::make_shared<BookingSeries>(*current);
+        series->skipDay(dayKey);
+        version = publishSeries(stripe, series, current);
+        event.booking = current->toBooking(start, end);
+        event.booking.setStatus(BookingStatus::CANCELLED);
+    }
+
+    persist(version);
+    notifyObservers(event);
+    serveWaitlist(current->getCourtId(), start, end);
+    return true;
+}
+
+bool BookingManager::endSeries(int seriesId, std::time_t from)
+{
+    SeriesPtr current = getSeries(seriesId);
+    if (!current)
+    {
+        return false;
+    }
+
+    uint64_t version;
+    std::vector<std::pair<std::time_t, std::time_t>> dropped;
+    {
+        CourtStripe &stripe = stripeFor(current->getCourtId());
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        current = getSeries(seriesId);
+        if (!current || !current->isActive())
+        {
+            return false;
+        }
+
+        // Keep 'from's own day only if that occurrence started before 'from'
+        DateTimeUtils::LocalTime local = DateTimeUtils::toLocal(from);
+        std::time_t start, end;
+        int lastDay = (current->getOccurrence(local.dayStart, start, end) && start < from) ? local.dayKey : local.dayKey - 1;
+        if (lastDay >= current->getLastDay())
+        {
+            return false;
+        }
+
+        auto series = std::make_shared<BookingSeries>(*current);
+        series->setDays(current->getFirstDay(), lastDay, current->getIntervalDays());
+        version = publishSeries(stripe, series, current);
+        dropped = current->getOccurrences(DateTimeUtils::getDayStart(lastDay + 1),
+                                          DateTimeUtils::getDayStart(current->getLastDay() + 1));
+    }
+
+    persist(version);
+    for (const auto &occurrence : dropped)
+    {
+        serveWaitlist(current->getCourtId(), occurrence.first, occurrence.second);
+    }
+    return true;
+}
+
+SeriesPtr BookingManager::getSeries(int seriesId) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    auto it = m_series.find(seriesId);
+    return it != m_series.end() ? it->second : SeriesPtr();
+}
+
+std::vector<SeriesPtr> BookingManager::getAllSeries() const
+{
+    return getSnapshot()->getSeries();
+}
+
+std::vector<Booking> BookingManager::getSeriesOccurrences(std::time_t from, std::time_t to) const
+{
+    std::vector<Booking> occurrences;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_dataLock);
+        for (const auto &entry : m_series)
+        {
+            for (const auto &occurrence : entry.second->getOccurrences(from, to))
+            {
+                occurrences.push_back(entry.second->toBooking(occurrence.first, occurrence.second));
+            }
+        }
+    }
+    std::stable_sort(occurrences.begin(), occurrences.end(),
+                     [](const Booking &a, const Booking &b)
+                     {
+                         return a.getStartTime() < b.getStartTime();
+                     });
+    return occurrences;
+}
+
+BookingPtr BookingManager::getBooking(int bookingId) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    return findBooking(bookingId);
+}
+
+std::vector<BookingPtr> BookingManager::getBookingsByUser(int userId) const
+{
+    std::vector<BookingPtr> userBookings;
+    auto snapshot = getSnapshot();
+
+    std::copy_if(snapshot->getBookings().begin(), snapshot->getBookings().end(), std::back_inserter(userBookings),
+                 [userId](const BookingPtr &booking)
+                 {
+                     return booking->getUserId() == userId;
+                 });
+    appendSeriesBookings(*snapshot, userId, 0, userBookings);
+
+    return userBookings;
+}
+
+std::vector<BookingPtr> BookingManager::getBookingsByCourt(int courtId) const
+{
+    std::vector<BookingPtr> courtBookings;
+    auto snapshot = getSnapshot();
+
+    std::copy_if(snapshot->getBookings().begin(), snapshot->getBookings().end(), std::back_inserter(courtBookings),
+                 [courtId](const BookingPtr &booking)
+                 {
+                     return booking->getCourtId() == courtId;
+                 });
+    appendSeriesBookings(*snapshot, 0, courtId, courtBookings);
+
+    return courtBookings;
+}
+
+void BookingManager::appendSeriesBookings(const BookingSnapshot &snapshot, int userId, int courtId,
+                                          std::vector<BookingPtr> &bookings)
+{
+    int today = DateTimeUtils::getDayKey(std::time(nullptr));
+    std::time_t from = DateTimeUtils::getDayStart(today - SERIES_LIST_DAYS);
+    std::time_t to = DateTimeUtils::getDayStart(today + SERIES_LIST_DAYS + 1);
+    for (const SeriesPtr &series : snapshot.getSeries())
+    {
+        if ((userId != 0 && series->getUserId() != userId) || (courtId != 0 && series->getCourtId() != courtId))
+            continue;
+
+        for (const auto &occurrence : series->getOccurrences(from, to))
+        {
+            bookings.push_back(std::make_shared<Booking>(series->toBooking(occurrence.first, occurrence.second)));
+        }
+    }
+}
+
+std::vector<BookingPtr> BookingManager::getBookingsByDate(std::time_t date) const
+{
+    std::vector<BookingPtr> dateBookings;
+    int dayKey = DateTimeUtils::getDayKey(date);
+    auto snapshot = getSnapshot();
+
+    std::copy_if(snapshot->getBookings().begin(), snapshot->getBookings().end(), std::back_inserter(dateBookings),
+                 [dayKey](const BookingPtr &booking)
+                 {
+                     // Compare dates (ignoring time)
+                     return DateTimeUtils::getDayKey(booking->getBookingDate()) == dayKey;
+                 });
+
+    return dateBookings;
+}
+
+bool BookingManager::isCourtAvailable(int courtId, std::time_t startTime, std::time_t endTime) const
+{
+    CourtStripe &stripe = stripeFor(courtId);
+    std::lock_guard<std::mutex> courtLock(stripe.lock);
+    auto it = stripe.activeByCourt.find(courtId);
+    return (it == stripe.activeByCourt.end() || !it->second.overlaps(startTime, endTime)) &&
+           findSeriesConflict(stripe, courtId, startTime, endTime) == 0;
+}
+
+std::vector<std::pair<std::time_t, std::time_t>> BookingManager::getAvailableSlots(
+    int courtId, std::time_t date, int slotDurationMinutes) const
+{
+
+    std::vector<std::pair<std::time_t, std::time_t>> availableSlots;
+
+    // Business hours: 6 AM to 11 PM
+    std::time_t startOfDay = DateTimeUtils::getTimeOnDay(date, 6);
+    std::time_t endOfDay = DateTimeUtils::getTimeOnDay(date, 23);
+
+    // Generate time slots
+    std::time_t currentSlot = startOfDay;
+    int slotDurationSeconds = slotDurationMinutes * 60;
+
+    CourtStripe &stripe = stripeFor(courtId);
+    std::lock_guard<std::mutex> courtLock(stripe.lock);
+    const IntervalSet &active = stripe.activeByCourt[courtId];
+    while (currentSlot + slotDurationSeconds <= endOfDay)
+    {
+        std::time_t slotEnd = currentSlot + slotDurationSeconds;
+
+        if (!active.overlaps(currentSlot, slotEnd) && findSeriesConflict(stripe, courtId, currentSlot, slotEnd) == 0)
+        {
+            availableSlots.push_back(std::make_pair(currentSlot, slotEnd));
+        }
+
+        currentSlot += slotDurationSeconds;
+    }
+
+    return availableSlots;
+}
+
+bool BookingManager::hasConflict(const Booking &booking) const
+{
+    CourtStripe &stripe = stripeFor(booking.getCourtId());
+    std::lock_guard<std::mutex> courtLock(stripe.lock);
+    auto it = stripe.activeByCourt.find(booking.getCourtId());
+    return (it != stripe.activeByCourt.end() &&
+            it->second.overlaps(booking.getStartTime(), booking.getEndTime(), booking.getId())) ||
+           findSeriesConflict(stripe, booking.getCourtId(), booking.getStartTime(), booking.getEndTime()) != 0;
+}
+
+OccupancyMap::DayBits BookingManager::getCourtOccupancy(int courtId, std::time_t date) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    return m_occupancy.getDay(courtId, date);
+}
+
+std::vector<SlotOption> BookingManager::findEarliestSlots(const SlotSearch &search) const
+{
+    std::vector<SlotOption> results;
+    if (search.courtIds.empty() || search.durationMinutes <= 0 || search.days <= 0 || search.maxResults <= 0)
+    {
+        return results;
+    }
+
+    const std::time_t slotSeconds = OccupancyMap::SLOT_MINUTES * 60;
+    int length = (search.durationMinutes + OccupancyMap::SLOT_MINUTES - 1) / OccupancyMap::SLOT_MINUTES;
+    int step = std::max(1, search.stepMinutes / OccupancyMap::SLOT_MINUTES);
+
+    // Daily windows in slots from each local midnight
+    struct DayWindow
+    {
+        std::time_t dayStart;
+        int fromSlot;
+        int endSlot;
+    };
+    std::vector<DayWindow> windows;
+    std::time_t dayStart = DateTimeUtils::getStartOfDay(search.earliestStart);
+    for (int day = 0; day < search.days; ++day)
+    {
+        std::time_t from = std::max(DateTimeUtils::getTimeOnDay(dayStart, search.firstHour), search.earliestStart);
+        std::time_t end = DateTimeUtils::getTimeOnDay(dayStart, search.lastHour);
+        windows.push_back({dayStart,
+                           static_cast<int>((std::max(from, dayStart) - dayStart + slotSeconds - 1) / slotSeconds),
+                           static_cast<int>((end - dayStart) / slotSeconds)});
+        dayStart = DateTimeUtils::toLocal(dayStart).dayEnd;
+    }
+
+    // Each court offers its next free run; a heap picks the soonest across courts
+    struct Candidate
+    {
+        std::time_t startTime;
+        size_t court;
+        size_t day;
+        int slot;
+    };
+    auto findNext = [&](size_t court, size_t day, int fromSlot, Candidate &candidate)
+    {
+        for (; day < windows.size(); ++day, fromSlot = 0)
+        {
+            const DayWindow &window = windows[day];
+            int slot = m_occupancy.findFreeRun(search.courtIds[court], window.dayStart,
+                                               std::max(fromSlot, window.fromSlot), window.endSlot, length, step);
+            if (slot >= 0)
+            {
+                candidate = {window.dayStart + slot * slotSeconds, court, day, slot};
+                return true;
+            }
+        }
+        return false;
+    };
+    auto later = [](const Candidate &a, const Candidate &b)
+    {
+        return a.startTime != b.startTime ? a.startTime > b.startTime : a.court > b.court;
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(later)> queue(later);
+
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    Candidate candidate;
+    for (size_t court = 0; court < search.courtIds.size(); ++court)
+    {
+        if (findNext(court, 0, 0, candidate))
+        {
+            queue.push(candidate);
+        }
+    }
+
+    while (!queue.empty() && static_cast<int>(results.size()) < search.maxResults)
+    {
+        Candidate best = queue.top();
+        queue.pop();
+        results.push_back({search.courtIds[best.court], best.startTime,
+                           best.startTime + static_cast<std::time_t>(search.durationMinutes) * 60});
+
+        // The court's next offer starts after this one ends
+        if (findNext(best.court, best.day, best.slot + length, candidate))
+        {
+            queue.push(candidate);
+        }
+    }
+    return results;
+}
+
+void BookingManager::setChangeFeed(ChangeFeed *feed)
+{
+    std::unique_lock<std::shared_mutex> lock(m_dataLock);
+    m_changeFeed = feed;
+}
+
+void BookingManager::addObserver(NotificationObserver* observer)
+{
+    std::unique_lock<std::shared_mutex> lock(m_dataLock);
+    m_observers.push_back(observer);
+    m_dispatcher.addObserver(observer);
+}
+
+void BookingManager::removeObserver(NotificationObserver* observer)
+{
+    std::unique_lock<std::shared_mutex> lock(m_dataLock);
+    m_dispatcher.removeObserver(observer);
+    m_observers.erase(
+        std::remove(m_observers.begin(), m_observers.end(), observer),
+        m_observers.end());
+}
+
+void BookingManager::notifyObservers(const BookingEvent &event)
+{
+    m_dispatcher.publish(event);
+}
+
+void BookingManager::shutdownNotifications()
+{
+    m_reminders.stop();
+    m_dispatcher.shutdown();
+}
+
+uint64_t BookingManager::getDroppedNotificationCount() const
+{
+    return m_dispatcher.getDroppedEvents();
+}
+
+size_t BookingManager::getPendingReminderCount() const
+{
+    return m_reminders.getPendingCount();
+}
+
+std::vector<BookingPtr> BookingManager::getAllBookings() const
+{
+    return getSnapshot()->getBookings();
+}
+
+std::vector<int> BookingManager::findBookingIds(const BookingQuery &query) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    return queryBookingIds(query);
+}
+
+std::shared_ptr<const BookingSnapshot> BookingManager::getSnapshot() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+
+    // Readers may race to build it; the first one does and the rest reuse it
+    std::lock_guard<std::mutex> snapshotLock(m_snapshotLock);
+    if (!m_snapshot)
+    {
+        std::vector<SeriesPtr> series;
+        series.reserve(m_series.size());
+        for (const auto &entry : m_series)
+        {
+            series.push_back(entry.second);
+        }
+        m_snapshot = std::make_shared<BookingSnapshot>(m_version, m_bookings, std::move(series));
+    }
+    return m_snapshot;
+}
+
+uint64_t BookingManager::getVersion() const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    return m_version;
+}
+
+BookingManager::ReadView BookingManager::openReadView() const
+{
+    return ReadView(*this);
+}
+
+// ReadView implementation
+BookingManager::ReadView::ReadView(const BookingManager &manager)
+    : m_manager(manager), m_lock(manager.m_dataLock)
+{
+}
+
+BookingPtr BookingManager::ReadView::getBooking(int bookingId) const
+{
+    return m_manager.findBooking(bookingId);
+}
+
+std::vector<int> BookingManager::ReadView::findBookingIds(const BookingQuery &query) const
+{
+    return m_manager.queryBookingIds(query);
+}
+
+std::vector<BookingPtr> BookingManager::ReadView::getSeriesBookings() const
+{
+    std::vector<BookingPtr> bookings;
+    for (const auto &entry : m_manager.m_series)
+    {
+        for (const auto &occurrence : entry.second->getAllOccurrences())
+        {
+            bookings.push_back(std::make_shared<Booking>(entry.second->toBooking(occurrence.first, occurrence.second)));
+        }
+    }
+    return bookings;
+}
+
+OccupancyMap::DayBits BookingManager::ReadView::getCourtOccupancy(int courtId, std::time_t date) const
+{
+    return m_manager.m_occupancy.getDay(courtId, date);
+}
+
+std::vector<std::pair<std::time_t, std::time_t>> BookingManager::ReadView::getAvailableSlots(
+    int courtId, std::time_t date, int slotDurationMinutes) const
+{
+    std::vector<std::pair<std::time_t, std::time_t>> availableSlots;
+    if (slotDurationMinutes <= 0)
+        return availableSlots;
+
+    // Same business hours as BookingManager::getAvailableSlots, but checked
+    // against the indexed bookings so the answer matches this version
+    std::time_t startOfDay = DateTimeUtils::getTimeOnDay(date, 6);
+    std::time_t endOfDay = DateTimeUtils::getTimeOnDay(date, 23);
+
+    BookingQuery query;
+    query.courtId = courtId;
+    query.fromTime = startOfDay - 24 * 3600;
+    query.toTime = endOfDay;
+    std::vector<std::pair<std::time_t, std::time_t>> busy;
+    for (int bookingId : m_manager.m_index.query(query))
+    {
+        const Booking *booking = m_manager.m_index.find(bookingId);
+        if (booking && booking->isActive() && booking->getEndTime() > startOfDay)
+        {
+            busy.push_back(std::make_pair(booking->getStartTime(), booking->getEndTime()));
+        }
+    }
+    {
+        std::lock_guard<std::mutex> holdLock(m_manager.m_holdLock);
+        for (const auto &entry : m_manager.m_holds)
+        {
+            const SlotHold &hold = entry.second;
+            if (hold.courtId == courtId && hold.endTime > startOfDay && hold.startTime < endOfDay)
+            {
+                busy.push_back(std::make_pair(hold.startTime, hold.endTime));
+            }
+        }
+    }
+    for (const auto &entry : m_manager.m_series)
+    {
+        const BookingSeries &series = *entry.second;
+        if (series.getCourtId() == courtId)
+        {
+            auto occurrences = series.getOccurrences(startOfDay - series.getDurationSeconds() + 1, endOfDay);
+            busy.insert(busy.end(), occurrences.begin(), occurrences.end());
+        }
+    }
+
+    int slotDurationSeconds = slotDurationMinutes * 60;
+    for (std::time_t currentSlot = startOfDay; currentSlot + slotDurationSeconds <= endOfDay;
+         currentSlot += slotDurationSeconds)
+    {
+        std::time_t slotEnd = currentSlot + slotDurationSeconds;
+        bool free = std::none_of(busy.begin(), busy.end(),
+                                 [currentSlot, slotEnd](const std::pair<std::time_t, std::time_t> &interval)
+                                 {
+                                     return interval.first < slotEnd && currentSlot < interval.second;
+                                 });
+        if (free)
+        {
+            availableSlots.push_back(std::make_pair(currentSlot, slotEnd));
+        }
+    }
+
+    return availableSlots;
+}
+
+std::vector<int> BookingManager::searchBookingNotes(const std::string &text) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+    return m_noteSearch.searchIds(text);
+}
+
+std::vector<int> BookingManager::getBookingIdsForUsers(const std::vector<int> &userIds) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_dataLock);
+
+    // Concatenate the per-user posting lists, then sort once: O(n log n) for
+    // n postings however many users match, instead of one merge pass per user
+    std::vector<int> result;
+    for (int userId : userIds)
+    {
+        const std::vector<int> &postings = m_index.getUserPostings(userId);
+        result.insert(result.end(), postings.begin(), postings.end());
+    }
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+std::vector<BookingPtr> BookingManager::getBookingsInDateRange(std::time_t startDate, std::time_t endDate) const
+{
+    std::vector<BookingPtr> rangeBookings;
+    auto snapshot = getSnapshot();
+
+    std::copy_if(snapshot->getBookings().begin(), snapshot->getBookings().end(), std::back_inserter(rangeBookings),
+                 [startDate, endDate](const BookingPtr &booking)
+                 {
+                     std::time_t bookingDate = booking->getBookingDate();
+                     return bookingDate >= startDate && bookingDate <= endDate;
+                 });
+
+    // Series occurrences are dated by their local day; expand only the days in range
+    if (!snapshot->getSeries().empty() && startDate <= endDate)
+    {
+        DateTimeUtils::LocalTime first = DateTimeUtils::toLocal(startDate);
+        std::time_t from = (first.dayStart == startDate) ? startDate : first.dayEnd;
+        std::time_t to = DateTimeUtils::toLocal(endDate).dayEnd;
+        for (const SeriesPtr &series : snapshot->getSeries())
+        {
+            for (const auto &occurrence : series->getOccurrences(from, to))
+            {
+                rangeBookings.push_back(std::make_shared<Booking>(series->toBooking(occurrence.first, occurrence.second)));
+            }
+        }
+        std::stable_sort(rangeBookings.begin(), rangeBookings.end(),
+                         [](const BookingPtr &a, const BookingPtr &b)
+                         {
+                             return a->getStartTime() < b->getStartTime();
+                         });
+    }
+
+    return rangeBookings;
+}
+
+double BookingManager::getTotalRevenue(std::time_t startDate, std::time_t endDate) const
+{
+    auto bookings = getBookingsInDateRange(startDate, endDate);
+    double totalRevenue = 0.0;
+
+    for (const auto &booking : bookings)
+    {
+        if (booking->getStatus() == BookingStatus::CONFIRMED ||
+            booking->getStatus() == BookingStatus::COMPLETED)
+        {
+            totalRevenue += booking->getTotalAmount();
+        }
+    }
+
+    return totalRevenue;
+}
+
+int BookingManager::getBookingCount(std::time_t startDate, std::time_t endDate) const
+{
+    auto bookings = getBookingsInDateRange(startDate, endDate);
+    return static_cast<int>(bookings.size());
+}
+
+void BookingManager::loadBookings()
+{
+    {
+        std::lock_guard<std::mutex> waitLock(m_waitlistLock);
+        loadWaitlist();
+    }
+
+    const std::string filename = "data/bookings.txt";
+    std::ifstream file(filename);
+
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    std::vector<BookingPtr> bookings;
+    std::unordered_map<int, Booking *> byId; // For replaying the status log
+    std::string line;
+    bool rewrite = false; // The file gets the migrated rows and replayed changes
+
+    while (std::getline(file, line))
+    {
+        if (line.empty())
+            continue;
+
+        std::istringstream iss(line);
+        std::string token;
+        std::vector<std::string> tokens;
+
+        while (std::getline(iss, token, '|'))
+        {
+            tokens.push_back(token);
+        }
+        if (line.back() == '|')
+        {
+            tokens.push_back(std::string()); // Empty notes; getline drops an empty last field
+        }
+
+        if (tokens.size() >= 8)
+        {
+            try
+            {
+                auto booking = std::make_shared<Booking>();
+                booking->setId(std::stoi(tokens[0]));
+                booking->setUserId(std::stoi(tokens[1]));
+                booking->setCourtId(std::stoi(tokens[2]));
+                booking->setBookingDate(std::stoll(tokens[3]));
+                booking->setStartTime(std::stoll(tokens[4]));
+                booking->setEndTime(std::stoll(tokens[5]));
+                booking->setTotalAmount(std::stod(tokens[6]));
+
+                // Handle both old format (8 tokens) and new format (9 tokens)
+                if (tokens.size() >= 9)
+                {
+                    // New format with status
+                    int statusInt = std::stoi(tokens[7]);
+                    booking->setStatus(static_cast<BookingStatus>(statusInt));
+                    booking->setNotes(tokens[8]);
+                }
+                else
+                {
+                    // Old format without status. Those rows were bookings already
+                    // made, so they count as confirmed; as PENDING the sweeper
+                    // would cancel them
+                    booking->setStatus(BookingStatus::CONFIRMED);
+                    booking->setNotes(tokens[7]);
+                    rewrite = true;
+                }
+
+                byId[booking->getId()] = booking.get();
+                bookings.push_back(booking);
+            }
+            catch (const std::exception &e)
+            {
+                // Skip invalid lines
+                continue;
             }
         }
     }
 
     file.close();
+
+    // Replay the sweeper's status log. Sweeps only move a row out of PENDING
+    // or CONFIRMED, so a line never undoes a later change the file already has.
+    std::ifstream statusLog("data/bookings.log");
+    while (std::getline(statusLog, line))
+    {
+        size_t separator = line.find('|');
+        try
+        {
+            auto it = separator != std::string::npos ? byId.find(std::stoi(line.substr(0, separator))) : byId.end();
+            if (it != byId.end() && (it->second->getStatus() == BookingStatus::PENDING ||
+                                     it->second->getStatus() == BookingStatus::CONFIRMED))
+            {
+                it->second->setStatus(static_cast<BookingStatus>(std::stoi(line.substr(separator + 1))));
+                rewrite = true;
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // Skip damaged lines (e.g. one cut short by a crash)
+            continue;
+        }
+    }
+    statusLog.close();
+
+    std::vector<SeriesPtr> series = readSeriesFile();
+
+    // Replacing everything: take every court stripe, in order, then the data lock
+    std::vector<std::unique_lock<std::mutex>> courtLocks;
+    for (CourtStripe &stripe : m_stripes)
+    {
+        courtLocks.emplace_back(stripe.lock);
+        stripe.activeByCourt.clear();
+        stripe.seriesByCourt.clear();
+    }
+
+    uint64_t version;
+    {
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        m_bookings.swap(bookings);
+        sortBookingsByDate();
+        m_index.rebuild(m_bookings);
+
+        int maxId = 0;
+        m_noteSearch.clear();
+        m_occupancy.clear();
+        m_completeMark = std::numeric_limits<std::time_t>::max();
+        m_expireMark = std::numeric_limits<std::time_t>::max();
+        for (const BookingPtr &booking : m_bookings)
+        {
+            maxId = std::max(maxId, booking->getId());
+            lowerSweepMarks(*booking);
+            indexNotes(*booking);
+            if (booking->getStatus() != BookingStatus::CANCELLED)
+            {
+                m_occupancy.mark(booking->getCourtId(), booking->getStartTime(), booking->getEndTime());
+            }
+            if (booking->isActive())
+            {
+                stripeFor(booking->getCourtId()).activeByCourt[booking->getCourtId()].insert(
+                    booking->getId(), booking->getStartTime(), booking->getEndTime());
+            }
+        }
+        m_nextBookingId = maxId + 1;
+
+        int maxSeriesId = 0;
+        m_series.clear();
+        for (const SeriesPtr &rule : series)
+        {
+            maxSeriesId = std::max(maxSeriesId, rule->getId());
+            m_series[rule->getId()] = rule;
+            if (rule->isActive())
+            {
+                stripeFor(rule->getCourtId()).seriesByCourt[rule->getCourtId()].push_back(rule);
+                m_occupancy.addSeries(rule);
+            }
+        }
+        m_nextSeriesId = maxSeriesId + 1;
+
+        // Holds are not in the file; put them back over the reloaded bookings
+        std::lock_guard<std::mutex> holdLock(m_holdLock);
+        for (const auto &entry : m_holds)
+        {
+            const SlotHold &hold = entry.second;
+            stripeFor(hold.courtId).activeByCourt[hold.courtId].insert(-hold.id, hold.startTime, hold.endTime);
+            m_occupancy.addHold(hold.id, hold.courtId, hold.startTime, hold.endTime);
+        }
+
+        rebuildReminders();
+        version = commit();
+        if (m_changeFeed)
+        {
+            m_changeFeed->restart(); // Replicas reload instead of replaying
+        }
+    }
+
+    if (rewrite)
+    {
+        {
+            std::lock_guard<std::mutex> saveLock(m_saveLock);
+            m_loggedVersion = std::max(m_loggedVersion, version); // So the save empties the replayed log
+        }
+        persist(version);
+        return;
+    }
+
+    // The file already holds this version
+    std::lock_guard<std::mutex> saveLock(m_saveLock);
+    m_savedVersion = std::max(m_savedVersion, version);
 }
 
 void BookingManager::saveBookings()
+{
+    persist(getVersion());
+}
+
+void BookingManager::persist(uint64_t version)
+{
+    std::unique_lock<std::mutex> lock(m_saveLock);
+    while (m_savedVersion < version)
+    {
+        if (m_saving)
+        {
+            // Another writer is saving; its snapshot may already cover this version
+            m_saveDone.wait(lock);
+            continue;
+        }
+
+        m_saving = true;
+        lock.unlock();
+        auto snapshot = getSnapshot();
+        writeSnapshot(*snapshot);
+        lock.lock();
+
+        m_saving = false;
+        m_savedVersion = std::max(m_savedVersion, snapshot->getVersion());
+        if (m_loggedVersion != 0 && m_savedVersion >= m_loggedVersion)
+        {
+            // The file now has every logged change
+            m_statusLog.close();
+            m_statusLog.open("data/bookings.log", std::ios::trunc);
+            m_loggedVersion = 0;
+        }
+        m_saveDone.notify_all();
+    }
+}
+
+void BookingManager::logStatusChanges(uint64_t version, const std::vector<BookingPtr> &bookings)
+{
+    std::lock_guard<std::mutex> lock(m_saveLock);
+    if (!m_statusLog.is_open())
+    {
+        std::error_code error;
+        std::filesystem::create_directories("data", error);
+        m_statusLog.open("data/bookings.log", std::ios::app);
+    }
+
+    for (const BookingPtr &booking : bookings)
+    {
+        m_statusLog << booking->getId() << "|" << static_cast<int>(booking->getStatus()) << "\n";
+    }
+    m_statusLog.flush();
+    m_loggedVersion = std::max(m_loggedVersion, version);
+}
+
+void BookingManager::writeSnapshot(const BookingSnapshot &snapshot)
 {
     // Create data directory if it doesn't exist
-    std::filesystem::create_directories("data");
+    std::error_code error;
+    std::filesystem::create_directories("data", error);
 
     const std::string filename = "data/bookings.txt";
     std::ofstream file(filename);
     file.clear();
     if (!file.is_open())
     {
-        return;
+        return;
+    }
+
+    for (const auto &booking : snapshot.getBookings())
+    {
+        if (booking)
+        {
+            file << booking->getId() << "|"
+                 << booking->getUserId() << "|"
+                 << booking->getCourtId() << "|"
+                 << booking->getBookingDate() << "|"
+                 << booking->getStartTime() << "|"
+                 << booking->getEndTime() << "|"
+                 << booking->getTotalAmount() << "|"
+                 << static_cast<int>(booking->getStatus()) << "|"
+                 << booking->getNotes() << "\n";
+        }
+    }
+
+    file.close();
+    writeSeriesFile(snapshot);
+}
+
+std::vector<SeriesPtr> BookingManager::readSeriesFile() const
+{
+    std::vector<SeriesPtr> series;
+    std::ifstream file("data/series.txt");
+    if (!file.is_open())
+    {
+        return series;
+    }
+
+    // id|userId|courtId|firstDay|lastDay|intervalDays|startSecond|durationSeconds|amount|skippedDays|notes
+    // where amount may be followed by ;day:amount,... for days priced differently
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> tokens;
+        std::istringstream iss(line);
+        std::string token;
+        for (int field = 0; field < 10 && std::getline(iss, token, '|'); ++field)
+        {
+            tokens.push_back(token);
+        }
+        if (tokens.size() < 10)
+            continue;
+
+        try
+        {
+            auto rule = std::make_shared<BookingSeries>();
+            rule->setId(std::stoi(tokens[0]));
+            rule->setUserId(std::stoi(tokens[1]));
+            rule->setCourtId(std::stoi(tokens[2]));
+            rule->setDays(std::stoi(tokens[3]), std::stoi(tokens[4]), std::stoi(tokens[5]));
+            rule->setTimeBand(std::stoi(tokens[6]), std::stoi(tokens[7]));
+            rule->setAmount(std::stod(tokens[8]));
+            size_t dayAmounts = tokens[8].find(';');
+            if (dayAmounts != std::string::npos)
+            {
+                std::istringstream days(tokens[8].substr(dayAmounts + 1));
+                while (std::getline(days, token, ','))
+                {
+                    size_t colon = token.find(':');
+                    if (colon != std::string::npos)
+                    {
+                        rule->setDayAmount(std::stoi(token.substr(0, colon)), std::stod(token.substr(colon + 1)));
+                    }
+                }
+            }
+
+            std::istringstream skipped(tokens[9]);
+            while (std::getline(skipped, token, ','))
+            {
+                if (!token.empty())
+                {
+                    rule->skipDay(std::stoi(token));
+                }
+            }
+
+            // Notes are the rest of the line, so they may contain '|'
+            std::string notes;
+            std::getline(iss, notes);
+            rule->setNotes(notes);
+            series.push_back(rule);
+        }
+        catch (const std::exception &e)
+        {
+            // Skip invalid lines
+            continue;
+        }
+    }
+    return series;
+}
+
+void BookingManager::writeSeriesFile(const BookingSnapshot &snapshot)
+{
+    std::ofstream file("data/series.txt");
+    if (!file.is_open())
+    {
+        return;
+    }
+
+    for (const SeriesPtr &series : snapshot.getSeries())
+    {
+        file << series->getId() << "|"
+             << series->getUserId() << "|"
+             << series->getCourtId() << "|"
+             << series->getFirstDay() << "|"
+             << series->getLastDay() << "|"
+             << series->getIntervalDays() << "|"
+             << series->getStartSecond() << "|"
+             << series->getDurationSeconds() << "|"
+             << series->getAmount();
+        char separator = ';';
+        for (const auto &day : series->getDayAmounts())
+        {
+            file << separator << day.first << ":" << day.second;
+            separator = ',';
+        }
+        file << "|";
+        const std::vector<int> &skipped = series->getSkippedDays();
+        for (size_t i = 0; i < skipped.size(); ++i)
+        {
+            file << (i > 0 ? "," : "") << skipped[i];
+        }
+        file << "|" << series->getNotes() << "\n";
+    }
+}
+
+void BookingManager::loadWaitlist()
+{
+    // Replay the log: entry lines add or restore a request, removal lines drop it
+    m_waitlist.clear();
+    m_waitlistLog.close();
+    const std::string logPath = "data/waitlist.log";
+    std::ifstream file(logPath);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> tokens;
+        std::istringstream iss(line);
+        std::string token;
+        for (int field = 0; field < 8 && std::getline(iss, token, '|'); ++field)
+        {
+            tokens.push_back(token);
+        }
+
+        try
+        {
+            if (tokens.size() >= 8 && tokens[0] == "W")
+            {
+                WaitlistEntry entry;
+                entry.id = std::stoi(tokens[1]);
+                entry.userId = std::stoi(tokens[2]);
+                entry.courtId = std::stoi(tokens[3]);
+                entry.startTime = std::stoll(tokens[4]);
+                entry.endTime = std::stoll(tokens[5]);
+                entry.amount = std::stod(tokens[6]);
+                entry.autoBook = std::stoi(tokens[7]) != 0;
+                std::getline(iss, entry.notes); // Rest of the line, may contain '|'
+                m_waitlist.restore(entry);
+            }
+            else if (tokens.size() >= 2 && tokens[0] == "R")
+            {
+                m_waitlist.remove(std::stoi(tokens[1]));
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // Skip damaged lines (e.g. one cut short by a crash)
+            continue;
+        }
+    }
+    file.close();
+    m_waitlist.removeStarted(std::time(nullptr));
+
+    // Compact to one line per waiting request
+    std::error_code error;
+    std::filesystem::create_directories("data", error);
+    const std::string tempPath = logPath + ".tmp";
+    {
+        std::ofstream compacted(tempPath, std::ios::trunc);
+        for (const auto &entry : m_waitlist.getEntries())
+        {
+            compacted << encodeWaitlistEntry(entry.second) << "\n";
+        }
+    }
+    std::filesystem::rename(tempPath, logPath, error);
+
+    m_waitlistLog.open(logPath, std::ios::app);
+}
+
+void BookingManager::logWaitlistEntry(const WaitlistEntry &entry)
+{
+    if (m_waitlistLog.is_open())
+    {
+        m_waitlistLog << encodeWaitlistEntry(entry) << std::endl;
     }
+}
 
-    for (const auto &booking : m_bookings)
+void BookingManager::logWaitlistRemoval(int entryId)
+{
+    if (m_waitlistLog.is_open())
     {
-        if (booking)
-        {
-            file << booking->getId() << "|"
-                 << booking->getUserId() << "|"
-                 << booking->getCourtId() << "|"
-                 << booking->getBookingDate() << "|"
-                 << booking->getStartTime() << "|"
-                 << booking->getEndTime() << "|"
-                 << booking->getTotalAmount() << "|"
-                 << static_cast<int>(booking->getStatus()) << "|"
-                 << booking->getNotes() << "\n";
-        }
+        m_waitlistLog << "R|" << entryId << std::endl;
     }
+}
 
-    file.close();
+std::string BookingManager::encodeWaitlistEntry(const WaitlistEntry &entry)
+{
+    // W|id|userId|courtId|startTime|endTime|amount|autoBook|notes
+    std::ostringstream oss;
+    oss << "W|" << entry.id << "|"
+        << entry.userId << "|"
+        << entry.courtId << "|"
+        << entry.startTime << "|"
+        << entry.endTime << "|"
+        << entry.amount << "|"
+        << (entry.autoBook ? 1 : 0) << "|"
+        << entry.notes;
+    return oss.str();
 }
 
 bool BookingManager::validateBooking(const Booking &booking) const
@@ -447,24 +1778,604 @@ bool BookingManager::validateBooking(const Booking &booking) const
     return true;
 }
 
+void BookingManager::insertBooking(const BookingPtr &booking)
+{
+    // Keep m_bookings ordered by start time without re-sorting it
+    auto position = std::upper_bound(m_bookings.begin(), m_bookings.end(), booking->getStartTime(),
+                                     [](std::time_t time, const BookingPtr &entry)
+                                     {
+                                         return time < entry->getStartTime();
+                                     });
+    m_bookings.insert(position, booking);
+    addToIndexes(booking);
+}
+
+void BookingManager::insertBookings(const std::vector<BookingPtr> &bookings)
+{
+    // One merge instead of an insert per booking; equal starts keep existing entries first
+    std::vector<BookingPtr> merged;
+    merged.reserve(m_bookings.size() + bookings.size());
+    std::merge(m_bookings.begin(), m_bookings.end(), bookings.begin(), bookings.end(), std::back_inserter(merged),
+               [](const BookingPtr &a, const BookingPtr &b)
+               {
+                   return a->getStartTime() < b->getStartTime();
+               });
+    m_bookings.swap(merged);
+
+    for (const BookingPtr &booking : bookings)
+    {
+        addToIndexes(booking);
+    }
+}
+
+void BookingManager::addToIndexes(const BookingPtr &booking)
+{
+    m_index.add(booking);
+    lowerSweepMarks(*booking);
+    indexNotes(*booking);
+    if (booking->getStatus() != BookingStatus::CANCELLED)
+    {
+        m_occupancy.mark(booking->getCourtId(), booking->getStartTime(), booking->getEndTime());
+    }
+    m_reminders.update(*booking);
+}
+
+void BookingManager::replaceBooking(const BookingPtr &booking)
+{
+    // m_bookings is ordered by start time, so look from the old start onwards
+    const Booking* current = m_index.find(booking->getId());
+    auto it = std::lower_bound(m_bookings.begin(), m_bookings.end(), current->getStartTime(),
+                               [](const BookingPtr &entry, std::time_t time)
+                               {
+                                   return entry->getStartTime() < time;
+                               });
+    while (it != m_bookings.end() && it->get() != current)
+    {
+        ++it;
+    }
+    if (it == m_bookings.end())
+    {
+        return;
+    }
+
+    m_index.replace(booking);
+    if (current->getStartTime() == booking->getStartTime())
+    {
+        *it = booking; // Readers holding the old version keep their copy alive
+    }
+    else
+    {
+        m_bookings.erase(it);
+        auto position = std::upper_bound(m_bookings.begin(), m_bookings.end(), booking->getStartTime(),
+                                         [](std::time_t time, const BookingPtr &entry)
+                                         {
+                                             return time < entry->getStartTime();
+                                         });
+        m_bookings.insert(position, booking);
+    }
+    lowerSweepMarks(*booking);
+}
+
+void BookingManager::lowerSweepMarks(const Booking &booking)
+{
+    // A row added or changed behind a watermark would otherwise never be swept
+    if (booking.getStatus() == BookingStatus::CONFIRMED)
+    {
+        m_completeMark = std::min(m_completeMark.load(), booking.getStartTime());
+    }
+    else if (booking.getStatus() == BookingStatus::PENDING)
+    {
+        m_expireMark = std::min(m_expireMark.load(), booking.getStartTime());
+    }
+}
+
+uint64_t BookingManager::commit()
+{
+    m_snapshot.reset();
+    return ++m_version;
+}
+
+void BookingManager::recordChange(ChangeType type, const BookingPtr &booking)
+{
+    if (m_changeFeed)
+    {
+        m_changeFeed->publishBooking(type, booking);
+    }
+}
+
 void BookingManager::generateBookingId(Booking &booking)
 {
-    int maxId = 0;
-    for (const auto &b : m_bookings)
+    // Lock-free so writers on different courts do not meet here
+    booking.setId(m_nextBookingId.fetch_add(1));
+}
+
+BookingManager::CourtStripe &BookingManager::stripeFor(int courtId) const
+{
+    return m_stripes[static_cast<unsigned>(courtId) % COURT_STRIPES];
+}
+
+bool BookingManager::removeHold(int holdId, bool onlyIfExpired, std::time_t now)
+{
+    SlotHold hold;
+    if (!getHold(holdId, hold))
+    {
+        return false;
+    }
+
+    {
+        CourtStripe &stripe = stripeFor(hold.courtId);
+        std::lock_guard<std::mutex> courtLock(stripe.lock);
+        {
+            // Checked again under the stripe: it may have been booked or extended meanwhile
+            std::lock_guard<std::mutex> holdLock(m_holdLock);
+            auto it = m_holds.find(holdId);
+            if (it == m_holds.end() || (onlyIfExpired && it->second.expiresAt > now))
+            {
+                return false;
+            }
+            m_holds.erase(it);
+            m_holdExpiry.cancel(holdId);
+        }
+        stripe.activeByCourt[hold.courtId].erase(-holdId, hold.startTime);
+
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+        m_occupancy.removeHold(holdId, hold.courtId);
+    }
+
+    // A lapsed waitlist offer passes to the next customer in line
+    serveWaitlist(hold.courtId, hold.startTime, hold.endTime);
+    return true;
+}
+
+void BookingManager::runHoldExpiry()
+{
+    while (m_holdsRunning.load())
+    {
+        expireHolds(std::time(nullptr));
+
+        std::unique_lock<std::mutex> lock(m_holdWakeMutex);
+        m_holdWake.wait_for(lock, std::chrono::seconds(1), [this]
+                            { return !m_holdsRunning.load(); });
+    }
+}
+
+void BookingManager::planSweep(std::time_t now, std::vector<int> &toComplete, std::vector<int> &toExpire,
+                               std::time_t &completeMark, std::time_t &expireMark) const
+{
+    const auto &timeIndex = m_index.getTimeIndex();
+
+    // Ended bookings up to now; one still being played holds the mark at its start
+    std::time_t unfinished = std::numeric_limits<std::time_t>::max();
+    auto it = std::lower_bound(timeIndex.begin(), timeIndex.end(), std::make_pair(m_completeMark.load(), INT_MIN));
+    for (; it != timeIndex.end() && it->first <= now && toComplete.size() < SWEEP_BATCH_SIZE; ++it)
+    {
+        const Booking *booking = m_index.find(it->second);
+        if (booking->getStatus() != BookingStatus::CONFIRMED)
+            continue;
+
+        if (booking->getEndTime() <= now)
+        {
+            toComplete.push_back(it->second);
+        }
+        else
+        {
+            unfinished = std::min(unfinished, it->first);
+        }
+    }
+    completeMark = std::min(unfinished, it != timeIndex.end() ? it->first : now + 1);
+
+    // Unconfirmed bookings starting within the lead, in the rest of the batch
+    std::time_t horizon = now + PENDING_EXPIRY_LEAD_SECONDS;
+    size_t room = SWEEP_BATCH_SIZE - toComplete.size();
+    it = std::lower_bound(timeIndex.begin(), timeIndex.end(), std::make_pair(m_expireMark.load(), INT_MIN));
+    for (; it != timeIndex.end() && it->first <= horizon && toExpire.size() < room; ++it)
+    {
+        if (m_index.find(it->second)->getStatus() == BookingStatus::PENDING)
+        {
+            toExpire.push_back(it->second);
+        }
+    }
+    expireMark = (it != timeIndex.end() && it->first <= horizon) ? it->first : horizon + 1;
+}
+
+int BookingManager::sweepBatch(std::time_t now)
+{
+    std::vector<int> toComplete, toExpire;
+    std::time_t completeMark, expireMark;
+    {
+        // Most sweeps find nothing due; they only advance the marks and never
+        // stall writers on every court
+        std::shared_lock<std::shared_mutex> lock(m_dataLock);
+        planSweep(now, toComplete, toExpire, completeMark, expireMark);
+        if (toComplete.empty() && toExpire.empty())
+        {
+            m_completeMark = completeMark;
+            m_expireMark = expireMark;
+            return 0;
+        }
+    }
+
+    std::vector<BookingPtr> swept, expired;
+    uint64_t version;
+    int changed = 0;
+    {
+        // Rows on any court may change: take every stripe, in order, then the data lock
+        std::vector<std::unique_lock<std::mutex>> courtLocks;
+        for (CourtStripe &stripe : m_stripes)
+        {
+            courtLocks.emplace_back(stripe.lock);
+        }
+        std::unique_lock<std::shared_mutex> lock(m_dataLock);
+
+        // Plan again, as writers may have run in between
+        toComplete.clear();
+        toExpire.clear();
+        planSweep(now, toComplete, toExpire, completeMark, expireMark);
+
+        // Same start times, so replacing leaves the time index as walked
+        for (int bookingId : toComplete)
+        {
+            auto booking = std::make_shared<Booking>(*m_index.find(bookingId));
+            booking->setStatus(BookingStatus::COMPLETED);
+            stripeFor(booking->getCourtId()).activeByCourt[booking->getCourtId()].erase(bookingId, booking->getStartTime());
+            replaceBooking(booking);
+            recordChange(ChangeType::BOOKING_UPDATED, booking);
+            swept.push_back(booking);
+        }
+        for (int bookingId : toExpire)
+        {
+            auto booking = std::make_shared<Booking>(*m_index.find(bookingId));
+            booking->setStatus(BookingStatus::CANCELLED);
+            stripeFor(booking->getCourtId()).activeByCourt[booking->getCourtId()].erase(bookingId, booking->getStartTime());
+            replaceBooking(booking);
+            refreshOccupancy(booking->getCourtId(), booking->getStartTime(), booking->getEndTime());
+            m_reminders.cancel(bookingId);
+            recordChange(ChangeType::BOOKING_CANCELLED, booking);
+            swept.push_back(booking);
+            expired.push_back(booking);
+        }
+
+        m_completeMark = completeMark;
+        m_expireMark = expireMark;
+        changed = static_cast<int>(toComplete.size() + toExpire.size());
+        if (changed == 0)
+        {
+            return 0;
+        }
+        version = commit();
+    }
+
+    logStatusChanges(version, swept); // One write for the whole batch
+    for (const BookingPtr &booking : expired)
+    {
+        BookingEvent event;
+        event.type = BookingEventType::CANCELLED;
+        event.booking = *booking;
+        notifyObservers(event);
+        serveWaitlist(booking->getCourtId(), booking->getStartTime(), booking->getEndTime());
+    }
+    return changed;
+}
+
+void BookingManager::runSweeper()
+{
+    while (m_sweepRunning.load())
+    {
+        sweepLifecycle(std::time(nullptr));
+
+        // (+ passes SWEEP_INTERVAL_SECONDS by value, so it needs no definition)
+        std::unique_lock<std::mutex> lock(m_sweepWakeMutex);
+        m_sweepWake.wait_for(lock, std::chrono::seconds(+SWEEP_INTERVAL_SECONDS), [this]
+                             { return !m_sweepRunning.load(); });
+    }
+}
+
+void BookingManager::serveWaitlist(int courtId, std::time_t startTime, std::time_t endTime)
+{
+    std::vector<WaitlistEntry> candidates;
+    {
+        std::lock_guard<std::mutex> waitLock(m_waitlistLock);
+        candidates = m_waitlist.findOverlapping(courtId, startTime, endTime);
+    }
+    if (candidates.empty())
+    {
+        return;
+    }
+
+    std::time_t now = std::time(nullptr);
+    for (const WaitlistEntry &entry : candidates)
+    {
+        // On a busy evening most requests still clash with something; skip them unclaimed
+        bool started = entry.startTime <= now;
+        if (!started && !isCourtAvailable(courtId, entry.startTime, entry.endTime))
+        {
+            continue;
+        }
+
+        // Claimed first, so concurrent frees cannot serve one request twice
+        {
+            std::lock_guard<std::mutex> waitLock(m_waitlistLock);
+            if (!m_waitlist.remove(entry.id))
+            {
+                continue;
+            }
+            logWaitlistRemoval(entry.id);
+        }
+        if (started)
+        {
+            continue;
+        }
+
+        Booking booking(entry.userId, courtId, DateTimeUtils::getStartOfDay(entry.startTime),
+                        entry.startTime, entry.endTime, entry.amount);
+        booking.setNotes(entry.notes);
+        bool served;
+        if (entry.autoBook)
+        {
+            booking.setStatus(BookingStatus::CONFIRMED);
+            served = createBooking(booking);
+        }
+        else
+        {
+            served = placeHold(entry.userId, courtId, entry.startTime, entry.endTime, WAITLIST_OFFER_SECONDS) != 0;
+            if (served)
+            {
+                BookingEvent event;
+                event.type = BookingEventType::WAITLIST_OFFER;
+                event.booking = booking;
+                notifyObservers(event);
+            }
+        }
+
+        if (!served)
+        {
+            // Taken again since the check; the request keeps its place in line
+            std::lock_guard<std::mutex> waitLock(m_waitlistLock);
+            m_waitlist.restore(entry);
+            logWaitlistEntry(entry);
+        }
+    }
+}
+
+int BookingManager::findSeriesConflict(const CourtStripe &stripe, int courtId, std::time_t startTime,
+                                       std::time_t endTime) const
+{
+    auto it = stripe.seriesByCourt.find(courtId);
+    if (it == stripe.seriesByCourt.end())
+        return 0;
+
+    // Few series per court, each answering from its rule without expanding
+    for (const SeriesPtr &series : it->second)
+    {
+        if (series->overlaps(startTime, endTime))
+            return series->getId();
+    }
+    return 0;
+}
+
+uint64_t BookingManager::publishSeries(CourtStripe &stripe, const SeriesPtr &series, const SeriesPtr &previous)
+{
+    std::vector<SeriesPtr> &courtSeries = stripe.seriesByCourt[series->getCourtId()];
+    courtSeries.erase(std::remove_if(courtSeries.begin(), courtSeries.end(),
+                                     [&series](const SeriesPtr &entry)
+                                     {
+                                         return entry->getId() == series->getId();
+                                     }),
+                      courtSeries.end());
+    if (series->isActive())
+    {
+        courtSeries.push_back(series);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(m_dataLock);
+    m_series[series->getId()] = series;
+    m_occupancy.removeSeries(series->getCourtId(), series->getId());
+    if (series->isActive())
     {
-        if (b->getId() > maxId)
+        m_occupancy.addSeries(series);
+    }
+
+    // Subscribers see occurrences as bookings: all of a new series, then each one dropped
+    std::time_t now = std::time(nullptr);
+    for (const auto &occurrence : (previous ? previous : series)->getAllOccurrences())
+    {
+        auto booking = std::make_shared<Booking>(series->toBooking(occurrence.first, occurrence.second));
+        if (!previous)
+        {
+            recordChange(ChangeType::BOOKING_CREATED, booking);
+        }
+        else if (!series->occursOn(DateTimeUtils::getDayKey(occurrence.first)))
         {
-            maxId = b->getId();
+            booking->setStatus(BookingStatus::CANCELLED);
+            recordChange(ChangeType::BOOKING_CANCELLED, booking);
+            if (occurrence.first > now)
+            {
+                m_reminders.cancel(booking->getId());
+            }
         }
     }
-    booking.setId(maxId + 1);
+    scheduleSeriesReminder(*series, now + ReminderScheduler::REMINDER_LEAD_SECONDS);
+    return commit();
 }
 
 void BookingManager::sortBookingsByDate()
 {
     std::sort(m_bookings.begin(), m_bookings.end(),
-              [](const Booking* a, const Booking* b)
+              [](const BookingPtr &a, const BookingPtr &b)
               {
                   return a->getStartTime() < b->getStartTime();
               });
 }
+
+void BookingManager::indexNotes(const Booking &booking)
+{
+    if (booking.getNotes().empty())
+    {
+        m_noteSearch.removeDocument(booking.getId());
+    }
+    else
+    {
+        m_noteSearch.addDocument(booking.getId(), {booking.getNotes()});
+    }
+}
+
+void BookingManager::refreshOccupancy(int courtId, std::time_t startTime, std::time_t endTime)
+{
+    // Bits cannot be cleared per booking (neighbours may share a 5-minute slot),
+    // so rebuild each affected day from the bookings that start near it
+    for (std::time_t day = DateTimeUtils::getStartOfDay(startTime); day < endTime;
+         day = DateTimeUtils::toLocal(day).dayEnd)
+    {
+        m_occupancy.clearDay(courtId, day);
+
+        BookingQuery query;
+        query.courtId = courtId;
+        query.fromTime = day - 24 * 3600;
+        query.toTime = DateTimeUtils::getEndOfDay(day);
+        for (int bookingId : m_index.query(query))
+        {
+            const Booking* booking = m_index.find(bookingId);
+            if (booking && booking->getStatus() != BookingStatus::CANCELLED && booking->getEndTime() > day)
+            {
+                m_occupancy.mark(courtId, booking->getStartTime(), booking->getEndTime());
+            }
+        }
+    }
+}
+
+BookingPtr BookingManager::findBooking(int bookingId) const
+{
+    if (!BookingSeries::isOccurrenceId(bookingId))
+    {
+        return m_index.findPtr(bookingId);
+    }
+
+    auto it = m_series.find(BookingSeries::getSeriesIdOf(bookingId));
+    std::time_t start, end;
+    if (it == m_series.end() ||
+        !it->second->getOccurrence(DateTimeUtils::getDayStart(it->second->getOccurrenceDay(bookingId)), start, end))
+    {
+        return BookingPtr();
+    }
+    return std::make_shared<Booking>(it->second->toBooking(start, end));
+}
+
+std::vector<int> BookingManager::queryBookingIds(const BookingQuery &query) const
+{
+    std::vector<int> bookingIds = m_index.query(query);
+    if (m_series.empty() || (query.filterStatus && query.status != BookingStatus::CONFIRMED))
+    {
+        return bookingIds;
+    }
+
+    int today = DateTimeUtils::getDayKey(std::time(nullptr));
+    std::time_t from = query.fromTime > 0 ? query.fromTime : DateTimeUtils::getDayStart(today - SERIES_LIST_DAYS);
+    std::time_t to = query.toTime > 0 ? query.toTime + 1 : DateTimeUtils::getDayStart(today + SERIES_LIST_DAYS + 1);
+    std::vector<std::pair<std::time_t, int>> occurrences;
+    for (const auto &entry : m_series)
+    {
+        const BookingSeries &series = *entry.second;
+        if ((query.courtId > 0 && series.getCourtId() != query.courtId) ||
+            (query.userId > 0 && series.getUserId() != query.userId))
+            continue;
+
+        for (const auto &occurrence : series.getOccurrences(from, to))
+        {
+            int occurrenceId = series.getOccurrenceId(DateTimeUtils::getDayKey(occurrence.first));
+            if (!query.restrictToIds ||
+                std::binary_search(query.bookingIds.begin(), query.bookingIds.end(), occurrenceId))
+            {
+                occurrences.emplace_back(occurrence.first, occurrenceId);
+            }
+        }
+    }
+    if (occurrences.empty())
+    {
+        return bookingIds;
+    }
+
+    // Both sides in (start time, id) order, as the index returns them
+    std::sort(occurrences.begin(), occurrences.end());
+    std::vector<std::pair<std::time_t, int>> merged;
+    merged.reserve(bookingIds.size() + occurrences.size());
+    auto next = occurrences.begin();
+    for (int bookingId : bookingIds)
+    {
+        std::pair<std::time_t, int> key(m_index.find(bookingId)->getStartTime(), bookingId);
+        for (; next != occurrences.end() && *next < key; ++next)
+        {
+            merged.push_back(*next);
+        }
+        merged.push_back(key);
+    }
+    merged.insert(merged.end(), next, occurrences.end());
+
+    bookingIds.clear();
+    bookingIds.reserve(merged.size());
+    for (const auto &entry : merged)
+    {
+        bookingIds.push_back(entry.second);
+    }
+    return bookingIds;
+}
+
+void BookingManager::scheduleSeriesReminder(const BookingSeries &series, std::time_t after)
+{
+    std::time_t start, end;
+    if (series.getNextOccurrence(after, start, end))
+    {
+        m_reminders.update(series.toBooking(start, end));
+    }
+}
+
+void BookingManager::rebuildReminders()
+{
+    // Only bookings starting after the lead window can still get a reminder
+    const auto &timeIndex = m_index.getTimeIndex();
+    std::time_t from = std::time(nullptr) + ReminderScheduler::REMINDER_LEAD_SECONDS;
+    auto first = std::lower_bound(timeIndex.begin(), timeIndex.end(),
+                                  std::make_pair(from, 0));
+
+    std::vector<const Booking*> upcoming;
+    upcoming.reserve(timeIndex.end() - first);
+    for (auto it = first; it != timeIndex.end(); ++it)
+    {
+        upcoming.push_back(m_index.find(it->second));
+    }
+    m_reminders.rebuild(upcoming);
+    for (const auto &entry : m_series)
+    {
+        scheduleSeriesReminder(*entry.second, from);
+    }
+}
+
+void BookingManager::startSweeper()
+{
+    if (!m_sweepRunning.exchange(true))
+    {
+        m_sweepThread = std::thread(&BookingManager::runSweeper, this);
+    }
+}
+
+void BookingManager::startReminders()
+{
+    m_reminders.start([this](const Booking &booking)
+                      {
+                          BookingEvent event;
+                          event.type = BookingEventType::REMINDER;
+                          event.booking = booking;
+                          m_dispatcher.publish(event);
+
+                          if (BookingSeries::isOccurrenceId(booking.getId()))
+                          {
+                              std::shared_lock<std::shared_mutex> lock(m_dataLock);
+                              auto it = m_series.find(BookingSeries::getSeriesIdOf(booking.getId()));
+                              if (it != m_series.end())
+                              {
+                                  scheduleSeriesReminder(*it->second,
+                                                         std::max(booking.getStartTime(),
+                                                                  std::time(nullptr) + ReminderScheduler::REMINDER_LEAD_SECONDS));
+                              }
+                          }
+                      });
+}
@@ -0,0 +1,971 @@
+#include "BookingServer.h"
+#include "BookingController.h"
+#include "BookingProtocol.h"
+#include "CourtController.h"
+#include "SocketUtils.h"
+#include <algorithm>
+#include <cstdio>
+
+#if defined(_WIN32)
+#ifndef _WIN32_WINNT
+#define _WIN32_WINNT 0x0600 // WSAPoll
+#endif
+#include <winsock2.h>
+#elif defined(__linux__)
+#include <cerrno>
+#include <sys/epoll.h>
+#include <unistd.h>
+#else
+#include <cerrno>
+#include <poll.h>
+#endif
+
+namespace
+{
+    // Connection ids start after these, and are never reused, so a late
+    // completion can never reach a newer connection on a recycled socket
+    const uint64_t LISTENER_ID = 0;
+    const uint64_t WAKEUP_ID = 1;
+    const uint64_t FIRST_CONNECTION_ID = 2;
+
+    const size_t READ_CHUNK_SIZE = 16 * 1024;
+    const size_t FEED_READ_BATCH = 256; // Change records copied per feed lock
+    const size_t STATUS_RESPONSE_SIZE = 6; // u8 op | u32 requestId | u8 status
+
+    // Response header; the caller appends the body, if any
+    MessageWriter beginResponse(ProtocolOp op, uint32_t requestId, ProtocolStatus status)
+    {
+        MessageWriter writer;
+        writer.writeU8(static_cast<uint8_t>(op));
+        writer.writeU32(requestId);
+        writer.writeU8(static_cast<uint8_t>(status));
+        return writer;
+    }
+
+    std::string respond(ProtocolOp op, uint32_t requestId, ProtocolStatus status)
+    {
+        return beginResponse(op, requestId, status).finish();
+    }
+
+#if !defined(__linux__)
+    int pollSockets(std::vector<pollfd> &fds)
+    {
+#ifdef _WIN32
+        return WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), -1);
+#else
+        return ::poll(fds.data(), static_cast<nfds_t>(fds.size()), -1);
+#endif
+    }
+
+    pollfd makePollEntry(intptr_t socket, short events)
+    {
+        pollfd entry{};
+#ifdef _WIN32
+        entry.fd = static_cast<SOCKET>(socket);
+#else
+        entry.fd = static_cast<int>(socket);
+#endif
+        entry.events = events;
+        return entry;
+    }
+#endif
+}
+
+BookingServer::BookingServer(BookingController &bookingController, CourtController &courtController)
+    : m_bookingController(bookingController), m_courtController(courtController), m_changeFeed(nullptr),
+      m_listener(SocketUtils::INVALID_HANDLE), m_wakeRead(SocketUtils::INVALID_HANDLE),
+      m_wakeWrite(SocketUtils::INVALID_HANDLE), m_poller(-1), m_nextConnectionId(FIRST_CONNECTION_ID),
+      m_subscriberCount(0), m_stopWorkers(false), m_wakePending(false), m_running(false), m_requestCount(0),
+      m_connectionCount(0)
+{
+}
+
+BookingServer::~BookingServer()
+{
+    stop();
+}
+
+bool BookingServer::start(const std::string &address, int workerCount)
+{
+    if (m_running.load())
+    {
+        m_lastError = "Server is already running";
+        return false;
+    }
+
+    m_listener = SocketUtils::listenOn(address, m_lastError);
+    if (m_listener == SocketUtils::INVALID_HANDLE)
+        return false;
+
+    if (!SocketUtils::createWakeupPair(m_wakeRead, m_wakeWrite))
+    {
+        m_lastError = "Cannot create the event loop wakeup socket";
+        SocketUtils::close(m_listener);
+        m_listener = SocketUtils::INVALID_HANDLE;
+        return false;
+    }
+
+#ifdef __linux__
+    m_poller = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u64 = LISTENER_ID;
+    bool registered = m_poller >= 0 && epoll_ctl(static_cast<int>(m_poller), EPOLL_CTL_ADD, static_cast<int>(m_listener), &event) == 0;
+    event.data.u64 = WAKEUP_ID;
+    registered = registered && epoll_ctl(static_cast<int>(m_poller), EPOLL_CTL_ADD, static_cast<int>(m_wakeRead), &event) == 0;
+    if (!registered)
+    {
+        m_lastError = "Cannot create the epoll instance";
+        if (m_poller >= 0)
+            ::close(static_cast<int>(m_poller));
+        m_poller = -1;
+        SocketUtils::close(m_listener);
+        SocketUtils::close(m_wakeRead);
+        SocketUtils::close(m_wakeWrite);
+        m_listener = m_wakeRead = m_wakeWrite = SocketUtils::INVALID_HANDLE;
+        return false;
+    }
+#endif
+
+    if (workerCount <= 0)
+    {
+        workerCount = std::max(2, static_cast<int>(std::thread::hardware_concurrency()));
+    }
+
+    m_address = address;
+    m_stopWorkers = false;
+    m_wakePending = false;
+    m_running = true;
+    for (int i = 0; i < workerCount; ++i)
+    {
+        m_workers.emplace_back(&BookingServer::workerLoop, this);
+    }
+    m_loopThread = std::thread(&BookingServer::eventLoop, this);
+
+    if (m_changeFeed)
+    {
+        // Runs on the committing thread; the loop thread does the pushing
+        m_changeFeed->setListener([this]
+                                  { wakeEventLoop(); });
+    }
+    return true;
+}
+
+void BookingServer::stop()
+{
+    if (!m_running.exchange(false))
+        return;
+
+    if (m_changeFeed)
+    {
+        m_changeFeed->setListener(nullptr);
+    }
+
+    // The loop notices m_running on its next wakeup and closes every connection
+    char wake = 0;
+    SocketUtils::sendSome(m_wakeWrite, &wake, 1);
+    m_loopThread.join();
+
+    // Workers finish the requests already queued; their responses are dropped
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        m_stopWorkers = true;
+    }
+    m_jobsReady.notify_all();
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+    m_completions.clear();
+
+#ifdef __linux__
+    ::close(static_cast<int>(m_poller));
+    m_poller = -1;
+#endif
+    SocketUtils::close(m_listener);
+    SocketUtils::close(m_wakeRead);
+    SocketUtils::close(m_wakeWrite);
+    m_listener = m_wakeRead = m_wakeWrite = SocketUtils::INVALID_HANDLE;
+
+    if (m_address.compare(0, 5, "unix:") == 0)
+    {
+        std::remove(m_address.substr(5).c_str());
+    }
+}
+
+void BookingServer::eventLoop()
+{
+#ifdef __linux__
+    epoll_event events[64];
+    while (m_running.load())
+    {
+        int count = epoll_wait(static_cast<int>(m_poller), events, 64, -1);
+        if (count < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        for (int i = 0; i < count; ++i)
+        {
+            uint64_t id = events[i].data.u64;
+            if (id == LISTENER_ID)
+            {
+                acceptConnections();
+                continue;
+            }
+            if (id == WAKEUP_ID)
+            {
+                collectCompletions();
+                continue;
+            }
+
+            auto it = m_connections.find(id);
+            if (it == m_connections.end())
+                continue; // Closed earlier in this batch
+
+            bool readable = (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0;
+            bool writable = (events[i].events & EPOLLOUT) != 0;
+            if (!serviceConnection(id, it->second, readable, writable))
+            {
+                closeConnection(id);
+            }
+        }
+    }
+#else
+    std::vector<pollfd> fds;
+    std::vector<uint64_t> ids;
+    while (m_running.load())
+    {
+        // Rebuilt every round; fine for the few hundred desks one server hosts
+        fds.clear();
+        ids.clear();
+        fds.push_back(makePollEntry(m_listener, POLLIN));
+        ids.push_back(LISTENER_ID);
+        fds.push_back(makePollEntry(m_wakeRead, POLLIN));
+        ids.push_back(WAKEUP_ID);
+        for (const auto &entry : m_connections)
+        {
+            short events = static_cast<short>((entry.second.wantRead ? POLLIN : 0) |
+                                              (entry.second.wantWrite ? POLLOUT : 0));
+            fds.push_back(makePollEntry(entry.second.socket, events));
+            ids.push_back(entry.first);
+        }
+
+        int count = pollSockets(fds);
+        if (count < 0)
+        {
+#ifndef _WIN32
+            if (errno == EINTR)
+                continue;
+#endif
+            break;
+        }
+
+        for (size_t i = 0; i < fds.size() && count > 0; ++i)
+        {
+            short revents = fds[i].revents;
+            if (revents == 0)
+                continue;
+            --count;
+
+            if (ids[i] == LISTENER_ID)
+            {
+                acceptConnections();
+                continue;
+            }
+            if (ids[i] == WAKEUP_ID)
+            {
+                collectCompletions();
+                continue;
+            }
+
+            auto it = m_connections.find(ids[i]);
+            if (it == m_connections.end())
+                continue;
+
+            bool readable = (revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+            bool writable = (revents & POLLOUT) != 0;
+            if ((revents & POLLNVAL) || !serviceConnection(ids[i], it->second, readable, writable))
+            {
+                closeConnection(ids[i]);
+            }
+        }
+    }
+#endif
+
+    closeAllConnections();
+}
+
+void BookingServer::acceptConnections()
+{
+    for (;;)
+    {
+        intptr_t socket = SocketUtils::acceptClient(m_listener);
+        if (socket == SocketUtils::INVALID_HANDLE)
+            return; // No more pending connections
+
+        uint64_t id = m_nextConnectionId++;
+        Connection &connection = m_connections[id];
+        connection.socket = socket;
+        connection.wantRead = true;
+
+#ifdef __linux__
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.u64 = id;
+        if (epoll_ctl(static_cast<int>(m_poller), EPOLL_CTL_ADD, static_cast<int>(socket), &event) != 0)
+        {
+            SocketUtils::close(socket);
+            m_connections.erase(id);
+            continue;
+        }
+#endif
+        m_connectionCount.store(m_connections.size());
+    }
+}
+
+bool BookingServer::readFrom(uint64_t connectionId, Connection &connection)
+{
+    char buffer[READ_CHUNK_SIZE];
+    for (;;)
+    {
+        long received = SocketUtils::receiveSome(connection.socket, buffer, sizeof(buffer));
+        if (received < 0)
+            return false;
+        if (received == 0)
+            break;
+
+        connection.input.append(buffer, static_cast<size_t>(received));
+        if (static_cast<size_t>(received) < sizeof(buffer))
+            break;
+    }
+
+    // Split complete frames off the front of the buffer
+    size_t offset = 0;
+    while (connection.input.size() - offset >= BookingProtocol::HEADER_SIZE)
+    {
+        uint32_t length = BookingProtocol::readLength(connection.input.data() + offset);
+        if (length > BookingProtocol::MAX_PAYLOAD_SIZE)
+            return false; // Not a client of ours, or a corrupted stream
+
+        if (connection.input.size() - offset - BookingProtocol::HEADER_SIZE < length)
+            break;
+
+        connection.pending.emplace_back(connection.input, offset + BookingProtocol::HEADER_SIZE, length);
+        offset += BookingProtocol::HEADER_SIZE + length;
+    }
+    connection.input.erase(0, offset);
+
+    if (!connection.inFlight)
+    {
+        dispatchNext(connectionId, connection);
+    }
+    return true;
+}
+
+bool BookingServer::writeTo(Connection &connection)
+{
+    while (connection.outputOffset < connection.output.size())
+    {
+        long sent = SocketUtils::sendSome(connection.socket, connection.output.data() + connection.outputOffset,
+                                          connection.output.size() - connection.outputOffset);
+        if (sent < 0)
+            return false;
+        if (sent == 0)
+            return true; // Socket buffer full; EPOLLOUT/POLLOUT resumes it
+
+        connection.outputOffset += static_cast<size_t>(sent);
+    }
+
+    connection.output.clear();
+    connection.outputOffset = 0;
+    return true;
+}
+
+bool BookingServer::serviceConnection(uint64_t connectionId, Connection &connection, bool readable, bool writable)
+{
+    if (readable && !readFrom(connectionId, connection))
+        return false;
+
+    if (writable)
+    {
+        if (!writeTo(connection))
+            return false;
+
+        // A subscriber held back by a full buffer continues where it stopped
+        if (connection.subscribed && (!pushChanges(connection) || !writeTo(connection)))
+            return false;
+    }
+
+    updateInterest(connectionId, connection);
+    return true;
+}
+
+void BookingServer::collectCompletions()
+{
+    char drain[64];
+    while (SocketUtils::receiveSome(m_wakeRead, drain, sizeof(drain)) > 0)
+    {
+    }
+
+    // Reset before taking the batch so a completion pushed after the swap wakes us again
+    m_wakePending.store(false);
+    std::vector<Completion> completions;
+    {
+        std::lock_guard<std::mutex> lock(m_completionsMutex);
+        completions.swap(m_completions);
+    }
+
+    for (Completion &completion : completions)
+    {
+        auto it = m_connections.find(completion.connectionId);
+        if (it == m_connections.end())
+            continue; // Client left before its response was ready
+
+        Connection &connection = it->second;
+        connection.output += completion.frame;
+        if (completion.subscribed && !connection.subscribed)
+        {
+            connection.subscribed = true;
+            connection.feedEpoch = completion.feedEpoch;
+            connection.feedCursor = completion.feedCursor;
+            ++m_subscriberCount;
+        }
+        dispatchNext(completion.connectionId, connection);
+
+        if (!writeTo(connection))
+        {
+            closeConnection(completion.connectionId);
+            continue;
+        }
+        updateInterest(completion.connectionId, connection);
+    }
+
+    pushChangesToSubscribers();
+}
+
+void BookingServer::pushChangesToSubscribers()
+{
+    if (!m_changeFeed || m_subscriberCount == 0)
+        return;
+
+    uint64_t epoch = m_changeFeed->getEpoch();
+    uint64_t lastSequence = m_changeFeed->getLastSequence();
+    std::vector<uint64_t> lagging;
+    for (auto &entry : m_connections)
+    {
+        Connection &connection = entry.second;
+        if (!connection.subscribed || (connection.feedEpoch == epoch && connection.feedCursor == lastSequence))
+            continue;
+
+        if (!pushChanges(connection) || !writeTo(connection))
+        {
+            lagging.push_back(entry.first);
+            continue;
+        }
+        updateInterest(entry.first, connection);
+    }
+
+    for (uint64_t connectionId : lagging)
+    {
+        closeConnection(connectionId);
+    }
+}
+
+bool BookingServer::pushChanges(Connection &connection)
+{
+    // Stops at the output limit; the rest follows once the client reads.
+    // A cursor the feed can no longer resume means the client resubscribes.
+    std::vector<ChangeRecord> records;
+    while (connection.output.size() - connection.outputOffset < MAX_OUTPUT_BYTES)
+    {
+        records.clear();
+        if (!m_changeFeed->readSince(connection.feedEpoch, connection.feedCursor, FEED_READ_BATCH, records))
+            return false;
+        if (records.empty())
+            break;
+
+        for (const ChangeRecord &record : records)
+        {
+            MessageWriter writer = beginResponse(ProtocolOp::CHANGE_EVENT, 0, ProtocolStatus::OK);
+            writer.writeChange(record);
+            connection.output += writer.finish();
+            connection.feedCursor = record.sequence;
+        }
+    }
+    return true;
+}
+
+void BookingServer::dispatchNext(uint64_t connectionId, Connection &connection)
+{
+    if (connection.pending.empty())
+    {
+        connection.inFlight = false;
+        return;
+    }
+
+    Job job{connectionId, std::move(connection.pending.front())};
+    connection.pending.pop_front();
+    connection.inFlight = true;
+    {
+        std::lock_guard<std::mutex> lock(m_jobsMutex);
+        m_jobs.push_back(std::move(job));
+    }
+    m_jobsReady.notify_one();
+}
+
+void BookingServer::updateInterest(uint64_t connectionId, Connection &connection)
+{
+    // Stop reading from a client that is not draining its responses
+    bool wantRead = connection.pending.size() < MAX_PENDING_REQUESTS &&
+                    connection.output.size() - connection.outputOffset < MAX_OUTPUT_BYTES;
+    bool wantWrite = connection.outputOffset < connection.output.size();
+    if (wantRead == connection.wantRead && wantWrite == connection.wantWrite)
+        return;
+
+    connection.wantRead = wantRead;
+    connection.wantWrite = wantWrite;
+#ifdef __linux__
+    epoll_event event{};
+    event.events = (wantRead ? static_cast<uint32_t>(EPOLLIN) : 0u) | (wantWrite ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+    event.data.u64 = connectionId;
+    epoll_ctl(static_cast<int>(m_poller), EPOLL_CTL_MOD, static_cast<int>(connection.socket), &event);
+#else
+    (void)connectionId; // poll() reads the flags when it rebuilds its set
+#endif
+}
+
+void BookingServer::closeConnection(uint64_t connectionId)
+{
+    auto it = m_connections.find(connectionId);
+    if (it == m_connections.end())
+        return;
+
+    if (it->second.subscribed)
+    {
+        --m_subscriberCount;
+    }
+#ifdef __linux__
+    epoll_ctl(static_cast<int>(m_poller), EPOLL_CTL_DEL, static_cast<int>(it->second.socket), nullptr);
+#endif
+    SocketUtils::close(it->second.socket);
+    m_connections.erase(it);
+    m_connectionCount.store(m_connections.size());
+}
+
+void BookingServer::closeAllConnections()
+{
+    for (auto &entry : m_connections)
+    {
+        SocketUtils::close(entry.second.socket);
+    }
+    m_connections.clear();
+    m_connectionCount.store(0);
+    m_subscriberCount = 0;
+}
+
+void BookingServer::workerLoop()
+{
+    for (;;)
+    {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_jobsMutex);
+            m_jobsReady.wait(lock, [this]
+                             { return m_stopWorkers || !m_jobs.empty(); });
+            if (m_jobs.empty())
+                return; // Stopping and nothing left to run
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        Completion completion;
+        completion.connectionId = job.connectionId;
+        handleRequest(job.payload, completion);
+        {
+            std::lock_guard<std::mutex> lock(m_completionsMutex);
+            m_completions.push_back(std::move(completion));
+        }
+        wakeEventLoop();
+    }
+}
+
+void BookingServer::wakeEventLoop()
+{
+    // One byte per batch is enough; the loop takes every completion at once
+    if (!m_wakePending.exchange(true))
+    {
+        char wake = 1;
+        SocketUtils::sendSome(m_wakeWrite, &wake, 1);
+    }
+}
+
+void BookingServer::handleRequest(const std::string &payload, Completion &completion)
+{
+    m_requestCount.fetch_add(1, std::memory_order_relaxed);
+
+    MessageReader reader(payload.data(), payload.size());
+    ProtocolOp op = static_cast<ProtocolOp>(reader.readU8());
+    uint32_t requestId = reader.readU32();
+    if (!reader.ok())
+    {
+        completion.frame = respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+        return;
+    }
+
+    try
+    {
+        switch (op)
+        {
+        case ProtocolOp::CREATE_BOOKING:
+        case ProtocolOp::CANCEL_BOOKING:
+        case ProtocolOp::MODIFY_BOOKING:
+            completion.frame = executeUpdate(op, requestId, reader);
+            break;
+
+        case ProtocolOp::BATCH:
+            completion.frame = executeBatch(requestId, reader);
+            break;
+
+        case ProtocolOp::SUBSCRIBE:
+            completion.frame = executeSubscribe(requestId, reader, completion);
+            break;
+
+        default:
+        {
+            BookingManager::ReadView view = m_bookingController.openReadView();
+            completion.frame = executeQuery(op, requestId, reader, view, BookingProtocol::PAGE_BYTES);
+            break;
+        }
+        }
+    }
+    catch (...)
+    {
+        completion.subscribed = false;
+        completion.frame = respond(op, requestId, ProtocolStatus::SERVER_ERROR);
+    }
+}
+
+std::string BookingServer::executeUpdate(ProtocolOp op, uint32_t requestId, MessageReader &reader)
+{
+    switch (op)
+    {
+    case ProtocolOp::CREATE_BOOKING:
+    {
+        int userId = reader.readI32();
+        int courtId = reader.readI32();
+        std::time_t bookingDate = static_cast<std::time_t>(reader.readI64());
+        std::time_t startTime = static_cast<std::time_t>(reader.readI64());
+        std::time_t endTime = static_cast<std::time_t>(reader.readI64());
+        std::string notes = reader.readString();
+        if (!reader.ok() || !reader.atEnd())
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        bool created = m_bookingController.createBooking(userId, courtId, bookingDate, startTime, endTime, notes);
+        return respond(op, requestId, created ? ProtocolStatus::OK : ProtocolStatus::REJECTED);
+    }
+
+    case ProtocolOp::CANCEL_BOOKING:
+    {
+        int bookingId = reader.readI32();
+        if (!reader.ok() || !reader.atEnd())
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        if (m_bookingController.cancelBooking(bookingId))
+            return respond(op, requestId, ProtocolStatus::OK);
+        return respond(op, requestId, m_bookingController.getBooking(bookingId) ? ProtocolStatus::REJECTED : ProtocolStatus::NOT_FOUND);
+    }
+
+    case ProtocolOp::MODIFY_BOOKING:
+    {
+        int bookingId = reader.readI32();
+        std::time_t startTime = static_cast<std::time_t>(reader.readI64());
+        std::time_t endTime = static_cast<std::time_t>(reader.readI64());
+        std::string notes = reader.readString();
+        if (!reader.ok() || !reader.atEnd())
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        if (m_bookingController.modifyBooking(bookingId, startTime, endTime, notes))
+            return respond(op, requestId, ProtocolStatus::OK);
+        return respond(op, requestId, m_bookingController.getBooking(bookingId) ? ProtocolStatus::REJECTED : ProtocolStatus::NOT_FOUND);
+    }
+
+    default:
+        return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+    }
+}
+
+std::string BookingServer::executeQuery(ProtocolOp op, uint32_t requestId, MessageReader &reader,
+                                        const BookingManager::ReadView &view, size_t pageBytes)
+{
+    switch (op)
+    {
+    case ProtocolOp::PING:
+        return respond(op, requestId, reader.atEnd() ? ProtocolStatus::OK : ProtocolStatus::BAD_REQUEST);
+
+    case ProtocolOp::GET_BOOKING:
+    {
+        int bookingId = reader.readI32();
+        if (!reader.ok() || !reader.atEnd())
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        BookingPtr booking = view.getBooking(bookingId);
+        if (!booking)
+            return respond(op, requestId, ProtocolStatus::NOT_FOUND);
+
+        MessageWriter writer = beginResponse(op, requestId, ProtocolStatus::OK);
+        writer.writeBooking(*booking);
+        return writer.finish();
+    }
+
+    case ProtocolOp::FIND_BOOKINGS:
+    {
+        BookingQuery query;
+        bool valid = reader.readQuery(query);
+        std::time_t afterStart = static_cast<std::time_t>(reader.readI64());
+        int afterId = reader.readI32();
+        if (!valid || !reader.ok() || !reader.atEnd())
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        // Matches come in (start time, id) order, so the page resumes after the cursor
+        std::vector<int> bookingIds = view.findBookingIds(query);
+        auto first = std::partition_point(bookingIds.begin(), bookingIds.end(),
+                                          [&view, afterStart, afterId](int bookingId)
+                                          {
+                                              std::time_t start = view.getBooking(bookingId)->getStartTime();
+                                              return start < afterStart || (start == afterStart && bookingId <= afterId);
+                                          });
+
+        // At least one booking per page, so the client always moves forward
+        std::vector<BookingPtr> page;
+        size_t bytes = 0;
+        auto it = first;
+        for (; it != bookingIds.end() && (page.empty() || bytes < pageBytes); ++it)
+        {
+            page.push_back(view.getBooking(*it));
+            bytes += MessageWriter::bookingSize(*page.back());
+        }
+
+        MessageWriter writer = beginResponse(op, requestId, ProtocolStatus::OK);
+        writer.writeU8(it != bookingIds.end() ? 1 : 0);
+        writer.writeU32(static_cast<uint32_t>(page.size()));
+        for (const BookingPtr &booking : page)
+        {
+            writer.writeBooking(*booking);
+        }
+        return writer.finish();
+    }
+
+    case ProtocolOp::GET_COURT_OCCUPANCY:
+    {
+        int courtId = reader.readI32();
+        std::time_t date = static_cast<std::time_t>(reader.readI64());
+        if (!reader.ok() || !reader.atEnd())
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        MessageWriter writer = beginResponse(op, requestId, ProtocolStatus::OK);
+        writer.writeDayBits(view.getCourtOccupancy(courtId, date));
+        return writer.finish();
+    }
+
+    case ProtocolOp::GET_AVAILABLE_SLOTS:
+    {
+        int courtId = reader.readI32();
+        std::time_t date = static_cast<std::time_t>(reader.readI64());
+        uint32_t slotMinutes = reader.readU32();
+        if (!reader.ok() || !reader.atEnd() || slotMinutes == 0 || slotMinutes > 24 * 60)
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        auto slots = view.getAvailableSlots(courtId, date, static_cast<int>(slotMinutes));
+        MessageWriter writer = beginResponse(op, requestId, ProtocolStatus::OK);
+        writer.writeU32(static_cast<uint32_t>(slots.size()));
+        for (const auto &slot : slots)
+        {
+            writer.writeI64(slot.first);
+            writer.writeI64(slot.second);
+        }
+        return writer.finish();
+    }
+
+    case ProtocolOp::GET_COURTS:
+    {
+        if (!reader.atEnd())
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        // Courts are only changed from the server's own process, never over the wire
+        std::vector<Court *> courts = m_courtController.getAllCourts();
+        MessageWriter writer = beginResponse(op, requestId, ProtocolStatus::OK);
+        writer.writeU32(static_cast<uint32_t>(courts.size()));
+        for (const Court *court : courts)
+        {
+            writer.writeCourt(*court);
+        }
+        return writer.finish();
+    }
+
+    case ProtocolOp::ESTIMATE_COST:
+    {
+        int courtId = reader.readI32();
+        std::time_t startTime = static_cast<std::time_t>(reader.readI64());
+        std::time_t endTime = static_cast<std::time_t>(reader.readI64());
+        if (!reader.ok() || !reader.atEnd())
+            return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+
+        double cost = m_bookingController.calculateBookingCost(courtId, startTime, endTime);
+        if (cost < 0)
+            return respond(op, requestId, ProtocolStatus::REJECTED);
+
+        MessageWriter writer = beginResponse(op, requestId, ProtocolStatus::OK);
+        writer.writeDouble(cost);
+        return writer.finish();
+    }
+
+    default:
+        // Updates and nested batches cannot run under a read view
+        return respond(op, requestId, ProtocolStatus::BAD_REQUEST);
+    }
+}
+
+std::string BookingServer::executeBatch(uint32_t requestId, MessageReader &reader)
+{
+    uint32_t count = reader.readU32();
+    if (!reader.ok() || count > BookingProtocol::MAX_BATCH_REQUESTS)
+        return respond(ProtocolOp::BATCH, requestId, ProtocolStatus::BAD_REQUEST);
+
+    // Split the envelope first so a malformed one is refused before any work
+    std::vector<std::pair<const char *, uint32_t>> items;
+    items.reserve(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        uint32_t length = reader.readU32();
+        const char *payload = reader.readBytes(length);
+        if (!payload)
+            return respond(ProtocolOp::BATCH, requestId, ProtocolStatus::BAD_REQUEST);
+        items.push_back(std::make_pair(payload, length));
+    }
+    if (!reader.atEnd())
+        return respond(ProtocolOp::BATCH, requestId, ProtocolStatus::BAD_REQUEST);
+
+    // Half a frame shared between the items' pages; the other half is slack
+    // for the small fixed-size answers and the per-item headers
+    size_t pageBytes = std::min<size_t>(BookingProtocol::PAGE_BYTES,
+                                        BookingProtocol::MAX_PAYLOAD_SIZE / 2 / std::max<uint32_t>(count, 1));
+
+    BookingManager::ReadView view = m_bookingController.openReadView();
+    MessageWriter writer = beginResponse(ProtocolOp::BATCH, requestId, ProtocolStatus::OK);
+    writer.writeI64(static_cast<int64_t>(view.getVersion()));
+    writer.writeU32(count);
+    size_t itemsLeft = count;
+    for (const auto &item : items)
+    {
+        MessageReader itemReader(item.first, item.second);
+        ProtocolOp itemOp = static_cast<ProtocolOp>(itemReader.readU8());
+        uint32_t itemId = itemReader.readU32();
+        std::string response = itemReader.ok() ? executeQuery(itemOp, itemId, itemReader, view, pageBytes)
+                                               : respond(itemOp, itemId, ProtocolStatus::BAD_REQUEST);
+
+        // Keep room for a bare status answer to every item still to come
+        --itemsLeft;
+        size_t reserved = itemsLeft * (BookingProtocol::HEADER_SIZE + STATUS_RESPONSE_SIZE);
+        if (writer.size() + response.size() + reserved > BookingProtocol::HEADER_SIZE + BookingProtocol::MAX_PAYLOAD_SIZE)
+        {
+            response = respond(itemOp, itemId, ProtocolStatus::TOO_LARGE);
+        }
+        writer.writeBytes(response.data(), response.size()); // Already a length-prefixed frame
+    }
+    return writer.finish();
+}
+
+std::string BookingServer::executeSubscribe(uint32_t requestId, MessageReader &reader, Completion &completion)
+{
+    uint64_t epoch = static_cast<uint64_t>(reader.readI64());
+    uint64_t afterSequence = static_cast<uint64_t>(reader.readI64());
+    if (!m_changeFeed || !reader.ok() || !reader.atEnd())
+        return respond(ProtocolOp::SUBSCRIBE, requestId, ProtocolStatus::BAD_REQUEST);
+
+    // Resume when every record after the client's position is still retained
+    std::vector<ChangeRecord> probe;
+    if (m_changeFeed->readSince(epoch, afterSequence, 0, probe))
+    {
+        MessageWriter writer = beginResponse(ProtocolOp::SUBSCRIBE, requestId, ProtocolStatus::OK);
+        writer.writeI64(static_cast<int64_t>(epoch));
+        writer.writeI64(static_cast<int64_t>(afterSequence));
+        writer.writeU8(0);
+
+        completion.subscribed = true;
+        completion.feedEpoch = epoch;
+        completion.feedCursor = afterSequence;
+        return writer.finish();
+    }
+
+    // Otherwise start from a snapshot. Booking records are published under
+    // the manager's writer lock, so none can slip in while the view is open;
+    // a court or user change racing with it is simply applied twice.
+    BookingManager::ReadView view = m_bookingController.openReadView();
+    std::vector<Court> courts;
+    std::vector<User> users;
+    uint64_t sequence;
+    m_changeFeed->getDirectory(epoch, sequence, courts, users);
+
+    // Series occurrences follow the bookings, as the feed publishes them too
+    const std::vector<BookingPtr> &bookings = view.getBookings();
+    std::vector<BookingPtr> occurrences = view.getSeriesBookings();
+    size_t bookingCount = bookings.size() + occurrences.size();
+
+    MessageWriter writer = beginResponse(ProtocolOp::SUBSCRIBE, requestId, ProtocolStatus::OK);
+    writer.writeI64(static_cast<int64_t>(epoch));
+    writer.writeI64(static_cast<int64_t>(sequence));
+    writer.writeU8(1);
+    writer.writeU32(static_cast<uint32_t>(courts.size()));
+    writer.writeU32(static_cast<uint32_t>(users.size()));
+    writer.writeU32(static_cast<uint32_t>(bookingCount));
+    std::string frames = writer.finish();
+
+    // The records follow in chunks that each fit in a frame; every chunk
+    // takes at least one record, so the loop always moves forward
+    size_t nextCourt = 0;
+    size_t nextUser = 0;
+    size_t nextBooking = 0;
+    while (nextCourt < courts.size() || nextUser < users.size() || nextBooking < bookingCount)
+    {
+        MessageWriter chunk = beginResponse(ProtocolOp::SNAPSHOT_CHUNK, requestId, ProtocolStatus::OK);
+        size_t countAt = chunk.size();
+        chunk.writeU32(0);
+        size_t first = nextCourt;
+        for (; nextCourt < courts.size() && chunk.size() < BookingProtocol::PAGE_BYTES; ++nextCourt)
+        {
+            chunk.writeCourt(courts[nextCourt]);
+        }
+        chunk.setU32(countAt, static_cast<uint32_t>(nextCourt - first));
+
+        countAt = chunk.size();
+        chunk.writeU32(0);
+        first = nextUser;
+        for (; nextUser < users.size() && chunk.size() < BookingProtocol::PAGE_BYTES; ++nextUser)
+        {
+            chunk.writeUser(users[nextUser]);
+        }
+        chunk.setU32(countAt, static_cast<uint32_t>(nextUser - first));
+
+        countAt = chunk.size();
+        chunk.writeU32(0);
+        first = nextBooking;
+        for (; nextBooking < bookingCount && chunk.size() < BookingProtocol::PAGE_BYTES; ++nextBooking)
+        {
+            chunk.writeBooking(nextBooking < bookings.size() ? *bookings[nextBooking]
+                                                             : *occurrences[nextBooking - bookings.size()]);
+        }
+        chunk.setU32(countAt, static_cast<uint32_t>(nextBooking - first));
+
+        frames += chunk.finish();
+    }
+
+    completion.subscribed = true;
+    completion.feedEpoch = epoch;
+    completion.feedCursor = sequence;
+    return frames;
+}
@@ -0,0 +1,163 @@
+#include "ChangeFeed.h"
+#include <chrono>
+#include <random>
+
+ChangeFeed::ChangeFeed(size_t capacity)
+    : m_capacity(capacity > 0 ? capacity : 1), m_epoch(newEpoch()), m_lastSequence(0)
+{
+}
+
+uint64_t ChangeFeed::publishBooking(ChangeType type, const BookingPtr &booking)
+{
+    ChangeRecord record;
+    record.type = type;
+    record.booking = booking;
+    return append(std::move(record));
+}
+
+uint64_t ChangeFeed::publishCourt(const Court &court)
+{
+    ChangeRecord record;
+    record.type = ChangeType::COURT_CHANGED;
+    record.court = std::make_shared<const Court>(court);
+    return append(std::move(record));
+}
+
+uint64_t ChangeFeed::publishCourtRemoved(int courtId)
+{
+    ChangeRecord record;
+    record.type = ChangeType::COURT_REMOVED;
+    record.removedId = courtId;
+    return append(std::move(record));
+}
+
+uint64_t ChangeFeed::publishUser(const User &user)
+{
+    // Password hashes never leave the server
+    auto profile = std::make_shared<User>(user);
+    profile->setPassword("");
+
+    ChangeRecord record;
+    record.type = ChangeType::USER_CHANGED;
+    record.user = profile;
+    return append(std::move(record));
+}
+
+uint64_t ChangeFeed::publishUserRemoved(int userId)
+{
+    ChangeRecord record;
+    record.type = ChangeType::USER_REMOVED;
+    record.removedId = userId;
+    return append(std::move(record));
+}
+
+void ChangeFeed::restart()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_epoch = newEpoch();
+    m_lastSequence = 0;
+    m_records.clear();
+    if (m_listener)
+    {
+        m_listener(); // Subscribers on the old epoch have to resynchronize
+    }
+}
+
+uint64_t ChangeFeed::getEpoch() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_epoch;
+}
+
+uint64_t ChangeFeed::getLastSequence() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lastSequence;
+}
+
+bool ChangeFeed::readSince(uint64_t epoch, uint64_t after, size_t maxCount, std::vector<ChangeRecord> &records) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (epoch != m_epoch || after > m_lastSequence)
+        return false;
+
+    // Sequences are contiguous, so the first wanted record is found by offset
+    uint64_t firstRetained = m_lastSequence - m_records.size() + 1;
+    if (after + 1 < firstRetained)
+        return false;
+
+    for (size_t i = static_cast<size_t>(after + 1 - firstRetained); i < m_records.size() && maxCount > 0; ++i, --maxCount)
+    {
+        records.push_back(m_records[i]);
+    }
+    return true;
+}
+
+void ChangeFeed::getDirectory(uint64_t &epoch, uint64_t &sequence, std::vector<Court> &courts,
+                              std::vector<User> &users) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    epoch = m_epoch;
+    sequence = m_lastSequence;
+
+    courts.clear();
+    for (const auto &entry : m_courts)
+    {
+        courts.push_back(*entry.second);
+    }
+    users.clear();
+    for (const auto &entry : m_users)
+    {
+        users.push_back(*entry.second);
+    }
+}
+
+void ChangeFeed::setListener(std::function<void()> listener)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_listener = std::move(listener);
+}
+
+uint64_t ChangeFeed::append(ChangeRecord record)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    record.sequence = ++m_lastSequence;
+
+    switch (record.type)
+    {
+    case ChangeType::COURT_CHANGED:
+        m_courts[record.court->getId()] = record.court;
+        break;
+    case ChangeType::COURT_REMOVED:
+        m_courts.erase(record.removedId);
+        break;
+    case ChangeType::USER_CHANGED:
+        m_users[record.user->getId()] = record.user;
+        break;
+    case ChangeType::USER_REMOVED:
+        m_users.erase(record.removedId);
+        break;
+    default:
+        break;
+    }
+
+    m_records.push_back(std::move(record));
+    if (m_records.size() > m_capacity)
+    {
+        m_records.pop_front();
+    }
+
+    if (m_listener)
+    {
+        m_listener();
+    }
+    return m_lastSequence;
+}
+
+uint64_t ChangeFeed::newEpoch()
+{
+    // Differs between runs and between restarts within one run
+    std::random_device device;
+    uint64_t random = (static_cast<uint64_t>(device()) << 32) ^ device();
+    return random ^ static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+}
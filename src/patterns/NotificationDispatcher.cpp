@@ -0,0 +1,205 @@
+#include "NotificationDispatcher.h"
+#include "NotificationObserver.h"
+#include <algorithm>
+#include <chrono>
+
+NotificationDispatcher::NotificationDispatcher()
+    : m_events(EVENT_QUEUE_CAPACITY), m_nextSequence(1), m_droppedEvents(0), m_running(false)
+{
+}
+
+NotificationDispatcher::~NotificationDispatcher()
+{
+    shutdown();
+}
+
+void NotificationDispatcher::addObserver(NotificationObserver *observer)
+{
+    if (!observer)
+        return;
+
+    auto queue = std::make_unique<ObserverQueue>();
+    queue->observer = observer;
+    queue->worker = std::thread(&NotificationDispatcher::observerLoop, queue.get());
+
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        m_queues.push_back(std::move(queue));
+    }
+    startThread();
+}
+
+void NotificationDispatcher::removeObserver(NotificationObserver *observer)
+{
+    std::unique_ptr<ObserverQueue> removed;
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        auto it = std::find_if(m_queues.begin(), m_queues.end(),
+                               [observer](const std::unique_ptr<ObserverQueue> &queue)
+                               {
+                                   return queue->observer == observer;
+                               });
+        if (it == m_queues.end())
+            return;
+
+        removed = std::move(*it);
+        m_queues.erase(it);
+    }
+
+    // Outside the lock so the dispatcher keeps serving the other observers
+    stopQueue(removed.get());
+}
+
+bool NotificationDispatcher::publish(BookingEvent event)
+{
+    event.sequence = m_nextSequence.fetch_add(1, std::memory_order_relaxed);
+    while (!m_events.tryPush(event))
+    {
+        if (!m_running.load())
+        {
+            m_droppedEvents.fetch_add(1, std::memory_order_relaxed);
+            return false; // Nobody left to make room
+        }
+
+        // Full: let the dispatcher catch up. It notifies without the mutex,
+        // so the timeout covers a wakeup that slips in before the wait
+        m_wake.notify_one();
+        std::unique_lock<std::mutex> lock(m_spaceMutex);
+        m_space.wait_for(lock, std::chrono::milliseconds(10));
+    }
+
+    m_wake.notify_one();
+    return true;
+}
+
+void NotificationDispatcher::shutdown()
+{
+    if (m_running.exchange(false))
+    {
+        m_wake.notify_one();
+        m_thread.join(); // Drains the ring before exiting
+    }
+
+    std::vector<std::unique_ptr<ObserverQueue>> queues;
+    {
+        std::lock_guard<std::mutex> lock(m_queuesMutex);
+        queues.swap(m_queues);
+    }
+    for (auto &queue : queues)
+    {
+        stopQueue(queue.get());
+    }
+}
+
+void NotificationDispatcher::startThread()
+{
+    if (!m_running.exchange(true))
+    {
+        m_thread = std::thread(&NotificationDispatcher::dispatchLoop, this);
+    }
+}
+
+void NotificationDispatcher::dispatchLoop()
+{
+    BookingEvent event;
+    for (;;)
+    {
+        bool drained = true;
+        while (m_events.tryPop(event))
+        {
+            m_space.notify_all();
+            fanOut(event);
+            drained = false;
+        }
+
+        if (drained && !m_running.load())
+            break;
+
+        if (drained)
+        {
+            // publish() notifies without taking the mutex, so a wakeup can slip
+            // in between the empty check and the wait; the timeout bounds that
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wake.wait_for(lock, std::chrono::milliseconds(50));
+        }
+    }
+}
+
+void NotificationDispatcher::fanOut(const BookingEvent &event)
+{
+    std::lock_guard<std::mutex> lock(m_queuesMutex);
+    for (auto &queue : m_queues)
+    {
+        {
+            // A slow observer holds the others up rather than missing events
+            std::unique_lock<std::mutex> queueLock(queue->mutex);
+            queue->space.wait(queueLock, [&queue]
+                              { return queue->pending.size() < OBSERVER_QUEUE_CAPACITY; });
+            queue->pending.push_back(event);
+        }
+        queue->ready.notify_one();
+    }
+}
+
+void NotificationDispatcher::observerLoop(ObserverQueue *queue)
+{
+    std::unique_lock<std::mutex> lock(queue->mutex);
+    for (;;)
+    {
+        queue->ready.wait(lock, [queue]
+                          { return queue->stopping || !queue->pending.empty(); });
+        if (queue->pending.empty())
+            break; // Stopping and nothing left to deliver
+
+        BookingEvent event = std::move(queue->pending.front());
+        queue->pending.pop_front();
+        queue->space.notify_one();
+
+        // Run the callback unlocked so the dispatcher can keep queueing;
+        // a throwing observer must not take its worker thread down
+        lock.unlock();
+        try
+        {
+            deliver(queue->observer, event);
+        }
+        catch (...)
+        {
+        }
+        lock.lock();
+    }
+}
+
+void NotificationDispatcher::deliver(NotificationObserver *observer, const BookingEvent &event)
+{
+    switch (event.type)
+    {
+    case BookingEventType::CREATED:
+        observer->onBookingCreated(event.booking);
+        break;
+    case BookingEventType::CANCELLED:
+        observer->onBookingCancelled(event.booking);
+        break;
+    case BookingEventType::MODIFIED:
+        observer->onBookingModified(event.previousBooking, event.booking);
+        break;
+    case BookingEventType::REMINDER:
+        observer->onBookingReminder(event.booking);
+        break;
+    case BookingEventType::WAITLIST_OFFER:
+        observer->onWaitlistOffer(event.booking);
+        break;
+    }
+}
+
+void NotificationDispatcher::stopQueue(ObserverQueue *queue)
+{
+    {
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->stopping = true;
+    }
+    queue->ready.notify_one();
+    if (queue->worker.joinable())
+    {
+        queue->worker.join();
+    }
+}
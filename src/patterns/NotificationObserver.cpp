@@ -1,16 +1,56 @@
-// just a placeholder
 #include "NotificationObserver.h"
+#include "NotificationOutbox.h"
+#include "DateTimeUtils.h"
 #include <iostream>
-#include <sstream>
-#include <iomanip>
 #include <ctime>
 #include <algorithm>
 
+namespace
+{
+    // Shared by all email bodies
+    const char *const BOOKING_DETAILS =
+        "Booking ID: {bookingId}\n"
+        "Court ID: {courtId}\n"
+        "Date: {date}\n"
+        "Start Time: {startTime}\n"
+        "End Time: {endTime}\n"
+        "Total Amount: ${amount}\n"
+        "Status: {status}{notesLine}";
+
+    const char *const SIGNATURE = "Best regards,\nBadminton Court Management System";
+}
+
 // EmailNotificationObserver implementation
 EmailNotificationObserver::EmailNotificationObserver(const std::string &smtpServer, int smtpPort,
                                                      const std::string &username, const std::string &password)
     : m_smtpServer(smtpServer), m_smtpPort(smtpPort), m_username(username),
-      m_password(password), m_isEnabled(true)
+      m_password(password), m_isEnabled(true), m_outbox(nullptr),
+      m_createdBody(std::string("Dear {customerName},\n\n"
+                                "Your booking has been successfully created.\n\n") +
+                    BOOKING_DETAILS +
+                    "\n\nThank you for choosing our badminton courts!\n" + SIGNATURE),
+      m_cancelledBody(std::string("Dear {customerName},\n\n"
+                                  "Your booking has been cancelled.\n\n") +
+                      BOOKING_DETAILS +
+                      "\n\nIf you have any questions, please contact us.\n" + SIGNATURE),
+      m_modifiedBody(std::string("Dear {customerName},\n\n"
+                                 "Your booking has been modified.\n\n"
+                                 "New booking details:\n") +
+                     BOOKING_DETAILS +
+                     "\n\nThank you for using our service!\n" + SIGNATURE),
+      m_reminderBody(std::string("Dear {customerName},\n\n"
+                                 "This is a reminder for your upcoming booking.\n\n") +
+                     BOOKING_DETAILS +
+                     "\n\nPlease arrive 15 minutes before your booking time.\n" + SIGNATURE),
+      m_offerBody(std::string("Dear {customerName},\n\n"
+                              "A slot you were waiting for has become free and is held for you.\n\n"
+                              "Court ID: {courtId}\n"
+                              "Date: {date}\n"
+                              "Start Time: {startTime}\n"
+                              "End Time: {endTime}\n"
+                              "Total Amount: ${amount}\n\n"
+                              "Please book it within 15 minutes, after which it is offered to the next customer.\n") +
+                  SIGNATURE)
 {
 }
 
@@ -19,16 +59,7 @@ void EmailNotificationObserver::onBookingCreated(const Booking &booking)
     if (!m_isEnabled)
         return;
 
-    std::string subject = "Booking Confirmation - Badminton Court";
-    std::string body = "Dear Customer,\n\n";
-    body += "Your booking has been successfully created.\n\n";
-    body += formatBookingDetails(booking);
-    body += "\n\nThank you for choosing our badminton courts!\n";
-    body += "Best regards,\nBadminton Court Management System";
-
-    // In a real implementation, this would send an actual email
-    std::cout << "Email sent - Booking Created:\n"
-              << body << std::endl;
+    send(booking, "Booking Confirmation - Badminton Court", m_createdBody);
 }
 
 void EmailNotificationObserver::onBookingCancelled(const Booking &booking)
@@ -36,15 +67,7 @@ void EmailNotificationObserver::onBookingCancelled(const Booking &booking)
     if (!m_isEnabled)
         return;
 
-    std::string subject = "Booking Cancellation - Badminton Court";
-    std::string body = "Dear Customer,\n\n";
-    body += "Your booking has been cancelled.\n\n";
-    body += formatBookingDetails(booking);
-    body += "\n\nIf you have any questions, please contact us.\n";
-    body += "Best regards,\nBadminton Court Management System";
-
-    std::cout << "Email sent - Booking Cancelled:\n"
-              << body << std::endl;
+    send(booking, "Booking Cancellation - Badminton Court", m_cancelledBody);
 }
 
 void EmailNotificationObserver::onBookingModified(const Booking &oldBooking, const Booking &newBooking)
@@ -52,16 +75,7 @@ void EmailNotificationObserver::onBookingModified(const Booking &oldBooking, con
     if (!m_isEnabled)
         return;
 
-    std::string subject = "Booking Modified - Badminton Court";
-    std::string body = "Dear Customer,\n\n";
-    body += "Your booking has been modified.\n\n";
-    body += "New booking details:\n";
-    body += formatBookingDetails(newBooking);
-    body += "\n\nThank you for using our service!\n";
-    body += "Best regards,\nBadminton Court Management System";
-
-    std::cout << "Email sent - Booking Modified:\n"
-              << body << std::endl;
+    send(newBooking, "Booking Modified - Badminton Court", m_modifiedBody);
 }
 
 void EmailNotificationObserver::onBookingReminder(const Booking &booking)
@@ -69,15 +83,15 @@ void EmailNotificationObserver::onBookingReminder(const Booking &booking)
     if (!m_isEnabled)
         return;
 
-    std::string subject = "Booking Reminder - Badminton Court";
-    std::string body = "Dear Customer,\n\n";
-    body += "This is a reminder for your upcoming booking.\n\n";
-    body += formatBookingDetails(booking);
-    body += "\n\nPlease arrive 15 minutes before your booking time.\n";
-    body += "Best regards,\nBadminton Court Management System";
+    send(booking, "Booking Reminder - Badminton Court", m_reminderBody);
+}
+
+void EmailNotificationObserver::onWaitlistOffer(const Booking &offer)
+{
+    if (!m_isEnabled)
+        return;
 
-    std::cout << "Email sent - Booking Reminder:\n"
-              << body << std::endl;
+    send(offer, "Waitlist Slot Available - Badminton Court", m_offerBody);
 }
 
 void EmailNotificationObserver::configure(const std::string &smtpServer, int smtpPort,
@@ -87,44 +101,63 @@ void EmailNotificationObserver::configure(const std::string &smtpServer, int smt
     m_smtpPort = smtpPort;
     m_username = username;
     m_password = password;
+
+    if (m_outbox)
+    {
+        SmtpSettings settings = m_outbox->getSettings();
+        settings.host = m_smtpServer;
+        settings.port = m_smtpPort;
+        settings.username = m_username;
+        settings.password = m_password;
+        m_outbox->configure(settings);
+    }
 }
 
-bool EmailNotificationObserver::sendEmail(const std::string &to, const std::string &subject,
-                                          const std::string &body) const
+void EmailNotificationObserver::setOutbox(NotificationOutbox *outbox)
 {
-    std::cout << "Sending email to: " << to << std::endl;
-    std::cout << "Subject: " << subject << std::endl;
-    std::cout << "Body: " << body << std::endl;
-    return true;
+    m_outbox = outbox;
+    configure(m_smtpServer, m_smtpPort, m_username, m_password);
 }
 
-std::string EmailNotificationObserver::formatBookingDetails(const Booking &booking) const
+void EmailNotificationObserver::send(const Booking &booking, const std::string &subject,
+                                     const NotificationTemplate &body)
 {
-    std::ostringstream oss;
-    oss << "Booking ID: " << booking.getId() << "\n";
-    oss << "Court ID: " << booking.getCourtId() << "\n";
-
-    // Format dates and times
-    std::time_t startTime = booking.getStartTime();
-    std::time_t endTime = booking.getEndTime();
+    NotificationRecipient recipient;
+    if (!m_resolveRecipient || !m_resolveRecipient(booking.getUserId(), recipient) ||
+        recipient.email.empty())
+    {
+        std::cout << "Email skipped - no address for user " << booking.getUserId() << std::endl;
+        return;
+    }
 
-    oss << "Date: " << std::put_time(std::localtime(&startTime), "%Y-%m-%d") << "\n";
-    oss << "Start Time: " << std::put_time(std::localtime(&startTime), "%H:%M") << "\n";
-    oss << "End Time: " << std::put_time(std::localtime(&endTime), "%H:%M") << "\n";
-    oss << "Total Amount: $" << std::fixed << std::setprecision(2) << booking.getTotalAmount() << "\n";
-    oss << "Status: " << booking.getStatusString();
+    m_buffer.clear(); // Keeps its capacity between messages
+    body.render(booking, recipient.fullName, m_dates, m_buffer);
+    sendEmail(recipient.email, subject, m_buffer);
+}
 
-    if (!booking.getNotes().empty())
+bool EmailNotificationObserver::sendEmail(const std::string &to, const std::string &subject,
+                                          const std::string &body) const
+{
+    if (m_outbox)
     {
-        oss << "\nNotes: " << booking.getNotes();
+        m_outbox->enqueue(OutboxChannel::EMAIL, to, subject, body);
+        return true;
     }
 
-    return oss.str();
+    std::cout << "Sending email to: " << to << std::endl;
+    std::cout << "Subject: " << subject << std::endl;
+    std::cout << "Body: " << body << std::endl;
+    return true;
 }
 
 // SMSNotificationObserver implementation
 SMSNotificationObserver::SMSNotificationObserver(const std::string &apiKey, const std::string &apiUrl)
-    : m_apiKey(apiKey), m_apiUrl(apiUrl), m_isEnabled(true)
+    : m_apiKey(apiKey), m_apiUrl(apiUrl), m_isEnabled(true), m_outbox(nullptr),
+      m_createdText("Booking confirmed for Court {courtId}. Booking ID: {bookingId}"),
+      m_cancelledText("Booking {bookingId} has been cancelled."),
+      m_modifiedText("Booking {bookingId} has been modified."),
+      m_reminderText("Reminder: Your booking {bookingId} is coming up soon."),
+      m_offerText("Court {courtId} is free on {date} at {startTime} and held for you for 15 minutes.")
 {
 }
 
@@ -133,10 +166,7 @@ void SMSNotificationObserver::onBookingCreated(const Booking &booking)
     if (!m_isEnabled)
         return;
 
-    std::string message = "Booking confirmed for Court " + std::to_string(booking.getCourtId()) +
-                          ". Booking ID: " + std::to_string(booking.getId());
-
-    std::cout << "SMS sent - Booking Created: " << message << std::endl;
+    send(booking, m_createdText);
 }
 
 void SMSNotificationObserver::onBookingCancelled(const Booking &booking)
@@ -144,9 +174,7 @@ void SMSNotificationObserver::onBookingCancelled(const Booking &booking)
     if (!m_isEnabled)
         return;
 
-    std::string message = "Booking " + std::to_string(booking.getId()) + " has been cancelled.";
-
-    std::cout << "SMS sent - Booking Cancelled: " << message << std::endl;
+    send(booking, m_cancelledText);
 }
 
 void SMSNotificationObserver::onBookingModified(const Booking &oldBooking, const Booking &newBooking)
@@ -154,9 +182,7 @@ void SMSNotificationObserver::onBookingModified(const Booking &oldBooking, const
     if (!m_isEnabled)
         return;
 
-    std::string message = "Booking " + std::to_string(newBooking.getId()) + " has been modified.";
-
-    std::cout << "SMS sent - Booking Modified: " << message << std::endl;
+    send(newBooking, m_modifiedText);
 }
 
 void SMSNotificationObserver::onBookingReminder(const Booking &booking)
@@ -164,23 +190,90 @@ void SMSNotificationObserver::onBookingReminder(const Booking &booking)
     if (!m_isEnabled)
         return;
 
-    std::string message = "Reminder: Your booking " + std::to_string(booking.getId()) +
-                          " is coming up soon.";
+    send(booking, m_reminderText);
+}
 
-    std::cout << "SMS sent - Booking Reminder: " << message << std::endl;
+void SMSNotificationObserver::onWaitlistOffer(const Booking &offer)
+{
+    if (!m_isEnabled)
+        return;
+
+    send(offer, m_offerText);
+}
+
+void SMSNotificationObserver::send(const Booking &booking, const NotificationTemplate &text)
+{
+    NotificationRecipient recipient;
+    if (!m_resolveRecipient || !m_resolveRecipient(booking.getUserId(), recipient) ||
+        recipient.phoneNumber.empty())
+    {
+        std::cout << "SMS skipped - no phone number for user " << booking.getUserId() << std::endl;
+        return;
+    }
+
+    m_buffer.clear();
+    text.render(booking, recipient.fullName, m_dates, m_buffer);
+    sendSMS(recipient.phoneNumber, m_buffer);
 }
 
 bool SMSNotificationObserver::sendSMS(const std::string &phoneNumber, const std::string &message) const
 {
+    if (m_outbox)
+    {
+        m_outbox->enqueue(OutboxChannel::SMS, phoneNumber, std::string(), message);
+        return true;
+    }
+
     // Placeholder implementation for SMS sending
     std::cout << "Sending SMS to: " << phoneNumber << std::endl;
     std::cout << "Message: " << message << std::endl;
     return true;
 }
 
+// InAppNotification implementation
+std::string InAppNotification::formatTimestamp() const
+{
+    return DateTimeUtils::formatDateTime(timestamp);
+}
+
+// InAppNotificationObserver::Inbox implementation
+InAppNotificationObserver::Inbox::Inbox(size_t capacity)
+    : m_capacity(std::max<size_t>(capacity, 1)), m_next(0), m_count(0), m_unread(0)
+{
+}
+
+void InAppNotificationObserver::Inbox::push(InAppNotification notification)
+{
+    // Grow until full, then overwrite the oldest slot in place
+    if (m_items.size() < m_capacity)
+    {
+        m_items.push_back(std::move(notification));
+    }
+    else
+    {
+        m_items[m_next] = std::move(notification);
+    }
+    m_next = (m_next + 1) % m_capacity;
+    m_count = std::min(m_count + 1, m_capacity);
+    m_unread = std::min(m_unread + 1, m_count);
+}
+
+void InAppNotificationObserver::Inbox::clear()
+{
+    m_items.clear();
+    m_next = 0;
+    m_count = 0;
+    m_unread = 0;
+}
+
+const InAppNotification &InAppNotificationObserver::Inbox::at(size_t index) const
+{
+    return m_items[(m_next + m_capacity - 1 - index) % m_capacity];
+}
+
 // InAppNotificationObserver implementation
-InAppNotificationObserver::InAppNotificationObserver(size_t maxNotifications)
-    : m_maxNotifications(maxNotifications)
+InAppNotificationObserver::InAppNotificationObserver(size_t capacityPerUser)
+    : m_capacityPerUser(capacityPerUser)
 {
 }
 
@@ -189,40 +282,83 @@ void InAppNotificationObserver::onBookingCreated(const Booking &booking)
     std::string message = "Booking created successfully for Court " +
                           std::to_string(booking.getCourtId()) +
                           " (ID: " + std::to_string(booking.getId()) + ")";
-    addNotification(message);
+    addNotification(booking, std::move(message));
 }
 
 void InAppNotificationObserver::onBookingCancelled(const Booking &booking)
 {
     std::string message = "Booking " + std::to_string(booking.getId()) + " has been cancelled";
-    addNotification(message);
+    addNotification(booking, std::move(message));
 }
 
 void InAppNotificationObserver::onBookingModified(const Booking &oldBooking, const Booking &newBooking)
 {
     std::string message = "Booking " + std::to_string(newBooking.getId()) + " has been modified";
-    addNotification(message);
+    addNotification(newBooking, std::move(message));
 }
 
 void InAppNotificationObserver::onBookingReminder(const Booking &booking)
 {
     std::string message = "Reminder: Your booking " + std::to_string(booking.getId()) +
                           " is starting soon";
-    addNotification(message);
+    addNotification(booking, std::move(message));
 }
 
-void InAppNotificationObserver::addNotification(const std::string &message)
+void InAppNotificationObserver::onWaitlistOffer(const Booking &offer)
 {
-    // Add timestamp to message
-    std::time_t now = std::time(nullptr);
-    std::ostringstream oss;
-    oss << "[" << std::put_time(std::localtime(&now), "%Y-%m-%d %H:%M:%S") << "] " << message;
+    std::string message = "A slot you were waiting for on Court " + std::to_string(offer.getCourtId()) +
+                          " (" + DateTimeUtils::formatDateTime(offer.getStartTime()) +
+                          ") is held for you for 15 minutes";
+    addNotification(offer, std::move(message));
+}
 
-    m_notifications.push_back(oss.str());
+InAppNotificationObserver::InboxView InAppNotificationObserver::getInbox(int userId) const
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto it = m_inboxes.find(userId);
+    const Inbox *inbox = (it != m_inboxes.end()) ? &it->second : nullptr;
+    return InboxView(std::move(lock), inbox);
+}
 
-    // Remove old notifications if we exceed the limit
-    if (m_notifications.size() > m_maxNotifications)
+size_t InAppNotificationObserver::getUnreadCount(int userId) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_inboxes.find(userId);
+    return (it != m_inboxes.end()) ? it->second.getUnreadCount() : 0;
+}
+
+void InAppNotificationObserver::markAllRead(int userId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_inboxes.find(userId);
+    if (it != m_inboxes.end())
+    {
+        it->second.markAllRead();
+    }
+}
+
+void InAppNotificationObserver::clearInbox(int userId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_inboxes.find(userId);
+    if (it != m_inboxes.end())
+    {
+        it->second.clear();
+    }
+}
+
+void InAppNotificationObserver::addNotification(const Booking &booking, std::string message)
+{
+    InAppNotification notification;
+    notification.timestamp = std::time(nullptr);
+    notification.bookingId = booking.getId();
+    notification.message = std::move(message);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_inboxes.find(booking.getUserId());
+    if (it == m_inboxes.end())
     {
-        m_notifications.erase(m_notifications.begin());
+        it = m_inboxes.emplace(booking.getUserId(), Inbox(m_capacityPerUser)).first;
     }
+    it->second.push(std::move(notification));
 }
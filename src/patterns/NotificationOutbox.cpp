@@ -0,0 +1,513 @@
+#include "NotificationOutbox.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+
+namespace
+{
+    // Log records are one line each, fields separated by '|':
+    //   M|id|channel|state|attempts|createdAt|nextAttemptAt|recipient|subject|body|lastError
+    //   S|id|state|attempts|nextAttemptAt|lastError
+    std::vector<std::string> splitRecord(const std::string &line)
+    {
+        std::vector<std::string> fields;
+        std::string field;
+        std::istringstream iss(line);
+        while (std::getline(iss, field, '|'))
+        {
+            fields.push_back(field);
+        }
+        if (!line.empty() && line.back() == '|')
+        {
+            fields.push_back(std::string());
+        }
+        return fields;
+    }
+}
+
+NotificationOutbox::NotificationOutbox(const std::string &logPath)
+    : m_logPath(logPath), m_deliveredCount(0), m_nextId(1),
+      m_settingsChanged(false), m_running(false)
+{
+    load();
+}
+
+NotificationOutbox::~NotificationOutbox()
+{
+    stop();
+}
+
+void NotificationOutbox::configure(const SmtpSettings &settings)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_settings = settings;
+    m_settingsChanged = true;
+    m_wake.notify_one();
+}
+
+SmtpSettings NotificationOutbox::getSettings() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_settings;
+}
+
+void NotificationOutbox::start()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_running)
+    {
+        m_running = true;
+        m_thread = std::thread(&NotificationOutbox::run, this);
+    }
+}
+
+void NotificationOutbox::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running)
+            return;
+        m_running = false;
+    }
+    m_wake.notify_one();
+    m_thread.join();
+}
+
+int NotificationOutbox::enqueue(OutboxChannel channel, const std::string &recipient,
+                                const std::string &subject, const std::string &body)
+{
+    OutboxMessage message;
+    message.channel = channel;
+    message.recipient = recipient;
+    message.subject = subject;
+    message.body = body;
+    message.createdAt = std::time(nullptr);
+    message.nextAttemptAt = message.createdAt;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    message.id = m_nextId++;
+    appendRecord(encodeMessage(message));
+    m_log.flush();
+
+    m_due.insert(std::make_pair(message.nextAttemptAt, message.id));
+    m_pending.emplace(message.id, std::move(message));
+    m_wake.notify_one();
+    return m_nextId - 1;
+}
+
+size_t NotificationOutbox::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending.size();
+}
+
+size_t NotificationOutbox::getDeliveredCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_deliveredCount;
+}
+
+size_t NotificationOutbox::getFailedCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed.size();
+}
+
+bool NotificationOutbox::getMessage(int messageId, OutboxMessage &message) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_pending.find(messageId);
+    if (it == m_pending.end())
+    {
+        it = m_failed.find(messageId);
+        if (it == m_failed.end())
+            return false;
+    }
+
+    message = it->second;
+    return true;
+}
+
+size_t NotificationOutbox::retryFailed()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::time_t now = std::time(nullptr);
+    size_t count = m_failed.size();
+    for (auto &entry : m_failed)
+    {
+        OutboxMessage &message = entry.second;
+        message.state = OutboxState::PENDING;
+        message.attempts = 0;
+        message.nextAttemptAt = now;
+        appendRecord(encodeState(message));
+        m_due.insert(std::make_pair(now, entry.first));
+        m_pending.emplace(entry.first, std::move(message));
+    }
+    m_failed.clear();
+    m_log.flush();
+    m_wake.notify_one();
+    return count;
+}
+
+void NotificationOutbox::load()
+{
+    // Replay the log; later state records override earlier ones
+    std::map<int, OutboxMessage> messages;
+    std::ifstream file(m_logPath);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::vector<std::string> fields = splitRecord(line);
+        try
+        {
+            if (fields.size() >= 11 && fields[0] == "M")
+            {
+                OutboxMessage message;
+                message.id = std::stoi(fields[1]);
+                message.channel = static_cast<OutboxChannel>(std::stoi(fields[2]));
+                message.state = static_cast<OutboxState>(std::stoi(fields[3]));
+                message.attempts = std::stoi(fields[4]);
+                message.createdAt = std::stoll(fields[5]);
+                message.nextAttemptAt = std::stoll(fields[6]);
+                message.recipient = unescape(fields[7]);
+                message.subject = unescape(fields[8]);
+                message.body = unescape(fields[9]);
+                message.lastError = unescape(fields[10]);
+                messages[message.id] = std::move(message);
+            }
+            else if (fields.size() >= 6 && fields[0] == "S")
+            {
+                auto it = messages.find(std::stoi(fields[1]));
+                if (it != messages.end())
+                {
+                    it->second.state = static_cast<OutboxState>(std::stoi(fields[2]));
+                    it->second.attempts = std::stoi(fields[3]);
+                    it->second.nextAttemptAt = std::stoll(fields[4]);
+                    it->second.lastError = unescape(fields[5]);
+                }
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // Skip damaged records (e.g. a line cut short by a crash)
+            continue;
+        }
+    }
+    file.close();
+
+    // Compact: keep pending and recently failed messages, drop delivered ones.
+    // A failed message's nextAttemptAt is when its last attempt was due.
+    std::time_t failedCutoff = std::time(nullptr) - FAILED_RETENTION_SECONDS;
+    for (auto it = messages.begin(); it != messages.end();)
+    {
+        bool expired = it->second.state == OutboxState::FAILED && it->second.nextAttemptAt < failedCutoff;
+        if (it->second.state == OutboxState::DELIVERED || expired)
+            it = messages.erase(it);
+        else
+            ++it;
+    }
+    std::filesystem::path logPath(m_logPath);
+    if (logPath.has_parent_path())
+    {
+        std::filesystem::create_directories(logPath.parent_path());
+    }
+    std::string tempPath = m_logPath + ".tmp";
+    {
+        std::ofstream compacted(tempPath, std::ios::trunc);
+        for (const auto &entry : messages)
+        {
+            compacted << encodeMessage(entry.second) << "\n";
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(tempPath, m_logPath, error);
+
+    for (auto &entry : messages)
+    {
+        m_nextId = std::max(m_nextId, entry.first + 1);
+        if (entry.second.state == OutboxState::PENDING)
+        {
+            m_due.insert(std::make_pair(entry.second.nextAttemptAt, entry.first));
+            m_pending.emplace(entry.first, std::move(entry.second));
+        }
+        else
+        {
+            m_failed.emplace(entry.first, std::move(entry.second));
+        }
+    }
+
+    m_log.open(m_logPath, std::ios::app);
+}
+
+void NotificationOutbox::appendRecord(const std::string &record)
+{
+    if (m_log.is_open())
+    {
+        m_log << record << "\n";
+    }
+}
+
+std::string NotificationOutbox::encodeMessage(const OutboxMessage &message)
+{
+    std::ostringstream oss;
+    oss << "M|" << message.id << "|"
+        << static_cast<int>(message.channel) << "|"
+        << static_cast<int>(message.state) << "|"
+        << message.attempts << "|"
+        << message.createdAt << "|"
+        << message.nextAttemptAt << "|"
+        << escape(message.recipient) << "|"
+        << escape(message.subject) << "|"
+        << escape(message.body) << "|"
+        << escape(message.lastError);
+    return oss.str();
+}
+
+std::string NotificationOutbox::encodeState(const OutboxMessage &message)
+{
+    std::ostringstream oss;
+    oss << "S|" << message.id << "|"
+        << static_cast<int>(message.state) << "|"
+        << message.attempts << "|"
+        << message.nextAttemptAt << "|"
+        << escape(message.lastError);
+    return oss.str();
+}
+
+std::string NotificationOutbox::escape(const std::string &text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (char c : text)
+    {
+        switch (c)
+        {
+        case '\\':
+            result += "\\\\";
+            break;
+        case '|':
+            result += "\\p";
+            break;
+        case '\n':
+            result += "\\n";
+            break;
+        case '\r':
+            result += "\\r";
+            break;
+        default:
+            result.push_back(c);
+        }
+    }
+    return result;
+}
+
+std::string NotificationOutbox::unescape(const std::string &text)
+{
+    std::string result;
+    result.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i)
+    {
+        if (text[i] != '\\' || i + 1 == text.size())
+        {
+            result.push_back(text[i]);
+            continue;
+        }
+
+        char code = text[++i];
+        switch (code)
+        {
+        case 'p':
+            result.push_back('|');
+            break;
+        case 'n':
+            result.push_back('\n');
+            break;
+        case 'r':
+            result.push_back('\r');
+            break;
+        default:
+            result.push_back(code);
+        }
+    }
+    return result;
+}
+
+void NotificationOutbox::run()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (m_running)
+    {
+        std::time_t now = std::time(nullptr);
+        if (m_due.empty() || m_due.begin()->first > now)
+        {
+            // Idle: release the connection instead of holding it open
+            if (m_client.isConnected())
+            {
+                lock.unlock();
+                m_client.quit();
+                lock.lock();
+                continue;
+            }
+
+            if (m_due.empty())
+                m_wake.wait(lock);
+            else
+                m_wake.wait_for(lock, std::chrono::seconds(m_due.begin()->first - now));
+            continue;
+        }
+
+        std::vector<OutboxMessage> batch = takeDueBatch(now);
+        SmtpSettings settings = m_settings;
+        bool reconnect = m_settingsChanged;
+        m_settingsChanged = false;
+
+        lock.unlock();
+        if (reconnect)
+        {
+            m_client.quit();
+        }
+        deliverBatch(batch, settings);
+        lock.lock();
+
+        applyResults(batch);
+    }
+
+    lock.unlock();
+    m_client.quit();
+}
+
+std::vector<OutboxMessage> NotificationOutbox::takeDueBatch(std::time_t now)
+{
+    std::vector<OutboxMessage> batch;
+    while (!m_due.empty() && m_due.begin()->first <= now && batch.size() < BATCH_SIZE)
+    {
+        auto it = m_pending.find(m_due.begin()->second);
+        m_due.erase(m_due.begin());
+        if (it != m_pending.end())
+        {
+            batch.push_back(it->second);
+        }
+    }
+    return batch;
+}
+
+void NotificationOutbox::deliverBatch(std::vector<OutboxMessage> &batch, const SmtpSettings &settings)
+{
+    bool unreachable = false; // Don't retry the connection for every message of the batch
+    std::string connectError;
+    for (OutboxMessage &message : batch)
+    {
+        std::time_t now = std::time(nullptr);
+
+        std::string address = message.recipient;
+        if (message.channel == OutboxChannel::SMS)
+        {
+            if (settings.smsGatewayDomain.empty())
+            {
+                recordAttempt(message, false, true, "No SMS gateway configured", now);
+                continue;
+            }
+            address.clear();
+            for (char c : message.recipient)
+            {
+                if (c >= '0' && c <= '9')
+                    address.push_back(c);
+            }
+            address += "@" + settings.smsGatewayDomain;
+        }
+
+        if (unreachable || !ensureConnected(settings))
+        {
+            if (!unreachable)
+            {
+                unreachable = true;
+                connectError = m_client.getLastError();
+            }
+            recordAttempt(message, false, false, connectError, now);
+            continue;
+        }
+
+        if (m_client.sendMail(settings.sender, address, message.subject, message.body))
+        {
+            recordAttempt(message, true, false, std::string(), now);
+            continue;
+        }
+
+        recordAttempt(message, false, m_client.isPermanentFailure(), m_client.getLastError(), now);
+        if (m_client.isConnected())
+        {
+            m_client.reset(); // Clear the rejected transaction and keep the connection
+        }
+    }
+}
+
+bool NotificationOutbox::ensureConnected(const SmtpSettings &settings)
+{
+    if (m_client.isConnected())
+        return true;
+
+    if (!m_client.connect(settings.host, settings.port) || !m_client.hello("badminton-court-manager"))
+    {
+        m_client.close();
+        return false;
+    }
+    if (!settings.username.empty() && !m_client.login(settings.username, settings.password))
+    {
+        m_client.quit();
+        return false;
+    }
+    return true;
+}
+
+void NotificationOutbox::recordAttempt(OutboxMessage &message, bool delivered, bool permanent,
+                                       const std::string &error, std::time_t now) const
+{
+    message.attempts++;
+    message.lastError = error;
+    if (delivered)
+    {
+        message.state = OutboxState::DELIVERED;
+        return;
+    }
+
+    if (permanent || message.attempts >= MAX_ATTEMPTS)
+    {
+        message.state = OutboxState::FAILED;
+        return;
+    }
+
+    // 30 s, 1 min, 2 min, ... capped at an hour
+    std::time_t delay = BASE_RETRY_SECONDS << std::min(message.attempts - 1, 16);
+    message.nextAttemptAt = now + std::min(delay, +MAX_RETRY_SECONDS); // + copies the cap so it needs no definition
+}
+
+void NotificationOutbox::applyResults(const std::vector<OutboxMessage> &batch)
+{
+    for (const OutboxMessage &message : batch)
+    {
+        appendRecord(encodeState(message));
+
+        auto it = m_pending.find(message.id);
+        if (it == m_pending.end())
+            continue;
+
+        if (message.state == OutboxState::PENDING)
+        {
+            it->second = message;
+            m_due.insert(std::make_pair(message.nextAttemptAt, message.id));
+        }
+        else
+        {
+            if (message.state == OutboxState::DELIVERED)
+                m_deliveredCount++;
+            else
+                m_failed[message.id] = message;
+            m_pending.erase(it);
+        }
+    }
+
+    // One flush per batch rather than per message
+    m_log.flush();
+}
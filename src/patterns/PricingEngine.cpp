@@ -0,0 +1,325 @@
+#include "PricingEngine.h"
+#include "DateTimeUtils.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+PricingEngine *PricingEngine::m_instance = nullptr;
+std::mutex PricingEngine::m_instanceMutex;
+
+namespace
+{
+    const int DAY_STRIDE = PricingEngine::MINUTES_PER_DAY + 1;
+    const unsigned ALL_DAYS = 0x7F;
+    const char *const DAY_NAMES[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+
+    bool sameLetters(char a, char b)
+    {
+        return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    }
+
+    int parseDayName(const std::string &name)
+    {
+        for (int day = 0; day < 7; ++day)
+        {
+            if (name.size() == 3 && std::equal(name.begin(), name.end(), DAY_NAMES[day], sameLetters))
+            {
+                return day;
+            }
+        }
+        return -1;
+    }
+
+    // "*", "Sat,Sun", "Mon-Fri" or a mix; 0 if invalid
+    unsigned parseDays(const std::string &text)
+    {
+        if (text == "*")
+            return ALL_DAYS;
+
+        unsigned mask = 0;
+        std::stringstream ss(text);
+        std::string part;
+        while (std::getline(ss, part, ','))
+        {
+            size_t dash = part.find('-');
+            int first = parseDayName(part.substr(0, dash));
+            int last = (dash == std::string::npos) ? first : parseDayName(part.substr(dash + 1));
+            if (first < 0 || last < 0)
+                return 0;
+
+            for (int day = first;; day = (day + 1) % 7) // Ranges may wrap, as in Fri-Mon
+            {
+                mask |= 1u << day;
+                if (day == last)
+                    break;
+            }
+        }
+        return mask;
+    }
+
+    std::string formatDays(unsigned mask)
+    {
+        if ((mask & ALL_DAYS) == ALL_DAYS)
+            return "*";
+
+        std::string text;
+        for (int day = 0; day < 7; ++day)
+        {
+            if (mask & (1u << day))
+            {
+                if (!text.empty())
+                    text += ',';
+                text += DAY_NAMES[day];
+            }
+        }
+        return text;
+    }
+
+    // "HH:MM" up to 24:00; -1 if invalid
+    int parseMinute(const std::string &text)
+    {
+        int hour, minute;
+        char colon;
+        std::istringstream ss(text);
+        if (!(ss >> hour >> colon >> minute) || colon != ':' || hour < 0 || minute < 0 || minute > 59)
+            return -1;
+
+        int total = hour * 60 + minute;
+        return total <= PricingEngine::MINUTES_PER_DAY ? total : -1;
+    }
+
+    std::string formatMinute(int minute)
+    {
+        char text[8];
+        char *end = text;
+        *end++ = static_cast<char>('0' + minute / 600);
+        *end++ = static_cast<char>('0' + minute / 60 % 10);
+        *end++ = ':';
+        *end++ = static_cast<char>('0' + minute % 60 / 10);
+        *end++ = static_cast<char>('0' + minute % 10);
+        return std::string(text, end);
+    }
+
+    // Rate-minutes from midnight to a second of the day, on a 24-hour day
+    double positionOf(const double *prefix, std::time_t second)
+    {
+        std::time_t minute = second / 60;
+        double position = prefix[minute];
+        if (second % 60 != 0)
+        {
+            position += (prefix[minute + 1] - prefix[minute]) * static_cast<double>(second % 60) / 60.0;
+        }
+        return position;
+    }
+}
+
+// DayPrices implementation
+double PricingEngine::DayPrices::getCost(int startMinute, int endMinute) const
+{
+    startMinute = std::max(0, startMinute);
+    endMinute = std::min(static_cast<int>(MINUTES_PER_DAY), endMinute);
+    if (endMinute <= startMinute)
+        return 0.0;
+    return (m_prefix[endMinute] - m_prefix[startMinute]) / 60.0;
+}
+
+// PricingEngine implementation
+PricingEngine &PricingEngine::getInstance()
+{
+    std::lock_guard<std::mutex> lock(m_instanceMutex);
+    if (m_instance == nullptr)
+    {
+        m_instance = new PricingEngine();
+        m_instance->loadRules();
+    }
+    return *m_instance;
+}
+
+void PricingEngine::setCourtRate(int courtId, double hourlyRate)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_courtRates[courtId] = hourlyRate;
+    m_tables[courtId] = compile(courtId, hourlyRate);
+}
+
+void PricingEngine::removeCourt(int courtId)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_courtRates.erase(courtId);
+    m_tables.erase(courtId);
+}
+
+bool PricingEngine::hasCourt(int courtId) const
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_courtRates.count(courtId) != 0;
+}
+
+std::vector<PriceRule> PricingEngine::getRules() const
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_rules;
+}
+
+void PricingEngine::setRules(const std::vector<PriceRule> &rules)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_rules = rules;
+        recompileAll();
+    }
+    saveRules();
+}
+
+void PricingEngine::loadRules()
+{
+    std::vector<PriceRule> rules;
+    std::ifstream file("data/pricing.txt");
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        // Parse rule: courtId|days|start|end|percent
+        std::stringstream ss(line);
+        std::string token;
+        std::vector<std::string> tokens;
+        while (std::getline(ss, token, '|'))
+        {
+            tokens.push_back(token);
+        }
+        if (tokens.size() < 5)
+            continue;
+
+        try
+        {
+            PriceRule rule;
+            rule.courtId = std::stoi(tokens[0]);
+            rule.dayMask = parseDays(tokens[1]);
+            rule.startMinute = parseMinute(tokens[2]);
+            rule.endMinute = parseMinute(tokens[3]);
+            rule.percent = std::stoi(tokens[4]);
+
+            if (rule.courtId >= 0 && rule.dayMask != 0 && rule.startMinute >= 0 &&
+                rule.endMinute > rule.startMinute && rule.percent >= 0)
+            {
+                rules.push_back(rule);
+            }
+        }
+        catch (const std::exception &e)
+        {
+            // Skip invalid lines
+            continue;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_rules = rules;
+    recompileAll();
+}
+
+void PricingEngine::saveRules() const
+{
+    std::filesystem::create_directories("data");
+
+    std::vector<PriceRule> rules = getRules();
+    std::ofstream file("data/pricing.txt");
+    if (file.is_open())
+    {
+        file << "# courtId|days|start|end|percent (courtId 0 = every court, later lines win)\n";
+        for (const PriceRule &rule : rules)
+        {
+            file << rule.courtId << "|"
+                 << formatDays(rule.dayMask) << "|"
+                 << formatMinute(rule.startMinute) << "|"
+                 << formatMinute(rule.endMinute) << "|"
+                 << rule.percent << "\n";
+        }
+    }
+}
+
+double PricingEngine::getCost(int courtId, std::time_t startTime, std::time_t endTime) const
+{
+    std::shared_ptr<const PriceTable> table = findTable(courtId);
+
+    double rateMinutes = 0.0;
+    while (startTime < endTime)
+    {
+        DateTimeUtils::LocalTime local = DateTimeUtils::toLocal(startTime);
+        std::time_t segmentEnd = std::min(endTime, local.dayEnd);
+        const double *prefix = table->data() + local.weekday * DAY_STRIDE;
+
+        if (local.dayEnd - local.dayStart == MINUTES_PER_DAY * 60)
+        {
+            rateMinutes += positionOf(prefix, segmentEnd - local.dayStart) -
+                           positionOf(prefix, startTime - local.dayStart);
+        }
+        else
+        {
+            // DST change inside the day: charge each real minute at its wall-clock price
+            for (std::time_t time = startTime; time < segmentEnd; time += 60)
+            {
+                DateTimeUtils::LocalTime at = DateTimeUtils::toLocal(time);
+                int minute = at.hour * 60 + at.minute;
+                double rate = prefix[minute + 1] - prefix[minute];
+                rateMinutes += rate * static_cast<double>(std::min<std::time_t>(60, segmentEnd - time)) / 60.0;
+            }
+        }
+        startTime = segmentEnd;
+    }
+    return rateMinutes / 60.0;
+}
+
+PricingEngine::DayPrices PricingEngine::getDayPrices(int courtId, std::time_t date) const
+{
+    DayPrices prices;
+    prices.m_table = findTable(courtId);
+    prices.m_prefix = prices.m_table->data() + DateTimeUtils::getDayOfWeek(date) * DAY_STRIDE;
+    return prices;
+}
+
+std::shared_ptr<const PricingEngine::PriceTable> PricingEngine::compile(int courtId, double hourlyRate) const
+{
+    auto table = std::make_shared<PriceTable>(7 * DAY_STRIDE);
+    std::vector<int> percent(MINUTES_PER_DAY);
+
+    for (int weekday = 0; weekday < 7; ++weekday)
+    {
+        std::fill(percent.begin(), percent.end(), 100);
+        for (const PriceRule &rule : m_rules)
+        {
+            if ((rule.courtId == 0 || rule.courtId == courtId) && (rule.dayMask & (1u << weekday)))
+            {
+                std::fill(percent.begin() + rule.startMinute, percent.begin() + rule.endMinute, rule.percent);
+            }
+        }
+
+        double *prefix = table->data() + weekday * DAY_STRIDE;
+        prefix[0] = 0.0;
+        for (int minute = 0; minute < MINUTES_PER_DAY; ++minute)
+        {
+            prefix[minute + 1] = prefix[minute] + hourlyRate * percent[minute] / 100.0;
+        }
+    }
+    return table;
+}
+
+void PricingEngine::recompileAll()
+{
+    m_defaultTable = compile(0, DEFAULT_HOURLY_RATE);
+    for (const auto &court : m_courtRates)
+    {
+        m_tables[court.first] = compile(court.first, court.second);
+    }
+}
+
+std::shared_ptr<const PricingEngine::PriceTable> PricingEngine::findTable(int courtId) const
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    auto it = m_tables.find(courtId);
+    return (it != m_tables.end()) ? it->second : m_defaultTable;
+}
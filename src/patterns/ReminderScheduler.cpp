@@ -0,0 +1,125 @@
+#include "ReminderScheduler.h"
+#include <chrono>
+
+ReminderScheduler::ReminderScheduler()
+    : m_wheel(std::time(nullptr)), m_running(false)
+{
+}
+
+ReminderScheduler::~ReminderScheduler()
+{
+    stop();
+}
+
+void ReminderScheduler::start(ReminderCallback callback)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_callback = std::move(callback);
+    }
+    if (!m_running.exchange(true))
+    {
+        m_thread = std::thread(&ReminderScheduler::run, this);
+    }
+}
+
+void ReminderScheduler::stop()
+{
+    if (m_running.exchange(false))
+    {
+        m_wake.notify_one();
+        m_thread.join();
+    }
+}
+
+void ReminderScheduler::update(const Booking &booking)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!shouldRemind(booking, std::time(nullptr)))
+    {
+        m_wheel.cancel(booking.getId());
+        m_bookings.erase(booking.getId());
+        return;
+    }
+
+    m_wheel.schedule(booking.getId(), booking.getStartTime() - REMINDER_LEAD_SECONDS);
+    m_bookings[booking.getId()] = booking;
+}
+
+void ReminderScheduler::cancel(int bookingId)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wheel.cancel(bookingId);
+    m_bookings.erase(bookingId);
+}
+
+void ReminderScheduler::rebuild(const std::vector<const Booking *> &bookings)
+{
+    std::time_t now = std::time(nullptr);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_wheel.clear(now);
+    m_bookings.clear();
+    for (const Booking *booking : bookings)
+    {
+        if (booking && shouldRemind(*booking, now))
+        {
+            m_wheel.schedule(booking->getId(), booking->getStartTime() - REMINDER_LEAD_SECONDS);
+            m_bookings[booking->getId()] = *booking;
+        }
+    }
+}
+
+size_t ReminderScheduler::getPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_wheel.size();
+}
+
+void ReminderScheduler::tick(std::time_t now)
+{
+    std::vector<Booking> due;
+    ReminderCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::vector<int> expired;
+        m_wheel.advance(now, expired);
+        for (int bookingId : expired)
+        {
+            auto it = m_bookings.find(bookingId);
+            if (it != m_bookings.end())
+            {
+                due.push_back(std::move(it->second));
+                m_bookings.erase(it);
+            }
+        }
+        callback = m_callback;
+    }
+
+    // Outside the lock so the callback may schedule or cancel reminders
+    if (callback)
+    {
+        for (const Booking &booking : due)
+        {
+            callback(booking);
+        }
+    }
+}
+
+void ReminderScheduler::run()
+{
+    while (m_running.load())
+    {
+        tick(std::time(nullptr));
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        m_wake.wait_for(lock, std::chrono::seconds(1), [this]
+                        { return !m_running.load(); });
+    }
+}
+
+bool ReminderScheduler::shouldRemind(const Booking &booking, std::time_t now) const
+{
+    // Bookings already inside the lead window were either reminded or created too late
+    return booking.isActive() && booking.getStartTime() - REMINDER_LEAD_SECONDS > now;
+}
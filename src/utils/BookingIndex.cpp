@@ -0,0 +1,314 @@
+#include "BookingIndex.h"
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+    const std::vector<int> EMPTY_POSTINGS;
+}
+
+void BookingIndex::clear()
+{
+    m_byId.clear();
+    m_byCourt.clear();
+    m_byUser.clear();
+    m_byStartTime.clear();
+}
+
+void BookingIndex::rebuild(const std::vector<BookingPtr> &bookings)
+{
+    clear();
+    m_byId.reserve(bookings.size());
+    m_byStartTime.reserve(bookings.size());
+
+    for (const BookingPtr &booking : bookings)
+    {
+        if (!booking)
+            continue;
+
+        m_byId[booking->getId()] = booking;
+        m_byCourt[booking->getCourtId()].push_back(booking->getId());
+        m_byUser[booking->getUserId()].push_back(booking->getId());
+        m_byStartTime.emplace_back(booking->getStartTime(), booking->getId());
+    }
+
+    // Sort once instead of inserting in order
+    for (auto &pair : m_byCourt)
+    {
+        std::sort(pair.second.begin(), pair.second.end());
+    }
+    for (auto &pair : m_byUser)
+    {
+        std::sort(pair.second.begin(), pair.second.end());
+    }
+    std::sort(m_byStartTime.begin(), m_byStartTime.end());
+}
+
+void BookingIndex::add(const BookingPtr &booking)
+{
+    if (!booking)
+        return;
+
+    m_byId[booking->getId()] = booking;
+    insertSorted(m_byCourt[booking->getCourtId()], booking->getId());
+    insertSorted(m_byUser[booking->getUserId()], booking->getId());
+
+    auto entry = std::make_pair(booking->getStartTime(), booking->getId());
+    m_byStartTime.insert(std::upper_bound(m_byStartTime.begin(), m_byStartTime.end(), entry), entry);
+}
+
+void BookingIndex::remove(const Booking &booking)
+{
+    m_byId.erase(booking.getId());
+
+    auto courtIt = m_byCourt.find(booking.getCourtId());
+    if (courtIt != m_byCourt.end())
+    {
+        eraseSorted(courtIt->second, booking.getId());
+    }
+
+    auto userIt = m_byUser.find(booking.getUserId());
+    if (userIt != m_byUser.end())
+    {
+        eraseSorted(userIt->second, booking.getId());
+    }
+
+    auto entry = std::make_pair(booking.getStartTime(), booking.getId());
+    auto it = std::lower_bound(m_byStartTime.begin(), m_byStartTime.end(), entry);
+    if (it != m_byStartTime.end() && *it == entry)
+    {
+        m_byStartTime.erase(it);
+    }
+}
+
+void BookingIndex::replace(const BookingPtr &booking)
+{
+    auto it = m_byId.find(booking->getId());
+    if (it != m_byId.end())
+    {
+        updateStartTime(booking->getId(), it->second->getStartTime(), booking->getStartTime());
+        it->second = booking;
+    }
+}
+
+void BookingIndex::updateStartTime(int bookingId, std::time_t oldStart, std::time_t newStart)
+{
+    if (oldStart == newStart)
+        return;
+
+    auto oldEntry = std::make_pair(oldStart, bookingId);
+    auto it = std::lower_bound(m_byStartTime.begin(), m_byStartTime.end(), oldEntry);
+    if (it != m_byStartTime.end() && *it == oldEntry)
+    {
+        m_byStartTime.erase(it);
+    }
+
+    auto newEntry = std::make_pair(newStart, bookingId);
+    m_byStartTime.insert(std::upper_bound(m_byStartTime.begin(), m_byStartTime.end(), newEntry), newEntry);
+}
+
+const Booking *BookingIndex::find(int bookingId) const
+{
+    auto it = m_byId.find(bookingId);
+    return (it != m_byId.end()) ? it->second.get() : nullptr;
+}
+
+BookingPtr BookingIndex::findPtr(int bookingId) const
+{
+    auto it = m_byId.find(bookingId);
+    return (it != m_byId.end()) ? it->second : BookingPtr();
+}
+
+const std::vector<int> &BookingIndex::getCourtPostings(int courtId) const
+{
+    auto it = m_byCourt.find(courtId);
+    return (it != m_byCourt.end()) ? it->second : EMPTY_POSTINGS;
+}
+
+const std::vector<int> &BookingIndex::getUserPostings(int userId) const
+{
+    auto it = m_byUser.find(userId);
+    return (it != m_byUser.end()) ? it->second : EMPTY_POSTINGS;
+}
+
+std::vector<int> BookingIndex::query(const BookingQuery &query) const
+{
+    std::vector<int> result;
+
+    auto rangeBegin = query.fromTime > 0 ? timeLowerBound(query.fromTime) : m_byStartTime.begin();
+    auto rangeEnd = query.toTime > 0 ? timeUpperBound(query.toTime) : m_byStartTime.end();
+    if (rangeBegin >= rangeEnd)
+    {
+        return result;
+    }
+    size_t rangeSize = static_cast<size_t>(rangeEnd - rangeBegin);
+    bool hasTimeRange = rangeSize < m_byStartTime.size();
+
+    // Collect the posting lists that apply, smallest first
+    std::vector<const std::vector<int> *> postings;
+    if (query.courtId > 0)
+    {
+        postings.push_back(&getCourtPostings(query.courtId));
+    }
+    if (query.userId > 0)
+    {
+        postings.push_back(&getUserPostings(query.userId));
+    }
+    if (query.restrictToIds)
+    {
+        postings.push_back(&query.bookingIds);
+    }
+
+    if (postings.empty())
+    {
+        // Only a time range (or nothing): walk the time index, already in order
+        result.reserve(rangeSize);
+        for (auto it = rangeBegin; it != rangeEnd; ++it)
+        {
+            if (!query.filterStatus)
+            {
+                result.push_back(it->second);
+                continue;
+            }
+
+            const Booking *booking = find(it->second);
+            if (booking && booking->getStatus() == query.status)
+            {
+                result.push_back(it->second);
+            }
+        }
+        return result;
+    }
+
+    std::sort(postings.begin(), postings.end(),
+              [](const std::vector<int> *a, const std::vector<int> *b)
+              {
+                  return a->size() < b->size();
+              });
+
+    std::vector<int> candidates = *postings[0];
+    for (size_t i = 1; i < postings.size() && !candidates.empty(); ++i)
+    {
+        candidates = intersect(candidates, *postings[i]);
+    }
+
+    // Materialize the time range as a posting list only when it is the more selective side
+    if (hasTimeRange && rangeSize < candidates.size())
+    {
+        std::vector<int> rangeIds;
+        rangeIds.reserve(rangeSize);
+        for (auto it = rangeBegin; it != rangeEnd; ++it)
+        {
+            rangeIds.push_back(it->second);
+        }
+        std::sort(rangeIds.begin(), rangeIds.end());
+        candidates = intersect(candidates, rangeIds);
+    }
+
+    // Verify the remaining predicates and order by start time
+    std::vector<std::pair<std::time_t, int>> ordered;
+    ordered.reserve(candidates.size());
+    for (int bookingId : candidates)
+    {
+        const Booking *booking = find(bookingId);
+        if (booking && matches(*booking, query))
+        {
+            ordered.emplace_back(booking->getStartTime(), bookingId);
+        }
+    }
+    std::sort(ordered.begin(), ordered.end());
+
+    result.reserve(ordered.size());
+    for (const auto &entry : ordered)
+    {
+        result.push_back(entry.second);
+    }
+    return result;
+}
+
+std::vector<int> BookingIndex::intersect(const std::vector<int> &a, const std::vector<int> &b)
+{
+    const std::vector<int> &small = (a.size() <= b.size()) ? a : b;
+    const std::vector<int> &large = (a.size() <= b.size()) ? b : a;
+
+    std::vector<int> result;
+    result.reserve(small.size());
+
+    auto cursor = large.begin();
+    for (int value : small)
+    {
+        // Gallop forward to bracket the value, then binary search inside the bracket
+        size_t step = 1;
+        auto probe = cursor;
+        while (probe != large.end() && *probe < value)
+        {
+            cursor = probe;
+            size_t remaining = static_cast<size_t>(large.end() - probe);
+            probe += std::min(step, remaining);
+            step *= 2;
+        }
+        cursor = std::lower_bound(cursor, probe, value);
+        if (cursor == large.end())
+        {
+            break;
+        }
+        if (*cursor == value)
+        {
+            result.push_back(value);
+        }
+    }
+
+    return result;
+}
+
+std::vector<std::pair<std::time_t, int>>::const_iterator BookingIndex::timeLowerBound(std::time_t time) const
+{
+    return std::lower_bound(m_byStartTime.begin(), m_byStartTime.end(),
+                            std::make_pair(time, std::numeric_limits<int>::min()));
+}
+
+std::vector<std::pair<std::time_t, int>>::const_iterator BookingIndex::timeUpperBound(std::time_t time) const
+{
+    return std::upper_bound(m_byStartTime.begin(), m_byStartTime.end(),
+                            std::make_pair(time, std::numeric_limits<int>::max()));
+}
+
+bool BookingIndex::matches(const Booking &booking, const BookingQuery &query) const
+{
+    if (query.courtId > 0 && booking.getCourtId() != query.courtId)
+        return false;
+    if (query.userId > 0 && booking.getUserId() != query.userId)
+        return false;
+    if (query.fromTime > 0 && booking.getStartTime() < query.fromTime)
+        return false;
+    if (query.toTime > 0 && booking.getStartTime() > query.toTime)
+        return false;
+    if (query.filterStatus && booking.getStatus() != query.status)
+        return false;
+    return true;
+}
+
+void BookingIndex::insertSorted(std::vector<int> &postings, int bookingId)
+{
+    // Ids are generated in ascending order, so this is almost always an append
+    if (postings.empty() || postings.back() < bookingId)
+    {
+        postings.push_back(bookingId);
+        return;
+    }
+
+    auto it = std::lower_bound(postings.begin(), postings.end(), bookingId);
+    if (it == postings.end() || *it != bookingId)
+    {
+        postings.insert(it, bookingId);
+    }
+}
+
+void BookingIndex::eraseSorted(std::vector<int> &postings, int bookingId)
+{
+    auto it = std::lower_bound(postings.begin(), postings.end(), bookingId);
+    if (it != postings.end() && *it == bookingId)
+    {
+        postings.erase(it);
+    }
+}
@@ -0,0 +1,413 @@
+#include "BookingProtocol.h"
+#include <cstring>
+#include <memory>
+
+namespace
+{
+    const size_t DAY_BYTES = (OccupancyMap::SLOTS_PER_DAY + 7) / 8;
+}
+
+// MessageWriter implementation
+MessageWriter::MessageWriter() : m_data(BookingProtocol::HEADER_SIZE, '\0')
+{
+}
+
+void MessageWriter::writeU8(uint8_t value)
+{
+    m_data.push_back(static_cast<char>(value));
+}
+
+void MessageWriter::writeU32(uint32_t value)
+{
+    char bytes[4];
+    for (int i = 0; i < 4; ++i)
+    {
+        bytes[i] = static_cast<char>(value >> (8 * i));
+    }
+    m_data.append(bytes, sizeof(bytes));
+}
+
+void MessageWriter::writeI64(int64_t value)
+{
+    uint64_t bits = static_cast<uint64_t>(value);
+    char bytes[8];
+    for (int i = 0; i < 8; ++i)
+    {
+        bytes[i] = static_cast<char>(bits >> (8 * i));
+    }
+    m_data.append(bytes, sizeof(bytes));
+}
+
+void MessageWriter::setU32(size_t offset, uint32_t value)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        m_data[offset + i] = static_cast<char>(value >> (8 * i));
+    }
+}
+
+void MessageWriter::writeDouble(double value)
+{
+    int64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    writeI64(bits);
+}
+
+void MessageWriter::writeString(const std::string &value)
+{
+    writeU32(static_cast<uint32_t>(value.size()));
+    m_data.append(value);
+}
+
+void MessageWriter::writeBytes(const void *data, size_t size)
+{
+    m_data.append(static_cast<const char *>(data), size);
+}
+
+void MessageWriter::writeBooking(const Booking &booking)
+{
+    writeI32(booking.getId());
+    writeI32(booking.getUserId());
+    writeI32(booking.getCourtId());
+    writeI64(booking.getBookingDate());
+    writeI64(booking.getStartTime());
+    writeI64(booking.getEndTime());
+    writeDouble(booking.getTotalAmount());
+    writeU8(static_cast<uint8_t>(booking.getStatus()));
+    writeString(booking.getNotes());
+}
+
+size_t MessageWriter::bookingSize(const Booking &booking)
+{
+    // Three i32, three i64, a double, the status byte and the notes string
+    return 3 * 4 + 3 * 8 + 8 + 1 + 4 + booking.getNotes().size();
+}
+
+void MessageWriter::writeQuery(const BookingQuery &query)
+{
+    writeI32(query.courtId);
+    writeI32(query.userId);
+    writeI64(query.fromTime);
+    writeI64(query.toTime);
+    writeU8(query.filterStatus ? 1 : 0);
+    writeU8(static_cast<uint8_t>(query.status));
+    writeU8(query.restrictToIds ? 1 : 0);
+    writeU32(static_cast<uint32_t>(query.bookingIds.size()));
+    for (int bookingId : query.bookingIds)
+    {
+        writeI32(bookingId);
+    }
+}
+
+void MessageWriter::writeCourt(const Court &court)
+{
+    writeI32(court.getId());
+    writeString(court.getName());
+    writeString(court.getDescription());
+    writeDouble(court.getHourlyRate());
+    writeU8(static_cast<uint8_t>(court.getStatus()));
+}
+
+void MessageWriter::writeUser(const User &user)
+{
+    writeI32(user.getId());
+    writeString(user.getEmail());
+    writeString(user.getFullName());
+    writeString(user.getPhoneNumber());
+    writeU8(static_cast<uint8_t>(user.getRole()));
+    writeU8(user.isActive() ? 1 : 0);
+}
+
+void MessageWriter::writeChange(const ChangeRecord &change)
+{
+    writeI64(static_cast<int64_t>(change.sequence));
+    writeU8(static_cast<uint8_t>(change.type));
+    switch (change.type)
+    {
+    case ChangeType::COURT_CHANGED:
+        writeCourt(*change.court);
+        break;
+    case ChangeType::USER_CHANGED:
+        writeUser(*change.user);
+        break;
+    case ChangeType::COURT_REMOVED:
+    case ChangeType::USER_REMOVED:
+        writeI32(change.removedId);
+        break;
+    default:
+        writeBooking(*change.booking);
+        break;
+    }
+}
+
+void MessageWriter::writeDayBits(const OccupancyMap::DayBits &bits)
+{
+    unsigned char bytes[DAY_BYTES] = {};
+    for (int slot = 0; slot < OccupancyMap::SLOTS_PER_DAY; ++slot)
+    {
+        if (bits.test(slot))
+        {
+            bytes[slot / 8] |= static_cast<unsigned char>(1u << (slot % 8));
+        }
+    }
+    writeBytes(bytes, sizeof(bytes));
+}
+
+const std::string &MessageWriter::finish()
+{
+    uint32_t length = static_cast<uint32_t>(m_data.size() - BookingProtocol::HEADER_SIZE);
+    for (size_t i = 0; i < BookingProtocol::HEADER_SIZE; ++i)
+    {
+        m_data[i] = static_cast<char>(length >> (8 * i));
+    }
+    return m_data;
+}
+
+// MessageReader implementation
+MessageReader::MessageReader(const char *data, size_t size)
+    : m_position(reinterpret_cast<const unsigned char *>(data)),
+      m_end(reinterpret_cast<const unsigned char *>(data) + size),
+      m_ok(true)
+{
+}
+
+bool MessageReader::take(size_t size)
+{
+    if (!m_ok || static_cast<size_t>(m_end - m_position) < size)
+    {
+        m_ok = false;
+        return false;
+    }
+    return true;
+}
+
+uint8_t MessageReader::readU8()
+{
+    return take(1) ? *m_position++ : 0;
+}
+
+uint32_t MessageReader::readU32()
+{
+    if (!take(4))
+        return 0;
+
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i)
+    {
+        value |= static_cast<uint32_t>(*m_position++) << (8 * i);
+    }
+    return value;
+}
+
+int64_t MessageReader::readI64()
+{
+    if (!take(8))
+        return 0;
+
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i)
+    {
+        value |= static_cast<uint64_t>(*m_position++) << (8 * i);
+    }
+    return static_cast<int64_t>(value);
+}
+
+double MessageReader::readDouble()
+{
+    int64_t bits = readI64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+std::string MessageReader::readString()
+{
+    uint32_t size = readU32();
+    if (!take(size))
+        return std::string();
+
+    std::string value(reinterpret_cast<const char *>(m_position), size);
+    m_position += size;
+    return value;
+}
+
+const char *MessageReader::readBytes(size_t size)
+{
+    if (!take(size))
+        return nullptr;
+
+    const char *bytes = reinterpret_cast<const char *>(m_position);
+    m_position += size;
+    return bytes;
+}
+
+bool MessageReader::readBooking(Booking &booking)
+{
+    booking.setId(readI32());
+    booking.setUserId(readI32());
+    booking.setCourtId(readI32());
+    booking.setBookingDate(readI64());
+    booking.setStartTime(readI64());
+    booking.setEndTime(readI64());
+    booking.setTotalAmount(readDouble());
+    uint8_t status = readU8();
+    booking.setNotes(readString());
+
+    if (status > static_cast<uint8_t>(BookingStatus::COMPLETED))
+    {
+        m_ok = false;
+    }
+    booking.setStatus(static_cast<BookingStatus>(status));
+    return m_ok;
+}
+
+bool MessageReader::readQuery(BookingQuery &query)
+{
+    query.courtId = readI32();
+    query.userId = readI32();
+    query.fromTime = readI64();
+    query.toTime = readI64();
+    query.filterStatus = readU8() != 0;
+    query.status = static_cast<BookingStatus>(readU8());
+    query.restrictToIds = readU8() != 0;
+
+    // Each id takes 4 bytes; refuse counts the payload cannot hold
+    uint32_t count = readU32();
+    if (!m_ok || count > static_cast<size_t>(m_end - m_position) / 4)
+    {
+        m_ok = false;
+        return false;
+    }
+    query.bookingIds.resize(count);
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        query.bookingIds[i] = readI32();
+    }
+    return m_ok;
+}
+
+bool MessageReader::readCourt(Court &court)
+{
+    court.setId(readI32());
+    court.setName(readString());
+    court.setDescription(readString());
+    court.setHourlyRate(readDouble());
+    uint8_t status = readU8();
+
+    if (status > static_cast<uint8_t>(CourtStatus::OUT_OF_SERVICE))
+    {
+        m_ok = false;
+    }
+    court.setStatus(static_cast<CourtStatus>(status));
+    return m_ok;
+}
+
+bool MessageReader::readUser(User &user)
+{
+    user.setId(readI32());
+    user.setEmail(readString());
+    user.setFullName(readString());
+    user.setPhoneNumber(readString());
+    uint8_t role = readU8();
+    user.setActive(readU8() != 0);
+
+    if (role > static_cast<uint8_t>(UserRole::CUSTOMER))
+    {
+        m_ok = false;
+    }
+    user.setRole(static_cast<UserRole>(role));
+    return m_ok;
+}
+
+bool MessageReader::readChange(ChangeRecord &change)
+{
+    change.sequence = static_cast<uint64_t>(readI64());
+    uint8_t type = readU8();
+    change.type = static_cast<ChangeType>(type);
+    change.booking.reset();
+    change.court.reset();
+    change.user.reset();
+    change.removedId = 0;
+
+    switch (change.type)
+    {
+    case ChangeType::BOOKING_CREATED:
+    case ChangeType::BOOKING_MODIFIED:
+    case ChangeType::BOOKING_CANCELLED:
+    case ChangeType::BOOKING_UPDATED:
+    {
+        auto booking = std::make_shared<Booking>();
+        readBooking(*booking);
+        change.booking = booking;
+        break;
+    }
+    case ChangeType::COURT_CHANGED:
+    {
+        auto court = std::make_shared<Court>();
+        readCourt(*court);
+        change.court = court;
+        break;
+    }
+    case ChangeType::USER_CHANGED:
+    {
+        auto user = std::make_shared<User>();
+        readUser(*user);
+        change.user = user;
+        break;
+    }
+    case ChangeType::COURT_REMOVED:
+    case ChangeType::USER_REMOVED:
+        change.removedId = readI32();
+        break;
+    default:
+        m_ok = false; // Newer server; the client cannot apply it
+        break;
+    }
+    return m_ok;
+}
+
+bool MessageReader::readDayBits(OccupancyMap::DayBits &bits)
+{
+    bits.reset();
+    if (!take(DAY_BYTES))
+        return false;
+
+    for (int slot = 0; slot < OccupancyMap::SLOTS_PER_DAY; ++slot)
+    {
+        if (m_position[slot / 8] & (1u << (slot % 8)))
+        {
+            bits.set(slot);
+        }
+    }
+    m_position += DAY_BYTES;
+    return true;
+}
+
+// BookingProtocol implementation
+uint32_t BookingProtocol::readLength(const char *data)
+{
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+const char *BookingProtocol::getStatusString(ProtocolStatus status)
+{
+    switch (status)
+    {
+    case ProtocolStatus::OK:
+        return "OK";
+    case ProtocolStatus::REJECTED:
+        return "Rejected";
+    case ProtocolStatus::NOT_FOUND:
+        return "Not found";
+    case ProtocolStatus::BAD_REQUEST:
+        return "Bad request";
+    case ProtocolStatus::SERVER_ERROR:
+        return "Server error";
+    case ProtocolStatus::TOO_LARGE:
+        return "Response too large";
+    default:
+        return "Unknown status";
+    }
+}
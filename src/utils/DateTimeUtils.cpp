@@ -1,12 +1,649 @@
 #include "DateTimeUtils.h"
-#include <sstream>
-#include <iomanip>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    const std::time_t DAY_SECONDS = 24 * 3600;
+    const std::time_t AVERAGE_YEAR_SECONDS = 31556952; // 365.2425 days
+    const int TABLE_FIRST_YEAR = 2000;
+    const int TABLE_YEARS = 100;
+
+    std::tm toLocalTm(std::time_t time)
+    {
+        std::tm result{};
+#ifdef _WIN32
+        localtime_s(&result, &time);
+#else
+        localtime_r(&time, &result);
+#endif
+        return result;
+    }
+
+    // mktime for a local date; normalises out-of-range fields
+    std::time_t makeLocalTime(int year, int month, int day, int hour = 0, int minute = 0, int second = 0)
+    {
+        std::tm timeInfo{};
+        timeInfo.tm_year = year - 1900;
+        timeInfo.tm_mon = month - 1;
+        timeInfo.tm_mday = day;
+        timeInfo.tm_hour = hour;
+        timeInfo.tm_min = minute;
+        timeInfo.tm_sec = second;
+        timeInfo.tm_isdst = -1;
+        return std::mktime(&timeInfo);
+    }
+
+    // Days since 1970-01-01 of a proleptic Gregorian date
+    int daysFromCivil(int year, int month, int day)
+    {
+        year -= month <= 2;
+        int era = (year >= 0 ? year : year - 399) / 400;
+        int yearOfEra = year - era * 400;
+        int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+        int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+    int weekdayOf(int dayKey)
+    {
+        return ((dayKey % 7) + 11) % 7; // 1970-01-01 was a Thursday
+    }
+
+    bool isLeapYear(int year)
+    {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    int daysInMonth(int year, int month)
+    {
+        static const int DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+        return (month == 2 && isLeapYear(year)) ? 29 : DAYS[month - 1];
+    }
+
+    const char *const WEEKDAY_NAMES[] = {"Sunday", "Monday", "Tuesday", "Wednesday",
+                                         "Thursday", "Friday", "Saturday"};
+    const char *const MONTH_NAMES[] = {"January", "February", "March", "April", "May", "June", "July",
+                                       "August", "September", "October", "November", "December"};
+
+    // "00" to "99" back to back
+    const char DIGIT_PAIRS[] =
+        "0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+        "5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+
+    char *writeTwoDigits(char *out, int value)
+    {
+        std::memcpy(out, DIGIT_PAIRS + value * 2, 2);
+        return out + 2;
+    }
+
+    char *writeDateFields(char *out, int year, int month, int day)
+    {
+        out = writeTwoDigits(out, year / 100);
+        out = writeTwoDigits(out, year % 100);
+        *out++ = '-';
+        out = writeTwoDigits(out, month);
+        *out++ = '-';
+        return writeTwoDigits(out, day);
+    }
+
+    // "HH:MM" for every minute of the day
+    class ClockTable
+    {
+    public:
+        static const ClockTable &instance()
+        {
+            static const ClockTable table;
+            return table;
+        }
+
+        char *write(char *out, int hour, int minute) const
+        {
+            std::memcpy(out, m_text[hour * 60 + minute], 5);
+            return out + 5;
+        }
+
+    private:
+        ClockTable()
+        {
+            for (int minute = 0; minute < 24 * 60; ++minute)
+            {
+                char *out = writeTwoDigits(m_text[minute], minute / 60);
+                *out++ = ':';
+                writeTwoDigits(out, minute % 60);
+            }
+        }
+
+        char m_text[24 * 60][5];
+    };
+
+    struct DayEntry
+    {
+        std::time_t start;
+        int32_t dayKey;
+        int16_t year;
+        int8_t month;
+        int8_t day;
+        char date[10]; // YYYY-MM-DD
+    };
+
+    // Local midnights of 2000-2099. Year boundaries are computed up front;
+    // each year's days are filled by mktime the first time it is touched.
+    class DayTable
+    {
+    public:
+        static DayTable &instance()
+        {
+            static DayTable table;
+            return table;
+        }
+
+        // The day containing time, or nullptr outside the table
+        const DayEntry *find(std::time_t time)
+        {
+            if (time < m_yearStart[0] || time >= m_yearStart[TABLE_YEARS])
+                return nullptr;
+
+            int year = static_cast<int>((time - m_yearStart[0]) / AVERAGE_YEAR_SECONDS);
+            if (year >= TABLE_YEARS)
+                year = TABLE_YEARS - 1;
+            while (time < m_yearStart[year])
+                --year;
+            while (time >= m_yearStart[year + 1])
+                ++year;
+
+            const std::vector<DayEntry> &days = getYear(year);
+            size_t last = days.size() - 2; // Final entry is next year's first day
+            size_t index = static_cast<size_t>((time - m_yearStart[year]) / DAY_SECONDS);
+            if (index > last)
+                index = last;
+            while (index > 0 && time < days[index].start)
+                --index;
+            while (index < last && time >= days[index + 1].start)
+                ++index;
+            return &days[index];
+        }
+
+        // The entry of a local date, or nullptr outside the table
+        const DayEntry *findDate(int year, int month, int day)
+        {
+            int tableYear = year - TABLE_FIRST_YEAR;
+            if (tableYear < 0 || tableYear >= TABLE_YEARS)
+                return nullptr;
+
+            const std::vector<DayEntry> &days = getYear(tableYear);
+            return &days[daysFromCivil(year, month, day) - days[0].dayKey];
+        }
+
+    private:
+        DayTable()
+        {
+            for (int year = 0; year <= TABLE_YEARS; ++year)
+            {
+                m_yearStart[year] = makeLocalTime(TABLE_FIRST_YEAR + year, 1, 1);
+            }
+        }
+
+        const std::vector<DayEntry> &getYear(int year)
+        {
+            std::call_once(m_built[year], [this, year]() { buildYear(year); });
+            return m_days[year];
+        }
+
+        void buildYear(int year)
+        {
+            std::vector<DayEntry> &days = m_days[year];
+            days.reserve(367);
+            for (int day = 1;; ++day)
+            {
+                std::tm timeInfo{};
+                timeInfo.tm_year = TABLE_FIRST_YEAR + year - 1900;
+                timeInfo.tm_mon = 0;
+                timeInfo.tm_mday = day;
+                timeInfo.tm_isdst = -1;
+
+                DayEntry entry;
+                entry.start = std::mktime(&timeInfo);
+                entry.year = static_cast<int16_t>(timeInfo.tm_year + 1900);
+                entry.month = static_cast<int8_t>(timeInfo.tm_mon + 1);
+                entry.day = static_cast<int8_t>(timeInfo.tm_mday);
+                entry.dayKey = daysFromCivil(entry.year, entry.month, entry.day);
+                writeDateFields(entry.date, entry.year, entry.month, entry.day);
+                days.push_back(entry);
+
+                if (entry.year != TABLE_FIRST_YEAR + year)
+                    break;
+            }
+        }
+
+        std::time_t m_yearStart[TABLE_YEARS + 1];
+        std::once_flag m_built[TABLE_YEARS];
+        std::vector<DayEntry> m_days[TABLE_YEARS];
+    };
+
+    // Same fields straight from the C library, for times outside the table
+    DateTimeUtils::LocalTime toLocalUncached(std::time_t time)
+    {
+        std::tm timeInfo = toLocalTm(time);
+
+        DateTimeUtils::LocalTime local;
+        local.year = timeInfo.tm_year + 1900;
+        local.month = timeInfo.tm_mon + 1;
+        local.day = timeInfo.tm_mday;
+        local.hour = timeInfo.tm_hour;
+        local.minute = timeInfo.tm_min;
+        local.second = timeInfo.tm_sec;
+        local.dayKey = daysFromCivil(local.year, local.month, local.day);
+        local.weekday = weekdayOf(local.dayKey);
+        local.dayStart = makeLocalTime(local.year, local.month, local.day);
+        local.dayEnd = makeLocalTime(local.year, local.month, local.day + 1);
+        return local;
+    }
+
+    char *writeName(char *out, const char *name, size_t length)
+    {
+        std::memcpy(out, name, length);
+        return out + length;
+    }
+
+    // One strftime conversion into out (16 bytes are enough), or nullptr
+    // for conversions left to the C library
+    char *writeConversion(char *out, char conversion, const DateTimeUtils::LocalTime &local)
+    {
+        bool fourDigitYear = local.year >= 0 && local.year <= 9999;
+        switch (conversion)
+        {
+        case 'Y':
+            if (!fourDigitYear)
+                return nullptr;
+            out = writeTwoDigits(out, local.year / 100);
+            return writeTwoDigits(out, local.year % 100);
+        case 'y':
+            return fourDigitYear ? writeTwoDigits(out, local.year % 100) : nullptr;
+        case 'm':
+            return writeTwoDigits(out, local.month);
+        case 'd':
+            return writeTwoDigits(out, local.day);
+        case 'e':
+            if (local.day >= 10)
+                return writeTwoDigits(out, local.day);
+            *out++ = ' ';
+            *out++ = static_cast<char>('0' + local.day);
+            return out;
+        case 'j':
+        {
+            int dayOfYear = local.dayKey - daysFromCivil(local.year, 1, 1) + 1;
+            *out++ = static_cast<char>('0' + dayOfYear / 100);
+            return writeTwoDigits(out, dayOfYear % 100);
+        }
+        case 'H':
+            return writeTwoDigits(out, local.hour);
+        case 'I':
+            return writeTwoDigits(out, local.hour % 12 == 0 ? 12 : local.hour % 12);
+        case 'M':
+            return writeTwoDigits(out, local.minute);
+        case 'S':
+            return writeTwoDigits(out, local.second);
+        case 'p':
+            return writeName(out, local.hour < 12 ? "AM" : "PM", 2);
+        case 'a':
+            return writeName(out, WEEKDAY_NAMES[local.weekday], 3);
+        case 'A':
+            return writeName(out, WEEKDAY_NAMES[local.weekday], std::strlen(WEEKDAY_NAMES[local.weekday]));
+        case 'b':
+            return writeName(out, MONTH_NAMES[local.month - 1], 3);
+        case 'B':
+            return writeName(out, MONTH_NAMES[local.month - 1], std::strlen(MONTH_NAMES[local.month - 1]));
+        case 'F':
+            return fourDigitYear ? writeDateFields(out, local.year, local.month, local.day) : nullptr;
+        case 'T':
+            out = ClockTable::instance().write(out, local.hour, local.minute);
+            *out++ = ':';
+            return writeTwoDigits(out, local.second);
+        case 'R':
+            return ClockTable::instance().write(out, local.hour, local.minute);
+        case '%':
+            *out++ = '%';
+            return out;
+        default:
+            return nullptr;
+        }
+    }
+
+    size_t formatWithStrftime(char *buffer, size_t size, std::time_t time, const char *format)
+    {
+        std::tm timeInfo = toLocalTm(time);
+        return std::strftime(buffer, size, format, &timeInfo);
+    }
+
+    // Parsed fields; -1 marks a date field the text did not give
+    struct ParsedFields
+    {
+        int year = -1;
+        int month = -1;
+        int day = -1;
+        int hour = 0;
+        int minute = 0;
+        int second = 0;
+        int hour12 = -1;
+        bool pm = false;
+        bool hasOffset = false;
+        int offsetSeconds = 0;
+    };
+
+    bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    char toLower(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool readNumber(const char *&p, const char *end, int minDigits, int maxDigits, int &value)
+    {
+        int digits = 0;
+        value = 0;
+        while (p < end && digits < maxDigits && *p >= '0' && *p <= '9')
+        {
+            value = value * 10 + (*p++ - '0');
+            ++digits;
+        }
+        return digits >= minDigits;
+    }
+
+    // Matches a full name or its three-letter abbreviation, ignoring case
+    bool readName(const char *&p, const char *end, const char *const *names, int count, int &index)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            size_t length = std::strlen(names[i]);
+            size_t matched = 0;
+            while (matched < length && p + matched < end && toLower(p[matched]) == toLower(names[i][matched]))
+            {
+                ++matched;
+            }
+            if (matched == length || matched == 3)
+            {
+                p += matched;
+                index = i;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool readOffset(const char *&p, const char *end, ParsedFields &fields)
+    {
+        if (p < end && (*p == 'Z' || *p == 'z'))
+        {
+            ++p;
+            fields.hasOffset = true;
+            fields.offsetSeconds = 0;
+            return true;
+        }
+        if (p == end || (*p != '+' && *p != '-'))
+            return false;
+
+        int sign = (*p++ == '-') ? -1 : 1;
+        int hours, minutes;
+        if (!readNumber(p, end, 2, 2, hours))
+            return false;
+        if (p < end && *p == ':')
+            ++p;
+        if (!readNumber(p, end, 2, 2, minutes) || hours > 23 || minutes > 59)
+            return false;
+
+        fields.hasOffset = true;
+        fields.offsetSeconds = sign * (hours * 3600 + minutes * 60);
+        return true;
+    }
+
+    bool parseFields(const char *&p, const char *end, const char *format, ParsedFields &fields)
+    {
+        for (const char *f = format; *f; ++f)
+        {
+            if (isSpace(*f))
+            {
+                while (p < end && isSpace(*p))
+                    ++p;
+                continue;
+            }
+            if (*f != '%')
+            {
+                if (p == end || *p != *f)
+                    return false;
+                ++p;
+                continue;
+            }
+
+            bool matched;
+            int index = 0;
+            switch (*++f)
+            {
+            case 'Y':
+                matched = readNumber(p, end, 4, 4, fields.year);
+                break;
+            case 'y':
+                matched = readNumber(p, end, 2, 2, fields.year);
+                fields.year += (fields.year < 69) ? 2000 : 1900;
+                break;
+            case 'm':
+                matched = readNumber(p, end, 1, 2, fields.month);
+                break;
+            case 'e':
+                if (p < end && *p == ' ')
+                    ++p;
+                matched = readNumber(p, end, 1, 2, fields.day);
+                break;
+            case 'd':
+                matched = readNumber(p, end, 1, 2, fields.day);
+                break;
+            case 'H':
+                matched = readNumber(p, end, 1, 2, fields.hour);
+                break;
+            case 'I':
+                matched = readNumber(p, end, 1, 2, fields.hour12);
+                break;
+            case 'M':
+                matched = readNumber(p, end, 1, 2, fields.minute);
+                break;
+            case 'S':
+                matched = readNumber(p, end, 1, 2, fields.second);
+                break;
+            case 'p':
+                matched = end - p >= 2 && toLower(p[1]) == 'm' &&
+                          (toLower(p[0]) == 'a' || toLower(p[0]) == 'p');
+                if (matched)
+                {
+                    fields.pm = toLower(p[0]) == 'p';
+                    p += 2;
+                }
+                break;
+            case 'a':
+            case 'A':
+                matched = readName(p, end, WEEKDAY_NAMES, 7, index); // Not checked against the date
+                break;
+            case 'b':
+            case 'B':
+                matched = readName(p, end, MONTH_NAMES, 12, index);
+                fields.month = index + 1;
+                break;
+            case 'F':
+                matched = parseFields(p, end, "%Y-%m-%d", fields);
+                break;
+            case 'T':
+                matched = parseFields(p, end, "%H:%M:%S", fields);
+                break;
+            case 'R':
+                matched = parseFields(p, end, "%H:%M", fields);
+                break;
+            case 'z':
+                matched = readOffset(p, end, fields);
+                break;
+            case '%':
+                matched = p < end && *p == '%';
+                if (matched)
+                    ++p;
+                break;
+            default:
+                return false;
+            }
+
+            if (!matched)
+                return false;
+        }
+        return true;
+    }
+
+    bool resolveFields(ParsedFields fields, std::time_t &result)
+    {
+        if (fields.hour12 >= 0)
+        {
+            if (fields.hour12 < 1 || fields.hour12 > 12)
+                return false;
+            fields.hour = fields.hour12 % 12 + (fields.pm ? 12 : 0);
+        }
+
+        if (fields.year < 0 || fields.month < 0 || fields.day < 0)
+        {
+            DateTimeUtils::LocalTime today = DateTimeUtils::toLocal(std::time(nullptr));
+            bool noDate = fields.year < 0 && fields.month < 0 && fields.day < 0;
+            if (fields.year < 0)
+                fields.year = today.year;
+            if (fields.month < 0)
+                fields.month = noDate ? today.month : 1;
+            if (fields.day < 0)
+                fields.day = noDate ? today.day : 1;
+        }
+
+        if (fields.month < 1 || fields.month > 12 || fields.day < 1 ||
+            fields.day > daysInMonth(fields.year, fields.month) ||
+            fields.hour > 23 || fields.minute > 59 || fields.second > 59)
+        {
+            return false;
+        }
+
+        if (fields.hasOffset)
+        {
+            result = static_cast<std::time_t>(daysFromCivil(fields.year, fields.month, fields.day)) * DAY_SECONDS +
+                     fields.hour * 3600 + fields.minute * 60 + fields.second - fields.offsetSeconds;
+        }
+        else
+        {
+            result = DateTimeUtils::makeTime(fields.year, fields.month, fields.day,
+                                             fields.hour, fields.minute, fields.second);
+        }
+        return true;
+    }
+}
+
+DateTimeUtils::LocalTime DateTimeUtils::toLocal(std::time_t time)
+{
+    const DayEntry *entry = DayTable::instance().find(time);
+    if (!entry)
+    {
+        return toLocalUncached(time);
+    }
+
+    LocalTime local;
+    local.dayStart = entry->start;
+    local.dayEnd = (entry + 1)->start;
+    local.dayKey = entry->dayKey;
+    local.year = entry->year;
+    local.month = entry->month;
+    local.day = entry->day;
+    local.weekday = weekdayOf(entry->dayKey);
+
+    if (local.dayEnd - local.dayStart == DAY_SECONDS)
+    {
+        int seconds = static_cast<int>(time - local.dayStart);
+        local.hour = seconds / 3600;
+        local.minute = seconds / 60 % 60;
+        local.second = seconds % 60;
+    }
+    else
+    {
+        // DST change inside the day: let the C library place the hour
+        std::tm timeInfo = toLocalTm(time);
+        local.hour = timeInfo.tm_hour;
+        local.minute = timeInfo.tm_min;
+        local.second = timeInfo.tm_sec;
+    }
+    return local;
+}
+
+int DateTimeUtils::getDayKey(std::time_t time)
+{
+    return toLocal(time).dayKey;
+}
+
+std::time_t DateTimeUtils::getDayStart(int dayKey)
+{
+    // Noon UTC of that date is the same local date unless the offset is 12h or
+    // more, in which case one correction lands on it
+    std::time_t time = static_cast<std::time_t>(dayKey) * DAY_SECONDS + DAY_SECONDS / 2;
+    LocalTime local = toLocal(time);
+    if (local.dayKey != dayKey)
+    {
+        local = toLocal(time - static_cast<std::time_t>(local.dayKey - dayKey) * DAY_SECONDS);
+    }
+    return local.dayStart;
+}
+
+int DateTimeUtils::getHour(std::time_t time)
+{
+    return toLocal(time).hour;
+}
+
+std::time_t DateTimeUtils::getTimeOnDay(std::time_t day, int hour, int minute)
+{
+    LocalTime local = toLocal(day);
+    if (local.dayEnd - local.dayStart == DAY_SECONDS)
+    {
+        return local.dayStart + hour * 3600 + minute * 60;
+    }
+    return makeLocalTime(local.year, local.month, local.day, hour, minute);
+}
+
+std::time_t DateTimeUtils::makeTime(int year, int month, int day, int hour, int minute, int second)
+{
+    const DayEntry *entry = DayTable::instance().findDate(year, month, day);
+    if (!entry)
+    {
+        return makeLocalTime(year, month, day, hour, minute, second);
+    }
+
+    std::time_t dayLength = (entry + 1)->start - entry->start;
+    if (dayLength == DAY_SECONDS)
+    {
+        return entry->start + hour * 3600 + minute * 60 + second;
+    }
+
+    // mktime with tm_isdst = -1 may return either instant of a time repeated
+    // at fall-back, depending on what it converted last; settle on the
+    // earlier one so a parse of a formatted time is stable
+    std::time_t result = makeLocalTime(year, month, day, hour, minute, second);
+    if (dayLength > DAY_SECONDS)
+    {
+        std::time_t earlier = result - (dayLength - DAY_SECONDS);
+        std::tm first = toLocalTm(earlier);
+        if (first.tm_mday == day && first.tm_hour == hour && first.tm_min == minute && first.tm_sec == second)
+        {
+            return earlier;
+        }
+    }
+    return result;
+}
 
 std::string DateTimeUtils::formatDateTime(std::time_t time, const std::string &format)
 {
-    std::ostringstream oss;
-    oss << std::put_time(std::localtime(&time), format.c_str());
-    return oss.str();
+    char buffer[128];
+    size_t length = formatTo(buffer, sizeof(buffer), time, format.c_str());
+    return std::string(buffer, length);
 }
 
 std::string DateTimeUtils::formatDate(std::time_t time, const std::string &format)
@@ -19,10 +656,66 @@ std::string DateTimeUtils::formatTime(std::time_t time, const std::string &forma
     return formatDateTime(time, format);
 }
 
+size_t DateTimeUtils::formatTo(char *buffer, size_t size, std::time_t time, const char *format)
+{
+    if (size == 0)
+        return 0;
+
+    LocalTime local = toLocal(time);
+    size_t length = 0;
+    for (const char *f = format; *f; ++f)
+    {
+        char field[16];
+        char *fieldEnd = field;
+        if (*f != '%')
+        {
+            *fieldEnd++ = *f;
+        }
+        else if (!(fieldEnd = writeConversion(field, *++f, local)))
+        {
+            return formatWithStrftime(buffer, size, time, format);
+        }
+
+        size_t fieldLength = static_cast<size_t>(fieldEnd - field);
+        if (length + fieldLength >= size)
+            return 0;
+        std::memcpy(buffer + length, field, fieldLength);
+        length += fieldLength;
+    }
+    buffer[length] = '\0';
+    return length;
+}
+
+char *DateTimeUtils::writeDate(char *out, std::time_t time)
+{
+    const DayEntry *entry = DayTable::instance().find(time);
+    if (entry)
+    {
+        std::memcpy(out, entry->date, sizeof(entry->date));
+        return out + sizeof(entry->date);
+    }
+
+    LocalTime local = toLocalUncached(time);
+    return writeDateFields(out, local.year, local.month, local.day);
+}
+
+char *DateTimeUtils::writeClock(char *out, std::time_t time)
+{
+    const DayEntry *entry = DayTable::instance().find(time);
+    if (entry && (entry + 1)->start - entry->start == DAY_SECONDS)
+    {
+        int minuteOfDay = static_cast<int>((time - entry->start) / 60);
+        return ClockTable::instance().write(out, minuteOfDay / 60, minuteOfDay % 60);
+    }
+
+    LocalTime local = toLocal(time);
+    return ClockTable::instance().write(out, local.hour, local.minute);
+}
+
 std::time_t DateTimeUtils::parseDateTime(const std::string &dateTimeStr, const std::string &format)
 {
-    // Placeholder implementation
-    return std::time(nullptr);
+    std::time_t result;
+    return tryParse(dateTimeStr.data(), dateTimeStr.size(), format.c_str(), result) ? result : -1;
 }
 
 std::time_t DateTimeUtils::parseDate(const std::string &dateStr, const std::string &format)
@@ -35,6 +728,65 @@ std::time_t DateTimeUtils::parseTime(const std::string &timeStr, const std::stri
     return parseDateTime(timeStr, format);
 }
 
+bool DateTimeUtils::tryParse(const char *text, size_t length, const char *format, std::time_t &result)
+{
+    const char *p = text;
+    const char *end = text + length;
+    ParsedFields fields;
+    if (!parseFields(p, end, format, fields))
+        return false;
+
+    while (p < end && isSpace(*p))
+        ++p;
+    return p == end && resolveFields(fields, result);
+}
+
+bool DateTimeUtils::parseIso(const char *text, size_t length, std::time_t &result)
+{
+    const char *p = text;
+    const char *end = text + length;
+    while (p < end && isSpace(*p))
+        ++p;
+    while (end > p && isSpace(end[-1]))
+        --end;
+
+    ParsedFields fields;
+    if (!parseFields(p, end, "%Y-%m-%d", fields))
+        return false;
+
+    if (p < end && (*p == 'T' || *p == 't' || *p == ' '))
+    {
+        ++p;
+        if (!readNumber(p, end, 2, 2, fields.hour) || p == end || *p++ != ':' ||
+            !readNumber(p, end, 2, 2, fields.minute))
+        {
+            return false;
+        }
+
+        if (p < end && *p == ':')
+        {
+            ++p;
+            if (!readNumber(p, end, 2, 2, fields.second))
+                return false;
+
+            if (p < end && (*p == '.' || *p == ','))
+            {
+                int fraction;
+                ++p;
+                if (!readNumber(p, end, 1, 1, fraction))
+                    return false;
+                while (p < end && *p >= '0' && *p <= '9')
+                    ++p; // Sub-second precision is dropped
+            }
+        }
+
+        if (p < end && !readOffset(p, end, fields))
+            return false;
+    }
+
+    return p == end && resolveFields(fields, result);
+}
+
 std::time_t DateTimeUtils::getCurrentTime()
 {
     return std::time(nullptr);
@@ -42,20 +794,12 @@ std::time_t DateTimeUtils::getCurrentTime()
 
 std::time_t DateTimeUtils::getStartOfDay(std::time_t time)
 {
-    struct tm *timeInfo = std::localtime(&time);
-    timeInfo->tm_hour = 0;
-    timeInfo->tm_min = 0;
-    timeInfo->tm_sec = 0;
-    return std::mktime(timeInfo);
+    return toLocal(time).dayStart;
 }
 
 std::time_t DateTimeUtils::getEndOfDay(std::time_t time)
 {
-    struct tm *timeInfo = std::localtime(&time);
-    timeInfo->tm_hour = 23;
-    timeInfo->tm_min = 59;
-    timeInfo->tm_sec = 59;
-    return std::mktime(timeInfo);
+    return toLocal(time).dayEnd - 1;
 }
 
 std::time_t DateTimeUtils::addHours(std::time_t time, int hours)
@@ -70,20 +814,18 @@ std::time_t DateTimeUtils::addDays(std::time_t time, int days)
 
 bool DateTimeUtils::isWithinBusinessHours(std::time_t time, int startHour, int endHour)
 {
-    struct tm *timeInfo = std::localtime(&time);
-    int hour = timeInfo->tm_hour;
+    int hour = getHour(time);
     return hour >= startHour && hour < endHour;
 }
 
 bool DateTimeUtils::isSameDay(std::time_t time1, std::time_t time2)
 {
-    return getStartOfDay(time1) == getStartOfDay(time2);
+    return getDayKey(time1) == getDayKey(time2);
 }
 
 int DateTimeUtils::getDayOfWeek(std::time_t time)
 {
-    struct tm *timeInfo = std::localtime(&time);
-    return timeInfo->tm_wday;
+    return toLocal(time).weekday;
 }
 
 double DateTimeUtils::getDurationHours(std::time_t startTime, std::time_t endTime)
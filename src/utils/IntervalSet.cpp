@@ -0,0 +1,51 @@
+#include "IntervalSet.h"
+#include <algorithm>
+#include <climits>
+
+void IntervalSet::clear()
+{
+    m_intervals.clear();
+    m_maxLength = 0;
+}
+
+void IntervalSet::insert(int id, std::time_t start, std::time_t end)
+{
+    m_intervals[std::make_pair(start, id)] = end;
+    m_maxLength = std::max(m_maxLength, end - start);
+}
+
+void IntervalSet::erase(int id, std::time_t start)
+{
+    m_intervals.erase(std::make_pair(start, id));
+}
+
+bool IntervalSet::overlaps(std::time_t start, std::time_t end, int ignoreId) const
+{
+    return findOverlap(start, end, ignoreId) != 0;
+}
+
+int IntervalSet::findOverlap(std::time_t start, std::time_t end, int ignoreId) const
+{
+    // Anything starting before start - m_maxLength has already ended
+    auto it = m_intervals.lower_bound(std::make_pair(start - m_maxLength, INT_MIN));
+    for (; it != m_intervals.end() && it->first.first < end; ++it)
+    {
+        if (it->first.second != ignoreId && it->second > start)
+        {
+            return it->first.second;
+        }
+    }
+    return 0;
+}
+
+void IntervalSet::findOverlaps(std::time_t start, std::time_t end, std::vector<int> &ids) const
+{
+    auto it = m_intervals.lower_bound(std::make_pair(start - m_maxLength, INT_MIN));
+    for (; it != m_intervals.end() && it->first.first < end; ++it)
+    {
+        if (it->second > start)
+        {
+            ids.push_back(it->first.second);
+        }
+    }
+}
@@ -0,0 +1,194 @@
+#include "NotificationTemplate.h"
+#include "DateTimeUtils.h"
+#include <charconv>
+#include <cmath>
+
+namespace
+{
+    void appendTwoDigits(std::string &out, int value)
+    {
+        out.push_back(static_cast<char>('0' + value / 10));
+        out.push_back(static_cast<char>('0' + value % 10));
+    }
+}
+
+// DateFragmentCache implementation
+DateFragmentCache::DateFragmentCache() : m_dayStart(0), m_dayEnd(0), m_regularDay(false)
+{
+    m_date[0] = '\0';
+}
+
+void DateFragmentCache::appendDate(std::string &out, std::time_t time)
+{
+    if (time < m_dayStart || time >= m_dayEnd)
+    {
+        load(time);
+    }
+    out += m_date;
+}
+
+void DateFragmentCache::appendTime(std::string &out, std::time_t time)
+{
+    if (time < m_dayStart || time >= m_dayEnd)
+    {
+        load(time);
+    }
+
+    int hour, minute;
+    if (m_regularDay)
+    {
+        int minutes = static_cast<int>((time - m_dayStart) / 60);
+        hour = minutes / 60;
+        minute = minutes % 60;
+    }
+    else
+    {
+        // DST change inside the day: the shared table places the hour
+        DateTimeUtils::LocalTime local = DateTimeUtils::toLocal(time);
+        hour = local.hour;
+        minute = local.minute;
+    }
+
+    appendTwoDigits(out, hour);
+    out.push_back(':');
+    appendTwoDigits(out, minute);
+}
+
+void DateFragmentCache::load(std::time_t time)
+{
+    DateTimeUtils::LocalTime local = DateTimeUtils::toLocal(time);
+    *DateTimeUtils::writeDate(m_date, time) = '\0';
+
+    m_dayStart = local.dayStart;
+    m_dayEnd = local.dayEnd;
+    m_regularDay = (m_dayEnd - m_dayStart == 24 * 60 * 60);
+}
+
+// NotificationTemplate implementation
+NotificationTemplate::NotificationTemplate(const std::string &text) : m_text(text)
+{
+    size_t literalStart = 0;
+    size_t pos = 0;
+    while ((pos = m_text.find('{', pos)) != std::string::npos)
+    {
+        size_t close = m_text.find('}', pos + 1);
+        if (close == std::string::npos)
+            break;
+
+        Field field = lookupField(m_text.substr(pos + 1, close - pos - 1));
+        if (field == Field::LITERAL)
+        {
+            pos = close + 1; // Not a placeholder we know, keep it as text
+            continue;
+        }
+
+        if (pos > literalStart)
+        {
+            m_segments.push_back(Segment{Field::LITERAL, literalStart, pos - literalStart});
+        }
+        m_segments.push_back(Segment{field, 0, 0});
+        literalStart = pos = close + 1;
+    }
+
+    if (literalStart < m_text.size())
+    {
+        m_segments.push_back(Segment{Field::LITERAL, literalStart, m_text.size() - literalStart});
+    }
+}
+
+void NotificationTemplate::render(const Booking &booking, const std::string &customerName,
+                                  DateFragmentCache &dates, std::string &out) const
+{
+    for (const Segment &segment : m_segments)
+    {
+        switch (segment.field)
+        {
+        case Field::LITERAL:
+            out.append(m_text, segment.offset, segment.length);
+            break;
+        case Field::BOOKING_ID:
+            appendInt(out, booking.getId());
+            break;
+        case Field::USER_ID:
+            appendInt(out, booking.getUserId());
+            break;
+        case Field::COURT_ID:
+            appendInt(out, booking.getCourtId());
+            break;
+        case Field::DATE:
+            dates.appendDate(out, booking.getStartTime());
+            break;
+        case Field::START_TIME:
+            dates.appendTime(out, booking.getStartTime());
+            break;
+        case Field::END_TIME:
+            dates.appendTime(out, booking.getEndTime());
+            break;
+        case Field::AMOUNT:
+        {
+            // Two decimals from integer cents
+            long long cents = std::llround(booking.getTotalAmount() * 100.0);
+            if (cents < 0)
+            {
+                out.push_back('-');
+                cents = -cents;
+            }
+            appendInt(out, cents / 100);
+            out.push_back('.');
+            appendTwoDigits(out, static_cast<int>(cents % 100));
+            break;
+        }
+        case Field::STATUS:
+            out += booking.getStatusString();
+            break;
+        case Field::NOTES:
+            out += booking.getNotes();
+            break;
+        case Field::NOTES_LINE:
+            if (!booking.getNotes().empty())
+            {
+                out += "\nNotes: ";
+                out += booking.getNotes();
+            }
+            break;
+        case Field::CUSTOMER_NAME:
+            out += customerName.empty() ? std::string("Customer") : customerName;
+            break;
+        }
+    }
+}
+
+NotificationTemplate::Field NotificationTemplate::lookupField(const std::string &name)
+{
+    static const struct
+    {
+        const char *name;
+        Field field;
+    } fields[] = {
+        {"bookingId", Field::BOOKING_ID},
+        {"userId", Field::USER_ID},
+        {"courtId", Field::COURT_ID},
+        {"date", Field::DATE},
+        {"startTime", Field::START_TIME},
+        {"endTime", Field::END_TIME},
+        {"amount", Field::AMOUNT},
+        {"status", Field::STATUS},
+        {"notes", Field::NOTES},
+        {"notesLine", Field::NOTES_LINE},
+        {"customerName", Field::CUSTOMER_NAME},
+    };
+
+    for (const auto &entry : fields)
+    {
+        if (name == entry.name)
+            return entry.field;
+    }
+    return Field::LITERAL;
+}
+
+void NotificationTemplate::appendInt(std::string &out, long long value)
+{
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+}
@@ -0,0 +1,114 @@
+#include "NumberFormat.h"
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+    const char VND_SUFFIX[] = " VND";
+    const size_t VND_SUFFIX_LENGTH = sizeof(VND_SUFFIX) - 1;
+
+    // "0 VND", "1,000 VND" ... "2,000,000 VND"
+    class VndCache
+    {
+    public:
+        static const long long THOUSANDS = 2001;
+
+        static const VndCache &instance()
+        {
+            static const VndCache cache;
+            return cache;
+        }
+
+        char *write(char *out, long long thousands) const
+        {
+            const Entry &entry = m_entries[thousands];
+            std::memcpy(out, entry.text, entry.length);
+            return out + entry.length;
+        }
+
+    private:
+        struct Entry
+        {
+            char text[15];
+            uint8_t length;
+        };
+
+        VndCache()
+        {
+            for (long long thousands = 0; thousands < THOUSANDS; ++thousands)
+            {
+                Entry &entry = m_entries[thousands];
+                char *end = NumberFormat::writeInteger(entry.text, thousands * 1000);
+                std::memcpy(end, VND_SUFFIX, VND_SUFFIX_LENGTH);
+                entry.length = static_cast<uint8_t>(end + VND_SUFFIX_LENGTH - entry.text);
+            }
+        }
+
+        Entry m_entries[THOUSANDS];
+    };
+
+    long long toDong(double amount)
+    {
+        // Same rounding as "%.0f"; out-of-range values are clamped
+        if (!(std::fabs(amount) < 9.0e18))
+            return std::isnan(amount) ? 0 : (amount < 0 ? -9000000000000000000LL : 9000000000000000000LL);
+        return static_cast<long long>(std::nearbyint(amount));
+    }
+}
+
+char *NumberFormat::writeInteger(char *out, long long value)
+{
+    unsigned long long magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value)
+                                             : static_cast<unsigned long long>(value);
+    char digits[24];
+    size_t count = static_cast<size_t>(std::to_chars(digits, digits + sizeof(digits), magnitude).ptr - digits);
+
+    if (value < 0)
+    {
+        *out++ = '-';
+    }
+
+    size_t lead = (count % 3 == 0) ? 3 : count % 3;
+    std::memcpy(out, digits, lead);
+    out += lead;
+    for (size_t i = lead; i < count; i += 3)
+    {
+        *out++ = ',';
+        std::memcpy(out, digits + i, 3);
+        out += 3;
+    }
+    return out;
+}
+
+char *NumberFormat::writeVnd(char *out, double amount)
+{
+    long long dong = toDong(amount);
+    if (dong >= 0 && dong % 1000 == 0 && dong / 1000 < VndCache::THOUSANDS)
+    {
+        return VndCache::instance().write(out, dong / 1000);
+    }
+
+    out = writeInteger(out, dong);
+    std::memcpy(out, VND_SUFFIX, VND_SUFFIX_LENGTH);
+    return out + VND_SUFFIX_LENGTH;
+}
+
+NumberText NumberFormat::integer(long long value)
+{
+    NumberText text;
+    char *end = writeInteger(text.m_text, value);
+    *end = '\0';
+    text.m_length = static_cast<size_t>(end - text.m_text);
+    return text;
+}
+
+NumberText NumberFormat::vnd(double amount)
+{
+    NumberText text;
+    char *end = writeVnd(text.m_text, amount);
+    *end = '\0';
+    text.m_length = static_cast<size_t>(end - text.m_text);
+    return text;
+}
@@ -0,0 +1,199 @@
+#include "OccupancyMap.h"
+#include "DateTimeUtils.h"
+#include <algorithm>
+
+namespace
+{
+    const std::time_t SLOT_SECONDS = OccupancyMap::SLOT_MINUTES * 60;
+}
+
+void OccupancyMap::clear()
+{
+    m_days.clear();
+    m_series.clear();
+    m_holds.clear();
+}
+
+void OccupancyMap::addSeries(const SeriesPtr &series)
+{
+    m_series[series->getCourtId()].push_back(series);
+}
+
+void OccupancyMap::removeSeries(int courtId, int seriesId)
+{
+    auto it = m_series.find(courtId);
+    if (it == m_series.end())
+        return;
+
+    std::vector<SeriesPtr> &courtSeries = it->second;
+    courtSeries.erase(std::remove_if(courtSeries.begin(), courtSeries.end(),
+                                     [seriesId](const SeriesPtr &series)
+                                     {
+                                         return series->getId() == seriesId;
+                                     }),
+                      courtSeries.end());
+    if (courtSeries.empty())
+    {
+        m_series.erase(it);
+    }
+}
+
+void OccupancyMap::mark(int courtId, std::time_t startTime, std::time_t endTime)
+{
+    std::time_t dayStart = DateTimeUtils::getStartOfDay(startTime);
+    while (startTime < endTime)
+    {
+        std::time_t dayEnd = nextDayStart(dayStart);
+        std::time_t segmentEnd = std::min(endTime, dayEnd);
+
+        int firstSlot = slotOf(dayStart, startTime);
+        int lastSlot = slotOf(dayStart, segmentEnd - 1);
+
+        DayBits &bits = m_days[makeKey(courtId, dayStart)];
+        for (int slot = firstSlot; slot <= lastSlot; ++slot)
+        {
+            bits.set(slot);
+        }
+
+        startTime = segmentEnd;
+        dayStart = dayEnd;
+    }
+}
+
+void OccupancyMap::clearDay(int courtId, std::time_t dayStart)
+{
+    m_days.erase(makeKey(courtId, DateTimeUtils::getStartOfDay(dayStart)));
+}
+
+void OccupancyMap::addHold(int holdId, int courtId, std::time_t startTime, std::time_t endTime)
+{
+    m_holds[courtId][holdId] = std::make_pair(startTime, endTime);
+}
+
+void OccupancyMap::removeHold(int holdId, int courtId)
+{
+    auto it = m_holds.find(courtId);
+    if (it != m_holds.end() && it->second.erase(holdId) != 0 && it->second.empty())
+    {
+        m_holds.erase(it);
+    }
+}
+
+OccupancyMap::DayBits OccupancyMap::getDay(int courtId, std::time_t date) const
+{
+    return combinedDay(courtId, DateTimeUtils::getStartOfDay(date));
+}
+
+bool OccupancyMap::isFree(int courtId, std::time_t startTime, std::time_t endTime) const
+{
+    std::time_t dayStart = DateTimeUtils::getStartOfDay(startTime);
+    while (startTime < endTime)
+    {
+        std::time_t dayEnd = nextDayStart(dayStart);
+        std::time_t segmentEnd = std::min(endTime, dayEnd);
+
+        DayBits bits = combinedDay(courtId, dayStart);
+        int lastSlot = slotOf(dayStart, segmentEnd - 1);
+        for (int slot = slotOf(dayStart, startTime); slot <= lastSlot; ++slot)
+        {
+            if (bits.test(slot))
+                return false;
+        }
+
+        startTime = segmentEnd;
+        dayStart = dayEnd;
+    }
+    return true;
+}
+
+int OccupancyMap::findFreeRun(int courtId, std::time_t dayStart, int fromSlot, int endSlot, int length, int step) const
+{
+    endSlot = std::min(endSlot, static_cast<int>(SLOTS_PER_DAY));
+    int slot = (std::max(fromSlot, 0) + step - 1) / step * step;
+
+    const DayBits bits = combinedDay(courtId, dayStart);
+    if (bits.none())
+    {
+        return (slot + length <= endSlot) ? slot : -1;
+    }
+
+    while (slot + length <= endSlot)
+    {
+        // Check the candidate from its end, so a clash skips past the last busy slot
+        int busy = slot + length - 1;
+        while (busy >= slot && !bits.test(busy))
+        {
+            --busy;
+        }
+        if (busy < slot)
+        {
+            return slot;
+        }
+        slot = (busy + step) / step * step;
+    }
+    return -1;
+}
+
+OccupancyMap::DayBits OccupancyMap::combinedDay(int courtId, std::time_t dayStart) const
+{
+    auto it = m_days.find(makeKey(courtId, dayStart));
+    DayBits bits = (it != m_days.end()) ? it->second : DayBits();
+
+    auto series = m_series.find(courtId);
+    auto holds = m_holds.find(courtId);
+    if (series == m_series.end() && holds == m_holds.end())
+        return bits;
+
+    std::time_t dayEnd = nextDayStart(dayStart);
+    auto markWithinDay = [&](std::time_t startTime, std::time_t endTime)
+    {
+        std::time_t start = std::max(startTime, dayStart);
+        std::time_t end = std::min(endTime, dayEnd);
+        if (start < end)
+        {
+            int lastSlot = slotOf(dayStart, end - 1);
+            for (int slot = slotOf(dayStart, start); slot <= lastSlot; ++slot)
+            {
+                bits.set(slot);
+            }
+        }
+    };
+
+    if (series != m_series.end())
+    {
+        // Occurrences starting the day before may run past midnight into this one
+        for (const SeriesPtr &rule : series->second)
+        {
+            for (const auto &occurrence : rule->getOccurrences(dayStart - rule->getDurationSeconds() + 1, dayEnd))
+            {
+                markWithinDay(occurrence.first, occurrence.second);
+            }
+        }
+    }
+    if (holds != m_holds.end())
+    {
+        for (const auto &hold : holds->second)
+        {
+            markWithinDay(hold.second.first, hold.second.second);
+        }
+    }
+    return bits;
+}
+
+int OccupancyMap::slotOf(std::time_t dayStart, std::time_t time)
+{
+    // Clamp so 25-hour DST days fold their extra hour into the last slot
+    std::time_t slot = (time - dayStart) / SLOT_SECONDS;
+    return static_cast<int>(std::max<std::time_t>(0, std::min<std::time_t>(slot, SLOTS_PER_DAY - 1)));
+}
+
+uint64_t OccupancyMap::makeKey(int courtId, std::time_t dayStart)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(courtId)) << 40) |
+           (static_cast<uint64_t>(dayStart) & 0xFFFFFFFFFFULL);
+}
+
+std::time_t OccupancyMap::nextDayStart(std::time_t dayStart)
+{
+    return DateTimeUtils::toLocal(dayStart).dayEnd;
+}
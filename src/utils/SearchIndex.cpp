@@ -0,0 +1,380 @@
+#include "SearchIndex.h"
+#include <algorithm>
+
+namespace
+{
+    // Pads the start of every word so one- and two-character terms have grams too
+    const unsigned char WORD_PAD = 0x01;
+
+    // Match quality multipliers
+    const int SCORE_EXACT = 4;
+    const int SCORE_WORD_START = 2;
+    const int SCORE_SUBSTRING = 1;
+
+    uint32_t packGram(unsigned char a, unsigned char b, unsigned char c)
+    {
+        return (static_cast<uint32_t>(a) << 16) | (static_cast<uint32_t>(b) << 8) | c;
+    }
+
+    bool isWordChar(unsigned char c)
+    {
+        return (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c >= 0x80;
+    }
+
+    bool isWordStart(const std::string &text, size_t pos)
+    {
+        return pos == 0 || !isWordChar(static_cast<unsigned char>(text[pos - 1]));
+    }
+
+    // Sorted-list intersection, galloping through the longer list
+    std::vector<uint32_t> intersectSlots(const std::vector<uint32_t> &a, const std::vector<uint32_t> &b)
+    {
+        const std::vector<uint32_t> &small = (a.size() <= b.size()) ? a : b;
+        const std::vector<uint32_t> &large = (a.size() <= b.size()) ? b : a;
+
+        std::vector<uint32_t> result;
+        result.reserve(small.size());
+
+        auto cursor = large.begin();
+        for (uint32_t value : small)
+        {
+            size_t step = 1;
+            auto probe = cursor;
+            while (probe != large.end() && *probe < value)
+            {
+                cursor = probe;
+                size_t remaining = static_cast<size_t>(large.end() - probe);
+                probe += std::min(step, remaining);
+                step *= 2;
+            }
+            cursor = std::lower_bound(cursor, probe, value);
+            if (cursor == large.end())
+                break;
+            if (*cursor == value)
+                result.push_back(value);
+        }
+        return result;
+    }
+
+    bool containsAtWordStart(const std::string &text, const std::string &term)
+    {
+        size_t pos = text.find(term);
+        while (pos != std::string::npos)
+        {
+            if (isWordStart(text, pos))
+                return true;
+            pos = text.find(term, pos + 1);
+        }
+        return false;
+    }
+}
+
+SearchIndex::SearchIndex(std::vector<int> fieldWeights) : m_fieldWeights(std::move(fieldWeights))
+{
+}
+
+void SearchIndex::clear()
+{
+    m_slots.clear();
+    m_freeSlots.clear();
+    m_slotById.clear();
+    m_postings.clear();
+}
+
+void SearchIndex::addDocument(int docId, const std::vector<std::string> &fields)
+{
+    removeDocument(docId);
+
+    uint32_t slot;
+    if (!m_freeSlots.empty())
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    Document &document = m_slots[slot];
+    document.docId = docId;
+    document.live = true;
+    document.fields.clear();
+    document.grams.clear();
+    for (const auto &field : fields)
+    {
+        document.fields.push_back(normalize(field));
+        collectGrams(document.fields.back(), document.grams);
+    }
+    std::sort(document.grams.begin(), document.grams.end());
+    document.grams.erase(std::unique(document.grams.begin(), document.grams.end()), document.grams.end());
+
+    for (uint32_t gram : document.grams)
+    {
+        std::vector<uint32_t> &postings = m_postings[gram];
+        // New slots are appended at the end, so this is almost always a push_back
+        if (postings.empty() || postings.back() < slot)
+        {
+            postings.push_back(slot);
+        }
+        else
+        {
+            postings.insert(std::lower_bound(postings.begin(), postings.end(), slot), slot);
+        }
+    }
+
+    m_slotById[docId] = slot;
+}
+
+void SearchIndex::removeDocument(int docId)
+{
+    auto slotIt = m_slotById.find(docId);
+    if (slotIt == m_slotById.end())
+        return;
+
+    uint32_t slot = slotIt->second;
+    Document &document = m_slots[slot];
+    for (uint32_t gram : document.grams)
+    {
+        auto postIt = m_postings.find(gram);
+        if (postIt == m_postings.end())
+            continue;
+
+        std::vector<uint32_t> &postings = postIt->second;
+        auto it = std::lower_bound(postings.begin(), postings.end(), slot);
+        if (it != postings.end() && *it == slot)
+        {
+            postings.erase(it);
+        }
+        if (postings.empty())
+        {
+            m_postings.erase(postIt);
+        }
+    }
+
+    document.live = false;
+    document.fields.clear();
+    document.grams.clear();
+    m_freeSlots.push_back(slot);
+    m_slotById.erase(slotIt);
+}
+
+std::vector<SearchIndex::Result> SearchIndex::search(const std::string &query, size_t limit) const
+{
+    std::vector<Result> results;
+    std::vector<std::string> terms = splitTerms(query);
+    if (terms.empty())
+        return results;
+
+    for (uint32_t slot : matchCandidates(terms))
+    {
+        const Document &document = m_slots[slot];
+        int score = document.live ? scoreDocument(document, terms) : 0;
+        if (score > 0)
+        {
+            results.push_back({document.docId, score});
+        }
+    }
+
+    auto byRank = [](const Result &a, const Result &b)
+    {
+        return a.score != b.score ? a.score > b.score : a.docId < b.docId;
+    };
+
+    if (limit > 0 && limit < results.size())
+    {
+        std::partial_sort(results.begin(), results.begin() + limit, results.end(), byRank);
+        results.resize(limit);
+    }
+    else
+    {
+        std::sort(results.begin(), results.end(), byRank);
+    }
+    return results;
+}
+
+std::vector<int> SearchIndex::searchIds(const std::string &query) const
+{
+    std::vector<int> ids;
+    std::vector<std::string> terms = splitTerms(query);
+    if (terms.empty())
+        return ids;
+
+    // A term of up to three characters is a single gram, so its posting list is
+    // already exact and the text check can be skipped
+    bool needsVerify = false;
+    for (const auto &term : terms)
+    {
+        needsVerify = needsVerify || term.size() > 3;
+    }
+
+    std::vector<uint32_t> candidates = matchCandidates(terms);
+    ids.reserve(candidates.size());
+    for (uint32_t slot : candidates)
+    {
+        const Document &document = m_slots[slot];
+        if (document.live && (!needsVerify || scoreDocument(document, terms) > 0))
+        {
+            ids.push_back(document.docId);
+        }
+    }
+    // Slots are reused, so ids are not necessarily in slot order
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::string SearchIndex::normalize(const std::string &text)
+{
+    std::string result;
+    result.reserve(text.size());
+
+    bool pendingSpace = false;
+    for (unsigned char c : text)
+    {
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r')
+        {
+            pendingSpace = !result.empty();
+            continue;
+        }
+        if (pendingSpace)
+        {
+            result.push_back(' ');
+            pendingSpace = false;
+        }
+        result.push_back((c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : static_cast<char>(c));
+    }
+    return result;
+}
+
+std::vector<uint32_t> SearchIndex::matchCandidates(const std::vector<std::string> &terms) const
+{
+    // Every gram of every term must be present; intersect the shortest lists first
+    std::vector<const std::vector<uint32_t> *> postings;
+    for (const auto &term : terms)
+    {
+        for (uint32_t gram : queryGrams(term))
+        {
+            auto it = m_postings.find(gram);
+            if (it == m_postings.end())
+                return {};
+            postings.push_back(&it->second);
+        }
+    }
+    if (postings.empty())
+        return {};
+
+    std::sort(postings.begin(), postings.end(),
+              [](const std::vector<uint32_t> *a, const std::vector<uint32_t> *b)
+              {
+                  return a->size() < b->size();
+              });
+    postings.erase(std::unique(postings.begin(), postings.end()), postings.end());
+
+    std::vector<uint32_t> candidates = *postings[0];
+    for (size_t i = 1; i < postings.size() && !candidates.empty(); ++i)
+    {
+        candidates = intersectSlots(candidates, *postings[i]);
+    }
+    return candidates;
+}
+
+int SearchIndex::scoreDocument(const Document &document, const std::vector<std::string> &terms) const
+{
+    // Grams only prove a candidate; check each term against the stored text
+    int total = 0;
+    for (const auto &term : terms)
+    {
+        bool shortTerm = term.size() < 3;
+        int best = 0;
+        for (size_t i = 0; i < document.fields.size(); ++i)
+        {
+            const std::string &field = document.fields[i];
+            int weight = i < m_fieldWeights.size() ? m_fieldWeights[i] : 1;
+
+            int quality = 0;
+            if (field == term)
+                quality = SCORE_EXACT;
+            else if (containsAtWordStart(field, term))
+                quality = SCORE_WORD_START;
+            else if (!shortTerm && field.find(term) != std::string::npos)
+                quality = SCORE_SUBSTRING;
+
+            best = std::max(best, weight * quality);
+        }
+
+        if (best == 0)
+            return 0;
+        total += best;
+    }
+    return total;
+}
+
+void SearchIndex::collectGrams(const std::string &field, std::vector<uint32_t> &grams)
+{
+    for (size_t i = 0; i < field.size(); ++i)
+    {
+        unsigned char c = static_cast<unsigned char>(field[i]);
+        if (isWordChar(c) && isWordStart(field, i))
+        {
+            grams.push_back(packGram(WORD_PAD, WORD_PAD, c));
+            if (i + 1 < field.size())
+            {
+                grams.push_back(packGram(WORD_PAD, c, static_cast<unsigned char>(field[i + 1])));
+            }
+        }
+        if (i + 2 < field.size())
+        {
+            grams.push_back(packGram(c, static_cast<unsigned char>(field[i + 1]),
+                                     static_cast<unsigned char>(field[i + 2])));
+        }
+    }
+}
+
+std::vector<uint32_t> SearchIndex::queryGrams(const std::string &term)
+{
+    std::vector<uint32_t> grams;
+    if (term.size() == 1)
+    {
+        grams.push_back(packGram(WORD_PAD, WORD_PAD, static_cast<unsigned char>(term[0])));
+    }
+    else if (term.size() == 2)
+    {
+        grams.push_back(packGram(WORD_PAD, static_cast<unsigned char>(term[0]),
+                                 static_cast<unsigned char>(term[1])));
+    }
+    else
+    {
+        for (size_t i = 0; i + 2 < term.size(); ++i)
+        {
+            grams.push_back(packGram(static_cast<unsigned char>(term[i]),
+                                     static_cast<unsigned char>(term[i + 1]),
+                                     static_cast<unsigned char>(term[i + 2])));
+        }
+    }
+    return grams;
+}
+
+std::vector<std::string> SearchIndex::splitTerms(const std::string &query)
+{
+    std::vector<std::string> terms;
+    std::string normalized = normalize(query);
+
+    size_t start = 0;
+    while (start < normalized.size())
+    {
+        size_t end = normalized.find(' ', start);
+        if (end == std::string::npos)
+            end = normalized.size();
+        if (end > start)
+        {
+            std::string term = normalized.substr(start, end - start);
+            if (std::find(terms.begin(), terms.end(), term) == terms.end())
+            {
+                terms.push_back(term);
+            }
+        }
+        start = end + 1;
+    }
+    return terms;
+}
@@ -0,0 +1,347 @@
+#include "SmtpClient.h"
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <netdb.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+    void initSockets()
+    {
+        static std::once_flag once;
+        std::call_once(once, []
+                       {
+                           WSADATA data;
+                           WSAStartup(MAKEWORD(2, 2), &data);
+                       });
+    }
+
+    void closeSocket(intptr_t socket) { closesocket(static_cast<SOCKET>(socket)); }
+#else
+    void initSockets() {}
+    void closeSocket(intptr_t socket) { ::close(static_cast<int>(socket)); }
+#endif
+
+    void setTimeouts(intptr_t socket, int timeoutSeconds)
+    {
+#ifdef _WIN32
+        DWORD timeout = static_cast<DWORD>(timeoutSeconds) * 1000;
+        setsockopt(static_cast<SOCKET>(socket), SOL_SOCKET, SO_RCVTIMEO,
+                   reinterpret_cast<const char *>(&timeout), sizeof(timeout));
+        setsockopt(static_cast<SOCKET>(socket), SOL_SOCKET, SO_SNDTIMEO,
+                   reinterpret_cast<const char *>(&timeout), sizeof(timeout));
+#else
+        timeval timeout{};
+        timeout.tv_sec = timeoutSeconds;
+        setsockopt(static_cast<int>(socket), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(static_cast<int>(socket), SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(static_cast<int>(socket), SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+#endif
+    }
+
+    // Header-safe single line
+    std::string stripLineBreaks(const std::string &text)
+    {
+        std::string result;
+        result.reserve(text.size());
+        for (char c : text)
+        {
+            result.push_back((c == '\r' || c == '\n') ? ' ' : c);
+        }
+        return result;
+    }
+}
+
+SmtpClient::SmtpClient() : m_socket(INVALID_HANDLE), m_lastReplyCode(0)
+{
+}
+
+SmtpClient::~SmtpClient()
+{
+    close();
+}
+
+bool SmtpClient::connect(const std::string &host, int port, int timeoutSeconds)
+{
+    close();
+    initSockets();
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    std::string service = std::to_string(port);
+    if (getaddrinfo(host.c_str(), service.c_str(), &hints, &addresses) != 0 || !addresses)
+    {
+        return fail("Cannot resolve " + host);
+    }
+
+    for (addrinfo *address = addresses; address; address = address->ai_next)
+    {
+        intptr_t handle = static_cast<intptr_t>(socket(address->ai_family, address->ai_socktype, address->ai_protocol));
+        if (handle == INVALID_HANDLE)
+            continue;
+
+        setTimeouts(handle, timeoutSeconds);
+#ifdef _WIN32
+        bool connected = ::connect(static_cast<SOCKET>(handle), address->ai_addr,
+                                   static_cast<int>(address->ai_addrlen)) == 0;
+#else
+        bool connected = ::connect(static_cast<int>(handle), address->ai_addr, address->ai_addrlen) == 0;
+#endif
+        if (connected)
+        {
+            m_socket = handle;
+            break;
+        }
+        closeSocket(handle);
+    }
+    freeaddrinfo(addresses);
+
+    if (m_socket == INVALID_HANDLE)
+    {
+        return fail("Cannot connect to " + host + ":" + service);
+    }
+
+    // Server greeting
+    if (!readReply() || m_lastReplyCode != 220)
+    {
+        close();
+        return fail("Unexpected greeting: " + m_lastReply);
+    }
+    return true;
+}
+
+bool SmtpClient::hello(const std::string &clientName)
+{
+    if (command("EHLO " + clientName, 250))
+        return true;
+    return command("HELO " + clientName, 250);
+}
+
+bool SmtpClient::login(const std::string &username, const std::string &password)
+{
+    std::string credentials;
+    credentials.push_back('\0');
+    credentials += username;
+    credentials.push_back('\0');
+    credentials += password;
+    return command("AUTH PLAIN " + encodeBase64(credentials), 235);
+}
+
+bool SmtpClient::sendMail(const std::string &from, const std::string &to,
+                          const std::string &subject, const std::string &body)
+{
+    if (!command("MAIL FROM:<" + stripLineBreaks(from) + ">", 250) ||
+        !command("RCPT TO:<" + stripLineBreaks(to) + ">", 250, 251) ||
+        !command("DATA", 354))
+    {
+        return false;
+    }
+
+    char date[64];
+    std::time_t now = std::time(nullptr);
+    std::tm utc{};
+#ifdef _WIN32
+    gmtime_s(&utc, &now);
+#else
+    gmtime_r(&now, &utc);
+#endif
+    std::strftime(date, sizeof(date), "%a, %d %b %Y %H:%M:%S +0000", &utc);
+
+    std::string message;
+    message.reserve(body.size() + subject.size() + 256);
+    message += "From: " + stripLineBreaks(from) + "\r\n";
+    message += "To: " + stripLineBreaks(to) + "\r\n";
+    message += "Subject: " + stripLineBreaks(subject) + "\r\n";
+    message += std::string("Date: ") + date + "\r\n";
+    message += "Content-Type: text/plain; charset=UTF-8\r\n\r\n";
+
+    // Normalize line endings and dot-stuff lines that start with '.'
+    bool lineStart = true;
+    for (size_t i = 0; i < body.size(); ++i)
+    {
+        char c = body[i];
+        if (c == '\r')
+            continue;
+        if (c == '\n')
+        {
+            message += "\r\n";
+            lineStart = true;
+            continue;
+        }
+        if (lineStart && c == '.')
+        {
+            message.push_back('.');
+        }
+        message.push_back(c);
+        lineStart = false;
+    }
+    if (!lineStart)
+    {
+        message += "\r\n";
+    }
+    message += ".";
+
+    return command(message, 250);
+}
+
+bool SmtpClient::reset()
+{
+    return command("RSET", 250);
+}
+
+void SmtpClient::quit()
+{
+    if (isConnected())
+    {
+        command("QUIT", 221);
+    }
+    close();
+}
+
+void SmtpClient::close()
+{
+    if (m_socket != INVALID_HANDLE)
+    {
+        closeSocket(m_socket);
+        m_socket = INVALID_HANDLE;
+    }
+    m_buffer.clear();
+}
+
+bool SmtpClient::command(const std::string &line, int expectedCode, int alternateCode)
+{
+    if (!sendAll(line + "\r\n") || !readReply())
+    {
+        return false;
+    }
+    if (m_lastReplyCode != expectedCode && (alternateCode == 0 || m_lastReplyCode != alternateCode))
+    {
+        m_lastError = m_lastReply;
+        return false;
+    }
+    return true;
+}
+
+bool SmtpClient::readReply()
+{
+    // Multi-line replies use "250-" on every line but the last ("250 ")
+    m_lastReply.clear();
+    for (;;)
+    {
+        size_t lineEnd = m_buffer.find("\r\n");
+        while (lineEnd == std::string::npos)
+        {
+            char chunk[1024];
+#ifdef _WIN32
+            int received = recv(static_cast<SOCKET>(m_socket), chunk, sizeof(chunk), 0);
+#else
+            ssize_t received = recv(static_cast<int>(m_socket), chunk, sizeof(chunk), 0);
+#endif
+            if (received <= 0)
+            {
+                close();
+                m_lastReplyCode = 0;
+                return fail("Connection closed while waiting for reply");
+            }
+            m_buffer.append(chunk, static_cast<size_t>(received));
+            lineEnd = m_buffer.find("\r\n");
+        }
+
+        std::string line = m_buffer.substr(0, lineEnd);
+        m_buffer.erase(0, lineEnd + 2);
+        if (!m_lastReply.empty())
+            m_lastReply += "\n";
+        m_lastReply += line;
+
+        if (line.size() < 3)
+        {
+            m_lastReplyCode = 0;
+            return fail("Malformed reply: " + line);
+        }
+        if (line.size() == 3 || line[3] != '-')
+        {
+            m_lastReplyCode = std::atoi(line.substr(0, 3).c_str());
+            return true;
+        }
+    }
+}
+
+bool SmtpClient::sendAll(const std::string &data)
+{
+    if (!isConnected())
+        return fail("Not connected");
+
+    size_t sent = 0;
+    while (sent < data.size())
+    {
+#ifdef _WIN32
+        int result = send(static_cast<SOCKET>(m_socket), data.data() + sent,
+                          static_cast<int>(data.size() - sent), 0);
+#elif defined(MSG_NOSIGNAL)
+        ssize_t result = send(static_cast<int>(m_socket), data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+#else
+        ssize_t result = send(static_cast<int>(m_socket), data.data() + sent, data.size() - sent, 0);
+#endif
+        if (result <= 0)
+        {
+            close();
+            m_lastReplyCode = 0;
+            return fail("Connection lost while sending");
+        }
+        sent += static_cast<size_t>(result);
+    }
+    return true;
+}
+
+bool SmtpClient::fail(const std::string &message)
+{
+    m_lastError = message;
+    return false;
+}
+
+std::string SmtpClient::encodeBase64(const std::string &data)
+{
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+    std::string encoded;
+    encoded.reserve((data.size() + 2) / 3 * 4);
+    size_t i = 0;
+    for (; i + 2 < data.size(); i += 3)
+    {
+        uint32_t triple = (static_cast<uint8_t>(data[i]) << 16) |
+                          (static_cast<uint8_t>(data[i + 1]) << 8) |
+                          static_cast<uint8_t>(data[i + 2]);
+        encoded.push_back(alphabet[(triple >> 18) & 0x3F]);
+        encoded.push_back(alphabet[(triple >> 12) & 0x3F]);
+        encoded.push_back(alphabet[(triple >> 6) & 0x3F]);
+        encoded.push_back(alphabet[triple & 0x3F]);
+    }
+    if (i < data.size())
+    {
+        uint32_t triple = static_cast<uint8_t>(data[i]) << 16;
+        if (i + 1 < data.size())
+            triple |= static_cast<uint8_t>(data[i + 1]) << 8;
+        encoded.push_back(alphabet[(triple >> 18) & 0x3F]);
+        encoded.push_back(alphabet[(triple >> 12) & 0x3F]);
+        encoded.push_back(i + 1 < data.size() ? alphabet[(triple >> 6) & 0x3F] : '=');
+        encoded.push_back('=');
+    }
+    return encoded;
+}
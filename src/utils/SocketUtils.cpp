@@ -0,0 +1,428 @@
+#include "SocketUtils.h"
+#include <cstring>
+#include <mutex>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    const char UNIX_PREFIX[] = "unix:";
+    const size_t UNIX_PREFIX_LENGTH = sizeof(UNIX_PREFIX) - 1;
+
+#ifdef _WIN32
+    typedef int SocketLength;
+
+    bool lastCallWouldBlock() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+    bool lastCallInterrupted() { return WSAGetLastError() == WSAEINTR; }
+    SOCKET native(intptr_t socket) { return static_cast<SOCKET>(socket); }
+    const int SEND_FLAGS = 0;
+#else
+    typedef socklen_t SocketLength;
+
+    bool lastCallWouldBlock() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+    bool lastCallInterrupted() { return errno == EINTR; }
+    int native(intptr_t socket) { return static_cast<int>(socket); }
+#ifdef MSG_NOSIGNAL
+    const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+    const int SEND_FLAGS = 0; // SO_NOSIGPIPE is set on the socket instead
+#endif
+#endif
+
+    intptr_t openSocket(int family, int type, int protocol)
+    {
+        intptr_t handle = static_cast<intptr_t>(::socket(family, type, protocol));
+#ifdef _WIN32
+        if (native(handle) == INVALID_SOCKET)
+            return SocketUtils::INVALID_HANDLE;
+#else
+        if (handle < 0)
+            return SocketUtils::INVALID_HANDLE;
+#endif
+#ifdef SO_NOSIGPIPE
+        int on = 1;
+        setsockopt(native(handle), SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+        return handle;
+    }
+
+    void setTimeouts(intptr_t socket, int timeoutSeconds)
+    {
+#ifdef _WIN32
+        DWORD timeout = static_cast<DWORD>(timeoutSeconds) * 1000;
+        setsockopt(native(socket), SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char *>(&timeout), sizeof(timeout));
+        setsockopt(native(socket), SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char *>(&timeout), sizeof(timeout));
+#else
+        timeval timeout{};
+        timeout.tv_sec = timeoutSeconds;
+        setsockopt(native(socket), SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(native(socket), SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+#endif
+    }
+
+    bool isUnixAddress(const std::string &address)
+    {
+        return address.compare(0, UNIX_PREFIX_LENGTH, UNIX_PREFIX) == 0;
+    }
+
+    // "host:port" -> host, port; an empty or "*" host means every interface
+    bool splitHostPort(const std::string &address, std::string &host, std::string &port)
+    {
+        size_t colon = address.rfind(':');
+        if (colon == std::string::npos || colon + 1 == address.size())
+            return false;
+
+        host = address.substr(0, colon);
+        port = address.substr(colon + 1);
+        if (host.size() >= 2 && host.front() == '[' && host.back() == ']')
+        {
+            host = host.substr(1, host.size() - 2); // [::1]:7878
+        }
+        if (host == "*")
+        {
+            host.clear();
+        }
+        return true;
+    }
+
+#ifndef _WIN32
+    bool makeUnixAddress(const std::string &address, sockaddr_un &unixAddress, std::string &error)
+    {
+        std::string path = address.substr(UNIX_PREFIX_LENGTH);
+        if (path.empty() || path.size() >= sizeof(unixAddress.sun_path))
+        {
+            error = "Invalid Unix socket path: " + path;
+            return false;
+        }
+
+        std::memset(&unixAddress, 0, sizeof(unixAddress));
+        unixAddress.sun_family = AF_UNIX;
+        std::memcpy(unixAddress.sun_path, path.c_str(), path.size() + 1);
+        return true;
+    }
+#endif
+}
+
+void SocketUtils::initialize()
+{
+#ifdef _WIN32
+    static std::once_flag once;
+    std::call_once(once, []
+                   {
+                       WSADATA data;
+                       WSAStartup(MAKEWORD(2, 2), &data);
+                   });
+#endif
+}
+
+void SocketUtils::close(intptr_t socket)
+{
+    if (socket == INVALID_HANDLE)
+        return;
+#ifdef _WIN32
+    closesocket(native(socket));
+#else
+    ::close(native(socket));
+#endif
+}
+
+bool SocketUtils::setNonBlocking(intptr_t socket)
+{
+#ifdef _WIN32
+    u_long on = 1;
+    return ioctlsocket(native(socket), FIONBIO, &on) == 0;
+#else
+    int flags = fcntl(native(socket), F_GETFL, 0);
+    return flags >= 0 && fcntl(native(socket), F_SETFL, flags | O_NONBLOCK) == 0;
+#endif
+}
+
+void SocketUtils::setNoDelay(intptr_t socket)
+{
+    // Small request/response frames must not wait for Nagle's algorithm
+    int on = 1;
+    setsockopt(native(socket), IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char *>(&on), sizeof(on));
+}
+
+intptr_t SocketUtils::listenOn(const std::string &address, std::string &error)
+{
+    initialize();
+
+    if (isUnixAddress(address))
+    {
+#ifdef _WIN32
+        error = "Unix sockets are not supported on Windows";
+        return INVALID_HANDLE;
+#else
+        sockaddr_un unixAddress;
+        if (!makeUnixAddress(address, unixAddress, error))
+            return INVALID_HANDLE;
+
+        intptr_t handle = openSocket(AF_UNIX, SOCK_STREAM, 0);
+        ::unlink(unixAddress.sun_path); // Left over from a previous run
+        if (handle == INVALID_HANDLE ||
+            ::bind(native(handle), reinterpret_cast<sockaddr *>(&unixAddress), sizeof(unixAddress)) != 0 ||
+            ::listen(native(handle), SOMAXCONN) != 0 || !setNonBlocking(handle))
+        {
+            error = "Cannot listen on " + address + ": " + std::strerror(errno);
+            close(handle);
+            return INVALID_HANDLE;
+        }
+        return handle;
+#endif
+    }
+
+    std::string host, port;
+    if (!splitHostPort(address, host, port))
+    {
+        error = "Expected host:port or unix:/path, got " + address;
+        return INVALID_HANDLE;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    hints.ai_flags = AI_PASSIVE;
+    addrinfo *addresses = nullptr;
+    if (getaddrinfo(host.empty() ? nullptr : host.c_str(), port.c_str(), &hints, &addresses) != 0 || !addresses)
+    {
+        error = "Cannot resolve " + address;
+        return INVALID_HANDLE;
+    }
+
+    intptr_t listener = INVALID_HANDLE;
+    for (addrinfo *candidate = addresses; candidate && listener == INVALID_HANDLE; candidate = candidate->ai_next)
+    {
+        intptr_t handle = openSocket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+        if (handle == INVALID_HANDLE)
+            continue;
+
+        int on = 1;
+        setsockopt(native(handle), SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char *>(&on), sizeof(on));
+        if (::bind(native(handle), candidate->ai_addr, static_cast<SocketLength>(candidate->ai_addrlen)) == 0 &&
+            ::listen(native(handle), SOMAXCONN) == 0 && setNonBlocking(handle))
+        {
+            listener = handle;
+        }
+        else
+        {
+            close(handle);
+        }
+    }
+    freeaddrinfo(addresses);
+
+    if (listener == INVALID_HANDLE)
+    {
+        error = "Cannot listen on " + address;
+    }
+    return listener;
+}
+
+intptr_t SocketUtils::connectTo(const std::string &address, int timeoutSeconds, std::string &error)
+{
+    initialize();
+
+    if (isUnixAddress(address))
+    {
+#ifdef _WIN32
+        error = "Unix sockets are not supported on Windows";
+        return INVALID_HANDLE;
+#else
+        sockaddr_un unixAddress;
+        if (!makeUnixAddress(address, unixAddress, error))
+            return INVALID_HANDLE;
+
+        intptr_t handle = openSocket(AF_UNIX, SOCK_STREAM, 0);
+        if (handle != INVALID_HANDLE)
+        {
+            setTimeouts(handle, timeoutSeconds);
+            if (::connect(native(handle), reinterpret_cast<sockaddr *>(&unixAddress), sizeof(unixAddress)) == 0)
+                return handle;
+        }
+        error = "Cannot connect to " + address + ": " + std::strerror(errno);
+        close(handle);
+        return INVALID_HANDLE;
+#endif
+    }
+
+    std::string host, port;
+    if (!splitHostPort(address, host, port))
+    {
+        error = "Expected host:port or unix:/path, got " + address;
+        return INVALID_HANDLE;
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    if (getaddrinfo(host.empty() ? "localhost" : host.c_str(), port.c_str(), &hints, &addresses) != 0 || !addresses)
+    {
+        error = "Cannot resolve " + address;
+        return INVALID_HANDLE;
+    }
+
+    intptr_t connected = INVALID_HANDLE;
+    for (addrinfo *candidate = addresses; candidate && connected == INVALID_HANDLE; candidate = candidate->ai_next)
+    {
+        intptr_t handle = openSocket(candidate->ai_family, candidate->ai_socktype, candidate->ai_protocol);
+        if (handle == INVALID_HANDLE)
+            continue;
+
+        setTimeouts(handle, timeoutSeconds);
+        if (::connect(native(handle), candidate->ai_addr, static_cast<SocketLength>(candidate->ai_addrlen)) == 0)
+        {
+            setNoDelay(handle);
+            connected = handle;
+        }
+        else
+        {
+            close(handle);
+        }
+    }
+    freeaddrinfo(addresses);
+
+    if (connected == INVALID_HANDLE)
+    {
+        error = "Cannot connect to " + address;
+    }
+    return connected;
+}
+
+intptr_t SocketUtils::acceptClient(intptr_t listener)
+{
+    intptr_t handle = static_cast<intptr_t>(::accept(native(listener), nullptr, nullptr));
+#ifdef _WIN32
+    if (native(handle) == INVALID_SOCKET)
+        return INVALID_HANDLE;
+#else
+    if (handle < 0)
+        return INVALID_HANDLE;
+#endif
+#ifdef SO_NOSIGPIPE
+    int on = 1;
+    setsockopt(native(handle), SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    setNonBlocking(handle);
+    setNoDelay(handle);
+    return handle;
+}
+
+long SocketUtils::sendSome(intptr_t socket, const char *data, size_t size)
+{
+    long sent = static_cast<long>(::send(native(socket), data, static_cast<int>(size), SEND_FLAGS));
+    if (sent < 0)
+    {
+        return (lastCallWouldBlock() || lastCallInterrupted()) ? 0 : -1;
+    }
+    return sent;
+}
+
+long SocketUtils::receiveSome(intptr_t socket, char *buffer, size_t size)
+{
+    long received = static_cast<long>(::recv(native(socket), buffer, static_cast<int>(size), 0));
+    if (received == 0)
+    {
+        return -1; // Peer closed the connection
+    }
+    if (received < 0)
+    {
+        return (lastCallWouldBlock() || lastCallInterrupted()) ? 0 : -1;
+    }
+    return received;
+}
+
+bool SocketUtils::sendAll(intptr_t socket, const char *data, size_t size)
+{
+    while (size > 0)
+    {
+        long sent = static_cast<long>(::send(native(socket), data, static_cast<int>(size), SEND_FLAGS));
+        if (sent < 0 && lastCallInterrupted())
+            continue;
+        if (sent <= 0)
+            return false;
+
+        data += sent;
+        size -= static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+bool SocketUtils::receiveAll(intptr_t socket, char *buffer, size_t size)
+{
+    while (size > 0)
+    {
+        long received = static_cast<long>(::recv(native(socket), buffer, static_cast<int>(size), 0));
+        if (received < 0 && lastCallInterrupted())
+            continue;
+        if (received <= 0)
+            return false; // Closed, timed out or failed
+
+        buffer += received;
+        size -= static_cast<size_t>(received);
+    }
+    return true;
+}
+
+bool SocketUtils::createWakeupPair(intptr_t &readEnd, intptr_t &writeEnd)
+{
+    initialize();
+    readEnd = writeEnd = INVALID_HANDLE;
+
+#ifdef _WIN32
+    // No socketpair on Windows: connect two loopback sockets through a temporary listener
+    intptr_t listener = openSocket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in loopback{};
+    loopback.sin_family = AF_INET;
+    loopback.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    loopback.sin_port = 0;
+    int length = sizeof(loopback);
+    bool ok = listener != INVALID_HANDLE &&
+              ::bind(native(listener), reinterpret_cast<sockaddr *>(&loopback), sizeof(loopback)) == 0 &&
+              ::getsockname(native(listener), reinterpret_cast<sockaddr *>(&loopback), &length) == 0 &&
+              ::listen(native(listener), 1) == 0;
+    if (ok)
+    {
+        writeEnd = openSocket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        ok = writeEnd != INVALID_HANDLE &&
+             ::connect(native(writeEnd), reinterpret_cast<sockaddr *>(&loopback), sizeof(loopback)) == 0;
+    }
+    if (ok)
+    {
+        readEnd = static_cast<intptr_t>(::accept(native(listener), nullptr, nullptr));
+        ok = native(readEnd) != INVALID_SOCKET;
+    }
+    close(listener);
+#else
+    int ends[2];
+    bool ok = ::socketpair(AF_UNIX, SOCK_STREAM, 0, ends) == 0;
+    if (ok)
+    {
+        readEnd = ends[0];
+        writeEnd = ends[1];
+    }
+#endif
+
+    if (!ok || !setNonBlocking(readEnd) || !setNonBlocking(writeEnd))
+    {
+        close(readEnd);
+        close(writeEnd);
+        readEnd = writeEnd = INVALID_HANDLE;
+        return false;
+    }
+    return true;
+}
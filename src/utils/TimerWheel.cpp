@@ -0,0 +1,168 @@
+#include "TimerWheel.h"
+#include <algorithm>
+
+TimerWheel::TimerWheel(int64_t currentTick) : m_currentTick(currentTick)
+{
+    std::fill(std::begin(m_heads), std::end(m_heads), -1);
+}
+
+void TimerWheel::schedule(int id, int64_t expiryTick)
+{
+    auto it = m_nodeById.find(id);
+    int nodeIndex;
+    if (it != m_nodeById.end())
+    {
+        nodeIndex = it->second;
+        unlink(nodeIndex);
+    }
+    else
+    {
+        nodeIndex = allocateNode();
+        m_nodeById[id] = nodeIndex;
+    }
+
+    Node &node = m_nodes[nodeIndex];
+    node.id = id;
+    node.expiry = std::max(expiryTick, m_currentTick + 1);
+    link(nodeIndex);
+}
+
+bool TimerWheel::cancel(int id)
+{
+    auto it = m_nodeById.find(id);
+    if (it == m_nodeById.end())
+        return false;
+
+    unlink(it->second);
+    m_freeNodes.push_back(it->second);
+    m_nodeById.erase(it);
+    return true;
+}
+
+void TimerWheel::clear(int64_t currentTick)
+{
+    m_currentTick = currentTick;
+    m_nodes.clear();
+    m_freeNodes.clear();
+    m_nodeById.clear();
+    std::fill(std::begin(m_heads), std::end(m_heads), -1);
+}
+
+void TimerWheel::advance(int64_t nowTick, std::vector<int> &expired)
+{
+    while (m_currentTick < nowTick)
+    {
+        if (m_nodeById.empty())
+        {
+            m_currentTick = nowTick; // Nothing to fire, skip the idle ticks
+            break;
+        }
+
+        int64_t tick = ++m_currentTick;
+
+        // Find how many levels roll over at this tick, then bring their
+        // current slots down, highest first
+        int levels = 0;
+        while (levels + 1 < LEVELS &&
+               ((tick >> (SLOT_BITS * (levels + 1))) << (SLOT_BITS * (levels + 1))) == tick)
+        {
+            ++levels;
+        }
+        for (int level = levels; level >= 1; --level)
+        {
+            cascade(level);
+        }
+
+        // Fire everything in the level 0 slot for this tick
+        int slot = static_cast<int>(tick & (SLOTS_PER_LEVEL - 1));
+        int nodeIndex = m_heads[slot];
+        m_heads[slot] = -1;
+        while (nodeIndex >= 0)
+        {
+            Node &node = m_nodes[nodeIndex];
+            int next = node.next;
+            expired.push_back(node.id);
+            m_nodeById.erase(node.id);
+            node.slot = -1;
+            m_freeNodes.push_back(nodeIndex);
+            nodeIndex = next;
+        }
+    }
+}
+
+void TimerWheel::link(int nodeIndex)
+{
+    Node &node = m_nodes[nodeIndex];
+    int64_t delta = node.expiry - m_currentTick;
+
+    // Lowest level whose span still reaches the expiry
+    int level = 0;
+    while (level + 1 < LEVELS && delta >= (int64_t(1) << (SLOT_BITS * (level + 1))))
+    {
+        ++level;
+    }
+
+    int64_t position = node.expiry >> (SLOT_BITS * level);
+    if (level == LEVELS - 1 && delta >= (int64_t(1) << (SLOT_BITS * LEVELS)))
+    {
+        // Beyond the wheel: park in the furthest slot and re-link when cascaded
+        position = (m_currentTick >> (SLOT_BITS * level)) - 1;
+    }
+    node.slot = level * SLOTS_PER_LEVEL + static_cast<int>(position & (SLOTS_PER_LEVEL - 1));
+
+    node.prev = -1;
+    node.next = m_heads[node.slot];
+    if (node.next >= 0)
+    {
+        m_nodes[node.next].prev = nodeIndex;
+    }
+    m_heads[node.slot] = nodeIndex;
+}
+
+void TimerWheel::unlink(int nodeIndex)
+{
+    Node &node = m_nodes[nodeIndex];
+    if (node.prev >= 0)
+    {
+        m_nodes[node.prev].next = node.next;
+    }
+    else
+    {
+        m_heads[node.slot] = node.next;
+    }
+    if (node.next >= 0)
+    {
+        m_nodes[node.next].prev = node.prev;
+    }
+    node.prev = node.next = -1;
+    node.slot = -1;
+}
+
+int TimerWheel::allocateNode()
+{
+    if (!m_freeNodes.empty())
+    {
+        int nodeIndex = m_freeNodes.back();
+        m_freeNodes.pop_back();
+        return nodeIndex;
+    }
+
+    m_nodes.push_back(Node{0, 0, -1, -1, -1});
+    return static_cast<int>(m_nodes.size()) - 1;
+}
+
+void TimerWheel::cascade(int level)
+{
+    int64_t position = m_currentTick >> (SLOT_BITS * level);
+    int slot = level * SLOTS_PER_LEVEL + static_cast<int>(position & (SLOTS_PER_LEVEL - 1));
+
+    // Detach the whole list first; re-linking places each timer on a lower level
+    int nodeIndex = m_heads[slot];
+    m_heads[slot] = -1;
+    while (nodeIndex >= 0)
+    {
+        int next = m_nodes[nodeIndex].next;
+        link(nodeIndex);
+        nodeIndex = next;
+    }
+}
@@ -0,0 +1,114 @@
+#include "Waitlist.h"
+#include "DateTimeUtils.h"
+#include <algorithm>
+
+void Waitlist::clear()
+{
+    m_entries.clear();
+    m_byCourtDay.clear();
+    m_nextId = 1;
+}
+
+int Waitlist::add(WaitlistEntry entry)
+{
+    entry.id = m_nextId;
+    restore(entry);
+    return entry.id;
+}
+
+void Waitlist::restore(const WaitlistEntry &entry)
+{
+    remove(entry.id);
+    m_entries[entry.id] = entry;
+    m_byCourtDay[keyOf(entry)].insert(entry.id, entry.startTime, entry.endTime);
+    m_nextId = std::max(m_nextId, entry.id + 1);
+}
+
+bool Waitlist::remove(int entryId)
+{
+    auto it = m_entries.find(entryId);
+    if (it == m_entries.end())
+        return false;
+
+    auto day = m_byCourtDay.find(keyOf(it->second));
+    if (day != m_byCourtDay.end())
+    {
+        day->second.erase(entryId, it->second.startTime);
+        if (day->second.empty())
+        {
+            m_byCourtDay.erase(day);
+        }
+    }
+    m_entries.erase(it);
+    return true;
+}
+
+bool Waitlist::get(int entryId, WaitlistEntry &entry) const
+{
+    auto it = m_entries.find(entryId);
+    if (it == m_entries.end())
+        return false;
+
+    entry = it->second;
+    return true;
+}
+
+size_t Waitlist::removeStarted(std::time_t now)
+{
+    std::vector<int> started;
+    for (const auto &entry : m_entries)
+    {
+        if (entry.second.startTime <= now)
+        {
+            started.push_back(entry.first);
+        }
+    }
+    for (int entryId : started)
+    {
+        remove(entryId);
+    }
+    return started.size();
+}
+
+std::vector<WaitlistEntry> Waitlist::findOverlapping(int courtId, std::time_t startTime, std::time_t endTime) const
+{
+    std::vector<int> ids;
+    // Requests are filed under the day they start, so one from the evening
+    // before can still reach past midnight into the freed interval
+    int lastDay = DateTimeUtils::getDayKey(endTime - 1);
+    for (int dayKey = DateTimeUtils::getDayKey(startTime) - 1; dayKey <= lastDay; ++dayKey)
+    {
+        auto day = m_byCourtDay.find(std::make_pair(courtId, dayKey));
+        if (day != m_byCourtDay.end())
+        {
+            day->second.findOverlaps(startTime, endTime, ids);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+
+    std::vector<WaitlistEntry> entries;
+    entries.reserve(ids.size());
+    for (int entryId : ids)
+    {
+        entries.push_back(m_entries.at(entryId));
+    }
+    return entries;
+}
+
+std::vector<WaitlistEntry> Waitlist::getUserEntries(int userId) const
+{
+    std::vector<WaitlistEntry> entries;
+    for (const auto &entry : m_entries)
+    {
+        if (entry.second.userId == userId)
+        {
+            entries.push_back(entry.second);
+        }
+    }
+    return entries;
+}
+
+std::pair<int, int> Waitlist::keyOf(const WaitlistEntry &entry)
+{
+    return std::make_pair(entry.courtId, DateTimeUtils::getDayKey(entry.startTime));
+}
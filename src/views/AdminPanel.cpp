@@ -4,14 +4,20 @@
 #include "../include/AuthController.h"
 #include "../include/Booking.h"
 #include "../include/User.h"
+#include "../include/DateTimeUtils.h"
+#include "../include/NumberFormat.h"
 #include <wx/sizer.h>
 #include <wx/msgdlg.h>
 #include <wx/statbox.h>
 #include <wx/filedlg.h>
 #include <wx/datectrl.h>
 #include <wx/dateevt.h>
+#include <algorithm>
 #include <fstream>
 
+// Delay between the last filter change and re-querying the index
+static const int FILTER_DEBOUNCE_MS = 200;
+
 wxBEGIN_EVENT_TABLE(AdminPanel, wxPanel)
     EVT_BUTTON(ID_REFRESH_DATA, AdminPanel::OnRefreshData)
     EVT_BUTTON(ID_EXPORT_DATA, AdminPanel::OnExportData)
@@ -22,8 +28,70 @@ wxBEGIN_EVENT_TABLE(AdminPanel, wxPanel)
     EVT_CHOICE(ID_STATUS_FILTER, AdminPanel::OnFilterByCourt)
     EVT_DATE_CHANGED(ID_START_DATE_PICKER, AdminPanel::OnFilterByDate)
     EVT_DATE_CHANGED(ID_END_DATE_PICKER, AdminPanel::OnFilterByDate)
+    EVT_TIMER(ID_FILTER_TIMER, AdminPanel::OnFilterTimer)
+    EVT_TEXT(ID_SEARCH_TEXT, AdminPanel::OnSearchText)
 wxEND_EVENT_TABLE()
 
+BookingHistoryList::BookingHistoryList(AdminPanel *owner, wxWindowID id, const wxSize &size)
+    : wxListCtrl(owner, id, wxDefaultPosition, size,
+                 wxLC_REPORT | wxLC_SINGLE_SEL | wxLC_VIRTUAL),
+      m_owner(owner)
+{
+    m_cancelledAttr.SetTextColour(wxColour(128, 128, 128));
+    m_confirmedAttr.SetTextColour(wxColour(0, 128, 0));
+    m_pendingAttr.SetTextColour(wxColour(255, 140, 0));
+}
+
+void BookingHistoryList::SetRows(std::vector<int> bookingIds)
+{
+    // Row positions are about to change, so drop the old selection
+    long selected = GetNextItem(-1, wxLIST_NEXT_ALL, wxLIST_STATE_SELECTED);
+    if (selected != -1)
+    {
+        SetItemState(selected, 0, wxLIST_STATE_SELECTED);
+    }
+
+    m_rowIds = std::move(bookingIds);
+    SetItemCount(static_cast<long>(m_rowIds.size()));
+    Refresh();
+}
+
+int BookingHistoryList::GetBookingIdAt(long row) const
+{
+    if (row < 0 || row >= static_cast<long>(m_rowIds.size()))
+    {
+        return -1;
+    }
+    return m_rowIds[row];
+}
+
+wxString BookingHistoryList::OnGetItemText(long item, long column) const
+{
+    int bookingId = GetBookingIdAt(item);
+    return bookingId != -1 ? m_owner->GetBookingCellText(bookingId, column) : wxString();
+}
+
+wxItemAttr *BookingHistoryList::OnGetItemAttr(long item) const
+{
+    BookingPtr booking = m_owner->GetBookingById(GetBookingIdAt(item));
+    if (!booking)
+    {
+        return nullptr;
+    }
+
+    switch (booking->getStatus())
+    {
+    case BookingStatus::CANCELLED:
+        return &m_cancelledAttr;
+    case BookingStatus::CONFIRMED:
+        return &m_confirmedAttr;
+    case BookingStatus::PENDING:
+        return &m_pendingAttr;
+    default:
+        return nullptr;
+    }
+}
+
 AdminPanel::AdminPanel(wxWindow *parent,
                         BookingController* bookingController,
                         CourtController* courtController,
@@ -32,7 +100,8 @@ AdminPanel::AdminPanel(wxWindow *parent,
     m_bookingController(bookingController),
     m_courtController(courtController),
     m_authController(authController),
-    m_selectedBookingId(-1)
+    m_selectedBookingId(-1),
+    m_filterTimer(this, ID_FILTER_TIMER)
 {
     CreateUI();
     RefreshData();
@@ -60,14 +129,14 @@ void AdminPanel::CreateFilterControls()
     m_startDatePicker = new wxDatePickerCtrl(this, ID_START_DATE_PICKER, wxDefaultDateTime,
                                              wxDefaultPosition, wxDefaultSize,
                                              wxDP_DROPDOWN | wxDP_SHOWCENTURY);
-    m_startDatePicker->SetValue(wxDateTime::Now() - wxTimeSpan::Days(30));
+    m_startDatePicker->SetValue(wxDateTime::Now() - wxDateSpan::Days(30));
     filterSizer->Add(m_startDatePicker, 0, wxRIGHT, 10);
 
     filterSizer->Add(new wxStaticText(this, wxID_ANY, "To:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
     m_endDatePicker = new wxDatePickerCtrl(this, ID_END_DATE_PICKER, wxDefaultDateTime,
                                            wxDefaultPosition, wxDefaultSize,
                                            wxDP_DROPDOWN | wxDP_SHOWCENTURY);
-    m_endDatePicker->SetValue(wxDateTime::Now());
+    m_endDatePicker->SetValue(wxDateTime::Now() + wxDateSpan::Days(30)); // Include upcoming bookings
     filterSizer->Add(m_endDatePicker, 0, wxRIGHT, 10);
 
     // Court filter
@@ -95,6 +164,12 @@ void AdminPanel::CreateFilterControls()
     m_statusFilter->SetSelection(0);
     filterSizer->Add(m_statusFilter, 0, wxRIGHT, 10);
 
+    // Free-text search over customer name, email, phone and booking notes
+    filterSizer->Add(new wxStaticText(this, wxID_ANY, "Search:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    m_searchCtrl = new wxTextCtrl(this, ID_SEARCH_TEXT, "", wxDefaultPosition, wxSize(160, -1));
+    m_searchCtrl->SetHint("Name, email, phone, notes");
+    filterSizer->Add(m_searchCtrl, 0, wxRIGHT, 10);
+
     // Buttons
     m_refreshBtn = new wxButton(this, ID_REFRESH_DATA, "Refresh");
     filterSizer->Add(m_refreshBtn, 0, wxRIGHT, 5);
@@ -109,9 +184,7 @@ void AdminPanel::CreateBookingHistoryView()
 {
     wxStaticBoxSizer *historySizer = new wxStaticBoxSizer(wxVERTICAL, this, "Booking History (All Users)");
 
-    m_bookingHistoryList = new wxListCtrl(this, ID_BOOKING_HISTORY_LIST,
-                                          wxDefaultPosition, wxSize(-1, 300),
-                                          wxLC_REPORT | wxLC_SINGLE_SEL);
+    m_bookingHistoryList = new BookingHistoryList(this, ID_BOOKING_HISTORY_LIST, wxSize(-1, 300));
 
     m_bookingHistoryList->AppendColumn("ID", wxLIST_FORMAT_RIGHT, 50);
     m_bookingHistoryList->AppendColumn("Customer", wxLIST_FORMAT_LEFT, 120);
@@ -153,6 +226,10 @@ void AdminPanel::CreateStatisticsView()
 
 void AdminPanel::RefreshData()
 {
+    // Remember the active filters so a refresh doesn't reset them
+    int selectedCourtId = GetSelectedFilterId(m_courtFilter);
+    int selectedUserId = GetSelectedFilterId(m_userFilter);
+
     // Populate court filter
     m_courtFilter->Clear();
     m_courtFilter->Append("All Courts");
@@ -175,7 +252,7 @@ void AdminPanel::RefreshData()
             // Handle error silently
         }
     }
-    m_courtFilter->SetSelection(0);
+    SelectFilterId(m_courtFilter, selectedCourtId);
 
     // Populate user filter
     m_userFilter->Clear();
@@ -201,7 +278,7 @@ void AdminPanel::RefreshData()
             // Handle error silently
         }
     }
-    m_userFilter->SetSelection(0);
+    SelectFilterId(m_userFilter, selectedUserId);
 
     RefreshBookingHistory();
     RefreshStatistics();
@@ -209,93 +286,91 @@ void AdminPanel::RefreshData()
 
 void AdminPanel::RefreshBookingHistory()
 {
-    m_bookingHistoryList->DeleteAllItems();
+    RebuildNameCaches();
+    ApplyFilters();
+}
 
-    if (!m_bookingController)
-    {
-        return;
-    }
+void AdminPanel::RebuildNameCaches()
+{
+    m_courtNames.clear();
+    m_userNames.clear();
 
     try
     {
-        auto allBookings = m_bookingController->getAllBookings();
-
-        for (size_t i = 0; i < allBookings.size(); ++i)
+        if (m_courtController)
         {
-            auto booking = allBookings[i];
-            if (!booking)
-                continue;
-
-            long index = m_bookingHistoryList->InsertItem(i, wxString::Format("%d", booking->getId()));
-
-            // Customer name
-            wxString customerName = GetUserNameById(booking->getUserId());
-            m_bookingHistoryList->SetItem(index, 1, customerName);
-
-            // Court name
-            wxString courtName = wxString::Format("Court %d", booking->getCourtId());
-            if (m_courtController)
+            for (const auto &court : m_courtController->getAllCourts())
             {
-                try
-                {
-                    auto courts = m_courtController->getAllCourts();
-                    for (const auto &court : courts)
-                    {
-                        if (court && court->getId() == booking->getCourtId())
-                        {
-                            courtName = court->getName();
-                            break;
-                        }
-                    }
-                }
-                catch (const std::exception &e)
+                if (court)
                 {
-                    // Keep default court name
+                    m_courtNames[court->getId()] = court->getName();
                 }
             }
-            m_bookingHistoryList->SetItem(index, 2, courtName);
-
-            // Date
-            wxDateTime bookingDate(booking->getBookingDate());
-            m_bookingHistoryList->SetItem(index, 3, bookingDate.Format("%d/%m/%Y"));
-
-            // Time
-            wxDateTime startTime(booking->getStartTime());
-            wxDateTime endTime(booking->getEndTime());
-            wxString timeSlot = startTime.Format("%H:%M") + " - " + endTime.Format("%H:%M");
-            m_bookingHistoryList->SetItem(index, 4, timeSlot);
-
-            // Status
-            m_bookingHistoryList->SetItem(index, 5, booking->getStatusString());
-
-            // Amount
-            m_bookingHistoryList->SetItem(index, 6, FormatCurrency(booking->getTotalAmount()));
-
-            // Notes
-            m_bookingHistoryList->SetItem(index, 7, booking->getNotes());
-
-            // Store booking ID
-            m_bookingHistoryList->SetItemData(index, booking->getId());
+        }
 
-            // Color coding
-            if (booking->getStatus() == BookingStatus::CANCELLED)
-            {
-                m_bookingHistoryList->SetItemTextColour(index, wxColour(128, 128, 128));
-            }
-            else if (booking->getStatus() == BookingStatus::CONFIRMED)
-            {
-                m_bookingHistoryList->SetItemTextColour(index, wxColour(0, 128, 0));
-            }
-            else if (booking->getStatus() == BookingStatus::PENDING)
+        if (m_authController)
+        {
+            for (const auto &user : m_authController->getAllUsers())
             {
-                m_bookingHistoryList->SetItemTextColour(index, wxColour(255, 140, 0));
+                if (user)
+                {
+                    m_userNames[user->getId()] = wxString::Format("%s (%s)", user->getFullName(), user->getEmail());
+                }
             }
         }
     }
     catch (const std::exception &e)
     {
-        wxMessageBox(wxString::Format("Error loading booking history: %s", e.what()),
-                     "Error", wxOK | wxICON_ERROR, this);
+        // Fall back to id-based names
+    }
+}
+
+BookingPtr AdminPanel::GetBookingById(int bookingId) const
+{
+    if (!m_bookingController || bookingId == -1)
+    {
+        return nullptr;
+    }
+    return m_bookingController->getBooking(bookingId);
+}
+
+wxString AdminPanel::GetBookingCellText(int bookingId, long column) const
+{
+    BookingPtr booking = GetBookingById(bookingId);
+    if (!booking)
+    {
+        return column == 0 ? wxString::Format("%d", bookingId) : wxString();
+    }
+
+    switch (column)
+    {
+    case 0:
+        return wxString::Format("%d", booking->getId());
+    case 1:
+        return GetUserNameById(booking->getUserId());
+    case 2:
+    {
+        auto it = m_courtNames.find(booking->getCourtId());
+        return it != m_courtNames.end() ? it->second : wxString::Format("Court %d", booking->getCourtId());
+    }
+    case 3:
+        return DateTimeUtils::formatDate(booking->getBookingDate(), "%d/%m/%Y");
+    case 4:
+    {
+        char slot[16];
+        char *end = DateTimeUtils::writeClock(slot, booking->getStartTime());
+        end = std::copy_n(" - ", 3, end);
+        end = DateTimeUtils::writeClock(end, booking->getEndTime());
+        return wxString(slot, end - slot);
+    }
+    case 5:
+        return booking->getStatusString();
+    case 6:
+        return NumberFormat::vnd(booking->getTotalAmount()).c_str();
+    case 7:
+        return booking->getNotes();
+    default:
+        return wxString();
     }
 }
 
@@ -341,7 +416,7 @@ void AdminPanel::RefreshStatistics()
         }
 
         m_totalBookingsLabel->SetLabel(wxString::Format("Total Bookings: %d (Cancelled: %d)", totalBookings, cancelledBookings));
-        m_totalRevenueLabel->SetLabel(wxString::Format("Total Revenue: %s", FormatCurrency(totalRevenue)));
+        m_totalRevenueLabel->SetLabel(wxString::Format("Total Revenue: %s", NumberFormat::vnd(totalRevenue).c_str()));
         m_activeBookingsLabel->SetLabel(wxString::Format("Active Bookings: %d", activeBookings));
     }
     catch (const std::exception &e)
@@ -351,48 +426,51 @@ void AdminPanel::RefreshStatistics()
     }
 }
 
-wxString AdminPanel::GetUserNameById(int userId)
+wxString AdminPanel::GetUserNameById(int userId) const
 {
-    if (!m_authController)
+    auto it = m_userNames.find(userId);
+    if (it != m_userNames.end())
     {
-        return wxString::Format("User %d", userId);
+        return it->second;
     }
 
-    try
+    return wxString::Format("User %d", userId);
+}
+
+int AdminPanel::GetSelectedFilterId(wxChoice *choice) const
+{
+    int selection = choice->GetSelection();
+    if (selection <= 0)
     {
-        auto users = m_authController->getAllUsers();
-        for (const auto &user : users)
-        {
-            if (user && user->getId() == userId)
-            {
-                return wxString::Format("%s (%s)", user->getFullName(), user->getEmail());
-            }
-        }
+        return 0; // "All" entry
     }
-    catch (const std::exception &e)
+
+    wxStringClientData *clientData = dynamic_cast<wxStringClientData *>(choice->GetClientObject(selection));
+    long id = 0;
+    if (!clientData || !clientData->GetData().ToLong(&id))
     {
-        // Handle error silently
+        return 0;
     }
-
-    return wxString::Format("User %d", userId);
+    return static_cast<int>(id);
 }
 
-wxString AdminPanel::FormatCurrency(double amount)
+void AdminPanel::SelectFilterId(wxChoice *choice, int id)
 {
-    wxString amountStr = wxString::Format("%.0f", amount);
+    choice->SetSelection(0);
+    if (id <= 0)
+    {
+        return;
+    }
 
-    wxString result = "";
-    int len = amountStr.length();
-    for (int i = 0; i < len; i++)
+    for (unsigned int i = 1; i < choice->GetCount(); ++i)
     {
-        if (i > 0 && (len - i) % 3 == 0)
+        wxStringClientData *clientData = dynamic_cast<wxStringClientData *>(choice->GetClientObject(i));
+        if (clientData && clientData->GetData() == wxString::Format("%d", id))
         {
-            result += ",";
+            choice->SetSelection(i);
+            return;
         }
-        result += amountStr[i];
     }
-
-    return result + " VND";
 }
 
 void AdminPanel::OnRefreshData(wxCommandEvent &event)
@@ -403,19 +481,35 @@ void AdminPanel::OnRefreshData(wxCommandEvent &event)
 
 void AdminPanel::OnFilterByDate(wxDateEvent &event)
 {
-    ApplyFilters();
+    ScheduleFilterUpdate();
 }
 
 void AdminPanel::OnFilterByCourt(wxCommandEvent &event)
 {
-    ApplyFilters();
+    ScheduleFilterUpdate();
 }
 
 void AdminPanel::OnFilterByUser(wxCommandEvent &event)
+{
+    ScheduleFilterUpdate();
+}
+
+void AdminPanel::OnSearchText(wxCommandEvent &event)
+{
+    ScheduleFilterUpdate();
+}
+
+void AdminPanel::OnFilterTimer(wxTimerEvent &event)
 {
     ApplyFilters();
 }
 
+void AdminPanel::ScheduleFilterUpdate()
+{
+    // Restarting the one-shot timer coalesces bursts of changes into one query
+    m_filterTimer.StartOnce(FILTER_DEBOUNCE_MS);
+}
+
 void AdminPanel::OnExportData(wxCommandEvent &event)
 {
     wxFileDialog dialog(this, "Export Booking Data", "", "booking_history.csv",
@@ -432,18 +526,13 @@ void AdminPanel::OnExportData(wxCommandEvent &event)
             // Write header
             file << "ID,Customer,Court,Date,Time,Status,Amount,Notes\n";
 
-            // Write data
-            long itemCount = m_bookingHistoryList->GetItemCount();
-            for (long i = 0; i < itemCount; i++)
+            // Write the rows matching the current filters
+            for (int bookingId : m_bookingHistoryList->GetRows())
             {
-                file << m_bookingHistoryList->GetItemText(i, 0) << ","   // ID
-                     << m_bookingHistoryList->GetItemText(i, 1) << ","   // Customer
-                     << m_bookingHistoryList->GetItemText(i, 2) << ","   // Court
-                     << m_bookingHistoryList->GetItemText(i, 3) << ","   // Date
-                     << m_bookingHistoryList->GetItemText(i, 4) << ","   // Time
-                     << m_bookingHistoryList->GetItemText(i, 5) << ","   // Status
-                     << m_bookingHistoryList->GetItemText(i, 6) << ","   // Amount
-                     << m_bookingHistoryList->GetItemText(i, 7) << "\n"; // Notes
+                for (long column = 0; column < 8; column++)
+                {
+                    file << GetBookingCellText(bookingId, column) << (column < 7 ? "," : "\n");
+                }
             }
 
             file.close();
@@ -461,7 +550,7 @@ void AdminPanel::OnBookingSelected(wxListEvent &event)
     long item = event.GetIndex();
     if (item != -1)
     {
-        m_selectedBookingId = m_bookingHistoryList->GetItemData(item);
+        m_selectedBookingId = m_bookingHistoryList->GetBookingIdAt(item);
         m_cancelBookingBtn->Enable(true);
     }
 }
@@ -505,7 +594,63 @@ void AdminPanel::OnCancelBooking(wxCommandEvent &event)
 
 void AdminPanel::ApplyFilters()
 {
-    // This method would apply the selected filters to the booking list
-    // For now, we'll just refresh the data
-    RefreshBookingHistory();
+    m_filterTimer.Stop();
+
+    if (!m_bookingController)
+    {
+        m_bookingHistoryList->SetRows({});
+        return;
+    }
+
+    BookingQuery query;
+    query.courtId = GetSelectedFilterId(m_courtFilter);
+    query.userId = GetSelectedFilterId(m_userFilter);
+
+    // Whole days, from the start of the first to the end of the last
+    wxDateTime fromDate = m_startDatePicker->GetValue();
+    wxDateTime toDate = m_endDatePicker->GetValue();
+    if (fromDate.IsValid())
+    {
+        query.fromTime = fromDate.GetDateOnly().GetTicks();
+    }
+    if (toDate.IsValid())
+    {
+        query.toTime = (toDate.GetDateOnly() + wxDateSpan::Day()).GetTicks() - 1;
+    }
+
+    // Status choices follow the BookingStatus order after "All Status"
+    int statusSelection = m_statusFilter->GetSelection();
+    if (statusSelection > 0)
+    {
+        query.filterStatus = true;
+        query.status = static_cast<BookingStatus>(statusSelection - 1);
+    }
+
+    try
+    {
+        // Text matches become one more posting list to intersect with the filters above
+        wxString searchText = m_searchCtrl->GetValue();
+        searchText.Trim().Trim(false);
+        if (!searchText.IsEmpty())
+        {
+            std::string text = searchText.ToStdString();
+            std::vector<int> userIds;
+            if (m_authController)
+            {
+                userIds = m_authController->searchUserIds(text);
+            }
+            query.restrictToIds = true;
+            query.bookingIds = m_bookingController->searchBookings(text, userIds);
+        }
+
+        m_bookingHistoryList->SetRows(m_bookingController->findBookings(query));
+    }
+    catch (const std::exception &e)
+    {
+        wxMessageBox(wxString::Format("Error loading booking history: %s", e.what()),
+                     "Error", wxOK | wxICON_ERROR, this);
+    }
+
+    m_selectedBookingId = -1;
+    m_cancelBookingBtn->Enable(false);
 }
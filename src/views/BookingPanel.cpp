@@ -3,11 +3,17 @@
 #include "../include/CourtController.h"
 #include "../include/AuthController.h"
 #include "../include/Booking.h"
+#include "../include/DateTimeUtils.h"
+#include "../include/NumberFormat.h"
+#include "../include/PricingEngine.h"
+#include "CourtTimeline.h"
 #include <wx/sizer.h>
 #include <wx/msgdlg.h>
+#include <wx/choicdlg.h>
 #include <wx/statbox.h>
 #include <wx/datectrl.h>
 #include <wx/timectrl.h>
+#include <algorithm>
 #include <map>
 
 wxBEGIN_EVENT_TABLE(BookingPanel, wxPanel)
@@ -15,13 +21,16 @@ wxBEGIN_EVENT_TABLE(BookingPanel, wxPanel)
     EVT_BUTTON(ID_CANCEL_BOOKING, BookingPanel::OnCancelBooking)
     EVT_BUTTON(ID_MODIFY_BOOKING, BookingPanel::OnModifyBooking)
     EVT_BUTTON(ID_CHECK_AVAILABILITY, BookingPanel::OnCheckAvailability)
+    EVT_BUTTON(ID_FIND_EARLIEST_SLOT, BookingPanel::OnFindEarliestSlot)
     EVT_BUTTON(ID_REFRESH_BOOKINGS, BookingPanel::OnRefreshBookings)
     EVT_LIST_ITEM_SELECTED(ID_BOOKING_LIST, BookingPanel::OnBookingSelected)
     EVT_LIST_ITEM_SELECTED(ID_AVAILABLE_SLOTS_LIST, BookingPanel::OnAvailableSlotSelected)
+    EVT_COMMAND(ID_AVAILABILITY_TIMELINE, wxEVT_TIMELINE_SELECTION, BookingPanel::OnTimelineSelection)
     EVT_CHOICE(ID_COURT_CHOICE, BookingPanel::OnCourtChanged)
     EVT_TIME_CHANGED(ID_START_TIME, BookingPanel::OnTimeChanged)
     EVT_TIME_CHANGED(ID_END_TIME, BookingPanel::OnTimeChanged)
     EVT_DATE_CHANGED(ID_DATE_PICKER, BookingPanel::OnDateChanged)
+    EVT_TIMER(ID_REMOTE_TIMER, BookingPanel::OnRemoteTimer)
 wxEND_EVENT_TABLE()
 
 BookingPanel::BookingPanel(wxWindow *parent,
@@ -32,16 +41,33 @@ BookingPanel::BookingPanel(wxWindow *parent,
     m_bookingController(bookingController),
     m_courtController(courtController),
     m_authController(authController),
-    m_selectedBookingId(-1)
+    m_selectedBookingId(-1),
+    m_heldSlotId(0),
+    m_remoteTimer(this, ID_REMOTE_TIMER),
+    m_remoteSequence(0)
 {
     CreateUI();
     BindEvents();
     RefreshCourtList();
     RefreshData();
     UpdateEstimatedCost(); // Calculate initial cost
+
+    if (m_bookingController && m_bookingController->isRemote())
+    {
+        // The server protocol has no earliest-slot search
+        m_findEarliestBtn->Disable();
+        m_findEarliestBtn->SetToolTip("Not available when connected to a booking server");
+
+        m_remoteSequence = m_bookingController->getRemoteSequence();
+        m_remoteTimer.Start(1000);
+    }
 }
 
-BookingPanel::~BookingPanel() {}
+BookingPanel::~BookingPanel()
+{
+    m_remoteTimer.Stop();
+    ReleaseHeldSlot();
+}
 
 void BookingPanel::CreateUI()
 {
@@ -119,9 +145,11 @@ void BookingPanel::CreateBookingForm()
     // Buttons
     wxBoxSizer *buttonSizer = new wxBoxSizer(wxHORIZONTAL);
     m_checkAvailabilityBtn = new wxButton(this, ID_CHECK_AVAILABILITY, "Check Availability");
+    m_findEarliestBtn = new wxButton(this, ID_FIND_EARLIEST_SLOT, "Find Earliest Slot");
     m_bookBtn = new wxButton(this, ID_BOOK_COURT, "Book Court");
 
     buttonSizer->Add(m_checkAvailabilityBtn, 0, wxRIGHT, 10);
+    buttonSizer->Add(m_findEarliestBtn, 0, wxRIGHT, 10);
     buttonSizer->Add(m_bookBtn, 0);
 
     m_bookingSizer->Add(buttonSizer, 0, wxALL | wxALIGN_CENTER, 10);
@@ -133,6 +161,10 @@ void BookingPanel::CreateAvailabilityDisplay()
 {
     m_availabilitySizer = new wxStaticBoxSizer(wxVERTICAL, this, "Available Time Slots");
 
+    // Timeline of the whole day; drag across a free span to pick the times
+    m_timeline = new CourtTimeline(this, ID_AVAILABILITY_TIMELINE);
+    m_availabilitySizer->Add(m_timeline, 0, wxEXPAND | wxALL, 5);
+
     m_availableSlotsList = new wxListCtrl(this, ID_AVAILABLE_SLOTS_LIST,
                                           wxDefaultPosition, wxSize(-1, 150),
                                           wxLC_REPORT | wxLC_SINGLE_SEL);
@@ -145,7 +177,7 @@ void BookingPanel::CreateAvailabilityDisplay()
 
     // Add instruction text
     wxStaticText *instructionText = new wxStaticText(this, wxID_ANY,
-                                                     "Click on an available time slot below to select it automatically:");
+                                                     "Drag across a free span of the timeline, or click an available slot below:");
     instructionText->SetFont(instructionText->GetFont().Bold());
     m_availabilitySizer->Insert(0, instructionText, 0, wxALL, 5);
 
@@ -322,19 +354,16 @@ void BookingPanel::RefreshMyBookings()
             m_userBookingsList->SetItem(index, 1, courtName);
 
             // Format date - Vietnamese format: DD/MM/YYYY
-            wxDateTime startTime(booking->getStartTime());
-            m_userBookingsList->SetItem(index, 2, startTime.Format("%d/%m/%Y"));
+            m_userBookingsList->SetItem(index, 2, DateTimeUtils::formatDate(booking->getStartTime(), "%d/%m/%Y"));
 
             // Format time slot
-            wxDateTime endTime(booking->getEndTime());
-            wxString timeSlot = startTime.Format("%H:%M") + " - " + endTime.Format("%H:%M");
-            m_userBookingsList->SetItem(index, 3, timeSlot);
+            m_userBookingsList->SetItem(index, 3, FormatTimeSlot(booking->getStartTime(), booking->getEndTime()));
 
             // Status
             m_userBookingsList->SetItem(index, 4, booking->getStatusString());
 
             // Cost
-            m_userBookingsList->SetItem(index, 5, FormatCurrency(booking->getTotalAmount()));
+            m_userBookingsList->SetItem(index, 5, NumberFormat::vnd(booking->getTotalAmount()).c_str());
 
             // Store booking ID in item data
             m_userBookingsList->SetItemData(index, booking->getId());
@@ -393,38 +422,26 @@ void BookingPanel::RefreshAvailableSlots()
     // Get selected date
     wxDateTime selectedDate = m_datePicker->GetValue();
 
-    // Get court's hourly rate
-    double hourlyRate = 50000.0; // Default rate
-    if (m_courtController)
-    {
-        try
-        {
-            auto courts = m_courtController->getAllCourts();
-            for (const auto &court : courts)
-            {
-                if (court && court->getId() == (int)courtId)
-                {
-                    hourlyRate = court->getHourlyRate();
-                    break;
-                }
-            }
-        }
-        catch (const std::exception &e)
-        {
-            // Use default rate if error
-            hourlyRate = 50000.0;
-        }
-    }
+    // Compiled prices for the court-day; each slot costs one subtraction
+    PricingEngine::DayPrices prices = PricingEngine::getInstance().getDayPrices((int)courtId, selectedDate.GetTicks());
+
+    // The timeline draws from the occupancy bitmap; it only re-renders if the day changed
+    m_timeline->SetDay((int)courtId, selectedDate, m_bookingController->getCourtOccupancy((int)courtId, selectedDate.GetTicks()));
+    UpdateTimelineSelection();
+
+    // Get this court's bookings that start on the selected date
+    BookingQuery query;
+    query.courtId = (int)courtId;
+    query.fromTime = selectedDate.GetDateOnly().GetTicks();
+    query.toTime = (selectedDate.GetDateOnly() + wxDateSpan::Day()).GetTicks() - 1;
 
-    // Get all bookings for this court on this date
-    auto allBookings = m_bookingController->getAllBookings();
     std::vector<std::pair<int, int>> bookedSlots;                           // start minutes, end minutes
-    std::map<std::pair<int, int>, Booking*> slotBookingMap; // map slot to booking details
+    std::map<std::pair<int, int>, BookingPtr> slotBookingMap; // map slot to booking details
 
-    for (const auto &booking : allBookings)
+    for (int bookingId : m_bookingController->findBookings(query))
     {
-        if (booking && booking->getCourtId() == courtId &&
-            booking->getStatus() != BookingStatus::CANCELLED)
+        BookingPtr booking = m_bookingController->getBooking(bookingId);
+        if (booking && booking->getStatus() != BookingStatus::CANCELLED)
         {
 
             // Check if booking is on the selected date
@@ -465,7 +482,7 @@ void BookingPanel::RefreshAvailableSlots()
 
         // Check if this slot conflicts with any booking
         bool isAvailable = !isPastTime; // Not available if in the past
-        Booking* conflictingBooking = nullptr;
+        BookingPtr conflictingBooking;
 
         if (!isPastTime)
         {
@@ -486,8 +503,7 @@ void BookingPanel::RefreshAvailableSlots()
             }
         }
 
-        // Calculate cost per slot (2 hours * court's hourly rate)
-        double cost = 2.0 * hourlyRate;
+        double cost = prices.getCost(startMinutes, endMinutes);
 
         wxString timeSlot = wxString::Format("%02d:00 - %02d:00", hour, hour + 2);
         wxString status;
@@ -519,7 +535,7 @@ void BookingPanel::RefreshAvailableSlots()
         }
 
         long index = m_availableSlotsList->InsertItem(m_availableSlotsList->GetItemCount(), timeSlot);
-        m_availableSlotsList->SetItem(index, 1, wxString::Format("%.0f VND", cost));
+        m_availableSlotsList->SetItem(index, 1, NumberFormat::vnd(cost).c_str());
         m_availableSlotsList->SetItem(index, 2, status);
 
         // Change text color and background for different statuses
@@ -599,14 +615,44 @@ void BookingPanel::OnBookCourt(wxCommandEvent &event)
         std::time_t startDateTime = CombineDateTime(bookingDate, startTime);
         std::time_t endDateTime = CombineDateTime(bookingDate, endTime);
 
-        // Create booking through controller
-        bool bookingSuccess = m_bookingController->createBooking(
-            currentUser->getId(),
-            (int)courtId,
-            bookingDateTime,
-            startDateTime,
-            endDateTime,
-            notes.ToStdString());
+        // A slot held from the list, or offered from the waitlist, is booked
+        // without racing other terminals; if the form no longer matches the
+        // hold, book the form as usual
+        bool bookingSuccess = false;
+        if (m_heldSlotId == 0)
+        {
+            m_heldSlotId = m_bookingController->findUserHold(currentUser->getId(), (int)courtId,
+                                                             startDateTime, endDateTime);
+        }
+        if (m_heldSlotId != 0)
+        {
+            bookingSuccess = m_bookingController->bookHeldSlot(
+                m_heldSlotId,
+                currentUser->getId(),
+                (int)courtId,
+                bookingDateTime,
+                startDateTime,
+                endDateTime,
+                notes.ToStdString());
+            if (bookingSuccess)
+            {
+                m_heldSlotId = 0;
+            }
+            else
+            {
+                ReleaseHeldSlot();
+            }
+        }
+        if (!bookingSuccess)
+        {
+            bookingSuccess = m_bookingController->createBooking(
+                currentUser->getId(),
+                (int)courtId,
+                bookingDateTime,
+                startDateTime,
+                endDateTime,
+                notes.ToStdString());
+        }
 
         if (bookingSuccess)
         {
@@ -635,6 +681,30 @@ void BookingPanel::OnBookCourt(wxCommandEvent &event)
             RefreshAvailableSlots(); // Also refresh slots to show the new booking
             ClearBookingForm();
         }
+        else if (m_bookingController->isRemote() &&
+                 !m_bookingController->isSlotAvailable((int)courtId, startDateTime, endDateTime))
+        {
+            // The server protocol has no waiting list to offer
+            wxMessageBox("This time is already booked. Please choose another slot.",
+                         "Slot Taken", wxOK | wxICON_WARNING, this);
+        }
+        else if (!m_bookingController->isSlotAvailable((int)courtId, startDateTime, endDateTime) &&
+                 wxMessageBox("This time is already booked.\n\n"
+                              "Join the waiting list? If it becomes free, it will be booked for you automatically.",
+                              "Slot Taken", wxYES_NO | wxICON_QUESTION, this) == wxYES)
+        {
+            if (m_bookingController->joinWaitlist(currentUser->getId(), (int)courtId,
+                                                  startDateTime, endDateTime, notes.ToStdString()) != 0)
+            {
+                wxMessageBox("You are on the waiting list for this slot.", "Waiting List",
+                             wxOK | wxICON_INFORMATION, this);
+                RefreshMyBookings(); // Joining may already have booked it
+            }
+            else
+            {
+                wxMessageBox("Could not join the waiting list.", "Booking Error", wxOK | wxICON_ERROR, this);
+            }
+        }
         else
         {
             wxMessageBox("Failed to create booking. Please try again.", "Booking Error", wxOK | wxICON_ERROR, this);
@@ -679,7 +749,7 @@ void BookingPanel::OnCancelBooking(wxCommandEvent &event)
         auto userBookings = m_bookingController->getUserBookings(
             m_authController->getCurrentUser()->getId());
 
-        Booking* selectedBooking = nullptr;
+        BookingPtr selectedBooking;
         for (const auto &booking : userBookings)
         {
             if (booking && booking->getId() == m_selectedBookingId)
@@ -771,6 +841,83 @@ void BookingPanel::OnCheckAvailability(wxCommandEvent &event)
     wxMessageBox("Available time slots updated!", "Information", wxOK | wxICON_INFORMATION);
 }
 
+void BookingPanel::OnFindEarliestSlot(wxCommandEvent &event)
+{
+    try
+    {
+        SlotSearch search;
+        std::map<int, wxString> courtNames;
+        for (Court *court : m_courtController->getAvailableCourts())
+        {
+            search.courtIds.push_back(court->getId());
+            courtNames[court->getId()] = wxString::FromUTF8(court->getName().c_str());
+        }
+        if (search.courtIds.empty())
+        {
+            wxMessageBox("No courts are available for booking.", "Find Earliest Slot", wxOK | wxICON_INFORMATION, this);
+            return;
+        }
+
+        // Keep the picked duration; start from the picked date, at least 1 hour from now
+        wxDateTime bookingDate = m_datePicker->GetValue();
+        std::time_t pickedStart = CombineDateTime(bookingDate, m_startTimePicker->GetValue());
+        std::time_t pickedEnd = CombineDateTime(bookingDate, m_endTimePicker->GetValue());
+        if (pickedEnd > pickedStart)
+        {
+            search.durationMinutes = static_cast<int>((pickedEnd - pickedStart) / 60);
+        }
+        search.earliestStart = std::max(DateTimeUtils::getStartOfDay(pickedStart), std::time(nullptr) + 3600);
+
+        std::vector<SlotOption> options = m_bookingController->findEarliestSlots(search);
+        if (options.empty())
+        {
+            wxMessageBox(wxString::Format("No free %d-minute slot in the next %d days.", search.durationMinutes, search.days),
+                         "Find Earliest Slot", wxOK | wxICON_INFORMATION, this);
+            return;
+        }
+
+        wxArrayString choices;
+        for (const SlotOption &option : options)
+        {
+            double cost = m_bookingController->calculateBookingCost(option.courtId, option.startTime, option.endTime);
+            choices.Add(wxString::Format("%s  %s  %s  (%s)",
+                                         DateTimeUtils::formatDate(option.startTime, "%a %d/%m/%Y").c_str(),
+                                         FormatTimeSlot(option.startTime, option.endTime),
+                                         courtNames[option.courtId],
+                                         NumberFormat::vnd(cost).c_str()));
+        }
+
+        int choice = wxGetSingleChoiceIndex("Soonest free slots across all courts:", "Find Earliest Slot", choices, this);
+        if (choice == wxNOT_FOUND)
+        {
+            return;
+        }
+
+        // Fill the form with the chosen slot
+        const SlotOption &chosen = options[choice];
+        for (unsigned int i = 0; i < m_courtChoice->GetCount(); ++i)
+        {
+            wxStringClientData *clientData = dynamic_cast<wxStringClientData *>(m_courtChoice->GetClientObject(i));
+            long courtId;
+            if (clientData && clientData->GetData().ToLong(&courtId) && courtId == chosen.courtId)
+            {
+                m_courtChoice->SetSelection(i);
+                break;
+            }
+        }
+        m_datePicker->SetValue(wxDateTime(chosen.startTime));
+        m_startTimePicker->SetValue(wxDateTime(chosen.startTime));
+        m_endTimePicker->SetValue(wxDateTime(chosen.endTime));
+
+        RefreshAvailableSlots();
+        UpdateEstimatedCost();
+    }
+    catch (const std::exception &e)
+    {
+        wxMessageBox(wxString::Format("Error finding slots: %s", e.what()), "Error", wxOK | wxICON_ERROR, this);
+    }
+}
+
 void BookingPanel::OnRefreshBookings(wxCommandEvent &event)
 {
     RefreshData();
@@ -799,6 +946,7 @@ void BookingPanel::OnModifyBooking(wxCommandEvent &event)
 
 void BookingPanel::OnCourtChanged(wxCommandEvent &event)
 {
+    ReleaseHeldSlot();
     RefreshAvailableSlots();
     UpdateEstimatedCost();
 }
@@ -806,10 +954,12 @@ void BookingPanel::OnCourtChanged(wxCommandEvent &event)
 void BookingPanel::OnTimeChanged(wxDateEvent &event)
 {
     UpdateEstimatedCost();
+    UpdateTimelineSelection();
 }
 
 void BookingPanel::OnDateChanged(wxDateEvent &event)
 {
+    ReleaseHeldSlot();
     RefreshAvailableSlots();
     UpdateEstimatedCost();
 }
@@ -879,6 +1029,31 @@ void BookingPanel::OnAvailableSlotSelected(wxListEvent &event)
 
                 // Update cost calculation
                 UpdateEstimatedCost();
+                UpdateTimelineSelection();
+
+                // Hold the slot until Book is pressed, so another terminal cannot take it meanwhile;
+                // a thin client has no holds and books the form directly
+                ReleaseHeldSlot();
+                auto currentUser = m_authController->getCurrentUser();
+                wxStringClientData *clientData = dynamic_cast<wxStringClientData *>(
+                    m_courtChoice->GetClientObject(m_courtChoice->GetSelection()));
+                long courtId;
+                if (!m_bookingController->isRemote() &&
+                    currentUser && clientData && clientData->GetData().ToLong(&courtId))
+                {
+                    m_heldSlotId = m_bookingController->holdSlot(currentUser->getId(), (int)courtId,
+                                                                 CombineDateTime(selectedDate, startTime),
+                                                                 CombineDateTime(selectedDate, endTime));
+                    if (m_heldSlotId == 0)
+                    {
+                        wxMessageBox("This time slot was just taken by another booking.\n\n"
+                                     "The list of available slots has been refreshed.",
+                                     "Slot Not Available",
+                                     wxOK | wxICON_WARNING, this);
+                        RefreshAvailableSlots();
+                        return;
+                    }
+                }
 
                 // Show confirmation message
                 // wxString confirmMsg = wxString::Format(
@@ -991,48 +1166,27 @@ void BookingPanel::UpdateEstimatedCost()
         return;
     }
 
-    double durationHours = (endMinutes - startMinutes) / 60.0;
-
-    // Get selected court's price
-    double hourlyRate = 50000.0; // Default price
-
+    // Selected court's prices for the chosen day (default rate if none is selected)
+    long courtId = 0;
     int courtSelection = m_courtChoice->GetSelection();
-    if (courtSelection != wxNOT_FOUND && m_courtController)
+    if (courtSelection != wxNOT_FOUND)
     {
         wxStringClientData *clientData = dynamic_cast<wxStringClientData *>(m_courtChoice->GetClientObject(courtSelection));
         if (clientData)
         {
-            long courtId;
-            if (clientData->GetData().ToLong(&courtId))
-            {
-                try
-                {
-                    auto courts = m_courtController->getAllCourts();
-                    for (const auto &court : courts)
-                    {
-                        if (court && court->getId() == (int)courtId)
-                        {
-                            hourlyRate = court->getHourlyRate();
-                            break;
-                        }
-                    }
-                }
-                catch (const std::exception &e)
-                {
-                    // Use default rate if error
-                    hourlyRate = 50000.0;
-                }
-            }
+            clientData->GetData().ToLong(&courtId);
         }
     }
 
-    double totalCost = durationHours * hourlyRate;
+    PricingEngine::DayPrices prices = PricingEngine::getInstance().getDayPrices((int)courtId, m_datePicker->GetValue().GetTicks());
+    double totalCost = prices.getCost(startMinutes, endMinutes);
 
-    m_costLabel->SetLabel(wxString::Format("%.0f VND", totalCost));
+    m_costLabel->SetLabel(NumberFormat::vnd(totalCost).c_str());
 }
 
 void BookingPanel::ClearBookingForm()
 {
+    ReleaseHeldSlot();
     m_notesCtrl->Clear();
     m_costLabel->SetLabel("0 VND");
 
@@ -1073,7 +1227,8 @@ void BookingPanel::UpdateButtonStates()
             {
                 if (booking && booking->getId() == m_selectedBookingId)
                 {
-                    // Can only cancel if booking is PENDING or CONFIRMED
+                    // Can only cancel if booking is PENDING or CONFIRMED; cancelling
+                    // a standing booking occurrence skips that day of its series
                     canCancel = (booking->getStatus() == BookingStatus::PENDING ||
                                  booking->getStatus() == BookingStatus::CONFIRMED);
 
@@ -1103,35 +1258,25 @@ void BookingPanel::SavePendingChanges()
 // Helper methods
 wxString BookingPanel::FormatTimeSlot(std::time_t startTime, std::time_t endTime)
 {
-    wxDateTime start(startTime);
-    wxDateTime end(endTime);
-    return start.Format("%H:%M") + " - " + end.Format("%H:%M");
+    char slot[16];
+    char *end = DateTimeUtils::writeClock(slot, startTime);
+    end = std::copy_n(" - ", 3, end);
+    end = DateTimeUtils::writeClock(end, endTime);
+    return wxString(slot, end - slot);
 }
 
-wxString BookingPanel::FormatCurrency(double amount)
+wxString BookingPanel::FormatDateTime(std::time_t time)
 {
-    // Convert to string with no decimals
-    wxString amountStr = wxString::Format("%.0f", amount);
-
-    // Add thousand separators manually
-    wxString result = "";
-    int len = amountStr.length();
-    for (int i = 0; i < len; i++)
-    {
-        if (i > 0 && (len - i) % 3 == 0)
-        {
-            result += ",";
-        }
-        result += amountStr[i];
-    }
-
-    return result + " VND";
+    return DateTimeUtils::formatDateTime(time, "%d/%m/%Y %H:%M");
 }
 
-wxString BookingPanel::FormatDateTime(std::time_t time)
+void BookingPanel::ReleaseHeldSlot()
 {
-    wxDateTime dt(time);
-    return dt.Format("%d/%m/%Y %H:%M");
+    if (m_heldSlotId != 0)
+    {
+        m_bookingController->releaseHold(m_heldSlotId);
+        m_heldSlotId = 0;
+    }
 }
 
 bool BookingPanel::IsCourtFullyBooked()
@@ -1177,6 +1322,36 @@ bool BookingPanel::IsCourtFullyBooked()
     return usage >= 80.0;
 }
 
+void BookingPanel::OnRemoteTimer(wxTimerEvent &event)
+{
+    // Other front desks' changes arrive through the replica; redraw once they land
+    uint64_t sequence = m_bookingController->getRemoteSequence();
+    if (sequence != m_remoteSequence)
+    {
+        m_remoteSequence = sequence;
+        RefreshData();
+    }
+}
+
+void BookingPanel::OnTimelineSelection(wxCommandEvent &event)
+{
+    // Copy the dragged span straight into the time pickers
+    wxDateTime startTime(m_timeline->GetSelectionStart());
+    wxDateTime endTime(m_timeline->GetSelectionEnd());
+    m_startTimePicker->SetValue(startTime);
+    m_endTimePicker->SetValue(endTime);
+
+    UpdateEstimatedCost();
+}
+
+void BookingPanel::UpdateTimelineSelection()
+{
+    // Mirror the time pickers on the timeline
+    wxDateTime bookingDate = m_datePicker->GetValue();
+    m_timeline->SetSelection(CombineDateTime(bookingDate, m_startTimePicker->GetValue()),
+                             CombineDateTime(bookingDate, m_endTimePicker->GetValue()));
+}
+
 std::time_t BookingPanel::CombineDateTime(const wxDateTime &date, const wxDateTime &time)
 {
     wxDateTime combined = date;
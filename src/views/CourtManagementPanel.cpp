@@ -2,6 +2,7 @@
 #include "../include/CourtController.h"
 #include "../include/AuthController.h"
 #include "../include/Court.h"
+#include "../include/NumberFormat.h"
 #include <wx/sizer.h>
 #include <wx/msgdlg.h>
 #include <wx/statbox.h>
@@ -441,7 +442,7 @@ void CourtManagementPanel::PopulateCourtList()
         long index = m_courtList->InsertItem(itemIndex, wxString::Format("%d", court->getId()));
         m_courtList->SetItem(index, 1, court->getName());
         m_courtList->SetItem(index, 2, court->getDescription());
-        m_courtList->SetItem(index, 3, FormatCurrency(court->getHourlyRate()));
+        m_courtList->SetItem(index, 3, NumberFormat::vnd(court->getHourlyRate()).c_str());
 
         // Convert status to string
         wxString statusStr = "Available";
@@ -475,7 +476,3 @@ void CourtManagementPanel::PopulateCourtList()
     }
 }
 
-wxString CourtManagementPanel::FormatCurrency(double amount)
-{
-    return wxString::Format("%.0f VND", amount);
-}
@@ -0,0 +1,374 @@
+#include "CourtTimeline.h"
+#include <wx/dcbuffer.h>
+#include <wx/dcmemory.h>
+#include <algorithm>
+
+wxDEFINE_EVENT(wxEVT_TIMELINE_SELECTION, wxCommandEvent);
+
+static const int LABEL_HEIGHT = 16;     // Hour labels above the bar
+static const size_t MAX_CACHED_DAYS = 32;
+
+wxBEGIN_EVENT_TABLE(CourtTimeline, wxWindow)
+    EVT_PAINT(CourtTimeline::OnPaint)
+    EVT_SIZE(CourtTimeline::OnSize)
+    EVT_LEFT_DOWN(CourtTimeline::OnLeftDown)
+    EVT_MOTION(CourtTimeline::OnMotion)
+    EVT_LEFT_UP(CourtTimeline::OnLeftUp)
+    EVT_MOUSE_CAPTURE_LOST(CourtTimeline::OnCaptureLost)
+wxEND_EVENT_TABLE()
+
+CourtTimeline::CourtTimeline(wxWindow *parent, wxWindowID id)
+    : wxWindow(parent, id, wxDefaultPosition, wxDefaultSize, wxFULL_REPAINT_ON_RESIZE),
+      m_courtId(-1),
+      m_day(wxDateTime::Today()),
+      m_dayStart(wxDateTime::Today().GetTicks()),
+      m_selStart(-1),
+      m_selEnd(-1),
+      m_dragAnchor(-1),
+      m_dragMoved(false)
+{
+    // Required by wxAutoBufferedPaintDC
+    SetBackgroundStyle(wxBG_STYLE_PAINT);
+    SetCursor(wxCursor(wxCURSOR_HAND));
+}
+
+void CourtTimeline::SetDay(int courtId, const wxDateTime &day, const OccupancyMap::DayBits &occupancy)
+{
+    wxDateTime dayStart = day.GetDateOnly();
+    if (courtId == m_courtId && dayStart == m_day && occupancy == m_occupancy)
+    {
+        return; // Nothing changed, keep the current rendering
+    }
+
+    m_courtId = courtId;
+    m_day = dayStart;
+    m_dayStart = dayStart.GetTicks();
+    m_occupancy = occupancy;
+    Refresh();
+}
+
+void CourtTimeline::SetSelection(std::time_t startTime, std::time_t endTime)
+{
+    int start = std::max(TimeToSlot(startTime), FirstSlot());
+    int end = std::min(TimeToSlot(endTime), LastSlot());
+    if (start >= end)
+    {
+        ClearSelection();
+        return;
+    }
+    SetSelectionSlots(start, end);
+}
+
+void CourtTimeline::ClearSelection()
+{
+    SetSelectionSlots(-1, -1);
+}
+
+void CourtTimeline::OnPaint(wxPaintEvent &event)
+{
+    wxAutoBufferedPaintDC dc(this);
+    const wxBitmap &dayBitmap = GetDayBitmap();
+
+    // Copy only the damaged rectangles from the cached rendering
+    wxMemoryDC source;
+    source.SelectObjectAsSource(dayBitmap);
+    for (wxRegionIterator update(GetUpdateRegion()); update; ++update)
+    {
+        wxRect rect = update.GetRect();
+        dc.Blit(rect.x, rect.y, rect.width, rect.height, &source, rect.x, rect.y);
+    }
+    source.SelectObject(wxNullBitmap);
+
+    // Hatch the part of the day that has already passed
+    int nowSlot = TimeToSlot(wxDateTime::Now().GetTicks());
+    if (nowSlot > FirstSlot())
+    {
+        wxRect past = SlotRangeRect(FirstSlot(), std::min(nowSlot, LastSlot()));
+        dc.SetBackgroundMode(wxBRUSHSTYLE_TRANSPARENT);
+        dc.SetPen(*wxTRANSPARENT_PEN);
+        dc.SetBrush(wxBrush(wxColour(160, 160, 160), wxBRUSHSTYLE_BDIAGONAL_HATCH));
+        dc.DrawRectangle(past);
+    }
+
+    if (HasSelection())
+    {
+        dc.SetPen(wxPen(wxColour(0, 90, 200), 2));
+        dc.SetBrush(wxBrush(wxColour(0, 90, 200), wxBRUSHSTYLE_FDIAGONAL_HATCH));
+        dc.DrawRectangle(SlotRangeRect(m_selStart, m_selEnd));
+    }
+}
+
+void CourtTimeline::OnSize(wxSizeEvent &event)
+{
+    // Cached renderings are sized to the window
+    m_cache.clear();
+    m_cacheOrder.clear();
+    Refresh();
+    event.Skip();
+}
+
+const wxBitmap &CourtTimeline::GetDayBitmap()
+{
+    wxSize size = GetClientSize();
+    size.IncTo(wxSize(1, 1));
+
+    uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(m_courtId)) << 40) |
+                   (static_cast<uint64_t>(m_dayStart) & 0xFFFFFFFFFFULL);
+
+    auto it = m_cache.find(key);
+    if (it != m_cache.end() && it->second.occupancy == m_occupancy &&
+        it->second.bitmap.GetSize() == size)
+    {
+        m_cacheOrder.remove(key);
+        m_cacheOrder.push_front(key);
+        return it->second.bitmap;
+    }
+
+    CachedDay &entry = m_cache[key];
+    entry.occupancy = m_occupancy;
+    entry.bitmap = RenderDay(m_occupancy, size);
+
+    m_cacheOrder.remove(key);
+    m_cacheOrder.push_front(key);
+    while (m_cacheOrder.size() > MAX_CACHED_DAYS)
+    {
+        m_cache.erase(m_cacheOrder.back());
+        m_cacheOrder.pop_back();
+    }
+    return entry.bitmap;
+}
+
+wxBitmap CourtTimeline::RenderDay(const OccupancyMap::DayBits &occupancy, const wxSize &size) const
+{
+    wxBitmap bitmap(size);
+    wxMemoryDC dc(bitmap);
+
+    dc.SetBackground(wxBrush(GetParent()->GetBackgroundColour()));
+    dc.Clear();
+
+    // Free background, same palette as the slot list
+    wxRect bar = SlotRangeRect(FirstSlot(), LastSlot());
+    dc.SetPen(wxPen(wxColour(160, 160, 160)));
+    dc.SetBrush(wxBrush(wxColour(240, 255, 240)));
+    dc.DrawRectangle(bar);
+
+    // Booked runs
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.SetBrush(wxBrush(wxColour(200, 60, 60)));
+    int slot = FirstSlot();
+    while (slot < LastSlot())
+    {
+        if (!occupancy.test(slot))
+        {
+            ++slot;
+            continue;
+        }
+
+        int runStart = slot;
+        while (slot < LastSlot() && occupancy.test(slot))
+        {
+            ++slot;
+        }
+        dc.DrawRectangle(SlotRangeRect(runStart, slot));
+    }
+
+    // Hour ticks, labelled every hour when there is room and every other hour otherwise
+    int hourWidth = SlotToX(FirstSlot() + OccupancyMap::SLOTS_PER_HOUR) - SlotToX(FirstSlot());
+    int labelStep = hourWidth >= 28 ? 1 : 2;
+
+    dc.SetFont(GetFont().Smaller());
+    dc.SetTextForeground(wxColour(80, 80, 80));
+    for (int hour = FIRST_HOUR; hour <= LAST_HOUR; ++hour)
+    {
+        int x = SlotToX(hour * OccupancyMap::SLOTS_PER_HOUR);
+        dc.SetPen(wxPen(wxColour(120, 120, 120)));
+        dc.DrawLine(x, bar.GetTop(), x, bar.GetTop() + 4);
+        dc.DrawLine(x, bar.GetBottom() - 4, x, bar.GetBottom());
+
+        if ((hour - FIRST_HOUR) % labelStep == 0)
+        {
+            wxString label = wxString::Format("%02d", hour);
+            wxSize extent = dc.GetTextExtent(label);
+            dc.DrawText(label, x - extent.GetWidth() / 2, (LABEL_HEIGHT - extent.GetHeight()) / 2);
+        }
+    }
+
+    dc.SelectObject(wxNullBitmap);
+    return bitmap;
+}
+
+void CourtTimeline::OnLeftDown(wxMouseEvent &event)
+{
+    int slot = XToSlot(event.GetX());
+    if (slot < FirstSlot() || slot >= LastSlot() || !IsSlotFree(slot))
+    {
+        return;
+    }
+
+    // Start on the 15-minute mark when it is free, otherwise where clicked
+    int anchor = slot - (slot % SNAP_SLOTS);
+    m_dragAnchor = IsSlotFree(anchor) ? anchor : slot;
+    m_dragMoved = false;
+    UpdateDragSelection(m_dragAnchor);
+
+    if (!HasCapture())
+    {
+        CaptureMouse();
+    }
+}
+
+void CourtTimeline::OnMotion(wxMouseEvent &event)
+{
+    if (m_dragAnchor < 0 || !event.LeftIsDown())
+    {
+        return;
+    }
+
+    int slot = std::max(FirstSlot(), std::min(XToSlot(event.GetX()), LastSlot() - 1));
+    if (slot != m_dragAnchor)
+    {
+        m_dragMoved = true;
+    }
+    UpdateDragSelection(slot);
+}
+
+void CourtTimeline::OnLeftUp(wxMouseEvent &event)
+{
+    if (m_dragAnchor < 0)
+    {
+        return;
+    }
+
+    if (!m_dragMoved)
+    {
+        // A plain click selects one hour, stopping at the next booking
+        int end = m_dragAnchor;
+        while (end < LastSlot() && end < m_dragAnchor + OccupancyMap::SLOTS_PER_HOUR && IsSlotFree(end))
+        {
+            ++end;
+        }
+        SetSelectionSlots(m_dragAnchor, end);
+    }
+    FinishDrag();
+}
+
+void CourtTimeline::OnCaptureLost(wxMouseCaptureLostEvent &event)
+{
+    m_dragAnchor = -1;
+}
+
+void CourtTimeline::UpdateDragSelection(int slot)
+{
+    // The selection may grow in either direction but never across a booking
+    int runStart = m_dragAnchor;
+    while (runStart > FirstSlot() && IsSlotFree(runStart - 1))
+    {
+        --runStart;
+    }
+    int runEnd = m_dragAnchor;
+    while (runEnd < LastSlot() && IsSlotFree(runEnd))
+    {
+        ++runEnd;
+    }
+
+    int start;
+    int end;
+    if (slot >= m_dragAnchor)
+    {
+        int snapped = ((slot + SNAP_SLOTS) / SNAP_SLOTS) * SNAP_SLOTS;
+        start = m_dragAnchor;
+        end = std::max(m_dragAnchor + 1, std::min(snapped, runEnd));
+    }
+    else
+    {
+        int snapped = slot - (slot % SNAP_SLOTS);
+        start = std::max(snapped, runStart);
+        end = std::min(m_dragAnchor + SNAP_SLOTS, runEnd);
+    }
+    SetSelectionSlots(start, end);
+}
+
+void CourtTimeline::FinishDrag()
+{
+    m_dragAnchor = -1;
+    if (HasCapture())
+    {
+        ReleaseMouse();
+    }
+
+    if (HasSelection())
+    {
+        wxCommandEvent selectionEvent(wxEVT_TIMELINE_SELECTION, GetId());
+        selectionEvent.SetEventObject(this);
+        ProcessWindowEvent(selectionEvent);
+    }
+}
+
+void CourtTimeline::SetSelectionSlots(int start, int end)
+{
+    if (start == m_selStart && end == m_selEnd)
+    {
+        return;
+    }
+
+    // Invalidate only the old and new selection areas
+    wxRect dirty;
+    if (HasSelection())
+    {
+        dirty = SlotRangeRect(m_selStart, m_selEnd);
+    }
+
+    m_selStart = start;
+    m_selEnd = end;
+
+    if (HasSelection())
+    {
+        dirty.Union(SlotRangeRect(m_selStart, m_selEnd));
+    }
+    if (!dirty.IsEmpty())
+    {
+        RefreshRect(dirty.Inflate(2, 2));
+    }
+}
+
+int CourtTimeline::SlotToX(int slot) const
+{
+    int width = std::max(1, GetClientSize().GetWidth() - 2);
+    return 1 + static_cast<int>(static_cast<long long>(slot - FirstSlot()) * width / (LastSlot() - FirstSlot()));
+}
+
+int CourtTimeline::XToSlot(int x) const
+{
+    int width = std::max(1, GetClientSize().GetWidth() - 2);
+    return FirstSlot() + static_cast<int>(static_cast<long long>(x - 1) * (LastSlot() - FirstSlot()) / width);
+}
+
+wxRect CourtTimeline::SlotRangeRect(int start, int end) const
+{
+    int height = GetClientSize().GetHeight();
+    int x0 = SlotToX(start);
+    int x1 = SlotToX(end);
+    return wxRect(x0, LABEL_HEIGHT, std::max(1, x1 - x0), std::max(1, height - LABEL_HEIGHT - 2));
+}
+
+std::time_t CourtTimeline::SlotToTime(int slot) const
+{
+    return m_dayStart + static_cast<std::time_t>(slot) * OccupancyMap::SLOT_MINUTES * 60;
+}
+
+int CourtTimeline::TimeToSlot(std::time_t time) const
+{
+    // Unlike OccupancyMap::slotOf this is not clamped, so other days fall outside the bar
+    std::time_t slotSeconds = OccupancyMap::SLOT_MINUTES * 60;
+    std::time_t offset = time - m_dayStart;
+    if (offset < 0)
+        return -1;
+    return static_cast<int>(std::min<std::time_t>(offset / slotSeconds, OccupancyMap::SLOTS_PER_DAY + 1));
+}
+
+bool CourtTimeline::IsSlotFree(int slot) const
+{
+    if (slot < 0 || slot >= OccupancyMap::SLOTS_PER_DAY)
+        return false;
+    return !m_occupancy.test(slot) && SlotToTime(slot) >= wxDateTime::Now().GetTicks();
+}
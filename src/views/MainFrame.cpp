@@ -5,10 +5,12 @@
 #include "StatisticsPanel.h"
 #include "UserManagementPanel.h"
 #include "AdminPanel.h"
+#include "ScheduleGridPanel.h"
 #include "LoginFrame.h"
 #include "../include/AuthController.h"
 #include "../include/CourtController.h"
 #include "../include/BookingController.h"
+#include "../include/NotificationObserver.h"
 #include <wx/sizer.h>
 #include <wx/msgdlg.h>
 #include <wx/notebook.h>
@@ -19,6 +21,8 @@ wxBEGIN_EVENT_TABLE(MainFrame, wxFrame)
     EVT_MENU(wxID_EXIT, MainFrame::OnExit)
     EVT_MENU(wxID_ABOUT, MainFrame::OnAbout)
     EVT_MENU(ID_LOGOUT, MainFrame::OnLogout)
+    EVT_MENU(ID_NOTIFICATIONS, MainFrame::OnShowNotifications)
+    EVT_TIMER(ID_NOTIFICATION_TIMER, MainFrame::OnNotificationTimer)
     EVT_CLOSE(MainFrame::OnClose)
 wxEND_EVENT_TABLE()
 
@@ -30,6 +34,15 @@ MainFrame::MainFrame(AuthController* authController,
     m_authController(authController),
     m_courtController(courtController),
     m_bookingController(bookingController),
+    m_courtPanel(nullptr),
+    m_bookingPanel(nullptr),
+    m_statisticsPanel(nullptr),
+    m_userPanel(nullptr),
+    m_adminPanel(nullptr),
+    m_schedulePanel(nullptr),
+    m_notificationTimer(this, ID_NOTIFICATION_TIMER),
+    m_lastUnreadCount(static_cast<size_t>(-1)),
+    m_remoteSequence(bookingController ? bookingController->getRemoteSequence() : 0),
     m_selectedCourtId(-1),
     m_selectedBookingId(-1)
 {
@@ -40,9 +53,15 @@ MainFrame::MainFrame(AuthController* authController,
 
     // Welcome message
     SetStatusText("Welcome to the Badminton Court Management System!");
+
+    UpdateNotificationBadge();
+    m_notificationTimer.Start(1000);
 }
 
-MainFrame::~MainFrame() {}
+MainFrame::~MainFrame()
+{
+    m_notificationTimer.Stop();
+}
 
 void MainFrame::CreateMenuBar()
 {
@@ -50,6 +69,7 @@ void MainFrame::CreateMenuBar()
 
     // File menu
     wxMenu *fileMenu = new wxMenu;
+    fileMenu->Append(ID_NOTIFICATIONS, "Notifications...\tCtrl+N", "Show your notifications");
     fileMenu->Append(ID_LOGOUT, "Logout\tCtrl+L", "Logout from the system");
     fileMenu->AppendSeparator();
     fileMenu->Append(wxID_EXIT, "Exit\tCtrl+Q", "Exit the application");
@@ -78,7 +98,9 @@ void MainFrame::CreateUI()
 
 void MainFrame::CreateStatusBar()
 {
-    m_statusBar = wxFrame::CreateStatusBar(2);
+    m_statusBar = wxFrame::CreateStatusBar(3);
+    int widths[] = {-2, -1, 180};
+    m_statusBar->SetStatusWidths(3, widths);
     SetStatusText("Ready", 0);
 
     // Show current user info
@@ -130,6 +152,10 @@ void MainFrame::CreateNotebook()
         m_courtPanel = new CourtManagementPanel(m_notebook, m_courtController, m_authController);
         m_notebook->AddPage(m_courtPanel, "Court Management");
 
+        // Week schedule across all courts
+        m_schedulePanel = new ScheduleGridPanel(m_notebook, m_bookingController, m_courtController);
+        m_notebook->AddPage(m_schedulePanel, "Schedule");
+
         // Statistics Panel
         m_statisticsPanel = new StatisticsPanel(m_notebook, m_bookingController, m_courtController, m_authController);
         m_notebook->AddPage(m_statisticsPanel, "Statistics");
@@ -149,6 +175,10 @@ void MainFrame::CreateNotebook()
         m_bookingPanel = new BookingPanel(m_notebook, m_bookingController, m_courtController, m_authController);
         m_notebook->AddPage(m_bookingPanel, "Booking");
 
+        // Week schedule across all courts
+        m_schedulePanel = new ScheduleGridPanel(m_notebook, m_bookingController, m_courtController);
+        m_notebook->AddPage(m_schedulePanel, "Schedule");
+
         // Statistics Panel
         m_statisticsPanel = new StatisticsPanel(m_notebook, m_bookingController, m_courtController, m_authController);
         m_notebook->AddPage(m_statisticsPanel, "Statistics");
@@ -165,6 +195,7 @@ void MainFrame::CreateNotebook()
 void MainFrame::BindEvents()
 {
     // Events are handled by the event table
+    m_notebook->Bind(wxEVT_NOTEBOOK_PAGE_CHANGED, &MainFrame::OnPageChanged, this);
 }
 
 void MainFrame::OnExit(wxCommandEvent &event)
@@ -247,6 +278,11 @@ void MainFrame::RefreshAllPanels()
         m_statisticsPanel->RefreshData();
     }
 
+    if (m_schedulePanel)
+    {
+        m_schedulePanel->RefreshData();
+    }
+
     SetStatusText("Data has been updated", 0);
 }
 
@@ -284,9 +320,91 @@ void MainFrame::ShowUserInfo()
     UpdateUserInterface();
 }
 
+void MainFrame::UpdateNotificationBadge()
+{
+    BadmintonApp *app = BadmintonApp::GetInstance();
+    InAppNotificationObserver *inbox = app ? app->GetInAppObserver() : nullptr;
+    if (!inbox || !m_authController || !m_authController->getCurrentUser())
+        return;
+
+    size_t unread = inbox->getUnreadCount(m_authController->getCurrentUser()->getId());
+    if (unread == m_lastUnreadCount)
+        return;
+
+    m_lastUnreadCount = unread;
+    if (unread == 0)
+    {
+        SetStatusText("No new notifications", 2);
+    }
+    else
+    {
+        SetStatusText(wxString::Format("Notifications: %zu unread", unread), 2);
+    }
+}
+
+void MainFrame::OnNotificationTimer(wxTimerEvent &event)
+{
+    UpdateNotificationBadge();
+
+    // Other front desks' changes arrive through the replica; the booking
+    // panel follows them itself, the management panels are redrawn here
+    if (m_bookingController && m_bookingController->isRemote())
+    {
+        uint64_t sequence = m_bookingController->getRemoteSequence();
+        if (sequence != m_remoteSequence)
+        {
+            m_remoteSequence = sequence;
+            if (m_adminPanel)
+            {
+                m_adminPanel->RefreshData();
+            }
+            if (m_statisticsPanel)
+            {
+                m_statisticsPanel->RefreshData();
+            }
+            if (m_schedulePanel)
+            {
+                m_schedulePanel->RefreshData();
+            }
+        }
+    }
+}
+
+void MainFrame::OnShowNotifications(wxCommandEvent &event)
+{
+    BadmintonApp *app = BadmintonApp::GetInstance();
+    InAppNotificationObserver *inbox = app ? app->GetInAppObserver() : nullptr;
+    if (!inbox || !m_authController || !m_authController->getCurrentUser())
+        return;
+
+    int userId = m_authController->getCurrentUser()->getId();
+    wxString text;
+    {
+        // Build the text while holding the view, then release it before showing the dialog
+        InAppNotificationObserver::InboxView view = inbox->getInbox(userId);
+        for (const InAppNotification &notification : view)
+        {
+            text += wxString::Format("[%s] %s\n",
+                                     notification.formatTimestamp(), notification.message);
+        }
+    }
+    inbox->markAllRead(userId);
+    UpdateNotificationBadge();
+
+    if (text.IsEmpty())
+    {
+        text = "You have no notifications.";
+    }
+    wxMessageBox(text, "Notifications", wxOK | wxICON_INFORMATION, this);
+}
+
 void MainFrame::OnPageChanged(wxBookCtrlEvent &event)
 {
-    // Handle notebook page changes if needed
+    // The schedule reads live occupancy, so bring it up to date when shown
+    if (m_schedulePanel && m_notebook->GetPage(event.GetSelection()) == m_schedulePanel)
+    {
+        m_schedulePanel->RefreshData();
+    }
     event.Skip();
 }
 
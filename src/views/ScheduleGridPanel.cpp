@@ -0,0 +1,323 @@
+#include "ScheduleGridPanel.h"
+#include "../include/BookingController.h"
+#include "../include/CourtController.h"
+#include "../include/Court.h"
+#include <wx/sizer.h>
+#include <wx/statbox.h>
+#include <algorithm>
+
+wxBEGIN_EVENT_TABLE(ScheduleGridPanel, wxPanel)
+    EVT_DATE_CHANGED(ID_WEEK_PICKER, ScheduleGridPanel::OnWeekChanged)
+    EVT_BUTTON(ID_PREV_WEEK, ScheduleGridPanel::OnPreviousWeek)
+    EVT_BUTTON(ID_NEXT_WEEK, ScheduleGridPanel::OnNextWeek)
+    EVT_BUTTON(ID_THIS_WEEK, ScheduleGridPanel::OnThisWeek)
+    EVT_BUTTON(ID_REFRESH_SCHEDULE, ScheduleGridPanel::OnRefresh)
+wxEND_EVENT_TABLE()
+
+ScheduleGridTable::ScheduleGridTable(BookingController *bookingController)
+    : m_bookingController(bookingController)
+{
+    SetWeekStart(wxDateTime::Today().SetToWeekDayInSameWeek(wxDateTime::Mon));
+}
+
+void ScheduleGridTable::SetCourts(const std::vector<std::pair<int, wxString>> &courts)
+{
+    m_courts = courts;
+    m_dayCache.clear();
+}
+
+void ScheduleGridTable::SetWeekStart(const wxDateTime &weekStart)
+{
+    for (int day = 0; day < DAYS_PER_WEEK; ++day)
+    {
+        m_days[day] = weekStart.GetDateOnly() + wxDateSpan::Days(day);
+
+        // Setting the local hour keeps DST days correct
+        std::time_t midnight = m_days[day].GetTicks();
+        for (int hour = 0; hour <= HOURS_PER_DAY; ++hour)
+        {
+            wxDateTime hourStart = m_days[day];
+            hourStart.SetHour(FIRST_HOUR + hour);
+            m_hourStarts[day][hour] = hourStart.GetTicks();
+            m_hourSlots[day][hour] = OccupancyMap::slotOf(midnight, m_hourStarts[day][hour]);
+        }
+    }
+    m_dayCache.clear();
+}
+
+uint16_t ScheduleGridTable::GetHourMask(int row, int col) const
+{
+    if (!m_bookingController || row < 0 || row >= static_cast<int>(m_courts.size()))
+        return 0;
+
+    int day = GetDayOfColumn(col);
+    int hour = col % HOURS_PER_DAY;
+    if (day < 0 || day >= DAYS_PER_WEEK)
+        return 0;
+
+    uint64_t key = (static_cast<uint64_t>(row) << 8) | static_cast<uint64_t>(day);
+    auto it = m_dayCache.find(key);
+    if (it == m_dayCache.end())
+    {
+        OccupancyMap::DayBits bits = m_bookingController->getCourtOccupancy(m_courts[row].first,
+                                                                            m_days[day].GetTicks());
+        it = m_dayCache.emplace(key, bits).first;
+    }
+
+    int firstSlot = m_hourSlots[day][hour];
+    int slotCount = std::min(m_hourSlots[day][hour + 1] - firstSlot, static_cast<int>(OccupancyMap::SLOTS_PER_HOUR));
+
+    uint16_t mask = 0;
+    for (int i = 0; i < slotCount; ++i)
+    {
+        if (it->second.test(firstSlot + i))
+        {
+            mask |= static_cast<uint16_t>(1u << i);
+        }
+    }
+    return mask;
+}
+
+std::time_t ScheduleGridTable::GetHourEnd(int col) const
+{
+    int day = GetDayOfColumn(col);
+    int hour = col % HOURS_PER_DAY;
+    return m_hourStarts[day][hour + 1];
+}
+
+wxString ScheduleGridTable::GetRowLabelValue(int row)
+{
+    if (row < 0 || row >= static_cast<int>(m_courts.size()))
+        return wxEmptyString;
+    return m_courts[row].second;
+}
+
+wxString ScheduleGridTable::GetColLabelValue(int col)
+{
+    int day = GetDayOfColumn(col);
+    int hour = FIRST_HOUR + col % HOURS_PER_DAY;
+
+    // Day name above the first hour of each day
+    wxString dayLabel = IsFirstHourOfDay(col) ? m_days[day].Format("%a %d/%m") : wxString();
+    return wxString::Format("%s\n%02d", dayLabel, hour);
+}
+
+void ScheduleSpanRenderer::Draw(wxGrid &grid, wxGridCellAttr &attr, wxDC &dc, const wxRect &rect,
+                                int row, int col, bool isSelected)
+{
+    // Same palette as the BookingPanel slot list; alternate days are shaded
+    const wxColour freeColour(240, 255, 240);
+    const wxColour freeAltColour(228, 245, 228);
+    const wxColour pastColour(248, 248, 248);
+    const wxColour bookedColour(200, 60, 60);
+    const wxColour bookedPastColour(200, 160, 160);
+
+    ScheduleGridTable *table = static_cast<ScheduleGridTable *>(grid.GetTable());
+    bool isPast = table->GetHourEnd(col) <= wxDateTime::Now().GetTicks();
+
+    wxColour background = isPast ? pastColour
+                                 : (table->GetDayOfColumn(col) % 2 == 0 ? freeColour : freeAltColour);
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.SetBrush(wxBrush(background));
+    dc.DrawRectangle(rect);
+
+    // One rectangle per run of booked 5-minute slots
+    uint16_t mask = table->GetHourMask(row, col);
+    if (mask != 0)
+    {
+        const int slots = OccupancyMap::SLOTS_PER_HOUR;
+        dc.SetBrush(wxBrush(isPast ? bookedPastColour : bookedColour));
+
+        int slot = 0;
+        while (slot < slots)
+        {
+            if (!(mask & (1u << slot)))
+            {
+                ++slot;
+                continue;
+            }
+
+            int runStart = slot;
+            while (slot < slots && (mask & (1u << slot)))
+            {
+                ++slot;
+            }
+
+            int x0 = rect.x + rect.width * runStart / slots;
+            int x1 = rect.x + rect.width * slot / slots;
+            dc.DrawRectangle(x0, rect.y + 2, std::max(1, x1 - x0), rect.height - 4);
+        }
+    }
+
+    if (table->IsFirstHourOfDay(col))
+    {
+        dc.SetPen(wxPen(wxColour(90, 90, 90)));
+        dc.DrawLine(rect.x, rect.y, rect.x, rect.y + rect.height);
+    }
+
+    if (isSelected)
+    {
+        dc.SetPen(wxPen(grid.GetSelectionBackground(), 2));
+        dc.SetBrush(*wxTRANSPARENT_BRUSH);
+        dc.DrawRectangle(rect);
+    }
+}
+
+wxSize ScheduleSpanRenderer::GetBestSize(wxGrid &grid, wxGridCellAttr &attr, wxDC &dc, int row, int col)
+{
+    // Four pixels per 5-minute slot keeps short spans visible
+    return wxSize(OccupancyMap::SLOTS_PER_HOUR * 4, 24);
+}
+
+ScheduleGridPanel::ScheduleGridPanel(wxWindow *parent,
+                                     BookingController *bookingController,
+                                     CourtController *courtController)
+    : wxPanel(parent, wxID_ANY),
+      m_bookingController(bookingController),
+      m_courtController(courtController),
+      m_table(nullptr)
+{
+    CreateUI();
+    RefreshData();
+}
+
+ScheduleGridPanel::~ScheduleGridPanel() {}
+
+void ScheduleGridPanel::CreateUI()
+{
+    m_mainSizer = new wxBoxSizer(wxVERTICAL);
+
+    CreateControls();
+    CreateGrid();
+
+    SetSizer(m_mainSizer);
+}
+
+void ScheduleGridPanel::CreateControls()
+{
+    wxStaticBoxSizer *controlSizer = new wxStaticBoxSizer(wxHORIZONTAL, this, "Week");
+
+    controlSizer->Add(new wxStaticText(this, wxID_ANY, "Week of:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 5);
+    m_weekPicker = new wxDatePickerCtrl(this, ID_WEEK_PICKER, wxDateTime::Today(),
+                                        wxDefaultPosition, wxDefaultSize,
+                                        wxDP_DROPDOWN | wxDP_SHOWCENTURY);
+    controlSizer->Add(m_weekPicker, 0, wxRIGHT, 10);
+
+    controlSizer->Add(new wxButton(this, ID_PREV_WEEK, "< Previous"), 0, wxRIGHT, 5);
+    controlSizer->Add(new wxButton(this, ID_THIS_WEEK, "This Week"), 0, wxRIGHT, 5);
+    controlSizer->Add(new wxButton(this, ID_NEXT_WEEK, "Next >"), 0, wxRIGHT, 10);
+    controlSizer->Add(new wxButton(this, ID_REFRESH_SCHEDULE, "Refresh"), 0, wxRIGHT, 10);
+
+    m_weekLabel = new wxStaticText(this, wxID_ANY, "");
+    controlSizer->Add(m_weekLabel, 1, wxALIGN_CENTER_VERTICAL);
+
+    m_mainSizer->Add(controlSizer, 0, wxEXPAND | wxALL, 10);
+}
+
+void ScheduleGridPanel::CreateGrid()
+{
+    m_grid = new wxGrid(this, wxID_ANY);
+
+    // The grid owns both the table and the renderer
+    m_table = new ScheduleGridTable(m_bookingController);
+    m_grid->AssignTable(m_table);
+    m_grid->SetDefaultRenderer(new ScheduleSpanRenderer);
+
+    m_grid->EnableEditing(false);
+    m_grid->EnableDragRowSize(false);
+    m_grid->EnableDragColSize(false);
+    m_grid->SetCellHighlightPenWidth(0);
+    m_grid->SetRowLabelSize(140);
+    m_grid->SetColLabelSize(40);
+    m_grid->SetDefaultRowSize(26);
+    m_grid->SetDefaultColSize(OccupancyMap::SLOTS_PER_HOUR * 4);
+    m_grid->SetColLabelAlignment(wxALIGN_LEFT, wxALIGN_CENTER);
+
+    wxStaticText *legend = new wxStaticText(this, wxID_ANY,
+                                            "Red spans are booked (5-minute resolution); green is free, grey is past.");
+    legend->SetForegroundColour(wxColour(100, 100, 100));
+
+    m_mainSizer->Add(m_grid, 1, wxEXPAND | wxLEFT | wxRIGHT, 10);
+    m_mainSizer->Add(legend, 0, wxALL, 10);
+}
+
+void ScheduleGridPanel::RefreshData()
+{
+    if (!m_table)
+        return;
+
+    int oldRows = m_table->GetNumberRows();
+
+    std::vector<std::pair<int, wxString>> courts;
+    if (m_courtController)
+    {
+        for (const auto &court : m_courtController->getAllCourts())
+        {
+            if (court)
+            {
+                courts.emplace_back(court->getId(), wxString(court->getName()));
+            }
+        }
+    }
+    m_table->SetCourts(courts);
+    UpdateRowCount(oldRows);
+
+    ShowWeek(m_weekPicker->GetValue());
+}
+
+void ScheduleGridPanel::ShowWeek(const wxDateTime &date)
+{
+    wxDateTime weekStart = date.IsValid() ? date : wxDateTime::Today();
+    weekStart.SetToWeekDayInSameWeek(wxDateTime::Mon);
+
+    m_table->SetWeekStart(weekStart);
+    m_weekLabel->SetLabel(wxString::Format("%s - %s",
+                                           weekStart.Format("%d/%m/%Y"),
+                                           (weekStart + wxDateSpan::Days(6)).Format("%d/%m/%Y")));
+
+    // Only the visible cells are redrawn, fetching day bitmaps on demand
+    m_grid->ForceRefresh();
+}
+
+void ScheduleGridPanel::UpdateRowCount(int oldRows)
+{
+    int newRows = m_table->GetNumberRows();
+    if (newRows > oldRows)
+    {
+        wxGridTableMessage msg(m_table, wxGRIDTABLE_NOTIFY_ROWS_APPENDED, newRows - oldRows);
+        m_grid->ProcessTableMessage(msg);
+    }
+    else if (newRows < oldRows)
+    {
+        wxGridTableMessage msg(m_table, wxGRIDTABLE_NOTIFY_ROWS_DELETED, newRows, oldRows - newRows);
+        m_grid->ProcessTableMessage(msg);
+    }
+}
+
+void ScheduleGridPanel::OnWeekChanged(wxDateEvent &event)
+{
+    ShowWeek(event.GetDate());
+}
+
+void ScheduleGridPanel::OnPreviousWeek(wxCommandEvent &event)
+{
+    m_weekPicker->SetValue(m_weekPicker->GetValue() - wxDateSpan::Week());
+    ShowWeek(m_weekPicker->GetValue());
+}
+
+void ScheduleGridPanel::OnNextWeek(wxCommandEvent &event)
+{
+    m_weekPicker->SetValue(m_weekPicker->GetValue() + wxDateSpan::Week());
+    ShowWeek(m_weekPicker->GetValue());
+}
+
+void ScheduleGridPanel::OnThisWeek(wxCommandEvent &event)
+{
+    m_weekPicker->SetValue(wxDateTime::Today());
+    ShowWeek(wxDateTime::Today());
+}
+
+void ScheduleGridPanel::OnRefresh(wxCommandEvent &event)
+{
+    RefreshData();
+}
@@ -2,6 +2,8 @@
 #include "../include/BookingController.h"
 #include "../include/CourtController.h"
 #include "../include/AuthController.h"
+#include "../include/DateTimeUtils.h"
+#include "../include/NumberFormat.h"
 #include <wx/sizer.h>
 #include <wx/msgdlg.h>
 #include <wx/datectrl.h>
@@ -279,9 +281,8 @@ void StatisticsPanel::OnExportStats(wxCommandEvent &event)
             if (bookingTime >= startTime && bookingTime <= endTime)
             {
                 // Format date as YYYY-MM-DD
-                std::tm *tm = std::localtime(&bookingTime);
                 char dateStr[11];
-                std::strftime(dateStr, sizeof(dateStr), "%Y-%m-%d", tm);
+                *DateTimeUtils::writeDate(dateStr, bookingTime) = '\0';
 
                 auto &dayData = dailyData[dateStr];
                 std::get<0>(dayData)++;                              // bookings
@@ -347,7 +348,7 @@ void StatisticsPanel::GenerateStatistics()
     auto courts = m_courtController->getAllCourts();
 
     // Filter out cancelled bookings
-    std::vector<Booking*> activeBookings;
+    std::vector<BookingPtr> activeBookings;
     for (const auto &booking : allBookings)
     {
         if (booking && booking->getStatus() != BookingStatus::CANCELLED)
@@ -381,8 +382,8 @@ void StatisticsPanel::GenerateStatistics()
     }
 
     // Display real data
-    m_totalRevenueLabel->SetLabel(wxString::Format("%.0f VND", totalRevenue));
-    m_totalBookingsLabel->SetLabel(wxString::Format("%d", totalBookings));
+    m_totalRevenueLabel->SetLabel(NumberFormat::vnd(totalRevenue).c_str());
+    m_totalBookingsLabel->SetLabel(NumberFormat::integer(totalBookings).c_str());
     m_totalHoursLabel->SetLabel(wxString::Format("%.1f hours", totalHours));
     m_averageUsageLabel->SetLabel(wxString::Format("%.1f%%", averageUsage));
 
@@ -403,7 +404,7 @@ void StatisticsPanel::PopulateStatsList()
     auto allBookings = m_bookingController->getAllBookings();
 
     // Filter out cancelled bookings
-    std::vector<Booking*> activeBookings;
+    std::vector<BookingPtr> activeBookings;
     for (const auto &booking : allBookings)
     {
         if (booking && booking->getStatus() != BookingStatus::CANCELLED)
@@ -462,9 +463,9 @@ void StatisticsPanel::PopulateStatsList()
         }
 
         long index = m_statsListCtrl->InsertItem(m_statsListCtrl->GetItemCount(), courtName);
-        m_statsListCtrl->SetItem(index, 1, wxString::Format("%d", courtBookings));
+        m_statsListCtrl->SetItem(index, 1, NumberFormat::integer(courtBookings).c_str());
         m_statsListCtrl->SetItem(index, 2, wxString::Format("%.1f hours", courtHours));
-        m_statsListCtrl->SetItem(index, 3, wxString::Format("%.0f VND", courtRevenue));
+        m_statsListCtrl->SetItem(index, 3, NumberFormat::vnd(courtRevenue).c_str());
         m_statsListCtrl->SetItem(index, 4, wxString::Format("%.1f%%", usage));
     }
 
@@ -485,26 +486,6 @@ void StatisticsPanel::CalculateSummary()
     // For now, using placeholder implementation
 }
 
-wxString StatisticsPanel::FormatCurrency(double amount)
-{
-    // Convert to string with no decimals
-    wxString amountStr = wxString::Format("%.0f", amount);
-
-    // Add thousand separators manually
-    wxString result = "";
-    int len = amountStr.length();
-    for (int i = 0; i < len; i++)
-    {
-        if (i > 0 && (len - i) % 3 == 0)
-        {
-            result += ",";
-        }
-        result += amountStr[i];
-    }
-
-    return result + " VND";
-}
-
 wxString StatisticsPanel::FormatDuration(int hours)
 {
     return wxString::Format("%d hours", hours);
@@ -1,22 +1,28 @@
 #include "UserManagementPanel.h"
 #include "../include/AuthController.h"
 #include "../include/User.h"
+#include "../include/DateTimeUtils.h"
 #include <wx/msgdlg.h>
 #include <wx/stattext.h>
 
+static const int SEARCH_DEBOUNCE_MS = 200;
+
 wxBEGIN_EVENT_TABLE(UserManagementPanel, wxPanel)
     EVT_BUTTON(ID_REFRESH_USERS, UserManagementPanel::OnRefreshUsers)
     EVT_BUTTON(ID_DELETE_USER, UserManagementPanel::OnDeleteUser)
     EVT_BUTTON(ID_CHANGE_ROLE, UserManagementPanel::OnChangeRole)
     EVT_BUTTON(ID_TOGGLE_STATUS, UserManagementPanel::OnToggleStatus)
     EVT_LIST_ITEM_SELECTED(ID_USER_LIST, UserManagementPanel::OnUserSelected)
+    EVT_TEXT(ID_USER_SEARCH, UserManagementPanel::OnSearchText)
+    EVT_TIMER(ID_USER_SEARCH_TIMER, UserManagementPanel::OnSearchTimer)
 wxEND_EVENT_TABLE()
 
 UserManagementPanel::UserManagementPanel(wxWindow *parent,
                                             AuthController* authController)
 : wxPanel(parent, wxID_ANY),
     m_authController(authController),
-    m_selectedUserId(-1)
+    m_selectedUserId(-1),
+    m_searchTimer(this, ID_USER_SEARCH_TIMER)
 {
     CreateUI();
     BindEvents();
@@ -47,6 +53,14 @@ void UserManagementPanel::CreateUserList()
 {
     m_userListSizer = new wxStaticBoxSizer(wxVERTICAL, this, "Registered Users");
 
+    // Search by partial name, email or phone; results are listed best match first
+    wxBoxSizer *searchSizer = new wxBoxSizer(wxHORIZONTAL);
+    searchSizer->Add(new wxStaticText(this, wxID_ANY, "Search:"), 0, wxALIGN_CENTER_VERTICAL | wxRIGHT, 10);
+    m_searchCtrl = new wxTextCtrl(this, ID_USER_SEARCH, "", wxDefaultPosition, wxSize(250, -1));
+    m_searchCtrl->SetHint("Name, email or phone");
+    searchSizer->Add(m_searchCtrl, 0);
+    m_userListSizer->Add(searchSizer, 0, wxALL, 5);
+
     m_userList = new wxListCtrl(this, ID_USER_LIST,
                                 wxDefaultPosition, wxSize(-1, 300),
                                 wxLC_REPORT | wxLC_SINGLE_SEL);
@@ -118,7 +132,12 @@ void UserManagementPanel::RefreshUserList()
 
     try
     {
-        auto users = m_authController->getAllUsers();
+        wxString searchText = m_searchCtrl->GetValue();
+        searchText.Trim().Trim(false);
+        bool searching = !searchText.IsEmpty();
+
+        auto users = searching ? m_authController->searchUsers(searchText.ToStdString())
+                               : m_authController->getAllUsers();
 
         for (size_t i = 0; i < users.size(); ++i)
         {
@@ -134,9 +153,7 @@ void UserManagementPanel::RefreshUserList()
             m_userList->SetItem(index, 5, user->isActive() ? "Active" : "Inactive");
 
             // Format creation date
-            std::time_t createdTime = user->getCreatedAt();
-            wxDateTime created(createdTime);
-            m_userList->SetItem(index, 6, created.Format("%Y-%m-%d %H:%M"));
+            m_userList->SetItem(index, 6, DateTimeUtils::formatDateTime(user->getCreatedAt(), "%Y-%m-%d %H:%M"));
 
             // Store user ID in item data
             m_userList->SetItemData(index, user->getId());
@@ -144,7 +161,11 @@ void UserManagementPanel::RefreshUserList()
 
         // Show total count
         wxString statusMsg = wxString::Format("Total Users: %zu", users.size());
-        if (users.empty())
+        if (searching)
+        {
+            statusMsg = wxString::Format("Matching Users: %zu", users.size());
+        }
+        else if (users.empty())
         {
             statusMsg = "No users found. Users will appear here after registration.";
         }
@@ -415,6 +436,17 @@ void UserManagementPanel::UpdateButtonStates()
     m_toggleStatusBtn->Enable(hasSelection);
 }
 
+void UserManagementPanel::OnSearchText(wxCommandEvent &event)
+{
+    m_searchTimer.StartOnce(SEARCH_DEBOUNCE_MS);
+}
+
+void UserManagementPanel::OnSearchTimer(wxTimerEvent &event)
+{
+    RefreshUserList();
+    ClearSelection();
+}
+
 void UserManagementPanel::ClearSelection()
 {
     m_selectedUserId = -1;